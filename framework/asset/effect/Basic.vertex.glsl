@@ -9,6 +9,7 @@
 #endif
 
 #pragma include("Skinning.function.glsl")
+#pragma include("Instancing.function.glsl")
 
 attribute vec3 position;
 attribute vec2 uv;
@@ -37,7 +38,9 @@ void main(void)
 		pos = skinning_moveVertex(pos);
 	#endif // NUM_BONES
 	
-	#ifdef MODEL_TO_WORLD
+	#if defined(INSTANCING)
+		pos = instancing_modelToWorldMatrix() * pos;
+	#elif defined(MODEL_TO_WORLD)
 		pos = modelToWorldMatrix * pos;
 	#endif
 	
@@ -0,0 +1,19 @@
+#if defined(VERTEX_SHADER) && defined(INSTANCING)
+
+	// rows of the model to world matrix of the current instance
+	attribute	vec4	instanceModelToWorldMatrix0;
+	attribute	vec4	instanceModelToWorldMatrix1;
+	attribute	vec4	instanceModelToWorldMatrix2;
+	attribute	vec4	instanceModelToWorldMatrix3;
+
+	mat4 instancing_modelToWorldMatrix()
+	{
+		return mat4(
+			instanceModelToWorldMatrix0.x, instanceModelToWorldMatrix1.x, instanceModelToWorldMatrix2.x, instanceModelToWorldMatrix3.x,
+			instanceModelToWorldMatrix0.y, instanceModelToWorldMatrix1.y, instanceModelToWorldMatrix2.y, instanceModelToWorldMatrix3.y,
+			instanceModelToWorldMatrix0.z, instanceModelToWorldMatrix1.z, instanceModelToWorldMatrix2.z, instanceModelToWorldMatrix3.z,
+			instanceModelToWorldMatrix0.w, instanceModelToWorldMatrix1.w, instanceModelToWorldMatrix2.w, instanceModelToWorldMatrix3.w
+		);
+	}
+
+#endif // defined(VERTEX_SHADER) && defined(INSTANCING)
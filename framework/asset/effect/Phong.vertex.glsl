@@ -9,6 +9,7 @@
 #endif
 
 #pragma include("Skinning.function.glsl")
+#pragma include("Instancing.function.glsl")
 
 attribute vec3 position;
 attribute vec2 uv;
@@ -33,13 +34,19 @@ void main(void)
 
 	vec4 worldPosition 	= vec4(position, 1.0);
 
+	#if defined INSTANCING
+		mat4 modelToWorld	= instancing_modelToWorldMatrix();
+	#elif defined MODEL_TO_WORLD
+		mat4 modelToWorld	= modelToWorldMatrix;
+	#endif // INSTANCING
+
 	#ifdef NUM_BONES
 		worldPosition	= skinning_moveVertex(worldPosition);
 	#endif // NUM_BONES
 
-	#ifdef MODEL_TO_WORLD
-		worldPosition 	= modelToWorldMatrix * worldPosition;
-	#endif // MODEL_TO_WORLD
+	#if defined MODEL_TO_WORLD || defined INSTANCING
+		worldPosition 	= modelToWorld * worldPosition;
+	#endif // MODEL_TO_WORLD || INSTANCING
 
 	#if defined NUM_DIRECTIONAL_LIGHTS || defined NUM_POINT_LIGHTS || defined NUM_SPOT_LIGHTS || defined ENVIRONMENT_MAP_2D || defined ENVIRONMENT_CUBE_MAP
 
@@ -50,16 +57,16 @@ void main(void)
 			vertexNormal	= skinning_moveVertex(vec4(normal, 0.0)).xyz;
 		#endif // NUM_BONES
 
-		#ifdef MODEL_TO_WORLD
-			vertexNormal 	= mat3(modelToWorldMatrix) * vertexNormal;
-		#endif // MODEL_TO_WORLD
+		#if defined MODEL_TO_WORLD || defined INSTANCING
+			vertexNormal 	= mat3(modelToWorld) * vertexNormal;
+		#endif // MODEL_TO_WORLD || INSTANCING
 		vertexNormal 	= normalize(vertexNormal);
 
 		#ifdef NORMAL_MAP
 			vertexTangent = tangent;
-			#ifdef MODEL_TO_WORLD
-				vertexTangent = mat3(modelToWorldMatrix) * vertexTangent;
-			#endif // MODEL_TO_WORLD
+			#if defined MODEL_TO_WORLD || defined INSTANCING
+				vertexTangent = mat3(modelToWorld) * vertexTangent;
+			#endif // MODEL_TO_WORLD || INSTANCING
 			vertexTangent = normalize(vertexTangent);
 		#endif // NORMAL_MAP
 
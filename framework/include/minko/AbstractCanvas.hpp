@@ -96,6 +96,12 @@ namespace minko
         std::shared_ptr<async::Worker>
         getWorker(const std::string& name) = 0;
 
+        // Threads executing the workers and the parallel tasks of the engine. Canvases should own
+        // theirs: by default, the global scheduler is returned.
+        virtual
+        std::shared_ptr<async::TaskScheduler>
+        taskScheduler();
+
         // Current frame execution time in milliseconds.
         virtual
         float
@@ -135,6 +141,11 @@ namespace minko
             _defaultCanvas = value;
         }
 
+        // The scheduler of the default canvas, or the global one when no canvas exists.
+        static
+        std::shared_ptr<async::TaskScheduler>
+        defaultTaskScheduler();
+
     protected:
         static
         std::unordered_map<std::string, WorkerHandler>        _workers;
@@ -31,7 +31,11 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #pragma once
 
 #include <algorithm>
+#include <cstddef>
+#include <new>
+#include <type_traits>
 #include <typeinfo>
+#include <utility>
 
 namespace minko
 {
@@ -47,77 +51,181 @@ namespace minko
         typedef T Type;
     };
 
+    /**
+     * Holds a copy of a value of any copyable type.
+     *
+     * Values that fit in BUFFER_SIZE bytes and can be moved without throwing (scalars, small
+     * tuples, vectors, strings and shared pointers) are stored inline, the others are allocated
+     * on the heap. Each stored type is handled by a single static manager function, which also
+     * serves as a cheap type tag for the casts.
+     */
     class Any
     {
+    public:
+        static const std::size_t BUFFER_SIZE = 4 * sizeof(void*);
+
+    private:
+        enum class Operation
+        {
+            TYPE,
+            COPY,
+            MOVE,
+            DESTROY
+        };
+
+        // returns the type_info of the held type for Operation::TYPE, nullptr otherwise
+        typedef const std::type_info* (*Manager)(Operation, Any* self, Any* other);
+
+        union Storage
+        {
+            void*                                                       heap;
+            std::aligned_storage<BUFFER_SIZE, sizeof(void*)>::type      buffer;
+        };
+
+        template <typename ValueType>
+        struct IsInline
+        {
+            static const bool value = sizeof(ValueType) <= BUFFER_SIZE
+                && std::alignment_of<ValueType>::value <= std::alignment_of<Storage>::value
+                && std::is_nothrow_move_constructible<ValueType>::value;
+        };
+
+        template <typename ValueType>
+        struct Decay
+        {
+            typedef typename std::decay<ValueType>::type Type;
+        };
+
+        template <typename ValueType>
+        struct IsValue
+        {
+            static const bool value = !std::is_same<typename Decay<ValueType>::Type, Any>::value;
+        };
+
+    private:
+        Manager _manager;
+        Storage _storage;
+
     public:
         Any() :
-            _content(0)
+            _manager(nullptr)
         {
         }
 
-        template <typename ValueType>
-        Any(const ValueType & value) :
-            _content(new Holder<ValueType>(value))
+        template <typename ValueType, typename = typename std::enable_if<IsValue<ValueType>::value>::type>
+        Any(ValueType&& value) :
+            _manager(nullptr)
         {
+            construct<typename Decay<ValueType>::Type>(std::forward<ValueType>(value));
         }
 
         Any(const Any& other) :
-            _content(other._content ? other._content->clone() : 0)
+            _manager(nullptr)
         {
+            if (other._manager)
+                other._manager(Operation::COPY, this, const_cast<Any*>(&other));
+        }
+
+        Any(Any&& other) :
+            _manager(other._manager)
+        {
+            if (_manager)
+            {
+                _manager(Operation::MOVE, this, &other);
+                other._manager = nullptr;
+            }
         }
 
         ~Any()
         {
-            delete _content;
+            clear();
         }
 
         Any&
         swap(Any& rhs)
         {
-            std::swap(_content, rhs._content);
+            if (this != &rhs)
+            {
+                Any tmp(std::move(rhs));
+
+                rhs = std::move(*this);
+                *this = std::move(tmp);
+            }
+
+            return *this;
+        }
+
+        template <typename ValueType, typename = typename std::enable_if<IsValue<ValueType>::value>::type>
+        Any&
+        operator=(ValueType&& rhs)
+        {
+            typedef typename Decay<ValueType>::Type Type;
+
+            // assigning a value of the type already held does not need to reallocate it
+            assign<Type>(
+                std::forward<ValueType>(rhs),
+                std::integral_constant<bool, std::is_assignable<Type&, ValueType&&>::value>()
+            );
+
             return *this;
         }
 
-        template <typename ValueType>
         Any&
-        operator=(const ValueType& rhs)
+        operator=(const Any& rhs)
         {
-            Any(rhs).swap(*this);
+            if (this != &rhs)
+                Any(rhs).swap(*this);
+
             return *this;
         }
 
         Any&
-        operator=(Any rhs)
+        operator=(Any&& rhs)
         {
-            rhs.swap(*this);
+            if (this != &rhs)
+            {
+                clear();
+
+                _manager = rhs._manager;
+                if (_manager)
+                {
+                    _manager(Operation::MOVE, this, &rhs);
+                    rhs._manager = nullptr;
+                }
+            }
+
             return *this;
         }
 
         bool
         empty() const
         {
-            return !_content;
+            return !_manager;
         }
 
         const std::type_info&
         type() const
         {
-            return _content ? _content->type() : typeid(void);
+            return _manager ? *_manager(Operation::TYPE, nullptr, nullptr) : typeid(void);
         }
 
         template <typename ValueType>
         static ValueType*
         cast(Any* operand)
         {
-            return operand && operand->type() == typeid(ValueType) ?
-                &static_cast<Any::Holder<ValueType> *>(operand->_content)->_held : 0;
+            // values are stored and identified by their unqualified type
+            typedef typename std::remove_cv<ValueType>::type Type;
+
+            return operand && operand->holds<Type>() ? operand->pointer<Type>() : 0;
         }
 
         template <typename ValueType>
         static ValueType*
         unsafe_cast(Any* operand)
         {
-            return operand ? &static_cast<Any::Holder<ValueType> *>(operand->_content)->_held : 0;
+            typedef typename std::remove_cv<ValueType>::type Type;
+
+            return operand && operand->_manager ? operand->pointer<Type>() : 0;
         }
 
         template <typename ValueType>
@@ -180,51 +288,101 @@ namespace minko
             return unsafe_cast<const NonRef&>(const_cast<Any&>(operand));
         }
 
-        class Placeholder
+    private:
+        template <typename ValueType>
+        static
+        const std::type_info*
+        manage(Operation operation, Any* self, Any* other)
         {
-        public:
-            virtual ~Placeholder()
+            switch (operation)
             {
+            case Operation::TYPE:
+                return &typeid(ValueType);
+            case Operation::COPY:
+                self->construct<ValueType>(*other->pointer<ValueType>());
+                break;
+            case Operation::MOVE:
+                if (IsInline<ValueType>::value)
+                {
+                    new (&self->_storage.buffer) ValueType(std::move(*other->pointer<ValueType>()));
+                    other->pointer<ValueType>()->~ValueType();
+                }
+                else
+                    self->_storage.heap = other->_storage.heap;
+                break;
+            case Operation::DESTROY:
+                if (IsInline<ValueType>::value)
+                    self->pointer<ValueType>()->~ValueType();
+                else
+                    delete self->pointer<ValueType>();
+                break;
             }
 
-        public:
-            virtual const std::type_info&
-            type() const = 0;
+            return nullptr;
+        }
 
-            virtual Placeholder*
-            clone() const = 0;
-        };
+        template <typename ValueType>
+        inline
+        bool
+        holds() const
+        {
+            // the manager address identifies the type, unless it was instantiated in several modules
+            return _manager == &Any::manage<ValueType>
+                || (_manager && *_manager(Operation::TYPE, nullptr, nullptr) == typeid(ValueType));
+        }
 
         template <typename ValueType>
-        class Holder :
-            public Placeholder
+        inline
+        ValueType*
+        pointer()
         {
-        public:
-            Holder(const ValueType & value) :
-                _held(value)
-            {
-            }
+            return IsInline<ValueType>::value
+                ? reinterpret_cast<ValueType*>(&_storage.buffer)
+                : static_cast<ValueType*>(_storage.heap);
+        }
 
-            virtual const std::type_info&
-            type() const
-            {
-                return typeid(ValueType);
-            }
+        // expects the Any to be empty
+        template <typename ValueType, typename Arg>
+        void
+        construct(Arg&& value)
+        {
+            if (IsInline<ValueType>::value)
+                new (&_storage.buffer) ValueType(std::forward<Arg>(value));
+            else
+                _storage.heap = new ValueType(std::forward<Arg>(value));
 
-            virtual Placeholder*
-            clone() const
-            {
-                return new Holder(_held);
-            }
+            _manager = &Any::manage<ValueType>;
+        }
+
+        template <typename ValueType, typename Arg>
+        void
+        assign(Arg&& value, std::true_type)
+        {
+            if (_manager == &Any::manage<ValueType>)
+                *pointer<ValueType>() = std::forward<Arg>(value);
+            else
+                assign<ValueType>(std::forward<Arg>(value), std::false_type());
+        }
 
-        public:
-            ValueType _held;
+        template <typename ValueType, typename Arg>
+        void
+        assign(Arg&& value, std::false_type)
+        {
+            Any tmp;
 
-        private:
-            // Intentionally left unimplemented.
-            Holder& operator=(const Holder &);
-        };
+            tmp.construct<ValueType>(std::forward<Arg>(value));
+            *this = std::move(tmp);
+        }
 
-        Placeholder* _content;
+        inline
+        void
+        clear()
+        {
+            if (_manager)
+            {
+                _manager(Operation::DESTROY, this, nullptr);
+                _manager = nullptr;
+            }
+        }
     };
 }
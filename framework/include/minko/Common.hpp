@@ -180,6 +180,8 @@ namespace minko
         class Renderer;
         class PerspectiveCamera;
         class Culling;
+        class Batching;
+        class AnimationLevelOfDetail;
         class Picking;
         class JobManager;
 
@@ -261,6 +263,7 @@ namespace minko
     namespace geometry
     {
         class Geometry;
+        class BoundingVolumeHierarchy;
         class CubeGeometry;
         class SphereGeometry;
         class QuadGeometry;
@@ -272,6 +275,8 @@ namespace minko
     {
         class AbstractTimeline;
         class Matrix4x4Timeline;
+        class Pose;
+        class SkinLayer;
     }
 
     namespace math
@@ -337,6 +342,8 @@ namespace minko
     namespace file
     {
         class File;
+        class MemoryMappedFile;
+        class LoadingCache;
         class Options;
         class Loader;
         class AbstractProtocol;
@@ -391,6 +398,7 @@ namespace minko
     namespace async
     {
         class Worker;
+        class TaskScheduler;
     }
 
     namespace log
@@ -29,6 +29,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/CloneOption.hpp"
 #include "minko/render/AbstractContext.hpp"
 #include "minko/render/OpenGLES2Context.hpp"
+#include "minko/render/RecordingContext.hpp"
 #include "minko/render/ProgramInputs.hpp"
 #include "minko/render/Pass.hpp"
 #include "minko/render/Shader.hpp"
@@ -45,9 +46,12 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/math/Box.hpp"
 #include "minko/math/Ray.hpp"
 #include "minko/math/Frustum.hpp"
+#include "minko/math/OctTree.hpp"
 #include "minko/Signal.hpp"
 #include "minko/scene/Node.hpp"
 #include "minko/scene/NodeSet.hpp"
+#include "minko/data/PropertyId.hpp"
+#include "minko/data/PropertyIdMap.hpp"
 #include "minko/data/Provider.hpp"
 #include "minko/data/ArrayProvider.hpp"
 #include "minko/data/StructureProvider.hpp"
@@ -71,6 +75,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/component/MouseManager.hpp"
 #include "minko/component/SkinningMethod.hpp"
 #include "minko/component/Culling.hpp"
+#include "minko/component/Batching.hpp"
+#include "minko/component/AnimationLevelOfDetail.hpp"
 #include "minko/component/Picking.hpp"
 #include "minko/component/AbstractAnimation.hpp"
 #include "minko/component/MasterAnimation.hpp"
@@ -78,6 +84,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/component/Skinning.hpp"
 #include "minko/animation/AbstractTimeline.hpp"
 #include "minko/animation/Matrix4x4Timeline.hpp"
+#include "minko/animation/Pose.hpp"
+#include "minko/animation/SkinLayer.hpp"
 #include "minko/component/JobManager.hpp"
 #include "minko/render/AbstractResource.hpp"
 #include "minko/render/Program.hpp"
@@ -88,12 +96,15 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/render/CubeTexture.hpp"
 #include "minko/render/Priority.hpp"
 #include "minko/geometry/Geometry.hpp"
+#include "minko/geometry/BoundingVolumeHierarchy.hpp"
 #include "minko/geometry/CubeGeometry.hpp"
 #include "minko/geometry/SphereGeometry.hpp"
 #include "minko/geometry/QuadGeometry.hpp"
 #include "minko/geometry/TeapotGeometry.hpp"
 #include "minko/geometry/LineGeometry.hpp"
 #include "minko/file/File.hpp"
+#include "minko/file/MemoryMappedFile.hpp"
+#include "minko/file/LoadingCache.hpp"
 #include "minko/file/Options.hpp"
 #include "minko/file/Loader.hpp"
 #include "minko/file/AbstractProtocol.hpp"
@@ -110,3 +121,4 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/input/Touch.hpp"
 #include "minko/scene/Layout.hpp"
 #include "minko/async/Worker.hpp"
+#include "minko/async/TaskScheduler.hpp"
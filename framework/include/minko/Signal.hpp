@@ -23,81 +23,196 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 namespace minko
 {
+    /**
+     * A list of callbacks executed in decreasing priority order, then in connection order.
+     *
+     * The callbacks are stored contiguously and each slot holds the id of its connection, which
+     * maps to the index of its callback: disconnecting a slot is O(1), the dead callbacks being
+     * compacted once they make up half of the list. Callbacks connected while the signal is
+     * executing are only called from the next execution; callbacks disconnected while the signal
+     * is executing are still called during the current one.
+     */
     template <typename... A>
     class Signal :
         public std::enable_shared_from_this<Signal<A...>>
     {
     private:
-        typedef std::function<void(A...)>                                        CallbackFunction;
-        typedef std::pair<float, CallbackFunction>                                Callback;
-        typedef typename std::list<Callback>::iterator                            CallbackIterator;
-        typedef typename std::list<std::pair<float, unsigned int>>::iterator    SlotIterator;
+        // the arguments are shared by all the callbacks, and are therefore never copied
+        typedef std::function<void(const A&...)>                CallbackFunction;
+
+        struct Callback
+        {
+            float               priority;
+            unsigned int        id;
+            CallbackFunction    function;
+        };
 
         template <typename... B>
         class SignalSlot;
 
+        // keeps the signal locked while its callbacks are executed, even if one of them throws
+        class ExecutionLock
+        {
+        public:
+            explicit
+            ExecutionLock(Signal<A...>& signal) :
+                _signal(signal)
+            {
+                ++_signal._numLocks;
+            }
+
+            ~ExecutionLock()
+            {
+                _signal.unlock();
+            }
+
+        private:
+            Signal<A...>&   _signal;
+        };
+
     public:
         typedef std::shared_ptr<Signal<A...>>            Ptr;
         typedef std::shared_ptr<SignalSlot<A...>>        Slot;
 
     private:
-        std::list<Callback>                                        _callbacks;
-        std::list<std::pair<float, unsigned int>>                _slotIds;
-        unsigned int                                             _nextSlotId;
+        static const unsigned int                       INVALID_ID      = 0xffffffff;
+        // flags the index of a callback connected while the signal is executing
+        static const unsigned int                       PENDING_INDEX   = 0x80000000;
 
-        bool                                                    _locked;
-        std::list<std::pair<Callback, uint>>                    _toAdd;
-        std::list<std::pair<CallbackIterator, SlotIterator>>    _toRemove;
-        std::list<unsigned int>                                    _toRemoveSlotId;
-        bool                                                    _signalListDirty;
+        std::vector<Callback>                           _callbacks;
+        // index of the callback of each connection id
+        std::vector<unsigned int>                       _callbackIndices;
+        std::vector<unsigned int>                       _freeIds;
+        unsigned int                                    _numDisconnected;
+
+        unsigned int                                    _numLocks;
+        std::vector<Callback>                           _toAdd;
+        std::vector<unsigned int>                       _toRemove;
 
     private:
         Signal() :
             std::enable_shared_from_this<Signal<A...>>(),
-            _nextSlotId(0),
-            _locked(false),
-            _signalListDirty(false)
+            _callbacks(),
+            _callbackIndices(),
+            _freeIds(),
+            _numDisconnected(0),
+            _numLocks(0),
+            _toAdd(),
+            _toRemove()
         {
         }
 
         void
-        removeConnectionById(const unsigned int connectionId)
+        disconnect(const unsigned int id)
         {
-            auto connectionIdIt = _slotIds.begin();
-            auto callbackIt     = _callbacks.begin();
+            const auto index = _callbackIndices[id];
+
+            _freeIds.push_back(id);
 
-            while ((*connectionIdIt).second != connectionId)
+            if (index & PENDING_INDEX)
             {
-                connectionIdIt++;
-                callbackIt++;
+                // the callback would have been added at the end of the current execution
+                _toAdd[index & ~PENDING_INDEX].id = INVALID_ID;
+                _toAdd[index & ~PENDING_INDEX].function = nullptr;
             }
+            else if (_numLocks != 0)
+                _toRemove.push_back(index);
+            else
+            {
+                // destroying the function might disconnect other slots: only do it once the
+                // signal is in a consistent state
+                auto function = std::move(_callbacks[index].function);
 
-            removeConnectionByIterator(connectionIdIt, callbackIt);
+                removeCallback(index);
+            }
         }
 
         void
-        removeConnectionByIterator(SlotIterator         connectionIdIt,
-                                   CallbackIterator     callbackIt)
+        removeCallback(const unsigned int index)
         {
-            if (_locked)
-            {
-                auto addIt = std::find_if(_toAdd.begin(), _toAdd.end(), [&](std::pair<Callback, unsigned int>& add)
+            _callbacks[index].id = INVALID_ID;
+            _callbacks[index].function = nullptr;
+
+            if (++_numDisconnected * 2 > _callbacks.size())
+                compact();
+        }
+
+        void
+        compact()
+        {
+            auto numCallbacks = 0u;
+
+            for (auto& callback : _callbacks)
+                if (callback.id != INVALID_ID)
                 {
-                    return add.second == (*connectionIdIt).second;
-                });
+                    _callbackIndices[callback.id] = numCallbacks;
+                    if (&_callbacks[numCallbacks] != &callback)
+                        _callbacks[numCallbacks] = std::move(callback);
+                    ++numCallbacks;
+                }
+
+            _callbacks.resize(numCallbacks);
+            _numDisconnected = 0;
+        }
 
-                if (addIt != _toAdd.end())
-                    _toAdd.erase(addIt);
-                else
+        void
+        insertCallback(Callback&& callback)
+        {
+            if (_callbacks.empty() || !(callback.priority > _callbacks.back().priority))
+            {
+                _callbackIndices[callback.id] = _callbacks.size();
+                _callbacks.push_back(std::move(callback));
+
+                return;
+            }
+
+            // after all the callbacks with a greater or equal priority
+            auto position = std::upper_bound(
+                _callbacks.begin(),
+                _callbacks.end(),
+                callback.priority,
+                [](float priority, const Callback& c) { return priority > c.priority; }
+            );
+            const std::size_t index = position - _callbacks.begin();
+
+            _callbacks.insert(position, std::move(callback));
+
+            for (auto i = index; i < _callbacks.size(); ++i)
+                if (_callbacks[i].id != INVALID_ID)
+                    _callbackIndices[_callbacks[i].id] = i;
+        }
+
+        void
+        unlock()
+        {
+            if (--_numLocks != 0)
+                return;
+
+            if (!_toRemove.empty())
+            {
+                std::vector<CallbackFunction> functions;
+
+                for (auto index : _toRemove)
                 {
-                    _toRemove.push_back(std::pair<CallbackIterator, SlotIterator>(callbackIt, connectionIdIt));
-                    _toRemoveSlotId.push_back(connectionIdIt->second);
+                    functions.push_back(std::move(_callbacks[index].function));
+                    _callbacks[index].id = INVALID_ID;
+                    _callbacks[index].function = nullptr;
+                    ++_numDisconnected;
                 }
+                _toRemove.clear();
+
+                if (_numDisconnected * 2 > _callbacks.size())
+                    compact();
             }
-            else
+
+            if (!_toAdd.empty())
             {
-                _callbacks.erase(callbackIt);
-                _slotIds.erase(connectionIdIt);
+                std::vector<Callback> toAdd;
+
+                toAdd.swap(_toAdd);
+                for (auto& callback : toAdd)
+                    if (callback.id != INVALID_ID)
+                        insertCallback(std::move(callback));
             }
         }
 
@@ -113,86 +228,49 @@ namespace minko
         uint
         numCallbacks() const
         {
-            return _callbacks.size();
-        }
-
-        void
-        sortSignals()
-        {
-            _callbacks.sort([&](const Callback& callback1, const Callback& callback2) -> bool
-            {
-                return callback1.first > callback2.first;
-            });
-
-            _slotIds.sort([&](const std::pair<float, unsigned int>& slot1, const std::pair<float, unsigned int>& slot2) -> bool
-            {
-                return slot1.first > slot2.first;
-            });
+            return _callbacks.size() - _numDisconnected;
         }
 
         Slot
         connect(CallbackFunction callback, float priority = 0)
         {
-            auto connection = SignalSlot<A...>::create(Signal<A...>::shared_from_this(), _nextSlotId++);
+            unsigned int id;
 
-            if (_locked)
-                _toAdd.push_back(std::pair<Callback, unsigned int>(std::pair<float, CallbackFunction>(priority, callback), connection->_id));
+            if (_freeIds.empty())
+            {
+                id = _callbackIndices.size();
+                _callbackIndices.push_back(INVALID_ID);
+            }
             else
             {
+                id = _freeIds.back();
+                _freeIds.pop_back();
+            }
 
-                _callbacks.push_back(std::pair<float, CallbackFunction>(priority, callback));
-                _slotIds.push_back(std::pair<float, unsigned int>(priority, connection->_id));
-
-                if (_callbacks.size() >= 2)
-                {
-                    auto prec = std::prev(_callbacks.end(), 2);
+            auto connection = SignalSlot<A...>::create(Signal<A...>::shared_from_this(), id);
 
-                    if (priority > prec->first)
-                        sortSignals();
-                }
+            if (_numLocks != 0)
+            {
+                _callbackIndices[id] = PENDING_INDEX | _toAdd.size();
+                _toAdd.push_back(Callback { priority, id, std::move(callback) });
             }
+            else
+                insertCallback(Callback { priority, id, std::move(callback) });
 
             return connection;
         }
 
         void
-        execute(A... arguments)
+        execute(const A&... arguments)
         {
+            // the callbacks connected during the execution are only added when it ends
+            const auto numCallbacks = _callbacks.size();
 
-            _locked = true;
-            for (auto& callback : _callbacks)
-                callback.second(arguments...);
-            _locked = false;
-
-            for (auto& callbackIt : _toRemove)
-            {
-                _callbacks.erase(callbackIt.first);
-                _slotIds.erase(callbackIt.second);
-            }
-
-            for (auto& callbackAndConnectionId : _toAdd)
-            {
-
-                _callbacks.push_back(callbackAndConnectionId.first);
-                _slotIds.push_back(std::pair<float, unsigned int>(callbackAndConnectionId.first.first, callbackAndConnectionId.second));
-
-                if (_callbacks.size() >= 2)
-                {
-                    auto prec = std::prev(_callbacks.end(), 2);
-
-                    if (callbackAndConnectionId.first.first > prec->first)
-                        _signalListDirty = true;
-                }
-            }
-
-            if (_signalListDirty)
-            {
-                _signalListDirty = false;
-                sortSignals();
-            }
+            ExecutionLock lock(*this);
 
-            _toAdd.clear();
-            _toRemove.clear();
+            for (auto i = 0u; i < numCallbacks; ++i)
+                if (_callbacks[i].id != INVALID_ID)
+                    _callbacks[i].function(arguments...);
         }
 
     private:
@@ -217,7 +295,7 @@ namespace minko
             {
                 if (_signal != nullptr)
                 {
-                    _signal->removeConnectionById(_id);
+                    _signal->disconnect(_id);
                     _signal = nullptr;
                 }
             }
@@ -247,4 +325,10 @@ namespace minko
         };
 
     };
+
+    template <typename... A>
+    const unsigned int Signal<A...>::INVALID_ID;
+
+    template <typename... A>
+    const unsigned int Signal<A...>::PENDING_INDEX;
 }
@@ -34,10 +34,15 @@ namespace minko
 
 		private:
 			typedef std::shared_ptr<math::Matrix4x4>			Matrix4x4Ptr;
+
+		public:
 			typedef std::vector<std::pair<uint, Matrix4x4Ptr>>	MatrixTimetable;
+			typedef std::shared_ptr<const MatrixTimetable>		MatrixTimetablePtr;
+
 		private:
-			MatrixTimetable	_matrices;
-			bool			_interpolate;
+			// the keys are never modified once created and are shared by all the clones
+			MatrixTimetablePtr	_matrices;
+			bool				_interpolate;
 
 		public:
 			inline static
@@ -76,9 +81,20 @@ namespace minko
 			void
 			update(uint time, UpdateTargetPtr, bool skipPropertyNameFormatting = true);
 
+			// writes the value of the timeline at time in a matrix resolved beforehand
+			void
+			update(uint time, Matrix4x4Ptr matrix) const;
+
             Matrix4x4Ptr
             interpolate(uint time, Matrix4x4Ptr output = nullptr) const;
 
+			inline
+			MatrixTimetablePtr
+			matrices() const
+			{
+				return _matrices;
+			}
+
 		private:
 			Matrix4x4Timeline(const std::string&,
 							  uint,
@@ -0,0 +1,124 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+    namespace animation
+    {
+        /**
+         * Translation, rotation and scale of each bone of a skin, stored by channel so that the
+         * bones are blended 4 at a time.
+         *
+         * Matrices are read and written in the layout Skinning uses. The bones whose matrices
+         * cannot be decomposed (projection, null scale) keep their matrix and switch to the other
+         * pose once it weighs more than half.
+         */
+        class Pose
+        {
+        public:
+            typedef std::shared_ptr<Pose>   Ptr;
+
+        private:
+            enum Channel
+            {
+                TX, TY, TZ,
+                QX, QY, QZ, QW,
+                SX, SY, SZ,
+                NUM_CHANNELS
+            };
+
+        private:
+            const uint                      _numBones;
+            const uint                      _stride;            // #bones rounded up to a multiple of 4
+
+            std::vector<float>              _channels;          // size = NUM_CHANNELS * stride
+            std::vector<float>              _matrices;          // size = #bones * 16, only for the bones not decomposed
+            std::vector<unsigned char>      _decomposed;        // size = #bones
+            std::vector<float>              _weights;           // size = stride
+
+        public:
+            inline static
+            Ptr
+            create(uint numBones)
+            {
+                return std::shared_ptr<Pose>(new Pose(numBones));
+            }
+
+            inline
+            uint
+            numBones() const
+            {
+                return _numBones;
+            }
+
+            // reads the numBones() matrices of the pose
+            void
+            decompose(const float* matrices);
+
+            // writes the numBones() matrices of the pose
+            void
+            compose(float* matrices) const;
+
+            // moves each bone towards pose by weight times its value in boneMask (all bones when empty)
+            void
+            blend(const Pose& pose, float weight, const std::vector<float>& boneMask);
+
+            // applies the transformation from reference to pose, scaled the same way
+            void
+            add(const Pose& pose, const Pose& reference, float weight, const std::vector<float>& boneMask);
+
+            // false when the matrix has a shear or a projection
+            static
+            bool
+            decomposeMatrix(const float* matrix, float* translation, float* rotation, float* scale);
+
+            static
+            void
+            composeMatrix(const float* translation, const float* rotation, const float* scale, float* matrix);
+
+        private:
+            Pose(uint numBones);
+
+            inline
+            float*
+            channel(Channel c)
+            {
+                return &_channels[c * _stride];
+            }
+
+            inline
+            const float*
+            channel(Channel c) const
+            {
+                return &_channels[c * _stride];
+            }
+
+            void
+            computeWeights(float weight, const std::vector<float>& boneMask);
+
+            void
+            copyBone(const Pose& pose, uint boneId);
+        };
+    }
+}
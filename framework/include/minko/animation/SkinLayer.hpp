@@ -0,0 +1,168 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+    namespace geometry
+    {
+        class Skin;
+    }
+
+    namespace animation
+    {
+        /**
+         * Clip blended by Skinning over the animation of its skin, with its own playhead.
+         *
+         * An override layer moves the bones towards its pose by its weight, an additive layer
+         * applies the difference between its pose and its first frame. The bone mask scales the
+         * weight of each bone, all of them being affected when it is empty.
+         */
+        class SkinLayer :
+            public std::enable_shared_from_this<SkinLayer>
+        {
+        public:
+            typedef std::shared_ptr<SkinLayer>      Ptr;
+
+        private:
+            typedef std::shared_ptr<geometry::Skin> SkinPtr;
+            typedef std::shared_ptr<Pose>           PosePtr;
+
+        private:
+            SkinPtr                                 _skin;
+            const bool                              _additive;
+            float                                   _weight;
+            std::vector<float>                      _boneMask;
+            uint                                    _time;          // in milliseconds
+
+            bool                                    _isFading;
+            float                                   _fadeStartWeight;
+            float                                   _fadeEndWeight;
+            uint                                    _fadeDuration;
+            uint                                    _fadeTime;
+            bool                                    _removeAfterFade;
+
+            PosePtr                                 _pose;
+            uint                                    _poseFrameId;
+            PosePtr                                 _reference;
+
+        public:
+            inline static
+            Ptr
+            create(SkinPtr skin, bool additive = false)
+            {
+                return std::shared_ptr<SkinLayer>(new SkinLayer(skin, additive));
+            }
+
+            inline
+            SkinPtr
+            skin() const
+            {
+                return _skin;
+            }
+
+            inline
+            bool
+            additive() const
+            {
+                return _additive;
+            }
+
+            inline
+            float
+            weight() const
+            {
+                return _weight;
+            }
+
+            // stops any fade
+            inline
+            Ptr
+            weight(float value)
+            {
+                _weight     = value;
+                _isFading   = false;
+
+                return shared_from_this();
+            }
+
+            inline
+            const std::vector<float>&
+            boneMask() const
+            {
+                return _boneMask;
+            }
+
+            // one weight per bone, or empty for all the bones
+            Ptr
+            boneMask(const std::vector<float>& value);
+
+            inline
+            uint
+            time() const
+            {
+                return _time;
+            }
+
+            Ptr
+            seek(uint time);
+
+            inline
+            bool
+            isFading() const
+            {
+                return _isFading;
+            }
+
+            // moves the weight to value within duration milliseconds
+            Ptr
+            fade(float value, uint duration, bool removeAfterFade = false);
+
+            // advances the playhead and the fade, returns false once the layer must be removed
+            bool
+            advance(uint deltaTime);
+
+            // true when the layer hides everything below it
+            inline
+            bool
+            opaque() const
+            {
+                return !_additive && _weight >= 1.0f && _boneMask.empty();
+            }
+
+            uint
+            frameId() const;
+
+            // the pose of the skin at the current time
+            const Pose&
+            pose();
+
+            // the first frame of the skin, additive layers apply their difference with it
+            const Pose&
+            reference();
+
+        private:
+            SkinLayer(SkinPtr skin, bool additive);
+        };
+    }
+}
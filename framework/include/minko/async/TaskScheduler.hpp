@@ -0,0 +1,158 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+namespace minko
+{
+    namespace async
+    {
+        /**
+         * A fixed set of threads executing tasks. Each thread owns a queue: it executes its own
+         * tasks from the most recent one and steals the oldest tasks of the other threads when
+         * its queue is empty. Tasks scheduled from outside of the threads are dispatched to the
+         * queues in turn.
+         *
+         * Tasks spending most of their time waiting, like file reads or HTTP requests, are
+         * scheduled with scheduleBlocking() instead: they run on a separate set of threads
+         * created on demand, so that they never hold a thread of the pool.
+         *
+         * A scheduler without any thread (always the case under Emscripten) executes the tasks
+         * immediately.
+         */
+        class TaskScheduler
+        {
+        public:
+            typedef std::shared_ptr<TaskScheduler>              Ptr;
+            typedef std::function<void()>                       Task;
+            typedef std::function<void(uint, uint)>             RangeFunction;
+
+        private:
+            struct TaskQueue
+            {
+                std::mutex          mutex;
+                std::deque<Task>    tasks;
+            };
+
+            struct ParallelFor;
+
+        private:
+            std::vector<std::thread>                            _threads;
+            std::vector<std::unique_ptr<TaskQueue>>             _queues;
+            std::atomic<uint>                                   _nextQueue;
+            std::atomic<uint>                                   _numPendingTasks;
+            std::mutex                                          _sleepMutex;
+            std::condition_variable                             _taskAvailable;
+            bool                                                _done;
+
+            std::vector<std::thread>                            _blockingThreads;
+            std::deque<Task>                                    _blockingTasks;
+            uint                                                _numIdleBlockingThreads;
+            std::mutex                                          _blockingMutex;
+            std::condition_variable                             _blockingTaskAvailable;
+            bool                                                _blockingDone;
+
+            std::mutex                                          _mainThreadMutex;
+            std::vector<Task>                                   _mainThreadTasks;
+
+            static const uint                                   MAX_NUM_BLOCKING_THREADS;
+
+            static Ptr                                          _defaultScheduler;
+
+        public:
+            inline static
+            Ptr
+            create(uint numThreads = defaultNumThreads())
+            {
+                return std::shared_ptr<TaskScheduler>(new TaskScheduler(numThreads));
+            }
+
+            // The global scheduler, used when there is no canvas to own one. Created on first use.
+            static
+            Ptr
+            defaultScheduler();
+
+            static
+            void
+            defaultScheduler(Ptr scheduler);
+
+            // One thread per hardware thread but the calling one, and at least one.
+            static
+            uint
+            defaultNumThreads();
+
+            inline
+            uint
+            numThreads() const
+            {
+                return _threads.size();
+            }
+
+            void
+            schedule(Task task);
+
+            // Executes a task which blocks most of the time on one of the blocking threads. A new
+            // thread is started when they are all busy, up to MAX_NUM_BLOCKING_THREADS.
+            void
+            scheduleBlocking(Task task);
+
+            uint
+            numBlockingThreads();
+
+            /**
+             * Calls f(chunkBegin, chunkEnd) on chunks of at most grainSize indices covering
+             * [begin, end), and returns once they have all been processed. The calling thread
+             * processes chunks as well, so this can safely be called from a task.
+             */
+            void
+            parallelFor(uint begin, uint end, const RangeFunction& f, uint grainSize = 1);
+
+            // Queues a task for the next call to pollMainThread(), which the scene manager makes
+            // at the beginning of each frame. Tasks use it to hand their results back to the main thread.
+            void
+            postToMainThread(Task task);
+
+            // Executes the tasks posted to the main thread in order and returns their number.
+            uint
+            pollMainThread();
+
+            ~TaskScheduler();
+
+        private:
+            TaskScheduler(uint numThreads);
+
+            void
+            run(uint threadId);
+
+            bool
+            popTask(uint threadId, Task& task);
+
+            void
+            runBlocking();
+        };
+    }
+}
@@ -19,7 +19,9 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 #pragma once
 
+#include "minko/AbstractCanvas.hpp"
 #include "minko/async/Worker.hpp"
+#include "minko/async/TaskScheduler.hpp"
 
 #if MINKO_PLATFORM == MINKO_PLATFORM_HTML5
 # error "ThreadWorkerImpl is not available under Emscripten"
@@ -39,7 +41,10 @@ namespace minko
 
                 _input = input;
 
-                std::thread(&Worker::run, _that->shared_from_this(), std::ref(_input)).detach();
+                auto that = _that->shared_from_this();
+
+                // workers mostly wait for files or the network: they must not hold a thread of the pool
+                AbstractCanvas::defaultTaskScheduler()->scheduleBlocking([this, that]() { that->run(_input); });
             }
 
             void
@@ -47,13 +52,20 @@ namespace minko
             {
                 // std::cout << "ThreadWorkerImpl::poll()" << std::endl;;
 
-                std::lock_guard<std::mutex> lock(_mutex);
+                std::queue<Message> messages;
+
+                {
+                    std::lock_guard<std::mutex> lock(_mutex);
+
+                    messages.swap(_messages);
+                }
 
-                while (!_messages.empty())
+                // the worker can keep posting messages while they are dispatched
+                while (!messages.empty())
                 {
                     //std::cout << "ThreadWorkerImpl::poll(): message execute" << std::endl;
-                    _message->execute(_that->shared_from_this(), _messages.front());
-                    _messages.pop();
+                    _message->execute(_that->shared_from_this(), messages.front());
+                    messages.pop();
                 }
             }
 
@@ -63,8 +75,7 @@ namespace minko
                 //std::cout << "ThreadWorkerImpl::post(): " << message.type << std::endl;
                 std::lock_guard<std::mutex> lock(_mutex);
 
-                // FIXME: Optimize here (useless copy).
-                _messages.push(message);
+                _messages.push(std::move(message));
             }
 
             Signal<Ptr, Message>::Ptr
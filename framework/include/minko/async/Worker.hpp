@@ -57,6 +57,13 @@ namespace minko
                     data = value;
                     return *this;
                 }
+
+                Message&
+                set(std::vector<char>&& value)
+                {
+                    data = std::move(value);
+                    return *this;
+                }
             };
 
         public:
@@ -70,6 +70,8 @@ namespace minko
 			bool		_isLooping;
 			bool		_isReversed;
 			bool		_mustUpdateOnce;
+			uint		_updateInterval;	// in frames
+			uint		_framesSinceUpdate;
 
 
 			clock_t		_clockStart;
@@ -208,6 +210,17 @@ namespace minko
 				_isPlaying = value;
 			}
 
+			inline
+			uint
+			updateInterval() const
+			{
+				return _updateInterval;
+			}
+
+			// the animation is only updated once every value frames, its time still following the scene
+			Ptr
+			updateInterval(uint value);
+
 			inline
 			bool
 			isLooping() const
@@ -320,6 +333,13 @@ namespace minko
 			void
 			setSceneManager(std::shared_ptr<SceneManager>);
 
+			inline
+			std::shared_ptr<SceneManager>
+			sceneManager() const
+			{
+				return _sceneManager;
+			}
+
 			virtual
 			void
 			frameBeginHandler(std::shared_ptr<SceneManager>, float, float);
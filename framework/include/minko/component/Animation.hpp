@@ -35,13 +35,37 @@ namespace minko
 
         private:
             typedef std::shared_ptr<animation::AbstractTimeline>    AbsTimelinePtr;
+            typedef std::shared_ptr<animation::Matrix4x4Timeline>   Matrix4x4TimelinePtr;
             typedef std::shared_ptr<MasterAnimation>                MasterAnimationPtr;
             typedef std::shared_ptr<scene::Node>                    NodePtr;
             typedef std::shared_ptr<AbstractComponent>              AbsCmpPtr;
+            typedef std::shared_ptr<math::Matrix4x4>                Matrix4x4Ptr;
+            typedef Signal<AbsCmpPtr, NodePtr>::Slot                TargetSlot;
+            typedef Signal<NodePtr, NodePtr, AbsCmpPtr>::Slot       ComponentSlot;
+
+            // a matrix timeline and the matrix it writes, looked up once in the data of the target
+            struct MatrixBinding
+            {
+                Matrix4x4TimelinePtr    timeline;
+                Matrix4x4Ptr            matrix;
+            };
+
+        public:
+            class RootAnimation;
 
         private:
             std::vector<AbsTimelinePtr>                             _timelines;
 
+            std::vector<MatrixBinding>                              _matrixBindings;
+            std::vector<std::pair<AbsTimelinePtr, NodePtr>>         _unboundTimelines;  // updated through the data of their target
+            bool                                                    _invalidBindings;
+            TargetSlot                                              _bindingsTargetAddedSlot;
+            TargetSlot                                              _bindingsTargetRemovedSlot;
+            std::unordered_map<NodePtr, std::list<ComponentSlot>>   _componentSlots;
+
+            std::shared_ptr<RootAnimation>                          _rootAnimation;
+            bool                                                    _queued;
+
         public:
             inline static
             Ptr
@@ -92,6 +116,27 @@ namespace minko
             void
             update() override;
 
+            void
+            addedHandler(NodePtr node, NodePtr target, NodePtr parent) override;
+
+            void
+            removedHandler(NodePtr node, NodePtr target, NodePtr parent) override;
+
+            void
+            bindingsTargetAddedHandler(AbsCmpPtr cmp, NodePtr target);
+
+            void
+            bindingsTargetRemovedHandler(AbsCmpPtr cmp, NodePtr target);
+
+            void
+            updateRootAnimation();
+
+            void
+            bind();
+
+            void
+            evaluate();
+
             void
             frameBeginHandler(std::shared_ptr<SceneManager> manager, float time, float deltaTime) override
             {
@@ -111,6 +156,83 @@ namespace minko
             {
                 AbstractAnimation::checkLabelHit(previousTime, newTime);
             }
+
+        public:
+            /**
+             * Added to the node of the scene manager: the animations updated during frameBegin queue
+             * themselves and are all evaluated at once after the last of them, their timelines writing
+             * straight into the matrices they were bound to. The scripts are updated afterwards and
+             * read the animated matrices of the current frame.
+             */
+            class RootAnimation :
+                public AbstractComponent
+            {
+            public:
+                typedef std::shared_ptr<RootAnimation>              Ptr;
+
+            private:
+                typedef std::shared_ptr<SceneManager>               SceneManagerPtr;
+
+            private:
+                std::vector<Animation::Ptr>                         _queue;
+                bool                                                _inFrame;
+
+                TargetSlot                                          _targetAddedSlot;
+                TargetSlot                                          _targetRemovedSlot;
+                Signal<SceneManagerPtr, float, float>::Slot         _frameStartSlot;
+                Signal<SceneManagerPtr, float, float>::Slot         _frameEndSlot;
+
+            public:
+                inline static
+                Ptr
+                create()
+                {
+                    auto ctrl = std::shared_ptr<RootAnimation>(new RootAnimation());
+
+                    ctrl->initialize();
+
+                    return ctrl;
+                }
+
+                AbstractComponent::Ptr
+                clone(const CloneOption& option);
+
+                // true while the animations of the scene are being updated
+                inline
+                bool
+                inFrame() const
+                {
+                    return _inFrame;
+                }
+
+                inline
+                void
+                queue(Animation::Ptr animation)
+                {
+                    _queue.push_back(animation);
+                }
+
+                void
+                evaluate();
+
+            private:
+                RootAnimation();
+
+                void
+                initialize();
+
+                void
+                targetAddedHandler(AbsCmpPtr ctrl, NodePtr target);
+
+                void
+                targetRemovedHandler(AbsCmpPtr ctrl, NodePtr target);
+
+                void
+                frameStartHandler(SceneManagerPtr sceneManager, float time, float deltaTime);
+
+                void
+                frameEndHandler(SceneManagerPtr sceneManager, float time, float deltaTime);
+            };
         };
     }
 }
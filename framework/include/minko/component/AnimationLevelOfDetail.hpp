@@ -0,0 +1,152 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "minko/Common.hpp"
+#include "minko/component/AbstractComponent.hpp"
+#include "minko/Signal.hpp"
+
+namespace minko
+{
+    namespace component
+    {
+        /**
+         * Lowers the cost of the animations found under its target according to the size they take on
+         * the screen of a camera. At the beginning of each frame, each animation gets the level of the
+         * projected size of the nearest bounding box (on its node or below): the smaller it gets, the
+         * less often it is updated and the fewer bones software skinning uses per vertex.
+         *
+         * The animations without any bounding box stay at the first level. The surfaces hidden by
+         * culling are not skinned at all, whatever their level, see Skinning.
+         */
+        class AnimationLevelOfDetail :
+            public AbstractComponent
+        {
+        public:
+            typedef std::shared_ptr<AnimationLevelOfDetail>                     Ptr;
+
+            struct Level
+            {
+                float   minScreenSize;      // fraction of the height of the screen covered by the box
+                uint    updateInterval;     // in frames
+                uint    maxNumVertexBones;  // 0 for all of them
+
+                inline
+                Level(float minScreenSize, uint updateInterval, uint maxNumVertexBones) :
+                    minScreenSize(minScreenSize),
+                    updateInterval(updateInterval),
+                    maxNumVertexBones(maxNumVertexBones)
+                {
+                }
+            };
+
+            static const std::vector<Level>                                     DEFAULT_LEVELS;
+
+        private:
+            typedef std::shared_ptr<scene::Node>                                NodePtr;
+            typedef std::shared_ptr<AbstractAnimation>                          AbstractAnimationPtr;
+            typedef std::shared_ptr<BoundingBox>                                BoundingBoxPtr;
+            typedef std::shared_ptr<SceneManager>                               SceneManagerPtr;
+
+            typedef Signal<AbstractComponent::Ptr, NodePtr>::Slot               TargetChangedSlot;
+            typedef Signal<NodePtr, NodePtr, NodePtr>::Slot                     NodeChangedSlot;
+            typedef Signal<NodePtr, NodePtr, AbstractComponent::Ptr>::Slot      ComponentChangedSlot;
+            typedef Signal<SceneManagerPtr, float, float>::Slot                 FrameBeginSlot;
+
+            struct Instance
+            {
+                AbstractAnimationPtr    animation;
+                BoundingBoxPtr          box;
+                uint                    level;
+            };
+
+        private:
+            NodePtr                                                             _camera;
+            std::vector<Level>                                                  _levels;
+
+            std::vector<Instance>                                               _instances;
+            bool                                                                _invalidInstances;
+
+            TargetChangedSlot                                                   _targetAddedSlot;
+            TargetChangedSlot                                                   _targetRemovedSlot;
+            NodeChangedSlot                                                     _addedSlot;
+            NodeChangedSlot                                                     _removedSlot;
+            ComponentChangedSlot                                                _componentAddedSlot;
+            ComponentChangedSlot                                                _componentRemovedSlot;
+            FrameBeginSlot                                                      _frameBeginSlot;
+
+        public:
+            // the levels are sorted by decreasing minScreenSize, the last one applying to any smaller size
+            inline static
+            Ptr
+            create(NodePtr camera, const std::vector<Level>& levels = DEFAULT_LEVELS)
+            {
+                Ptr lod = std::shared_ptr<AnimationLevelOfDetail>(new AnimationLevelOfDetail(camera, levels));
+
+                lod->initialize();
+
+                return lod;
+            }
+
+            inline
+            const std::vector<Level>&
+            levels() const
+            {
+                return _levels;
+            }
+
+            // index in levels() of the current level of animation
+            uint
+            level(AbstractAnimationPtr animation) const;
+
+            // apply the levels, done automatically at the beginning of each frame
+            void
+            update();
+
+        private:
+            AnimationLevelOfDetail(NodePtr camera, const std::vector<Level>& levels);
+
+            void
+            initialize();
+
+            void
+            targetAddedHandler(AbstractComponent::Ptr ctrl, NodePtr target);
+
+            void
+            targetRemovedHandler(AbstractComponent::Ptr ctrl, NodePtr target);
+
+            void
+            addedHandler(NodePtr node, NodePtr target, NodePtr ancestor);
+
+            void
+            frameBeginHandler(SceneManagerPtr sceneManager, float time, float deltaTime);
+
+            void
+            collectInstances();
+
+            void
+            applyLevel(Instance& instance, uint level);
+
+            float
+            screenSize(BoundingBoxPtr box) const;
+        };
+    }
+}
@@ -0,0 +1,206 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+#include "minko/component/AbstractComponent.hpp"
+#include "minko/Signal.hpp"
+
+namespace minko
+{
+    namespace component
+    {
+        /**
+         * Merges the geometries of the surfaces found under its target that share the same material,
+         * effect, technique, layouts and vertex format into pre-transformed batches, each of them
+         * rendered with a single draw call per pass instead of one per surface.
+         *
+         * Only the surfaces of the nodes matching the layout mask of the component are batched.
+         * A batch is rebuilt when one of its surfaces is added, removed, hidden or shown; when a
+         * surface only moves, its vertices are transformed again and re-uploaded in place.
+         */
+        class Batching :
+            public AbstractComponent
+        {
+        public:
+            typedef std::shared_ptr<Batching>                                   Ptr;
+
+        private:
+            typedef std::shared_ptr<scene::Node>                                NodePtr;
+            typedef std::shared_ptr<Surface>                                    SurfacePtr;
+            typedef std::shared_ptr<SceneManager>                               SceneManagerPtr;
+            typedef std::shared_ptr<data::Container>                            ContainerPtr;
+            typedef std::shared_ptr<render::AbstractTexture>                    AbsTexturePtr;
+            typedef std::shared_ptr<geometry::Geometry>                         GeometryPtr;
+
+            typedef Signal<AbstractComponent::Ptr, NodePtr>::Slot               TargetChangedSlot;
+            typedef Signal<NodePtr, NodePtr, NodePtr>::Slot                     NodeChangedSlot;
+            typedef Signal<NodePtr, NodePtr, AbstractComponent::Ptr>::Slot      ComponentChangedSlot;
+            typedef Signal<NodePtr, NodePtr>::Slot                              LayoutsChangedSlot;
+            typedef Signal<SceneManagerPtr, uint, AbsTexturePtr>::Slot          SceneManagerSignalSlot;
+            typedef Signal<ContainerPtr, const std::string&>::Slot              PropertyChangedSlot;
+            typedef Signal<SurfacePtr, std::shared_ptr<Renderer>, bool>::Slot   VisibilityChangedSlot;
+
+            // material, effect, technique, layouts and vertex format
+            typedef std::tuple<const void*, const void*, std::string, Layouts, std::string>    BatchKey;
+
+            struct Batch
+            {
+                NodePtr                     node;
+                std::vector<SurfacePtr>     surfaces;
+                // index of the first vertex of each surface in the merged vertex buffers
+                std::vector<uint>           firstVertices;
+            };
+
+            struct Bucket
+            {
+                std::vector<SurfacePtr>     surfaces;
+                std::vector<Batch>          batches;
+                bool                        invalid;
+            };
+
+        private:
+            static const uint                                                   MIN_NUM_SURFACES;
+            static const uint                                                   MAX_NUM_VERTICES;
+
+            std::map<BatchKey, Bucket>                                          _buckets;
+            std::unordered_map<SurfacePtr, BatchKey>                            _surfaceToKey;
+            // index of the batch and of the surface in that batch for each batched surface
+            std::unordered_map<SurfacePtr, std::pair<uint, uint>>               _surfaceToBatch;
+            std::unordered_map<SurfacePtr, PropertyChangedSlot>                 _surfaceToTransformChangedSlot;
+            std::unordered_map<SurfacePtr, VisibilityChangedSlot>               _surfaceToVisibilityChangedSlot;
+            std::unordered_set<SurfacePtr>                                      _movedSurfaces;
+            std::unordered_set<SurfacePtr>                                      _hiddenSurfaces;
+            std::unordered_set<NodePtr>                                         _batchNodes;
+            bool                                                                _invalidSurfaces;
+
+            uint                                                                _numRebuilds;
+            uint                                                                _numUpdates;
+
+            TargetChangedSlot                                                   _targetAddedSlot;
+            TargetChangedSlot                                                   _targetRemovedSlot;
+            NodeChangedSlot                                                     _addedSlot;
+            NodeChangedSlot                                                     _removedSlot;
+            ComponentChangedSlot                                                _componentAddedSlot;
+            ComponentChangedSlot                                                _componentRemovedSlot;
+            LayoutsChangedSlot                                                  _layoutsChangedSlot;
+            SceneManagerSignalSlot                                              _renderingBeginSlot;
+
+        public:
+            inline static
+            Ptr
+            create()
+            {
+                Ptr batching = std::shared_ptr<Batching>(new Batching());
+
+                batching->initialize();
+
+                return batching;
+            }
+
+            // number of batches currently rendered
+            uint
+            numBatches() const;
+
+            // number of surfaces rendered as part of a batch
+            inline
+            uint
+            numBatchedSurfaces() const
+            {
+                return _surfaceToBatch.size();
+            }
+
+            // number of draw calls per frame saved by rendering the batches instead of their surfaces
+            uint
+            numSavedDrawCalls() const;
+
+            // number of times a batch had to be rebuilt from scratch
+            inline
+            uint
+            numRebuilds() const
+            {
+                return _numRebuilds;
+            }
+
+            // number of times the vertices of a moved surface were updated in its batch
+            inline
+            uint
+            numUpdates() const
+            {
+                return _numUpdates;
+            }
+
+            // apply the pending changes, done automatically at the beginning of each frame
+            void
+            update();
+
+        private:
+            Batching();
+
+            void
+            initialize();
+
+            void
+            targetAddedHandler(AbstractComponent::Ptr ctrl, NodePtr target);
+
+            void
+            targetRemovedHandler(AbstractComponent::Ptr ctrl, NodePtr target);
+
+            void
+            addedHandler(NodePtr node, NodePtr target, NodePtr ancestor);
+
+            void
+            renderingBeginHandler(SceneManagerPtr sceneManager, uint frameId, AbsTexturePtr renderTarget);
+
+            void
+            collectSurfaces();
+
+            bool
+            isBatchable(SurfacePtr surface) const;
+
+            BatchKey
+            getBatchKey(SurfacePtr surface) const;
+
+            void
+            addSurface(SurfacePtr surface);
+
+            void
+            removeSurface(SurfacePtr surface);
+
+            void
+            surfaceVisibilityChangedHandler(SurfacePtr surface);
+
+            void
+            buildBatches(Bucket& bucket);
+
+            void
+            removeBatches(Bucket& bucket);
+
+            GeometryPtr
+            createBatchGeometry(Batch& batch);
+
+            void
+            updateBatchedVertices(SurfacePtr surface);
+
+            void
+            writeVertices(SurfacePtr surface, GeometryPtr batchGeometry, uint firstVertex);
+        };
+    }
+}
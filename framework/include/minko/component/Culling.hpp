@@ -28,6 +28,12 @@ namespace minko
 {
     namespace component
     {
+        /**
+         * Hides the surfaces outside of the frustum of the camera it is added to. The nodes of the scene
+         * matching the layout mask of the component are stored in a loose octree that grows to fit the
+         * scene and follows the moving nodes. The frustum is tested at the beginning of each frame, after
+         * the transforms were updated, and the surfaces are only notified when their visibility changes.
+         */
         class Culling :
             public AbstractComponent
         {
@@ -37,18 +43,27 @@ namespace minko
         private:
             typedef std::shared_ptr<scene::Node>                                NodePtr;
             typedef std::shared_ptr<math::AbstractShape>                        ShapePtr;
+            typedef std::shared_ptr<SceneManager>                               SceneManagerPtr;
+            typedef std::shared_ptr<render::AbstractTexture>                    AbsTexturePtr;
 
         private:
-            static std::shared_ptr<math::OctTree>                               _octTree;
+            static const float                                                  DEFAULT_WORLD_SIZE;
+            static const uint                                                   MAX_DEPTH;
 
+            std::shared_ptr<math::OctTree>                                      _octTree;
             std::shared_ptr<math::AbstractShape>                                _frustum;
+            bool                                                                _invalidFrustum;
 
             Signal<AbstractComponent::Ptr, NodePtr>::Slot                       _targetAddedSlot;
             Signal<AbstractComponent::Ptr, NodePtr>::Slot                       _targetRemovedSlot;
             Signal<NodePtr, NodePtr, NodePtr>::Slot                             _addedSlot;
+            Signal<NodePtr, NodePtr, NodePtr>::Slot                             _removedSlot;
             Signal<NodePtr, NodePtr, NodePtr>::Slot                             _addedToSceneSlot;
+            Signal<NodePtr, NodePtr, AbstractComponent::Ptr>::Slot              _componentAddedSlot;
+            Signal<NodePtr, NodePtr, AbstractComponent::Ptr>::Slot              _componentRemovedSlot;
             Signal<NodePtr, NodePtr>::Slot                                      _layoutChangedSlot;
             Signal<std::shared_ptr<data::Container>, const std::string&>::Slot  _viewMatrixChangedSlot;
+            Signal<SceneManagerPtr, uint, AbsTexturePtr>::Slot                  _renderingBeginSlot;
 
             std::string                                                         _bindProperty;
 
@@ -65,6 +80,13 @@ namespace minko
                 return CullingComponent;
             }
 
+            inline
+            std::shared_ptr<math::OctTree>
+            octTree() const
+            {
+                return _octTree;
+            }
+
         private:
             Culling(ShapePtr                shape,
                     const std::string&      bindProperty);
@@ -81,6 +103,12 @@ namespace minko
             void
             addedHandler(NodePtr node, NodePtr target, NodePtr ancestor);
 
+            void
+            removedHandler(NodePtr node, NodePtr target, NodePtr ancestor);
+
+            void
+            componentAddedOrRemovedHandler(NodePtr node, NodePtr target, AbstractComponent::Ptr component);
+
             void
             layoutChangedHandler(NodePtr node, NodePtr target);
 
@@ -89,6 +117,15 @@ namespace minko
 
             void
             targetAddedToSceneHandler(NodePtr node, NodePtr target, NodePtr ancestor);
+
+            void
+            renderingBeginHandler(SceneManagerPtr sceneManager, uint frameId, AbsTexturePtr renderTarget);
+
+            void
+            updateNode(NodePtr node);
+
+            void
+            setComputedVisibility(NodePtr node, bool visible);
         };
     }
 }
@@ -24,6 +24,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/component/AbstractScript.hpp"
 #include "minko/Signal.hpp"
 
+#include <atomic>
+
 namespace minko
 {
     namespace component
@@ -43,9 +45,17 @@ namespace minko
                 std::shared_ptr<JobManager>     _jobManager;
                 bool                            _running;
                 bool                            _oneStepPerFrame;
+                bool                            _threadSafe;
 
                 Signal<float>::Ptr              _priorityChanged;
 
+            private:
+                // true while steps are executed by the task scheduler
+                std::atomic<bool>               _stepping;
+                uint                            _numSteps;
+                float                           _stepTime;
+                float                           _maxStepTime;
+
             public:
                 virtual
                 bool
@@ -95,6 +105,23 @@ namespace minko
                     _oneStepPerFrame = value;
                 }
 
+                // The steps of a thread-safe job do not touch the scene and can be executed by the
+                // threads of the task scheduler. beforeFirstStep() and afterLastStep() are always
+                // called from the main thread.
+                inline
+                bool
+                threadSafe()
+                {
+                    return _threadSafe;
+                }
+
+                inline
+                void
+                threadSafe(bool value)
+                {
+                    _threadSafe = value;
+                }
+
                 inline
                 std::shared_ptr<JobManager>
                 jobManager()
@@ -102,6 +129,29 @@ namespace minko
                     return _jobManager;
                 }
 
+                inline
+                uint
+                numSteps() const
+                {
+                    return _numSteps;
+                }
+
+                // Time spent in step() since the job started, in milliseconds.
+                inline
+                float
+                stepTime() const
+                {
+                    return _stepTime;
+                }
+
+                // Duration of the longest step() in milliseconds.
+                inline
+                float
+                maxStepTime() const
+                {
+                    return _maxStepTime;
+                }
+
                 inline
                 Signal<float>::Ptr
                 priorityChanged() const
@@ -117,14 +167,36 @@ namespace minko
             typedef std::shared_ptr<JobManager>     Ptr;
 
         private:
-            typedef std::shared_ptr<scene::Node>    NodePtr;
+            typedef std::shared_ptr<scene::Node>                NodePtr;
+            typedef std::chrono::steady_clock                   clock;
+
+            struct QueuedJob
+            {
+                float       priority;
+                uint        order;
+                Job::Ptr    job;
+
+                // highest priority first, then first pushed first
+                inline
+                bool
+                operator<(const QueuedJob& other) const
+                {
+                    return priority < other.priority || (priority == other.priority && order > other.order);
+                }
+            };
 
         private:
             unsigned int                                                    _loadingFramerate;
             float                                                           _frameTime;
-            std::list<Job::Ptr>                                             _jobs;
+            // max-heap of the jobs waiting for the main thread or the task scheduler
+            std::vector<QueuedJob>                                          _jobs;
+            bool                                                            _invalidPriorities;
+            uint                                                            _numPushedJobs;
+            // jobs being stepped by the task scheduler
+            std::vector<Job::Ptr>                                           _steppingJobs;
             std::unordered_map<Job::Ptr, Signal<float>::Slot>               _jobPriorityChangedSlots;
-            clock_t                                                         _frameStartTime;
+            clock::time_point                                               _frameStartTime;
+            Signal<Ptr, Job::Ptr>::Ptr                                      _jobComplete;
 
         public:
             static
@@ -147,11 +219,34 @@ namespace minko
             void
             end(NodePtr target);
 
+            inline
+            uint
+            numJobs() const
+            {
+                return _jobs.size() + _steppingJobs.size();
+            }
+
+            // Executed on the main thread once the last step of a job is done, its timings can
+            // be read from the job.
+            inline
+            Signal<Ptr, Job::Ptr>::Ptr
+            jobComplete() const
+            {
+                return _jobComplete;
+            }
+
         private:
             JobManager(unsigned int loadingFramerate);
 
             void
-            insertJob(Job::Ptr job);
+            queueJob(Job::Ptr job);
+
+            void
+            completeJob(Job::Ptr job);
+
+            static
+            void
+            stepJob(Job::Ptr job, clock::time_point deadline);
         };
     }
 }
\ No newline at end of file
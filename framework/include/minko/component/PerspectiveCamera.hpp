@@ -164,6 +164,14 @@ namespace minko
                 }
             }
 
+            // in world space
+            inline
+            std::shared_ptr<math::Vector3>
+            position() const
+            {
+                return _position;
+            }
+
             inline
             std::shared_ptr<data::StructureProvider>
             data()
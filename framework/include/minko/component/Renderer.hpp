@@ -44,7 +44,7 @@ namespace minko
             typedef std::shared_ptr<render::AbstractContext>                    AbsContext;
             typedef std::shared_ptr<Surface>                                    SurfacePtr;
             typedef std::shared_ptr<render::DrawCall>                           DrawCallPtr;
-            typedef std::list<DrawCallPtr>                                      DrawCallList;
+            typedef std::vector<DrawCallPtr>                                    DrawCallList;
             typedef std::shared_ptr<SceneManager>                               SceneManagerPtr;
             typedef std::shared_ptr<render::AbstractTexture>                    AbsTexturePtr;
             typedef std::shared_ptr<render::Effect>                             EffectPtr;
@@ -57,7 +57,7 @@ namespace minko
         private:
             std::string                                                         _name;
 
-            DrawCallList                                                        _drawCalls;
+            uint                                                                _numDrawCalls;
             std::unordered_map<SurfacePtr, DrawCallList>                        _surfaceDrawCalls;
 
             unsigned int                                                        _backgroundColor;
@@ -74,6 +74,7 @@ namespace minko
             EffectPtr                                                           _effect;
             float                                                               _priority;
             bool                                                                _enabled;
+            bool                                                                _instancing;
 
             Signal<AbsCmpPtr, NodePtr>::Slot                                    _targetAddedSlot;
             Signal<AbsCmpPtr, NodePtr>::Slot                                    _targetRemovedSlot;
@@ -147,7 +148,30 @@ namespace minko
             unsigned int
             numDrawCalls()
             {
-                return _drawCalls.size();
+                return _numDrawCalls;
+            }
+
+            inline
+            std::shared_ptr<render::DrawCallPool>
+            drawCallPool()
+            {
+                return _drawCallPool;
+            }
+
+            // When enabled and supported by the context, surfaces sharing the same geometry, material and
+            // effect are rendered with a single instanced draw call.
+            inline
+            bool
+            instancing() const
+            {
+                return _instancing;
+            }
+
+            inline
+            void
+            instancing(bool value)
+            {
+                _instancing = value;
             }
 
             inline
@@ -57,6 +57,7 @@ namespace minko
             Signal<NodePtr, NodePtr, NodePtr>::Slot             _addedSlot;
 
             std::shared_ptr<AbstractCanvas>                     _canvas;
+            std::shared_ptr<async::TaskScheduler>               _taskScheduler;
 
         public:
             inline static
@@ -70,6 +71,18 @@ namespace minko
                 return sm;
             }
 
+            // Create a scene manager without any canvas, ie. rendering to the specified context only.
+            inline static
+            Ptr
+            create(const std::shared_ptr<render::AbstractContext>& context)
+            {
+                auto sm = std::shared_ptr<SceneManager>(new SceneManager(context));
+
+                sm->initialize();
+
+                return sm;
+            }
+
             ~SceneManager()
             {
             }
@@ -81,6 +94,14 @@ namespace minko
                 return _canvas;
             }
 
+            // The scheduler of the canvas, or the one of the default canvas without any canvas.
+            inline
+            std::shared_ptr<async::TaskScheduler>
+            taskScheduler()
+            {
+                return _taskScheduler;
+            }
+
             inline
             uint
             frameId()
@@ -153,6 +174,8 @@ namespace minko
         private:
             SceneManager(const std::shared_ptr<AbstractCanvas>& canvas);
 
+            SceneManager(const std::shared_ptr<render::AbstractContext>& context);
+
             void
             targetAddedHandler(AbstractComponent::Ptr ctrl, NodePtr target);
 
@@ -54,10 +54,15 @@ namespace minko
 			typedef std::shared_ptr<geometry::Bone>					BonePtr;
             typedef std::shared_ptr<data::Provider>                 ProviderPtr;
             typedef std::shared_ptr<data::ArrayProvider>            ArrayProviderPtr;
+            typedef std::shared_ptr<animation::SkinLayer>           SkinLayerPtr;
+            typedef std::shared_ptr<animation::Pose>                PosePtr;
+            typedef std::shared_ptr<Surface>                        SurfacePtr;
+            typedef std::shared_ptr<Renderer>                       RendererPtr;
 
             typedef Signal<AbsCmpPtr, NodePtr>                      TargetAddedOrRemovedSignal;
             typedef Signal<NodePtr, NodePtr, NodePtr>               AddedOrRemovedSignal;
             typedef Signal<SceneManagerPtr>                         SceneManagerSignal;
+            typedef Signal<SurfacePtr, RendererPtr, bool>::Slot     VisibilityChangedSlot;
 
         public:
             static const std::string                                PNAME_NUM_BONES;
@@ -71,6 +76,9 @@ namespace minko
         private:
             static const std::string                                ATTRNAME_POSITION;
             static const std::string                                ATTRNAME_NORMAL;
+            static const unsigned int                               MIN_NUM_VERTICES_PER_TASK;
+            static const unsigned int                               BLENDED_FRAME_ID;
+            static const unsigned int                               NO_TIME;
 
         private:
 			SkinPtr													_skin;
@@ -85,6 +93,23 @@ namespace minko
             std::unordered_map<NodePtr, GeometryPtr>                _targetGeometry;
             std::unordered_map<NodePtr,    std::vector<float>>      _targetInputPositions;  // only for software skinning
             std::unordered_map<NodePtr,    std::vector<float>>      _targetInputNormals;    // only for software skinning
+            std::unordered_map<NodePtr, uint>                       _targetFrameId;         // only for software skinning
+            std::unordered_map<NodePtr, std::vector<float>>         _targetSkinnedMatrices; // only for software skinning
+            std::vector<unsigned char>                              _movedBones;            // only for software skinning
+
+            std::vector<SkinLayerPtr>                               _layers;
+            PosePtr                                                 _pose;
+            std::vector<float>                                      _blendedMatrices;
+            uint                                                    _layersTime;            // last global time the layers moved to
+
+            uint                                                    _maxNumVertexBones;     // only for software skinning
+            uint                                                    _reducedNumVertexBones;
+            std::vector<unsigned int>                               _reducedSlotsOffsets;
+            std::vector<unsigned int>                               _reducedSlotsBoneIds;
+            std::vector<float>                                      _reducedSlotsBoneWeights;
+
+            std::unordered_set<NodePtr>                             _hiddenTargets;         // skinned again once visible
+            std::unordered_map<NodePtr, std::list<VisibilityChangedSlot>>   _visibilitySlots;
 
             TargetAddedOrRemovedSignal::Slot                        _targetAddedSlot;
 
@@ -108,6 +133,42 @@ namespace minko
 			AbsCmpPtr
 			clone(const CloneOption& option);
 
+            inline
+            SkinPtr
+            skin() const
+            {
+                return _skin;
+            }
+
+            inline
+            const std::vector<SkinLayerPtr>&
+            layers() const
+            {
+                return _layers;
+            }
+
+            // layers are blended over the skin in the order they were added
+            Ptr
+            addLayer(SkinLayerPtr layer);
+
+            Ptr
+            removeLayer(SkinLayerPtr layer);
+
+            inline
+            uint
+            maxNumVertexBones() const
+            {
+                return _maxNumVertexBones;
+            }
+
+            // software skinning only keeps the value heaviest bones of each vertex, 0 keeps all of them
+            Ptr
+            maxNumVertexBones(uint value);
+
+            // fades the override layers out and a new layer playing skin in, within duration milliseconds
+            SkinLayerPtr
+            crossFade(SkinPtr skin, uint duration);
+
         private:
             Skinning(const SkinPtr,
                      SkinningMethod,
@@ -128,24 +189,33 @@ namespace minko
             void
             removedHandler(NodePtr, NodePtr, NodePtr);
 
+            bool
+            update(uint rawGlobalTime);
+
             void
             update();
 
+            const std::vector<float>&
+            blendLayers(uint frameId);
+
+            // frameId is set to BLENDED_FRAME_ID when the matrices come from the layers
+            const std::vector<float>&
+            currentBoneMatrices(uint& frameId);
+
+            bool
+            targetVisible(NodePtr target) const;
+
             void
-            updateFrame(uint frameId, NodePtr);
+            visibilityChangedHandler(NodePtr target);
 
             void
-            targetAddedHandler(AbsCmpPtr, NodePtr);
+            updateFrame(uint frameId, const std::vector<float>& boneMatrices, NodePtr);
 
             void
-            performSoftwareSkinning(NodePtr, const std::vector<float>&);
+            targetAddedHandler(AbsCmpPtr, NodePtr);
 
             void
-            performSoftwareSkinning(render::VertexBuffer::AttributePtr,
-                                    render::VertexBuffer::Ptr,
-                                    const std::vector<float>&,
-                                    const std::vector<float>&,
-                                    bool doDeltaTransform);
+            performSoftwareSkinning(NodePtr, uint frameId, const std::vector<float>& boneMatrices);
 
             render::VertexBuffer::Ptr
             createVertexBufferForBones() const;
@@ -57,6 +57,7 @@ namespace minko
             std::string                                                             _technique;
 
             bool                                                                    _visible;
+            bool                                                                    _batched;
             std::unordered_map<std::shared_ptr<component::Renderer>, bool>          _rendererToVisibility;
             std::unordered_map<std::shared_ptr<component::Renderer>, bool>          _rendererToComputedVisibility;
 
@@ -195,6 +196,21 @@ namespace minko
             void
             computedVisibility(std::shared_ptr<component::Renderer>, bool value);
 
+            // false only when every renderer found the surface invisible
+            bool
+            computedVisibility() const;
+
+            // true when the surface is rendered as part of a merged geometry built by a Batching component
+            inline
+            bool
+            batched() const
+            {
+                return _batched;
+            }
+
+            void
+            batched(bool value);
+
             inline
             TechniqueChangedSignal::Ptr
             techniqueChanged() const
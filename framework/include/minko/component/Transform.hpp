@@ -186,6 +186,11 @@ namespace minko
                 typedef std::shared_ptr<RootTransform>              Ptr;
 
             private:
+                struct alignas(16) AlignedMatrix
+                {
+                    float m[16];
+                };
+
                 typedef std::shared_ptr<Renderer>                   RendererCtrlPtr;
                 typedef std::shared_ptr<render::AbstractTexture>    AbsTexPtr;
                 typedef std::shared_ptr<SceneManager>               SceneMgrPtr;
@@ -210,20 +215,45 @@ namespace minko
                 forceUpdate(NodePtr node, bool updateTransformLists = false);
 
             private:
+                // the nodes are sorted so that each node comes after its parent: updating them in order
+                // updates the whole hierarchy in a single pass
                 std::vector<std::shared_ptr<math::Matrix4x4>>   _transforms;
                 std::vector<std::shared_ptr<math::Matrix4x4>>   _modelToWorld;
 
-                std::map<NodePtr, unsigned int>                 _nodeToId;
-                std::vector<NodePtr>                            _idToNode;
+                std::unordered_map<NodePtr, unsigned int>       _nodeToId;
+                std::vector<NodePtr>                            _idToNode; // nullptr for removed nodes
                 std::vector<int>                                _parentId;
-                std::vector<unsigned int>                       _firstChildId;
-                std::vector<unsigned int>                       _numChildren;
                 bool                                            _invalidLists;
 
+                // copies of the matrices stored contiguously by node id: the Matrix4x4 objects are only read
+                // when they changed and written when their node moved
+                std::vector<AlignedMatrix>                      _localMatrices;
+                std::vector<AlignedMatrix>                      _worldMatrices;
+                std::vector<unsigned char>                      _dirty;
+
+                // node ids sorted by depth: the nodes of a level only depend on the previous levels and
+                // can be updated in parallel by the tasks of the default scheduler
+                static const unsigned int                       MIN_NUM_DIRTY_NODES_PER_TASK;
+
+                std::vector<unsigned int>                       _levelOrder;
+                std::vector<unsigned int>                       _levelStart;
+                bool                                            _invalidLevels;
+
+                // subtrees added (true) or removed (false) since the lists were last updated
+                std::vector<std::pair<NodePtr, bool>>           _changedSubtrees;
+                unsigned int                                    _numRemovedNodes;
+
+                // scratch buffers kept between updates to avoid allocations
+                std::vector<std::pair<NodePtr, int>>            _nodeStack;
+                std::vector<int>                                _newIds;
+                std::vector<unsigned int>                       _nodeDepth;
+
                 std::list<Any>                                  _targetSlots;
                 Signal<SceneMgrPtr, uint, AbsTexPtr>::Slot      _renderingBeginSlot;
 
             private:
+                RootTransform();
+
                 void
                 initialize();
 
@@ -249,19 +279,30 @@ namespace minko
                 updateTransformsList();
 
                 void
-                updateTransforms();
+                addSubtree(NodePtr subtreeRoot);
+
+                void
+                removeSubtree(NodePtr subtreeRoot);
 
                 void
-                updateTransformPath(const std::vector<unsigned int>& path);
+                removeNode(unsigned int nodeId);
+
+                void
+                compactTransformsList();
+
+                void
+                updateLevels();
+
+                void
+                updateTransforms(std::shared_ptr<async::TaskScheduler> scheduler);
+
+                void
+                updateNode(unsigned int nodeId);
 
                 void
                 renderingBeginHandler(std::shared_ptr<SceneManager>             sceneManager,
                                       uint                                      frameId,
                                       std::shared_ptr<render::AbstractTexture>  abstractTexture);
-
-                static
-                void
-                juxtaposeSiblings(std::vector<NodePtr>&);
             };
         };
     }
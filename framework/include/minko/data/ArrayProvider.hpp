@@ -62,6 +62,9 @@ namespace minko
             IndexChangedSignalPtr
             indexChanged()
             {
+                if (!_indexChanged)
+                    _indexChanged = IndexChangedSignal::create();
+
                 return _indexChanged;
             }
 
@@ -39,11 +39,15 @@ namespace minko
 
             typedef std::shared_ptr<Provider>                               ProviderPtr;
             typedef std::shared_ptr<data::AbstractFilter>                   AbsFilterPtr;
-            typedef Signal<ProviderPtr, const std::string&>                 ProviderPropertyChangedSignal;
+            typedef Provider::PropertyChangedSignal                         ProviderPropertyChangedSignal;
             typedef ProviderPropertyChangedSignal::Slot                     ProviderPropertyChangedSlot;
+            // the provider holding a property and the id of the property in that provider
+            typedef std::pair<ProviderPtr, PropertyId>                      ProviderAndPropertyId;
 
             std::list<ProviderPtr>                                          _providers;
-            std::unordered_map<std::string, ProviderPtr>                    _propertyNameToProvider;
+            std::unordered_map<PropertyId, ProviderAndPropertyId>           _propertyIdToProvider;
+            // ids of the properties of each provider as they appear in the container
+            std::unordered_map<ProviderPtr, std::unordered_map<PropertyId, PropertyId>> _formattedPropertyIds;
             std::unordered_map<ProviderPtr, uint>                           _providersToNumUse;
             std::unordered_map<ProviderPtr, uint>                           _providerToIndex;
 
@@ -51,8 +55,8 @@ namespace minko
 
             PropertyChangedSignalPtr                                        _propertyAdded;
             PropertyChangedSignalPtr                                        _propertyRemoved;
-            std::unordered_map<std::string, PropertyChangedSignalPtr>       _propValueChanged;
-            std::unordered_map<std::string, PropertyChangedSignalPtr>       _propReferenceChanged;
+            std::unordered_map<PropertyId, PropertyChangedSignalPtr>        _propValueChanged;
+            std::unordered_map<PropertyId, PropertyChangedSignalPtr>        _propReferenceChanged;
 
             std::unordered_map<ProviderPtr, std::list<Any>>                 _propertyAddedOrRemovedSlots;
             std::unordered_map<ProviderPtr, ProviderPropertyChangedSlot>    _providerValueChangedSlot;
@@ -95,11 +99,29 @@ namespace minko
             bool
             hasProvider(std::shared_ptr<Provider> provider) const;
 
+            inline
+            bool
+            hasProperty(const PropertyId& propertyId) const
+            {
+                return _propertyIdToProvider.count(propertyId) != 0;
+            }
+
+            inline
+            bool
+            hasProperty(const std::string& propertyName) const
+            {
+                return hasProperty(PropertyId(propertyName));
+            }
+
             bool
-            hasProperty(const std::string&) const;
+            isLengthProperty(const PropertyId&) const;
 
+            inline
             bool
-            isLengthProperty(const std::string&) const;
+            isLengthProperty(const std::string& propertyName) const
+            {
+                return isLengthProperty(PropertyId(propertyName));
+            }
 
             inline
             int
@@ -112,39 +134,53 @@ namespace minko
 
             template <typename T>
             T
-            get(const std::string& propertyName) const
+            get(const PropertyId& propertyId) const
             {
-                assertPropertyExists(propertyName);
+                const auto& providerAndPropertyId = getProviderAndPropertyId(propertyId);
 
-                const auto& provider = _propertyNameToProvider.find(propertyName)->second;
-                auto unformatedPropertyName = unformatPropertyName(provider, propertyName);
+                return providerAndPropertyId.first->get<T>(providerAndPropertyId.second);
+            }
 
-                return provider->get<T>(unformatedPropertyName, true);
+            template <typename T>
+            inline
+            T
+            get(const std::string& propertyName) const
+            {
+                return get<T>(PropertyId(propertyName));
             }
 
             template <typename T>
             void
-            set(const std::string& propertyName, T value)
+            set(const PropertyId& propertyId, T value)
             {
-                assertPropertyExists(propertyName);
+                const auto& providerAndPropertyId = getProviderAndPropertyId(propertyId);
 
-                auto provider = _propertyNameToProvider[propertyName];
-                auto unformatedPropertyName = unformatPropertyName(provider, propertyName);
+                providerAndPropertyId.first->set<T>(providerAndPropertyId.second, value);
+            }
 
-                provider->set<T>(unformatedPropertyName, value);
+            template <typename T>
+            inline
+            void
+            set(const std::string& propertyName, T value)
+            {
+                set<T>(PropertyId(propertyName), value);
             }
 
             template <typename T>
             bool
-            propertyHasType(const std::string& propertyName, bool skipPropertyNameFormatting = false) const
+            propertyHasType(const PropertyId& propertyId) const
             {
-                assertPropertyExists(propertyName);
+                const auto& providerAndPropertyId = getProviderAndPropertyId(propertyId);
 
-                const auto& provider = _propertyNameToProvider.find(propertyName)->second;
-
-                auto unformatedPropertyName = unformatPropertyName(provider, propertyName);
+                return providerAndPropertyId.first->propertyHasType<T>(providerAndPropertyId.second);
+            }
 
-                return provider->propertyHasType<T>(unformatedPropertyName, skipPropertyNameFormatting);
+            template <typename T>
+            inline
+            bool
+            propertyHasType(const std::string& propertyName) const
+            {
+                return propertyHasType<T>(PropertyId(propertyName));
             }
 
             inline
@@ -162,10 +198,24 @@ namespace minko
             }
 
             PropertyChangedSignalPtr
-            propertyValueChanged(const std::string& propertyName);
+            propertyValueChanged(const PropertyId& propertyId);
+
+            inline
+            PropertyChangedSignalPtr
+            propertyValueChanged(const std::string& propertyName)
+            {
+                return propertyValueChanged(PropertyId(propertyName));
+            }
 
             PropertyChangedSignalPtr
-            propertyReferenceChanged(const std::string& propertyName);
+            propertyReferenceChanged(const PropertyId& propertyId);
+
+            inline
+            PropertyChangedSignalPtr
+            propertyReferenceChanged(const std::string& propertyName)
+            {
+                return propertyReferenceChanged(PropertyId(propertyName));
+            }
 
             inline
             Signal<Ptr, Provider::Ptr>::Ptr
@@ -194,8 +244,8 @@ namespace minko
             {
                 std::vector<std::string> properties;
 
-                for (auto& kv : _propertyNameToProvider)
-                    properties.push_back(kv.first);
+                for (auto& kv : _propertyIdToProvider)
+                    properties.push_back(kv.first.name());
 
                 return properties;
             }
@@ -206,26 +256,41 @@ namespace minko
         private:
             Container();
 
+            inline
+            const ProviderAndPropertyId&
+            getProviderAndPropertyId(const PropertyId& propertyId) const
+            {
+                auto foundIt = _propertyIdToProvider.find(propertyId);
+
+                if (foundIt == _propertyIdToProvider.end())
+                    throw std::invalid_argument(propertyId.name());
+
+                return foundIt->second;
+            }
+
             void
-            assertPropertyExists(const std::string& propertyName) const;
+            providerPropertyAddedHandler(ProviderPtr, const PropertyId& propertyId);
 
             void
-            providerPropertyAddedHandler(ProviderPtr, const std::string& propertyName);
+            providerPropertyRemovedHandler(ProviderPtr, const PropertyId& propertyId);
 
             void
-            providerPropertyRemovedHandler(ProviderPtr, const std::string& propertyName);
+            providerValueChangedHandler(ProviderPtr, const PropertyId& propertyId);
 
             void
-            providerValueChangedHandler(ProviderPtr, const std::string& propertyName);
+            providerReferenceChangedHandler(ProviderPtr, const PropertyId& propertyId);
 
             void
-            providerReferenceChangedHandler(ProviderPtr, const std::string& propertyName);
+            connectProviderValueChanged(ProviderPtr);
 
-            std::string
-            formatPropertyName(ProviderPtr  arrayProvider, const std::string&) const;
+            void
+            connectProviderReferenceChanged(ProviderPtr);
+
+            PropertyId
+            formatPropertyId(ProviderPtr, const PropertyId& propertyId);
 
             std::string
-            unformatPropertyName(ProviderPtr  arrayProvider, const std::string&) const;
+            formatPropertyName(ProviderPtr  arrayProvider, const std::string&) const;
 
             inline
             void
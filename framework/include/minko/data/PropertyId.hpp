@@ -0,0 +1,110 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+    namespace data
+    {
+        /**
+         * Handle on a property name interned in a global, thread-safe table. Two ids are equal
+         * if and only if they were built from the same name, so comparing and hashing an id
+         * never touches the characters of the name it stands for.
+         *
+         * Building an id from a string costs a hash lookup: hot paths should build their ids
+         * once and keep them around.
+         */
+        class PropertyId
+        {
+        private:
+            uint                    _id;
+            const std::string*      _name;
+
+        public:
+            // the id of the empty name
+            PropertyId();
+
+            explicit
+            PropertyId(const std::string& name);
+
+            inline
+            uint
+            id() const
+            {
+                return _id;
+            }
+
+            inline
+            const std::string&
+            name() const
+            {
+                return *_name;
+            }
+
+            // the name outlives the id, so it can be bound to a const reference
+            inline
+            operator const std::string&() const
+            {
+                return *_name;
+            }
+
+            inline
+            bool
+            operator==(const PropertyId& x) const
+            {
+                return _id == x._id;
+            }
+
+            inline
+            bool
+            operator!=(const PropertyId& x) const
+            {
+                return _id != x._id;
+            }
+
+            inline
+            bool
+            operator<(const PropertyId& x) const
+            {
+                return _id < x._id;
+            }
+
+            // number of distinct names interned so far
+            static
+            uint
+            numIds();
+        };
+    }
+}
+
+namespace std
+{
+    template<> struct hash<minko::data::PropertyId>
+    {
+        inline
+        size_t
+        operator()(const minko::data::PropertyId& x) const
+        {
+            return std::hash<minko::uint>()(x.id());
+        }
+    };
+}
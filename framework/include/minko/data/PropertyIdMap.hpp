@@ -0,0 +1,256 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+#include "minko/data/PropertyId.hpp"
+
+namespace minko
+{
+    namespace data
+    {
+        /**
+         * Flat map from property ids to values.
+         *
+         * The entries are stored contiguously, in an order that only changes when one of them is
+         * erased, and indexed by an open-addressed table probed linearly. Looking up an id does
+         * not allocate nor follow any node pointer, and copying the map only copies two vectors.
+         */
+        template <typename T>
+        class PropertyIdMap
+        {
+        public:
+            typedef std::pair<PropertyId, T>                            value_type;
+            typedef typename std::vector<value_type>::iterator          iterator;
+            typedef typename std::vector<value_type>::const_iterator    const_iterator;
+
+        private:
+            static const uint       EMPTY_SLOT          = 0xffffffff;
+            static const uint       MIN_NUM_SLOTS       = 8;
+
+            std::vector<value_type> _entries;
+            // index of an entry in _entries for each slot, at most half of the slots are used
+            std::vector<uint>       _slots;
+            uint                    _shift;
+
+        public:
+            PropertyIdMap() :
+                _entries(),
+                _slots(),
+                _shift(0)
+            {
+            }
+
+            inline
+            iterator
+            begin()
+            {
+                return _entries.begin();
+            }
+
+            inline
+            iterator
+            end()
+            {
+                return _entries.end();
+            }
+
+            inline
+            const_iterator
+            begin() const
+            {
+                return _entries.begin();
+            }
+
+            inline
+            const_iterator
+            end() const
+            {
+                return _entries.end();
+            }
+
+            inline
+            std::size_t
+            size() const
+            {
+                return _entries.size();
+            }
+
+            inline
+            bool
+            empty() const
+            {
+                return _entries.empty();
+            }
+
+            inline
+            void
+            clear()
+            {
+                _entries.clear();
+                _slots.clear();
+            }
+
+            inline
+            iterator
+            find(const PropertyId& propertyId)
+            {
+                const auto slot = findSlot(propertyId);
+
+                return slot == EMPTY_SLOT ? _entries.end() : _entries.begin() + _slots[slot];
+            }
+
+            inline
+            const_iterator
+            find(const PropertyId& propertyId) const
+            {
+                const auto slot = findSlot(propertyId);
+
+                return slot == EMPTY_SLOT ? _entries.end() : _entries.begin() + _slots[slot];
+            }
+
+            inline
+            std::size_t
+            count(const PropertyId& propertyId) const
+            {
+                return findSlot(propertyId) == EMPTY_SLOT ? 0 : 1;
+            }
+
+            T&
+            operator[](const PropertyId& propertyId)
+            {
+                auto slot = findSlot(propertyId);
+
+                if (slot != EMPTY_SLOT)
+                    return _entries[_slots[slot]].second;
+
+                if ((_entries.size() + 1) * 2 > _slots.size())
+                    rehash(_slots.empty() ? MIN_NUM_SLOTS : _slots.size() * 2);
+
+                for (slot = homeSlot(propertyId); _slots[slot] != EMPTY_SLOT; slot = nextSlot(slot))
+                    ;
+
+                _slots[slot] = _entries.size();
+                _entries.push_back(value_type(propertyId, T()));
+
+                return _entries.back().second;
+            }
+
+            std::size_t
+            erase(const PropertyId& propertyId)
+            {
+                auto slot = findSlot(propertyId);
+
+                if (slot == EMPTY_SLOT)
+                    return 0;
+
+                const auto entryIndex = _slots[slot];
+                const auto lastIndex = _entries.size() - 1;
+
+                removeSlot(slot);
+
+                // fill the hole with the last entry to keep the entries contiguous
+                if (entryIndex != lastIndex)
+                {
+                    _slots[findSlot(_entries[lastIndex].first)] = entryIndex;
+                    _entries[entryIndex] = std::move(_entries[lastIndex]);
+                }
+                _entries.pop_back();
+
+                return 1;
+            }
+
+        private:
+            inline
+            uint
+            homeSlot(const PropertyId& propertyId) const
+            {
+                // Fibonacci hashing: the top bits of the product are well spread even for the
+                // consecutive ids handed out by PropertyId
+                return (propertyId.id() * 2654435769u) >> _shift;
+            }
+
+            inline
+            uint
+            nextSlot(uint slot) const
+            {
+                return (slot + 1) & (_slots.size() - 1);
+            }
+
+            uint
+            findSlot(const PropertyId& propertyId) const
+            {
+                if (_slots.empty())
+                    return EMPTY_SLOT;
+
+                for (auto slot = homeSlot(propertyId); _slots[slot] != EMPTY_SLOT; slot = nextSlot(slot))
+                    if (_entries[_slots[slot]].first == propertyId)
+                        return slot;
+
+                return EMPTY_SLOT;
+            }
+
+            void
+            removeSlot(uint slot)
+            {
+                // backward shift deletion: move back the following entries of the cluster that
+                // would not be reachable anymore from their home slot
+                _slots[slot] = EMPTY_SLOT;
+
+                for (auto next = nextSlot(slot); _slots[next] != EMPTY_SLOT; next = nextSlot(next))
+                {
+                    const auto home = homeSlot(_entries[_slots[next]].first);
+
+                    if (((next - home) & (_slots.size() - 1)) >= ((next - slot) & (_slots.size() - 1)))
+                    {
+                        _slots[slot] = _slots[next];
+                        _slots[next] = EMPTY_SLOT;
+                        slot = next;
+                    }
+                }
+            }
+
+            void
+            rehash(uint numSlots)
+            {
+                _slots.assign(numSlots, EMPTY_SLOT);
+
+                for (_shift = 32; numSlots > 1; numSlots >>= 1)
+                    --_shift;
+
+                for (uint i = 0; i < _entries.size(); ++i)
+                {
+                    auto slot = homeSlot(_entries[i].first);
+
+                    while (_slots[slot] != EMPTY_SLOT)
+                        slot = nextSlot(slot);
+
+                    _slots[slot] = i;
+                }
+            }
+        };
+
+        template <typename T>
+        const uint PropertyIdMap<T>::EMPTY_SLOT;
+
+        template <typename T>
+        const uint PropertyIdMap<T>::MIN_NUM_SLOTS;
+    }
+}
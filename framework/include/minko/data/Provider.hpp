@@ -23,6 +23,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/Any.hpp"
 #include "minko/Signal.hpp"
 #include "minko/data/Value.hpp"
+#include "minko/data/PropertyId.hpp"
+#include "minko/data/PropertyIdMap.hpp"
 
 namespace minko
 {
@@ -34,6 +36,7 @@ namespace minko
         public:
             typedef std::shared_ptr<Provider>                        Ptr;
             typedef std::shared_ptr<const Provider>                  ConstPtr;
+            typedef Signal<Ptr, const PropertyId&>                   PropertyChangedSignal;
 
         private:
             template <typename P>
@@ -42,15 +45,17 @@ namespace minko
             typedef Signal<std::shared_ptr<Value>>::Slot ChangedSignalSlot;
 
         private:
-            std::vector<std::string>                                _names;
-            std::unordered_map<std::string, Any>                    _values;
-            std::unordered_map<std::string, ChangedSignalSlot>      _valueChangedSlots;
-            std::unordered_map<std::string, ChangedSignalSlot>      _referenceChangedSlots;
-
-            std::shared_ptr<Signal<Ptr, const std::string&>>        _propertyAdded;
-            std::shared_ptr<Signal<Ptr, const std::string&>>        _propValueChanged;
-            std::shared_ptr<Signal<Ptr, const std::string&>>        _propReferenceChanged;
-            std::shared_ptr<Signal<Ptr, const std::string&>>        _propertyRemoved;
+            std::vector<PropertyId>                                 _names;
+            PropertyIdMap<Any>                                      _values;
+            PropertyIdMap<ChangedSignalSlot>                        _valueChangedSlots;
+            PropertyIdMap<ChangedSignalSlot>                        _referenceChangedSlots;
+
+            // created on first access: most providers are never watched, and creating, copying
+            // or setting the properties of such a provider should not pay for its signals
+            mutable std::shared_ptr<PropertyChangedSignal>          _propertyAdded;
+            mutable std::shared_ptr<PropertyChangedSignal>          _propValueChanged;
+            mutable std::shared_ptr<PropertyChangedSignal>          _propReferenceChanged;
+            mutable std::shared_ptr<PropertyChangedSignal>          _propertyRemoved;
 
         public:
             static const std::string NO_STRUCT_SEP;
@@ -73,7 +78,7 @@ namespace minko
             }
 
             inline
-            const std::vector<std::string>&
+            const std::vector<PropertyId>&
             propertyNames() const
             {
                 return _names;
@@ -83,8 +88,16 @@ namespace minko
             bool
             hasProperty(const std::string&, bool skipPropertyNameFormatting = false) const;
 
+            // the PropertyId overloads always address a property by its formatted name
+            inline
+            bool
+            hasProperty(const PropertyId& propertyId) const
+            {
+                return _values.count(propertyId) != 0;
+            }
+
             inline
-            const std::unordered_map<std::string, Any>&
+            const PropertyIdMap<Any>&
             values() const
             {
                 return _values;
@@ -94,50 +107,69 @@ namespace minko
             const std::string&
             propertyName(const unsigned int propertyIndex) const
             {
-                return _names[propertyIndex];
+                return _names[propertyIndex].name();
             }
 
             inline
-            std::shared_ptr<Signal<Ptr, const std::string&>>
+            std::shared_ptr<PropertyChangedSignal>
             propertyValueChanged() const
             {
+                if (!_propValueChanged)
+                    _propValueChanged = PropertyChangedSignal::create();
+
                 return _propValueChanged;
             }
 
             inline
-            std::shared_ptr<Signal<Ptr, const std::string&>>
+            std::shared_ptr<PropertyChangedSignal>
             propertyReferenceChanged() const
             {
+                if (!_propReferenceChanged)
+                    _propReferenceChanged = PropertyChangedSignal::create();
+
                 return _propReferenceChanged;
             }
 
             inline
-            std::shared_ptr<Signal<Ptr, const std::string&>>
+            std::shared_ptr<PropertyChangedSignal>
             propertyAdded() const
             {
+                if (!_propertyAdded)
+                    _propertyAdded = PropertyChangedSignal::create();
+
                 return _propertyAdded;
             }
 
             inline
-            std::shared_ptr<Signal<Ptr, const std::string&>>
+            std::shared_ptr<PropertyChangedSignal>
             propertyRemoved() const
             {
+                if (!_propertyRemoved)
+                    _propertyRemoved = PropertyChangedSignal::create();
+
                 return _propertyRemoved;
             }
 
             template <typename T>
             T
-            get(const std::string& propertyName, bool skipPropertyNameFormatting) const
+            get(const PropertyId& propertyId) const
             {
-                const std::string&    formattedName    = skipPropertyNameFormatting ? propertyName : formatPropertyName(propertyName);
-                auto                  foundIt          = values().find(formattedName);
+                auto foundIt = _values.find(propertyId);
 
-                if (foundIt == values().end())
+                if (foundIt == _values.end())
                     throw std::invalid_argument("propertyName");
 
                 return Any::unsafe_cast<T>(foundIt->second);
             }
 
+            template <typename T>
+            inline
+            T
+            get(const std::string& propertyName, bool skipPropertyNameFormatting) const
+            {
+                return get<T>(PropertyId(skipPropertyNameFormatting ? propertyName : formatPropertyName(propertyName)));
+            }
+
             template <typename T>
             inline
             T
@@ -148,71 +180,69 @@ namespace minko
 
             template <typename T>
             bool
-            propertyHasType(const std::string& propertyName, bool skipPropertyNameFormatting = false) const
+            propertyHasType(const PropertyId& propertyId) const
             {
-                const std::string&    formattedName    = skipPropertyNameFormatting ? propertyName : formatPropertyName(propertyName);
-                const auto            foundIt          = _values.find(formattedName);
+                const auto foundIt = _values.find(propertyId);
 
                 if (foundIt == _values.end())
                     throw std::invalid_argument("propertyName");
 
-				return Any::cast<T>(&foundIt->second) != nullptr;
+                return Any::cast<T>(&foundIt->second) != nullptr;
+            }
 
+            template <typename T>
+            inline
+            bool
+            propertyHasType(const std::string& propertyName, bool skipPropertyNameFormatting = false) const
+            {
+                return propertyHasType<T>(PropertyId(skipPropertyNameFormatting ? propertyName : formatPropertyName(propertyName)));
             }
 
             template <typename T>
             typename std::enable_if<!std::is_convertible<T, Value::Ptr>::value, Provider::Ptr>::type
-            set(const std::string& propertyName, T value, bool skipPropertyNameFormatting)
+            set(const PropertyId& propertyId, T value)
             {
-                auto          formattedName    = skipPropertyNameFormatting ? propertyName : formatPropertyName(propertyName);
-
-                const auto    foundValueIt     = _values.find(formattedName);
-                const bool    isNewValue       = foundValueIt == _values.end();
+                auto&       storedValue = _values[propertyId];
+                const bool  isNewValue  = storedValue.empty();
 
-                _values[formattedName] = value;
+                storedValue = std::move(value);
 
                 if (isNewValue)
-                {
-                    _names.push_back(formattedName);
-
-                    _propertyAdded->execute(shared_from_this(), formattedName);
-                }
+                    _names.push_back(propertyId);
 
-                _propReferenceChanged->execute(shared_from_this(), formattedName);
-                _propValueChanged->execute(shared_from_this(), formattedName);
-
-                return shared_from_this();
+                return propertySet(propertyId, isNewValue);
             }
 
             template <typename T>
             typename std::enable_if<std::is_convertible<T, Value::Ptr>::value, Provider::Ptr>::type
-            set(const std::string& propertyName, T value, bool skipPropertyNameFormatting)
+            set(const PropertyId& propertyId, T value)
             {
-                auto          formattedName    = skipPropertyNameFormatting ? propertyName : formatPropertyName(propertyName);
+                auto&       storedValue = _values[propertyId];
+                const bool  isNewValue  = storedValue.empty();
 
-                const auto    foundValueIt     = _values.find(formattedName);
-                const bool    isNewValue       = (foundValueIt == _values.end());
-
-                _values[formattedName] = value;
+                storedValue = value;
 
                 if (isNewValue)
                 {
-                    _valueChangedSlots[formattedName] = value->changed()->connect(std::bind(
-                         &Signal<Provider::Ptr, const std::string&>::execute,
-                         _propValueChanged,
+                    _valueChangedSlots[propertyId] = value->changed()->connect(std::bind(
+                         &PropertyChangedSignal::execute,
+                         propertyValueChanged(),
                          shared_from_this(),
-                         formattedName
+                         propertyId
                     ));
 
-                    _names.push_back(formattedName);
-
-                    _propertyAdded->execute(shared_from_this(), formattedName);
+                    _names.push_back(propertyId);
                 }
 
-                _propReferenceChanged->execute(shared_from_this(), formattedName);
-                _propValueChanged->execute(shared_from_this(), formattedName);
+                return propertySet(propertyId, isNewValue);
+            }
 
-                return shared_from_this();
+            template <typename T>
+            inline
+            Ptr
+            set(const std::string& propertyName, T value, bool skipPropertyNameFormatting)
+            {
+                return set(PropertyId(skipPropertyNameFormatting ? propertyName : formatPropertyName(propertyName)), value);
             }
 
             template <typename T>
@@ -240,6 +270,10 @@ namespace minko
         protected:
             Provider();
 
+            // executes the signals following the assignment of a property
+            Ptr
+            propertySet(const PropertyId& propertyId, bool isNewValue);
+
 
             virtual
             std::string
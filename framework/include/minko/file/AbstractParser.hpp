@@ -58,6 +58,77 @@ namespace minko
                   const std::vector<unsigned char>&    data,
                   std::shared_ptr<AssetLibrary>        assetLibrary) = 0;
 
+            // Parses bytes the parser does not own, such as the content of a memory mapped file.
+            // Parsers able to read their input in place override it, the others get a copy.
+            virtual
+            void
+            parse(const std::string&                   filename,
+                  const std::string&                   resolvedFilename,
+                  std::shared_ptr<Options>             options,
+                  const unsigned char*                 data,
+                  uint                                 size,
+                  std::shared_ptr<AssetLibrary>        assetLibrary)
+            {
+                parse(filename, resolvedFilename, options, std::vector<unsigned char>(data, data + size), assetLibrary);
+            }
+
+            /**
+             * Parsers returning true here split parsing in two stages, which parse() runs in a
+             * row: decode() turns the input into plain buffers without using the rendering
+             * context nor the asset library, and finalize() creates the assets from them and
+             * then executes complete(). When Options::parseAsynchronously() is set, the Loader
+             * runs decode() on the task scheduler and finalize() back on the main thread.
+             */
+            virtual
+            bool
+            decodable()
+            {
+                return false;
+            }
+
+            virtual
+            void
+            decode(const std::string&                  filename,
+                   const std::string&                  resolvedFilename,
+                   std::shared_ptr<Options>            options,
+                   const unsigned char*                data,
+                   uint                                size)
+            {
+            }
+
+            virtual
+            void
+            finalize(const std::string&                filename,
+                     const std::string&                resolvedFilename,
+                     std::shared_ptr<Options>          options,
+                     std::shared_ptr<AssetLibrary>     assetLibrary)
+            {
+            }
+
+            /**
+             * Parsers returning true here can start before their file is completely loaded.
+             * When the file is streamed, the Loader calls parseChunk() each time bytes are
+             * received, with the beginning of the file received so far, and then parse() with
+             * the whole file as usual.
+             */
+            virtual
+            bool
+            streamable()
+            {
+                return false;
+            }
+
+            virtual
+            void
+            parseChunk(const std::string&              filename,
+                       const std::string&              resolvedFilename,
+                       std::shared_ptr<Options>        options,
+                       const unsigned char*            data,
+                       uint                            size,
+                       std::shared_ptr<AssetLibrary>   assetLibrary)
+            {
+            }
+
         protected:
             AbstractParser() :
                 _complete(Signal<Ptr>::create()),
@@ -39,6 +39,7 @@ namespace minko
             std::shared_ptr<Options>                    _options;
 
             std::shared_ptr<Signal<Ptr, float>>         _progress;
+            std::shared_ptr<Signal<Ptr, uint, uint>>    _chunk;
             std::shared_ptr<Signal<Ptr>>                _complete;
             std::shared_ptr<Signal<Ptr>>                _error;
 
@@ -88,6 +89,15 @@ namespace minko
                 return _error;
             }
 
+            // Executed with the offset and the size of the bytes just appended to the data of
+            // the file, when the file is streamed (see Options::streamFiles()).
+            inline
+            std::shared_ptr<Signal<Ptr, uint, uint>>
+            chunk()
+            {
+                return _chunk;
+            }
+
             inline
             void
             load(const std::string&         filename,
@@ -125,6 +135,18 @@ namespace minko
             {
                 return _file->_data;
             }
+
+            // Appends bytes to the data of the file and executes chunk().
+            void
+            appendChunk(const unsigned char* bytes, uint size);
+
+            // Makes the file read its content from a mapping instead of data().
+            inline
+            void
+            mappedFile(std::shared_ptr<MemoryMappedFile> mappedFile)
+            {
+                _file->_mappedFile = mappedFile;
+            }
         };
 
     }
@@ -202,6 +202,11 @@ namespace minko
             AssetLibrary::Ptr
             sound(const std::string& name, audio::Sound::Ptr sound);
 
+            // True when any kind of asset is stored under name, as parsers store the assets
+            // they load under the name of their file.
+            bool
+            hasAsset(const std::string& name) const;
+
         private:
             AssetLibrary(AbsContextPtr context);
         };
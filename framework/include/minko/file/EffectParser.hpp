@@ -107,6 +107,9 @@ namespace minko
             UniformValues                                                          _defaultUniformValues;
 
 
+            std::shared_ptr<Json::Value>                                           _root;
+            std::string                                                            _decodeError;
+
             std::shared_ptr<AssetLibrary>                                          _assetLibrary;
             unsigned int                                                           _numDependencies;
             unsigned int                                                           _numLoadedDependencies;
@@ -151,6 +154,36 @@ namespace minko
                   const std::vector<unsigned char>& data,
                   std::shared_ptr<AssetLibrary>     assetLibrary);
 
+            void
+            parse(const std::string&                filename,
+                  const std::string&                resolvedFilename,
+                  std::shared_ptr<Options>          options,
+                  const unsigned char*              data,
+                  uint                              size,
+                  std::shared_ptr<AssetLibrary>     assetLibrary);
+
+            inline
+            bool
+            decodable()
+            {
+                return true;
+            }
+
+            // Only reads the JSON document: the passes, shaders and states are created by
+            // finalize().
+            void
+            decode(const std::string&               filename,
+                   const std::string&               resolvedFilename,
+                   std::shared_ptr<Options>         options,
+                   const unsigned char*             data,
+                   uint                             size);
+
+            void
+            finalize(const std::string&             filename,
+                     const std::string&             resolvedFilename,
+                     std::shared_ptr<Options>       options,
+                     std::shared_ptr<AssetLibrary>  assetLibrary);
+
         private:
             EffectParser();
 
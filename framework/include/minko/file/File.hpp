@@ -21,6 +21,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 #include "minko/Common.hpp"
 
+#include "minko/file/MemoryMappedFile.hpp"
+
 namespace minko
 {
     namespace file
@@ -36,6 +38,8 @@ namespace minko
             std::string                         _filename;
 
             std::vector<unsigned char>          _data;
+            MemoryMappedFile::Ptr               _mappedFile;
+            Ptr                                 _content;
             std::string                         _resolvedFilename;
 
         public:
@@ -46,6 +50,20 @@ namespace minko
                 return std::shared_ptr<File>(new File());
             }
 
+            // A file sharing the content of another one without copying it.
+            inline static
+            Ptr
+            create(const std::string& filename, const std::string& resolvedFilename, Ptr content)
+            {
+                auto file = create();
+
+                file->_filename = filename;
+                file->_resolvedFilename = resolvedFilename;
+                file->_content = content->_content != nullptr ? content->_content : content;
+
+                return file;
+            }
+
             inline
             const std::string&
             filename()
@@ -60,13 +78,48 @@ namespace minko
                 return _resolvedFilename;
             }
 
+            // The content of a memory mapped file is copied on the first call: prefer bytes() and
+            // size(), which read the mapping in place.
             inline
             const std::vector<unsigned char>&
             data()
             {
+                if (_content != nullptr)
+                    return _content->data();
+
+                if (_mappedFile != nullptr && _data.empty())
+                    _data.assign(_mappedFile->data(), _mappedFile->data() + _mappedFile->size());
+
                 return _data;
             }
 
+            inline
+            const unsigned char*
+            bytes() const
+            {
+                if (_content != nullptr)
+                    return _content->bytes();
+
+                return _mappedFile != nullptr ? _mappedFile->data() : _data.data();
+            }
+
+            inline
+            uint
+            size() const
+            {
+                if (_content != nullptr)
+                    return _content->size();
+
+                return _mappedFile != nullptr ? _mappedFile->size() : _data.size();
+            }
+
+            inline
+            bool
+            memoryMapped() const
+            {
+                return _content != nullptr ? _content->memoryMapped() : _mappedFile != nullptr;
+            }
+
             static
             std::string
             getCurrentWorkingDirectory();
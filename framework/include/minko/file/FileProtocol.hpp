@@ -47,6 +47,12 @@ namespace minko
             bool
             fileExists(const std::string& filename);
 
+            // Size of the chunks in which a file of the given length is read: about 1/50 of it,
+            // between 8 kB and 1 MB.
+            static
+            uint
+            chunkSize(uint length);
+
         protected:
             FileProtocol();
 
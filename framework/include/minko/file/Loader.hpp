@@ -37,9 +37,11 @@ namespace minko
             typedef std::shared_ptr<AbstractParser>                                         AbsParserPtr;
             typedef std::unordered_map<std::string, std::shared_ptr<Options>>               FilenameToOptions;
             typedef std::unordered_map<std::string, std::shared_ptr<File>>                  FilenameToFile;
-            typedef std::unordered_map<std::shared_ptr<AbstractProtocol>, float>            ProtocolToProgress;
+            typedef std::unordered_map<std::string, float>                                  FilenameToProgress;
             typedef std::vector<Signal<std::shared_ptr<AbstractProtocol>>::Slot>            ProtocolSlots;
             typedef std::vector<Signal<std::shared_ptr<AbstractProtocol>, float>::Slot>     ProtocolProgressSlots;
+            typedef std::vector<Signal<std::shared_ptr<AbstractProtocol>, uint, uint>::Slot> ProtocolChunkSlots;
+            typedef std::unordered_map<std::string, AbsParserPtr>                           FilenameToParser;
             typedef std::unordered_map<AbsParserPtr, Signal<AbsParserPtr>::Slot>            ParserCompleteSlots;
             
             typedef std::unordered_map<AbsParserPtr, Signal<AbsParserPtr, const Error&>::Slot>            ParserErrorSlots;
@@ -58,15 +60,17 @@ namespace minko
 
             ProtocolSlots                                       _protocolSlots;
             ProtocolProgressSlots                               _protocolProgressSlots;
+            ProtocolChunkSlots                                  _protocolChunkSlots;
             ParserCompleteSlots                                 _parserCompleteSlots;
             ParserErrorSlots                                    _parserErrorSlots;
 
-            ProtocolToProgress                                  _protocolToProgress;
+            FilenameToProgress                                  _filenameToProgress;
 
             int                                                 _numFiles;
         
         private:
             int                                                 _numFilesToParse;
+            FilenameToParser                                    _streamedFileParsers;
 
         public:
             inline static
@@ -175,14 +179,43 @@ namespace minko
             void
             protocolProgressHandler(std::shared_ptr<AbstractProtocol> protocol, float);
 
+            void
+            protocolChunkHandler(std::shared_ptr<AbstractProtocol> protocol, uint offset, uint size);
+
+            void
+            cachedFileHandler(const std::string&       filename,
+                              const std::string&       resolvedFilename,
+                              std::shared_ptr<Options> options,
+                              std::shared_ptr<File>    content);
+
+            void
+            fileLoaded(const std::string& filename, std::shared_ptr<Options> options, std::shared_ptr<File> file);
+
+            void
+            fileFailed(const std::string& filename, const Error& error);
+
             void
             finalize();
 
+            AbsParserPtr
+            createParser(const std::string& filename);
+
             bool
             processData(const std::string&                 filename,
                         const std::string&                 resolvedFilename,
                         std::shared_ptr<Options>           options,
-                        const std::vector<unsigned char>&  data);
+                        std::shared_ptr<File>              file);
+
+            void
+            decodeAsynchronously(std::shared_ptr<AbstractParser>    parser,
+                                 const std::string&                 filename,
+                                 const std::string&                 resolvedFilename,
+                                 std::shared_ptr<Options>           options,
+                                 std::shared_ptr<File>              file,
+                                 std::shared_ptr<async::TaskScheduler> scheduler);
+
+            void
+            decodeFailed(std::shared_ptr<AbstractParser> parser, const Error& error);
 
             void
             parserCompleteHandler(std::shared_ptr<AbstractParser> parser);
@@ -0,0 +1,160 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+    namespace file
+    {
+        // Shares loaded files between loaders, keyed by resolved filename and read range (see
+        // key()): requests for a file that is already loading wait for that load instead of
+        // starting another one, and completed files are kept in a least recently used cache
+        // within a memory budget.
+        class LoadingCache
+        {
+        public:
+            typedef std::shared_ptr<LoadingCache>               Ptr;
+
+            // Receives nullptr when the load failed.
+            typedef std::function<void(std::shared_ptr<File>)> CompleteFunction;
+
+        private:
+            typedef std::list<std::string>                      RecentlyUsed;
+
+            struct Entry
+            {
+                std::shared_ptr<File>   file;
+                RecentlyUsed::iterator  recentlyUsed;
+            };
+
+        private:
+            uint                                                            _budget;
+            uint                                                            _size;
+            RecentlyUsed                                                    _recentlyUsed;
+            std::unordered_map<std::string, Entry>                          _files;
+            std::unordered_map<std::string, std::list<CompleteFunction>>    _pending;
+
+            uint                                                            _numHits;
+            uint                                                            _numMisses;
+            uint                                                            _numCoalescedRequests;
+
+        public:
+            inline static
+            Ptr
+            create(uint budget = 64 * 1024 * 1024)
+            {
+                return std::shared_ptr<LoadingCache>(new LoadingCache(budget));
+            }
+
+            // Identifies the bytes read from a file: the whole file when both offset and length
+            // are 0 (see Options::seekingOffset() and Options::seekedLength()).
+            static
+            std::string
+            key(const std::string& resolvedFilename, int offset, int length);
+
+            inline
+            uint
+            budget() const
+            {
+                return _budget;
+            }
+
+            void
+            budget(uint budget);
+
+            // Number of bytes held by the cached files.
+            inline
+            uint
+            size() const
+            {
+                return _size;
+            }
+
+            inline
+            uint
+            numFiles() const
+            {
+                return _files.size();
+            }
+
+            inline
+            uint
+            numHits() const
+            {
+                return _numHits;
+            }
+
+            inline
+            uint
+            numMisses() const
+            {
+                return _numMisses;
+            }
+
+            inline
+            uint
+            numCoalescedRequests() const
+            {
+                return _numCoalescedRequests;
+            }
+
+            inline
+            bool
+            hasFile(const std::string& resolvedFilename) const
+            {
+                return _files.count(resolvedFilename) != 0;
+            }
+
+            inline
+            bool
+            loading(const std::string& resolvedFilename) const
+            {
+                return _pending.count(resolvedFilename) != 0;
+            }
+
+            // Returns false when the file is neither cached nor loading: the caller must then
+            // load it and report the result with complete() or fail(). Otherwise, callback is
+            // called with the cached file, immediately or once the pending load completes.
+            bool
+            request(const std::string& resolvedFilename, const CompleteFunction& callback);
+
+            void
+            complete(const std::string& resolvedFilename, std::shared_ptr<File> file);
+
+            void
+            fail(const std::string& resolvedFilename);
+
+            void
+            remove(const std::string& resolvedFilename);
+
+            void
+            clear();
+
+        private:
+            LoadingCache(uint budget);
+
+            void
+            evict(uint budget);
+        };
+    }
+}
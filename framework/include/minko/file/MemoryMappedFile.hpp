@@ -0,0 +1,75 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+    namespace file
+    {
+        // A read-only memory mapping of a whole file or of a range of it.
+        class MemoryMappedFile
+        {
+        public:
+            typedef std::shared_ptr<MemoryMappedFile>   Ptr;
+
+        private:
+            void*                                       _mapping;
+            size_t                                      _mappingSize;
+            const unsigned char*                        _data;
+            uint                                        _size;
+#if defined(_MSC_VER)
+            void*                                       _file;
+            void*                                       _fileMapping;
+#endif
+
+        public:
+            // Returns nullptr when the file cannot be mapped (missing file, empty range, or no
+            // memory mapping on the platform).
+            static
+            Ptr
+            create(const std::string& filename, uint offset = 0, uint length = 0);
+
+            inline
+            const unsigned char*
+            data() const
+            {
+                return _data;
+            }
+
+            inline
+            uint
+            size() const
+            {
+                return _size;
+            }
+
+            ~MemoryMappedFile();
+
+        private:
+            MemoryMappedFile();
+
+            bool
+            map(const std::string& filename, uint offset, uint length);
+        };
+    }
+}
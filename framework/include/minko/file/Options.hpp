@@ -40,6 +40,8 @@ namespace minko
             typedef std::shared_ptr<render::Effect>                                        EffectPtr;
             typedef std::shared_ptr<Loader>                                             LoaderPtr;
             typedef std::shared_ptr<AbstractParser>                                     AbsParserPtr;
+            typedef std::shared_ptr<LoadingCache>                                       LoadingCachePtr;
+            typedef std::shared_ptr<async::TaskScheduler>                               TaskSchedulerPtr;
             typedef std::function<AbsParserPtr(void)>                                   ParserHandler;
             typedef std::function<AbsProtocolPtr(void)>                                    ProtocolHandler;
 
@@ -72,12 +74,16 @@ namespace minko
             bool                                                _isCubeTexture;
             bool                                                _startAnimation;
             bool                                                _loadAsynchronously;
+            bool                                                _memoryMapFiles;
+            bool                                                _parseAsynchronously;
+            bool                                                _streamFiles;
             bool                                                _disposeIndexBufferAfterLoading;
             bool                                                _disposeVertexBufferAfterLoading;
             bool                                                _disposeTextureAfterLoading;
             bool                                                _storeDataIfNotParsed;
             unsigned int                                        _skinningFramerate;
             component::SkinningMethod                            _skinningMethod;
+            float                                               _skinningCompressionTolerance;
             std::shared_ptr<render::Effect>                     _effect;
             MaterialPtr                                            _material;
             std::list<render::TextureFormat>                    _textureFormats;
@@ -89,6 +95,8 @@ namespace minko
             NodeFunction                                        _nodeFunction;
             EffectFunction                                        _effectFunction;
             TextureFormatFunction                               _textureFormatFunction;
+            LoadingCachePtr                                     _loadingCache;
+            TaskSchedulerPtr                                    _taskScheduler;
 
             int                                                 _seekingOffset;
             int                                                 _seekedLength;
@@ -138,6 +146,7 @@ namespace minko
                 opt->_disposeTextureAfterLoading = options->_disposeTextureAfterLoading;
                 opt->_skinningFramerate = options->_skinningFramerate;
                 opt->_skinningMethod = options->_skinningMethod;
+                opt->_skinningCompressionTolerance = options->_skinningCompressionTolerance;
                 opt->_effect = options->_effect;
                 opt->_materialFunction = options->_materialFunction;
                 opt->_geometryFunction = options->_geometryFunction;
@@ -146,6 +155,11 @@ namespace minko
                 opt->_uriFunction = options->_uriFunction;
                 opt->_nodeFunction = options->_nodeFunction;
                 opt->_loadAsynchronously = options->_loadAsynchronously;
+                opt->_memoryMapFiles = options->_memoryMapFiles;
+                opt->_parseAsynchronously = options->_parseAsynchronously;
+                opt->_streamFiles = options->_streamFiles;
+                opt->_loadingCache = options->_loadingCache;
+                opt->_taskScheduler = options->_taskScheduler;
 
                 return opt;
             }
@@ -251,6 +265,95 @@ namespace minko
                 return shared_from_this();
             }
 
+            // Local files are memory mapped and parsed in place instead of being read in memory.
+            inline
+            bool
+            memoryMapFiles() const
+            {
+                return _memoryMapFiles;
+            }
+
+            inline
+            Ptr
+            memoryMapFiles(bool value)
+            {
+                _memoryMapFiles = value;
+
+                return shared_from_this();
+            }
+
+            // Files are decoded on the task scheduler by the parsers supporting it: see
+            // AbstractParser::decodable().
+            inline
+            bool
+            parseAsynchronously() const
+            {
+                return _parseAsynchronously;
+            }
+
+            inline
+            Ptr
+            parseAsynchronously(bool value)
+            {
+                _parseAsynchronously = value;
+
+                return shared_from_this();
+            }
+
+            // Protocols deliver files in chunks as they are read, so that the parsers supporting
+            // it start before the whole file is loaded: see AbstractParser::streamable().
+            inline
+            bool
+            streamFiles() const
+            {
+                return _streamFiles;
+            }
+
+            inline
+            Ptr
+            streamFiles(bool value)
+            {
+                _streamFiles = value;
+
+                return shared_from_this();
+            }
+
+            inline
+            LoadingCachePtr
+            loadingCache() const
+            {
+                return _loadingCache;
+            }
+
+            // Loaders sharing a cache load each file once and skip parsing the files whose
+            // assets are already in the asset library.
+            inline
+            Ptr
+            loadingCache(LoadingCachePtr cache)
+            {
+                _loadingCache = cache;
+
+                return shared_from_this();
+            }
+
+            inline
+            TaskSchedulerPtr
+            taskScheduler() const
+            {
+                return _taskScheduler;
+            }
+
+            // Scheduler decoding the files when parsing asynchronously. Scene managers set the one of
+            // their canvas, the one of the default canvas is used when none is set.
+            inline
+            Ptr
+            taskScheduler(TaskSchedulerPtr scheduler)
+            {
+                _taskScheduler = scheduler;
+
+                return shared_from_this();
+            }
+
             inline
             bool
             resizeSmoothly() const
@@ -379,6 +482,23 @@ namespace minko
                 return shared_from_this();
             }
 
+            // maximum error on the compressed skin matrices, 0 keeps them baked for every frame
+            inline
+            float
+            skinningCompressionTolerance() const
+            {
+                return _skinningCompressionTolerance;
+            }
+
+            inline
+            Ptr
+            skinningCompressionTolerance(float value)
+            {
+                _skinningCompressionTolerance = value;
+
+                return shared_from_this();
+            }
+
             inline
             std::shared_ptr<render::Effect>
             effect() const
@@ -0,0 +1,160 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+    namespace geometry
+    {
+        /**
+         * A bounding volume hierarchy over the triangles of an indexed mesh, to cast rays without
+         * testing every triangle. Nodes are split according to the surface area heuristic and stored
+         * depth first in a flat array, the left child of an inner node following it directly. The
+         * triangles of each leaf are copied in packets of 4 that are intersected at once.
+         *
+         * The hierarchy keeps its own copy of the triangles: it has to be built again when the
+         * indices change, and refit when the positions change. Casting rays is thread-safe.
+         */
+        class BoundingVolumeHierarchy
+        {
+        public:
+            typedef std::shared_ptr<BoundingVolumeHierarchy>    Ptr;
+
+            static const uint                                   PACKET_SIZE         = 4;
+            static const uint                                   MAX_DEPTH           = 48;
+            static const uint                                   MAX_LEAF_SIZE;
+
+        private:
+            static const uint                                   LEAF;
+            static const uint                                   NUM_BINS            = 16;
+            static const float                                  EPSILON;
+
+            struct Node
+            {
+                float           min[3];
+                uint            offset;         // inner node: index of the right child, leaf: first packet
+                float           max[3];
+                uint            info;           // inner node: split axis, leaf: number of packets << 2 | LEAF
+            };
+
+            // structure of arrays: a coordinate of each of the 4 triangles at a time
+            struct Packet
+            {
+                float           v0[3][PACKET_SIZE];
+                float           edge1[3][PACKET_SIZE];
+                float           edge2[3][PACKET_SIZE];
+                uint            triangles[PACKET_SIZE];
+            };
+
+            struct BuildTriangle
+            {
+                float           vertices[3][3];
+                float           min[3];
+                float           max[3];
+                uint            triangle;
+            };
+
+        private:
+            std::vector<Node>                                   _nodes;
+            std::vector<Packet>                                 _packets;
+            uint                                                _numTriangles;
+            uint                                                _depth;
+
+        public:
+            /**
+             * Builds the hierarchy of the triangles of indices, each vertex being read as 3 floats
+             * from xyz + index * vertexSize.
+             */
+            inline static
+            Ptr
+            create(const float*                         xyz,
+                   uint                                 vertexSize,
+                   const std::vector<unsigned short>&   indices)
+            {
+                Ptr bvh(new BoundingVolumeHierarchy());
+
+                bvh->build(xyz, vertexSize, indices);
+
+                return bvh;
+            }
+
+            inline
+            uint
+            numNodes() const
+            {
+                return _nodes.size();
+            }
+
+            inline
+            uint
+            numTriangles() const
+            {
+                return _numTriangles;
+            }
+
+            inline
+            uint
+            depth() const
+            {
+                return _depth;
+            }
+
+            /**
+             * Reads the positions of the triangles again and updates the bounds of the nodes,
+             * keeping the tree as it was built. This is much faster than building it again, but
+             * casting rays slows down as the triangles move away from their original places.
+             */
+            void
+            refit(const float* xyz, uint vertexSize, const std::vector<unsigned short>& indices);
+
+            /**
+             * Finds the nearest triangle hit by the ray in front of its origin. triangle is the
+             * position of the first index of the triangle in the indices, u and v are the barycentric
+             * coordinates of the hit relative to its second and third vertices.
+             */
+            bool
+            cast(const float*   origin,
+                 const float*   direction,
+                 float&         distance,
+                 uint&          triangle,
+                 float&         u,
+                 float&         v) const;
+
+        private:
+            BoundingVolumeHierarchy();
+
+            void
+            build(const float* xyz, uint vertexSize, const std::vector<unsigned short>& indices);
+
+            void
+            buildNode(std::vector<BuildTriangle>& triangles, uint begin, uint end, uint depth);
+
+            void
+            buildLeaf(Node& node, std::vector<BuildTriangle>& triangles, uint begin, uint end);
+
+            // partitions the triangles along the cheapest split and returns where, or begin if none is worth it
+            uint
+            split(std::vector<BuildTriangle>& triangles, uint begin, uint end, const Node& node, uint& axis) const;
+        };
+    }
+}
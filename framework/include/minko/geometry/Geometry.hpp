@@ -35,7 +35,11 @@ namespace minko
 
         private:
             typedef std::shared_ptr<render::VertexBuffer>       VBPtr;
+            typedef std::shared_ptr<render::IndexBuffer>        IBPtr;
             typedef std::shared_ptr<data::ArrayProvider>        ProviderPtr;
+            typedef std::shared_ptr<BoundingVolumeHierarchy>    BVHPtr;
+
+            static const unsigned int                           MIN_NUM_RAYS_PER_TASK;
 
         private:
             ProviderPtr                                         _data;
@@ -45,6 +49,11 @@ namespace minko
             std::shared_ptr<render::IndexBuffer>                _indexBuffer;
 
             std::unordered_map<VBPtr, Signal<VBPtr, int>::Slot> _vbToVertexSizeChangedSlot;
+            std::unordered_map<VBPtr, Signal<VBPtr>::Slot>      _vbToChangedSlot;
+            Signal<IBPtr>::Slot                                 _indicesChangedSlot;
+
+            BVHPtr                                              _boundingVolumeHierarchy;
+            bool                                                _boundingVolumeHierarchyOutdated;
 
         public:
             virtual
@@ -107,13 +116,8 @@ namespace minko
                 return _data->hasProperty(vertexAttributeName);
             }
 
-            inline
             void
-            indices(std::shared_ptr<render::IndexBuffer> indices)
-            {
-                _indexBuffer = indices;
-                _data->set("indices", indices);
-            }
+            indices(std::shared_ptr<render::IndexBuffer> indices);
 
             inline
             std::shared_ptr<render::IndexBuffer>
@@ -160,6 +164,11 @@ namespace minko
                                      std::vector<std::vector<float>>&    vertices,
                                      uint                                numVertices);
 
+            // Built on the first cast, and again after the indices change. It is refit to the
+            // positions uploaded since the last cast.
+            BVHPtr
+            boundingVolumeHierarchy();
+
             bool
             cast(std::shared_ptr<math::Ray>        ray,
                  float&                            distance,
@@ -168,6 +177,13 @@ namespace minko
                  std::shared_ptr<math::Vector2>    hitUv         = nullptr,
                  std::shared_ptr<math::Vector3>    hitNormal     = nullptr);
 
+            // Casts many rays at once, spread over the task scheduler. distances[i] is infinity and
+            // triangles[i] is not set when rays[i] hits nothing. Returns the number of rays that hit.
+            uint
+            cast(const std::vector<std::shared_ptr<math::Ray>>&    rays,
+                 std::vector<float>&                               distances,
+                 std::vector<uint>&                                triangles);
+
             void
             upload();
 
@@ -218,6 +234,9 @@ namespace minko
             void
             removeVertexBuffer(std::list<VBPtr>::iterator vertexBufferIt);
 
+            void
+            vertexBufferChanged(VBPtr vertexBuffer);
+
             void
             getHitUv(uint triangle, std::shared_ptr<math::Vector2> lambda, std::shared_ptr<math::Vector2> hitUv);
 
@@ -26,6 +26,7 @@ namespace minko
     namespace geometry
     {
         class Bone;
+        class SkinClip;
 
         class Skin:
             public std::enable_shared_from_this<Skin>
@@ -33,9 +34,12 @@ namespace minko
         public:
             typedef std::shared_ptr<Skin>               Ptr;
 
+            static const unsigned int                   NUM_BONES_PER_SLOT;
+
         private:
             typedef std::shared_ptr<Bone>               BonePtr;
             typedef std::shared_ptr<math::Matrix4x4>    Matrix4x4Ptr;
+            typedef std::shared_ptr<SkinClip>           SkinClipPtr;
 
         private:
             const unsigned int                          _numBones;
@@ -43,13 +47,23 @@ namespace minko
 
             const uint                                  _duration;               // in milliseconds
             const float                                 _timeFactor;
-            std::vector<std::vector<float>>             _boneMatricesPerFrame;
+            std::vector<std::vector<float>>             _boneMatricesPerFrame;   // empty once compressed
+
+            SkinClipPtr                                 _clip;                   // shared by the clones
+            mutable std::vector<float>                  _clipMatrices;           // matrices of _clipFrameId
+            mutable int                                 _clipFrameId;
 
             unsigned int                                _maxNumVertexBones;
             std::vector<unsigned int>                   _numVertexBones;         // size = #vertices
             std::vector<unsigned int>                   _vertexBones;            // size = #vertices * #bones
             std::vector<float>                          _vertexBoneWeights;      // size = #vertices * #bones
 
+            // compact copy of the influences: the ones of each vertex are padded to whole slots of
+            // NUM_BONES_PER_SLOT bones, bone ids and weights are stored in separate arrays
+            std::vector<unsigned int>                   _slotsOffsets;           // size = #vertices + 1
+            std::vector<unsigned int>                   _slotsBoneIds;           // size = #slots * NUM_BONES_PER_SLOT
+            std::vector<float>                          _slotsBoneWeights;       // size = #slots * NUM_BONES_PER_SLOT
+
         public:
             inline
             static
@@ -114,34 +128,30 @@ namespace minko
             uint
             getFrameId(uint) const;
 
-            inline
             unsigned int
-            numFrames() const
-            {
-                return _boneMatricesPerFrame.size();
-            }
+            numFrames() const;
 
-            inline
-			void
-			setBoneMatricesPerFrame(std::vector<std::vector<float>> boneMatricesPerFrame)
-			{
-				_boneMatricesPerFrame = boneMatricesPerFrame;
-			}
+            void
+            setBoneMatricesPerFrame(std::vector<std::vector<float>> boneMatricesPerFrame);
 
-			inline
-			std::vector<std::vector<float>>
-			getBoneMatricesPerFrame()
-			{
-				return _boneMatricesPerFrame;
-			}
+            std::vector<std::vector<float>>
+            getBoneMatricesPerFrame();
 
-			inline
+            // the matrices of a compressed skin are only valid until those of another frame are read
             const std::vector<float>&
-            matrices(unsigned int frameId) const
+            matrices(unsigned int frameId) const;
+
+            inline
+            SkinClipPtr
+            clip() const
             {
-                return _boneMatricesPerFrame[frameId];
+                return _clip;
             }
 
+            // replaces the baked matrices by a compressed clip, once they were transposed
+            Ptr
+            compressMatrices(float tolerance);
+
             void
             matrix(unsigned int frameId, unsigned int boneId, Matrix4x4Ptr);
 
@@ -172,6 +182,38 @@ namespace minko
             float
             vertexBoneWeight(unsigned int vertexId, unsigned int j) const;
 
+            // index of the first bone of vertexId in slotsBoneIds() and slotsBoneWeights(), the
+            // influences of vertexId end where the ones of vertexId + 1 start
+            inline
+            const std::vector<unsigned int>&
+            slotsOffsets() const
+            {
+                return _slotsOffsets;
+            }
+
+            inline
+            const std::vector<unsigned int>&
+            slotsBoneIds() const
+            {
+                return _slotsBoneIds;
+            }
+
+            // padding bones have a null weight
+            inline
+            const std::vector<float>&
+            slotsBoneWeights() const
+            {
+                return _slotsBoneWeights;
+            }
+
+            // same layout as the slots, each vertex keeping only its maxNumBones heaviest influences
+            // with their weights normalized again
+            void
+            reducedSlots(unsigned int                   maxNumBones,
+                         std::vector<unsigned int>&     offsets,
+                         std::vector<unsigned int>&     boneIds,
+                         std::vector<float>&            boneWeights) const;
+
             Ptr
             reorganizeByVertices();
 
@@ -189,6 +231,9 @@ namespace minko
             unsigned short
             lastVertexId() const;
 
+            void
+            packSlots();
+
             inline
             unsigned int
             vertexArraysIndex(unsigned int vertexId, unsigned int j) const
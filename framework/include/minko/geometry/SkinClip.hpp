@@ -0,0 +1,128 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+namespace minko
+{
+    namespace geometry
+    {
+        /**
+         * Compressed and immutable bone animation of a Skin, meant to be shared by all its clones.
+         *
+         * Each bone keeps only the keyframes needed to rebuild its matrices within a tolerance: a
+         * translation, a scale and a rotation quaternion quantized on 16 bits per component,
+         * interpolated between keys. The bones whose matrices cannot be decomposed this way (shear,
+         * projection) keep one baked matrix per frame.
+         *
+         * Matrices are read and written in the layout Skinning uses, i.e. once the skin matrices
+         * were transposed.
+         */
+        class SkinClip
+        {
+        public:
+            typedef std::shared_ptr<SkinClip>   Ptr;
+
+            static const float                  DEFAULT_TOLERANCE;
+
+        private:
+            static const uint                   NO_BAKED_MATRICES;
+
+        private:
+            const uint                          _numBones;
+            const uint                          _numFrames;
+
+            std::vector<uint>                   _keysOffsets;           // size = #bones + 1
+            std::vector<unsigned short>         _keyFrames;             // size = #keys
+            std::vector<float>                  _keyTranslations;       // size = #keys * 3
+            std::vector<short>                  _keyRotations;          // size = #keys * 4
+            std::vector<float>                  _keyScales;             // size = #keys * 3
+
+            std::vector<uint>                   _bakedOffsets;          // size = #bones
+            std::vector<float>                  _bakedMatrices;         // size = #baked bones * #frames * 16
+
+        public:
+            // matricesPerFrame holds the numBones matrices of each frame, tolerance is the maximum
+            // difference allowed on any matrix component
+            inline static
+            Ptr
+            create(uint                                     numBones,
+                   const std::vector<std::vector<float>>&   matricesPerFrame,
+                   float                                    tolerance = DEFAULT_TOLERANCE)
+            {
+                auto clip = std::shared_ptr<SkinClip>(new SkinClip(numBones, matricesPerFrame.size()));
+
+                clip->compress(matricesPerFrame, tolerance);
+
+                return clip;
+            }
+
+            inline
+            uint
+            numBones() const
+            {
+                return _numBones;
+            }
+
+            inline
+            uint
+            numFrames() const
+            {
+                return _numFrames;
+            }
+
+            inline
+            uint
+            numKeys() const
+            {
+                return _keyFrames.size();
+            }
+
+            inline
+            uint
+            numBakedBones() const
+            {
+                return _numFrames > 0 ? _bakedMatrices.size() / (_numFrames << 4) : 0;
+            }
+
+            // size in bytes of the compressed data
+            uint
+            size() const;
+
+            // writes the numBones() matrices of frameId in output
+            void
+            matrices(uint frameId, float* output) const;
+
+        private:
+            SkinClip(uint numBones, uint numFrames);
+
+            void
+            compress(const std::vector<std::vector<float>>& matricesPerFrame, float tolerance);
+
+            void
+            keyMatrix(uint keyId, float* output) const;
+
+            void
+            interpolatedMatrix(uint keyId, float ratio, float* output) const;
+        };
+    }
+}
@@ -20,53 +20,80 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #pragma once
 
 #include "minko/Common.hpp"
-#include "minko/data/Container.hpp"
 #include "minko/Signal.hpp"
 
 namespace minko
 {
     namespace math
     {
+        /**
+         * Loose octree of the nodes of a scene, used to cull the nodes outside a shape (usually a frustum).
+         *
+         * Each octant accepts the nodes whose center is inside its cell and whose bounding box is not larger
+         * than its cell: its bounds are twice as large as its cell so that nodes never straddle two octants.
+         * The tree grows to fit the nodes inserted outside of its bounds and moving nodes are reinserted
+         * incrementally when their "transform.modelToWorldMatrix" changes.
+         */
         class OctTree :
             public std::enable_shared_from_this<OctTree>
         {
         public:
-            typedef std::shared_ptr<OctTree> Ptr;
+            typedef std::shared_ptr<OctTree>                                        Ptr;
 
         private:
-            typedef std::shared_ptr<scene::Node> NodePtr;
+            typedef std::shared_ptr<scene::Node>                                    NodePtr;
+            typedef std::function<void(NodePtr)>                                    NodeCallback;
+            typedef Signal<std::shared_ptr<data::Container>, const std::string&>    PropertyChangedSignal;
 
-        private:
-            static const uint _k = 2;
+            struct Octant
+            {
+                float               center[3];
+                float               halfSize;
+                uint                depth;
+                int                 parent;
+                // x + (y << 1) + (z << 2), -1 until the octant is split
+                int                 children[8];
+                // number of nodes in this octant and its descendants
+                uint                numNodes;
+                std::vector<uint>   content;
+            };
+
+            struct Item
+            {
+                NodePtr                         node;
+                float                           min[3];
+                float                           max[3];
+                int                             octant;
+                uint                            positionInOctant;
+                // -1 until the node has been tested
+                int                             visibility;
+                bool                            changed;
+                PropertyChangedSignal::Slot     modelToWorldChangedSlot;
+            };
 
         private:
-            uint                                                                        _maxDepth;
-            uint                                                                        _depth;
-            bool                                                                        _splitted;
-            Ptr                                                                         _parent;
-            std::vector<Ptr>                                                            _children; //x, y, z in {0, 1}, child index : x + y << 1 + z << 2
-            std::list<NodePtr>                                                          _content;
-            std::list<NodePtr>                                                          _childrenContent;
-            float                                                                       _worldSize;
-            std::shared_ptr<math::Vector3>                                              _center;
-            std::unordered_map<NodePtr, Ptr>                                            _nodeToOctant;
-            std::unordered_map<NodePtr, data::Container::PropertyChangedSignal::Slot>   _nodeToTransformChangedSlot;
-            std::unordered_map<std::shared_ptr<math::Matrix4x4>, NodePtr>               _matrixToNode;
-            std::shared_ptr<math::Box>                                                  _octantBox;
-
-
-            bool _inside;
-            NodePtr debugNode;
+            static const float                                                      MAX_HALF_SIZE;
+
+            uint                                                                    _maxDepth;
+            std::vector<Octant>                                                     _octants;
+            std::vector<Item>                                                       _items;
+            std::unordered_map<NodePtr, uint>                                       _nodeToItem;
+            std::vector<NodePtr>                                                    _changedNodes;
+            // octants to visit and whether they are known to be outside of the tested shape
+            std::vector<std::pair<uint, bool>>                                      _octantStack;
+            std::shared_ptr<math::Box>                                              _box;
 
         public:
+            /**
+             * worldSize is the initial edge length of the root octant: the tree grows when it is too small.
+             */
             inline static
             Ptr
             create(float                            worldSize,
                    uint                             maxDepth,
-                   std::shared_ptr<math::Vector3>   center,
-                   uint                             depth = 0)
+                   std::shared_ptr<math::Vector3>   center)
             {
-                return std::shared_ptr<OctTree>(new OctTree(worldSize, maxDepth, center, depth));
+                return std::shared_ptr<OctTree>(new OctTree(worldSize, maxDepth, center));
             }
 
             Ptr
@@ -75,49 +102,105 @@ namespace minko
             Ptr
             remove(NodePtr node);
 
-            uint
-            computeDepth(NodePtr node);
+            inline
+            bool
+            hasNode(NodePtr node) const
+            {
+                return _nodeToItem.count(node) != 0;
+            }
 
-            NodePtr
-            generateVisual(std::shared_ptr<file::AssetLibrary>              assetLibrary,
-                           NodePtr                                          rootNode = nullptr);
+            inline
+            uint
+            numNodes() const
+            {
+                return _items.size();
+            }
 
+            inline
             uint
-            testFrustum(std::shared_ptr<math::Frustum>                      frustum);
+            numOctants() const
+            {
+                return _octants.size();
+            }
+
+            // current edge length of the root octant
+            inline
+            float
+            worldSize() const
+            {
+                return _octants[0].halfSize * 2.f;
+            }
+
+            // true when nodes were inserted or moved since they were last tested
+            inline
+            bool
+            hasChangedNodes() const
+            {
+                return !_changedNodes.empty();
+            }
 
+            NodePtr
+            generateVisual(std::shared_ptr<file::AssetLibrary>  assetLibrary,
+                           NodePtr                              rootNode = nullptr);
+
+            /**
+             * Tests all the nodes against the shape. The callbacks are only called for the nodes that were
+             * never tested or whose visibility changed since they were last tested.
+             */
+            void
+            testFrustum(std::shared_ptr<math::AbstractShape>    frustum,
+                        NodeCallback                            insideFrustumCallback,
+                        NodeCallback                            outsideFustumCallback);
+
+            /**
+             * Only tests the nodes inserted or moved since they were last tested, to be used when the shape
+             * did not change.
+             */
             void
-            testFrustum(std::shared_ptr<math::AbstractShape>                frustum,
-                        std::function<void(std::shared_ptr<scene::Node>)>   insideFrustumCallback,
-                        std::function<void(std::shared_ptr<scene::Node>)>   outsideFustumCallback);
+            testChangedNodes(std::shared_ptr<math::AbstractShape>   frustum,
+                             NodeCallback                           insideFrustumCallback,
+                             NodeCallback                           outsideFustumCallback);
 
         private:
+            OctTree(float                           worldSize,
+                    uint                            maxDepth,
+                    std::shared_ptr<math::Vector3>  center);
 
-            bool
-            nodeChangedOctant(NodePtr node);
+            void
+            reset(const float* center, float halfSize);
 
             void
-            nodeModelToWorldChanged(std::shared_ptr<data::Container>        data,
-                                    const std::string&                      propertyName);
+            grow(const float* towards);
 
             void
-            split();
+            split(uint octantId);
 
-            float
-            computeRadius(std::shared_ptr<component::BoundingBox>           boundingBox);
+            void
+            updateBounds(Item& item);
+
+            bool
+            fits(const Item& item, uint octantId) const;
+
+            uint
+            computeDepth(const Item& item) const;
 
             void
-            addChildContent(NodePtr                                         node);
+            place(uint itemId);
 
             void
-            removeChildContent(NodePtr                                      node);
+            unplace(uint itemId);
 
-            float
-            edgeLength();
+            void
+            updateItem(uint itemId);
 
-            OctTree(float                                                   worldSize,
-                     uint                                                   maxDepth,
-                     std::shared_ptr<math::Vector3>                         center,
-                     uint                                                   depth);
+            void
+            updateChangedNodes();
+
+            bool
+            testItem(std::shared_ptr<math::AbstractShape> frustum, const Item& item);
+
+            void
+            setVisibility(Item& item, bool visible, NodeCallback& insideCallback, NodeCallback& outsideCallback);
         };
     }
 }
@@ -92,6 +92,14 @@ namespace minko
             void
             drawTriangles(const uint indexBuffer, const int numTriangles) = 0;
 
+            virtual
+            bool
+            supportsInstancing() = 0;
+
+            virtual
+            void
+            drawInstancedTriangles(const uint indexBuffer, const int numTriangles, const uint numInstances) = 0;
+
             virtual
             const uint
             createVertexBuffer(const uint size) = 0;
@@ -102,7 +110,8 @@ namespace minko
                               const uint    vertexBuffer,
                               const uint    size,
                               const uint    stride,
-                              const uint    offset) = 0;
+                              const uint    offset,
+                              const uint    divisor = 0) = 0;
 
             virtual
             void
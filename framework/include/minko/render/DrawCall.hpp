@@ -44,6 +44,8 @@ namespace minko
         public:
             typedef std::shared_ptr<DrawCall>                               Ptr;
 
+            static const unsigned int                                       MAX_NUM_VERTEXBUFFERS;
+
         private:
             enum class ContainerId{ COMPLETE = 0, FILTERED };
 
@@ -60,9 +62,22 @@ namespace minko
             typedef std::tuple<int, int, int>                               Int3;
             typedef std::tuple<int, int, int, int>                          Int4;
 
+            // A bound uniform, as it will be uploaded at each rendering. Scalar values are copied
+            // when the uniform is bound, other values are read through the data pointer so that
+            // changes made in place (to a vector, a matrix or an array) are always uploaded.
+            struct UniformInput
+            {
+                ProgramInputs::Type     type;
+                int                     location;
+                bool                    isArray;
+                float                   floatValue;
+                int                     intValues[4];
+                void*                   data;
+                std::shared_ptr<void>   owner;
+            };
+
         private:
             static const unsigned int                                       MAX_NUM_TEXTURES;
-            static const unsigned int                                       MAX_NUM_VERTEXBUFFERS;
 
             static SamplerState                                             _defaultSamplerState;
 
@@ -88,6 +103,7 @@ namespace minko
             std::vector<int>                                                _vertexSizes;
             std::vector<int>                                                _vertexAttributeSizes;
             std::vector<int>                                                _vertexAttributeOffsets;
+            std::vector<uint>                                               _vertexAttributeDivisors;
             std::vector<int>                                                _textureIds;
             std::vector<int>                                                _textureLocations;
             std::vector<WrapMode>                                           _textureWrapMode;
@@ -113,26 +129,10 @@ namespace minko
             Layouts                                                         _layouts;
             float                                                           _priority;
             bool                                                            _zsorted;
-            std::unordered_map<uint, float>                                 _uniformFloat;
-            std::unordered_map<uint, std::shared_ptr<math::Vector2>>        _uniformFloat2;
-            std::unordered_map<uint, std::shared_ptr<math::Vector3>>        _uniformFloat3;
-            std::unordered_map<uint, std::shared_ptr<math::Vector4>>        _uniformFloat4;
-            std::unordered_map<uint, const float*>                          _uniformFloat16;
-            std::unordered_map<uint, int>                                   _uniformInt;
-            std::unordered_map<uint, Int2>                                  _uniformInt2;
-            std::unordered_map<uint, Int3>                                  _uniformInt3;
-            std::unordered_map<uint, Int4>                                  _uniformInt4;
-            std::unordered_map<uint, data::UniformArrayPtr<float>>          _uniformFloats;
-            std::unordered_map<uint, data::UniformArrayPtr<float>>          _uniformFloats2;
-            std::unordered_map<uint, data::UniformArrayPtr<float>>          _uniformFloats3;
-            std::unordered_map<uint, data::UniformArrayPtr<float>>          _uniformFloats4;
-            std::unordered_map<uint, data::UniformArrayPtr<float>>          _uniformFloats16;
-            std::unordered_map<uint, data::UniformArrayPtr<int>>            _uniformInts;
-            std::unordered_map<uint, data::UniformArrayPtr<int>>            _uniformInts2;
-            std::unordered_map<uint, data::UniformArrayPtr<int>>            _uniformInts3;
-            std::unordered_map<uint, data::UniformArrayPtr<int>>            _uniformInts4;
-
-            std::unordered_map<std::string, std::list<Any>>                                           _referenceChangedSlots;        // Any = PropertyChangedSlot
+            uint                                                            _numInstances;
+            std::vector<UniformInput>                                       _uniformInputs;
+
+            std::unordered_map<data::PropertyId, std::list<Any>>                                      _referenceChangedSlots;        // Any = PropertyChangedSlot
             std::list<PropertyChangedSlot>                                                            _macroAddedOrRemovedSlots;
             std::unordered_map<ContainerPtr, std::unordered_map<std::string, PropertyChangedSlot>>    _macroChangedSlots;            // Any = PropertyChangedSlot
             Signal<std::shared_ptr<IndexBuffer>>::Slot                                                _indicesChangedSlot;
@@ -209,6 +209,20 @@ namespace minko
                 return _target;
             }
 
+            inline
+            std::shared_ptr<Program>
+            program() const
+            {
+                return _program;
+            }
+
+            inline
+            const std::vector<int>&
+            textureIds() const
+            {
+                return _textureIds;
+            }
+
             inline
             float
             priority() const
@@ -223,6 +237,21 @@ namespace minko
                 return _layouts;
             }
 
+            // 0 when the draw call is not instanced
+            inline
+            uint
+            numInstances() const
+            {
+                return _numInstances;
+            }
+
+            inline
+            void
+            numInstances(uint value)
+            {
+                _numInstances = value;
+            }
+
             inline
             bool
             zSorted() const
@@ -313,6 +342,9 @@ namespace minko
             void
             bindUniform(const std::string& propertyName, ProgramInputs::Type, int location);
 
+            bool
+            bindUniformValue(ContainerPtr, const data::PropertyId&, ProgramInputs::Type, int location);
+
             void
             bindUniformArray(const std::string& propertyName, ContainerPtr, ProgramInputs::Type, int location);
 
@@ -322,6 +354,12 @@ namespace minko
             void
             bindIntegerUniformArray(const std::string& propertyName, ContainerPtr, ProgramInputs::Type, int location);
 
+            UniformInput&
+            setUniformInput(ProgramInputs::Type, int location, bool isArray, std::shared_ptr<void> owner = nullptr, void* data = nullptr);
+
+            void
+            uploadUniformInputs(const std::shared_ptr<AbstractContext>& context);
+
             void
             watchUniformRefChange(ContainerPtr, const std::string& propertyName, ProgramInputs::Type, int location);
 
@@ -337,26 +375,26 @@ namespace minko
             {
                 const auto&                stateBindings    = _pass->stateBindings();
                 data::Container::Ptr    container        = nullptr;
-                std::string                propertyName    = "";
+                data::PropertyId        propertyId;
 
                 if (stateBindings.count(stateName) > 0)
                 {
                     const auto&    binding    = stateBindings.at(stateName);
 
-                    propertyName        = formatPropertyName(std::get<0>(binding));
+                    propertyId            = data::PropertyId(formatPropertyName(std::get<0>(binding)));
                     container            = getContainer(ContainerId::FILTERED, std::get<1>(binding));
                 }
 
 
                 if (container)
                 {
-                    stateValue = container->hasProperty(propertyName)
-                        ? container->get<T>(propertyName)
+                    stateValue = container->hasProperty(propertyId)
+                        ? container->get<T>(propertyId)
                         : defaultValue;
 
-                    if (_referenceChangedSlots.count(propertyName) == 0)
+                    if (_referenceChangedSlots.count(propertyId) == 0)
                     {
-                        _referenceChangedSlots[propertyName].push_back(container->propertyReferenceChanged(propertyName)->connect(std::bind(
+                        _referenceChangedSlots[propertyId].push_back(container->propertyReferenceChanged(propertyId)->connect(std::bind(
                             &DrawCall::bindState<T>,
                             shared_from_this(),
                             stateName,
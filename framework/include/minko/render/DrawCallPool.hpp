@@ -21,6 +21,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 #include "minko/Common.hpp"
 #include "minko/Signal.hpp"
+#include "minko/scene/Layout.hpp"
 
 namespace std
 {
@@ -61,9 +62,31 @@ namespace minko
             typedef std::shared_ptr<scene::Node>                                                        NodePtr;
             typedef std::shared_ptr<data::ArrayProvider>                                                ArrayProviderPtr;
             typedef std::shared_ptr<data::AbstractFilter>                                               AbstractFilterPtr;
+            typedef std::shared_ptr<data::StructureProvider>                                            StructureProviderPtr;
+            typedef std::shared_ptr<VertexBuffer>                                                       VertexBufferPtr;
+            typedef std::shared_ptr<math::Matrix4x4>                                                    Matrix4x4Ptr;
 
             typedef std::unordered_set<std::string>                                                     Techniques;
 
+            // a draw call sort key and the index of the draw call in the sorted list
+            typedef std::pair<uint64_t, uint>                                                           SortEntry;
+
+            // pass, program, geometry, material, render target, layouts and priority shared by instanced draw calls
+            typedef std::tuple<const void*, const void*, const void*, const void*, const void*, Layouts, float>  InstancingKey;
+
+            // draw calls that only differ by the model to world matrix of their target, rendered at once by
+            // an instanced draw call reading the matrices from a per-instance vertex buffer
+            struct InstancingGroup
+            {
+                DrawCallPtr                 drawCall;
+                DrawCallPtr                 source; // the member drawCall was initialized from
+                std::vector<DrawCallPtr>    drawCalls;
+                std::vector<Matrix4x4Ptr>   modelToWorldMatrices;
+                StructureProviderPtr        data;
+                VertexBufferPtr             instanceBuffer; // can hold more instances than the group
+                bool                        dirty; // members changed: instances rewritten at next frame
+            };
+
             typedef Signal<DrawCallPtr, ContainerPtr, const std::string&>                               DrawCallMacroChanged;
             typedef Signal<ContainerPtr, const std::string&>                                            PropertyChanged;
             typedef Signal<SurfacePtr, const std::string&, bool>                                        TechniqueChanged;
@@ -75,7 +98,13 @@ namespace minko
         private:
             static const unsigned int                                                                   NUM_FALLBACK_ATTEMPTS;
             static std::unordered_map<std::string, std::pair<std::string, int>>                         _variablePropertyNameToPosition;
-            static std::unordered_map<DrawCallPtr, Vector3Ptr>                                          _cachedDrawcallPositions; // in eye space
+            // sort keys layout, from the most significant bits to the least significant ones:
+            // priority rank | z-sorted flag | render target rank | program and textures (opaque)
+            //                                                    | or back-to-front depth (z-sorted)
+            static const uint                                                                           PRIORITY_RANK_BITS;
+            static const uint                                                                           TARGET_RANK_BITS;
+            static const uint                                                                           MIN_NUM_INSTANCES;
+            static const uint                                                                           NUM_INSTANCE_ATTRIBUTES;
 
             RendererPtr                                                                                 _renderer;
 
@@ -90,11 +119,22 @@ namespace minko
             std::unordered_map<DrawCallPtr, ZSortNeeded::Slot>                                          _drawcallToZSortNeededSlot;
             std::unordered_map<SurfacePtr, ContainerPtr>                                                _surfaceToRootContainer;
             std::unordered_map<SurfacePtr, uint>                                                        _surfaceToMaterialProviderIndex;
-            std::list<DrawCallPtr>                                                                      _drawCalls;
+            std::vector<DrawCallPtr>                                                                    _drawCalls;
+            std::vector<DrawCallPtr>                                                                    _sortedDrawCalls;
+            std::vector<SortEntry>                                                                      _sortEntries;
+            std::vector<SortEntry>                                                                      _sortBuffer;
+            std::vector<float>                                                                          _priorities;
+            std::vector<int>                                                                            _targetIds;
 
             std::set<DrawCallPtr>                                                                       _dirtyDrawCalls;
             bool                                                                                        _mustZSort; // forces z-sorting at next frame
 
+            // when instanced draw calls exist, _renderedDrawCalls replaces _drawCalls as the list of draw calls to render
+            bool                                                                                        _instancing;
+            std::map<InstancingKey, InstancingGroup>                                                    _instancingGroups;
+            std::unordered_map<DrawCallPtr, InstancingKey>                                              _drawCallToInstancingKey;
+            std::vector<DrawCallPtr>                                                                    _renderedDrawCalls;
+
             std::unordered_map<SurfacePtr, TechniqueChanged::Slot>                                      _surfaceToTechniqueChangedSlot;
             std::unordered_multimap<SurfacePtr, VisibilityChanged::Slot>                                _surfaceToVisibilityChangedSlots;
             std::unordered_multimap<SurfacePtr, ArrayIndexChanged::Slot>                                _surfaceToIndexChangedSlots;
@@ -116,7 +156,7 @@ namespace minko
                 return ptr;
             }
 
-            const std::list<std::shared_ptr<DrawCall>>&
+            const std::vector<std::shared_ptr<DrawCall>>&
             drawCalls();
 
             void
@@ -136,7 +176,8 @@ namespace minko
             std::shared_ptr<DrawCall>
             initializeDrawCall(SurfacePtr,
                                PassPtr,
-                               DrawCallPtr = nullptr);
+                               DrawCallPtr = nullptr,
+                               StructureProviderPtr instancingData = nullptr);
 
             std::shared_ptr<Program>
             getWorkingProgram(SurfacePtr,
@@ -189,13 +230,39 @@ namespace minko
             formatPropertyName(const std::string&                               rawPropertyName,
                                std::unordered_map<std::string, std::string>&    variablesToValue);
 
-            static
-            Vector3Ptr
-            getDrawcallEyePosition(DrawCallPtr, Vector3Ptr output = nullptr);
+            void
+            sortDrawCalls(std::vector<DrawCallPtr>& drawCalls);
+
+            void
+            addToInstancingGroup(DrawCallPtr);
+
+            void
+            removeFromInstancingGroup(DrawCallPtr);
+
+            void
+            clearInstancingGroups();
+
+            void
+            updateInstancingGroups();
 
-            static
             bool
-            compareDrawCalls(DrawCallPtr, DrawCallPtr);
+            initializeInstancingGroup(InstancingGroup& group);
+
+            void
+            releaseInstancingGroup(InstancingGroup& group);
+
+            void
+            updateInstances(InstancingGroup& group);
+
+            void
+            updateInstanceBuffer(InstancingGroup& group);
+
+            uint64_t
+            getDrawCallSortKey(DrawCallPtr);
+
+            static
+            void
+            radixSort(std::vector<SortEntry>& entries, std::vector<SortEntry>& buffer);
         };
     }
 }
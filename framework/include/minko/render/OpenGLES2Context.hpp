@@ -42,6 +42,7 @@ namespace minko
             typedef std::unordered_map<StencilOperation, unsigned int>    StencilOperationMap;
             typedef std::unordered_map<unsigned int, unsigned int>        TextureToBufferMap;
             typedef std::pair<uint, uint>                                TextureSize;
+            typedef std::unordered_map<uint, std::vector<uint>>          UniformValuesMap;
 
         protected:
             static BlendFactorsMap                    _blendingFactors;
@@ -59,6 +60,7 @@ namespace minko
             std::unordered_map<uint, TextureType>     _textureTypes;
 
             std::string                               _driverInfo;
+            bool                                      _supportsInstancing;
 
             std::list<unsigned int>                   _vertexBuffers;
             std::list<unsigned int>                   _indexBuffers;
@@ -80,12 +82,16 @@ namespace minko
 
             unsigned int                              _currentTarget;
             int                                       _currentIndexBuffer;
+            int                                       _currentArrayBuffer;
+            std::vector<bool>                         _currentVertexAttributeEnabled;
             std::vector<int>                          _currentVertexBuffer;
             std::vector<int>                          _currentVertexSize;
             std::vector<int>                          _currentVertexStride;
             std::vector<int>                          _currentVertexOffset;
-            uint                                      _currentBoundTexture;
+            std::vector<uint>                         _currentVertexDivisor;
+            uint                                      _currentActiveTexture;
             std::vector<int>                          _currentTexture;
+            std::vector<uint>                         _currentTextureTarget;
             std::unordered_map<uint, WrapMode>        _currentWrapMode;
             std::unordered_map<uint, TextureFilter>   _currentTextureFilter;
             std::unordered_map<uint, MipFilter>       _currentMipFilter;
@@ -101,6 +107,18 @@ namespace minko
             StencilOperation                        _currentStencilFailOp;
             StencilOperation                        _currentStencilZFailOp;
             StencilOperation                        _currentStencilZPassOp;
+            bool                                      _currentScissorTest;
+            ScissorBox                                _currentScissorBox;
+            float                                     _currentClearColor[4];
+            float                                     _currentClearDepth;
+            uint                                      _currentClearStencil;
+
+            // last values set for each uniform location of each program, as raw 32 bits words
+            std::unordered_map<uint, UniformValuesMap> _uniformValues;
+            UniformValuesMap*                         _currentUniformValues;
+
+            uint                                      _numIssuedStateChanges;
+            uint                                      _numSkippedStateChanges;
 
         public:
             ~OpenGLES2Context();
@@ -144,6 +162,13 @@ namespace minko
                 return _currentTarget;
             }
 
+            inline
+            bool
+            supportsInstancing()
+            {
+                return _supportsInstancing;
+            }
+
             inline
             uint
             viewportWidth()
@@ -165,6 +190,31 @@ namespace minko
                 return _currentProgram;
             }
 
+            // Number of state changes (uniforms, textures, samplers, vertex attributes, buffers,
+            // blend/depth/stencil/scissor/culling states...) that actually reached the driver.
+            inline
+            uint
+            numIssuedStateChanges() const
+            {
+                return _numIssuedStateChanges;
+            }
+
+            // Number of state changes dropped because they would not have changed the GL state.
+            inline
+            uint
+            numSkippedStateChanges() const
+            {
+                return _numSkippedStateChanges;
+            }
+
+            inline
+            void
+            resetStateChangesCounters()
+            {
+                _numIssuedStateChanges = 0;
+                _numSkippedStateChanges = 0;
+            }
+
             void
             configureViewport(const uint x,
                               const uint y,
@@ -186,6 +236,9 @@ namespace minko
             void
             drawTriangles(const uint indexBuffer, const int numTriangles);
 
+            void
+            drawInstancedTriangles(const uint indexBuffer, const int numTriangles, const uint numInstances);
+
             const uint
             createVertexBuffer(const uint size);
 
@@ -194,7 +247,8 @@ namespace minko
                               const uint    vertexBuffer,
                               const uint    size,
                               const uint    stride,
-                              const uint    offset);
+                              const uint    offset,
+                              const uint    divisor = 0);
             void
             uploadVertexBufferData(const uint     vertexBuffer,
                                    const uint     offset,
@@ -481,6 +535,52 @@ namespace minko
 
             TextureType
             getTextureType(uint textureId) const;
+
+            inline
+            bool
+            stateChanged(bool changed)
+            {
+                if (changed)
+                    ++_numIssuedStateChanges;
+                else
+                    ++_numSkippedStateChanges;
+
+                return changed;
+            }
+
+            // Compare the values of a uniform of the current program with the ones it was last set to
+            // and update them: the GL call should be issued only when this method returns true.
+            template <typename T>
+            bool
+            uniformChanged(uint location, uint numValues, const T* values, uint flags = 0)
+            {
+                static_assert(sizeof(T) == sizeof(uint), "uniform values must be 32 bits wide");
+
+                auto& cachedValues = (*_currentUniformValues)[location];
+
+                if (cachedValues.size() == numValues + 1
+                    && cachedValues[0] == flags
+                    && std::memcmp(&cachedValues[1], values, numValues * sizeof(T)) == 0)
+                    return stateChanged(false);
+
+                cachedValues.resize(numValues + 1);
+                cachedValues[0] = flags;
+                std::memcpy(&cachedValues[1], values, numValues * sizeof(T));
+
+                return stateChanged(true);
+            }
+
+            void
+            setActiveTexture(uint position);
+
+            void
+            bindTexture(uint glTarget, uint texture);
+
+            void
+            bindArrayBuffer(uint vertexBuffer);
+
+            void
+            bindElementArrayBuffer(uint indexBuffer);
         };
     }
 }
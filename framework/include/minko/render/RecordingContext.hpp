@@ -0,0 +1,607 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#pragma once
+
+#include "minko/Common.hpp"
+
+#include "minko/render/AbstractContext.hpp"
+#include "minko/render/ProgramInputs.hpp"
+#include "minko/render/Blending.hpp"
+
+namespace minko
+{
+    namespace render
+    {
+        /*
+        ** A GPU-less implementation of AbstractContext: resources are only given ids, programs inputs
+        ** are extracted from the (preprocessed) GLSL sources and every other call is appended to a
+        ** command log. Counters are kept per command type, including the number of calls that did not
+        ** change the current state (redundant calls). Useful to profile and test the CPU side of the
+        ** rendering pipeline on machines without any graphics driver.
+        */
+        class RecordingContext :
+            public AbstractContext,
+            public std::enable_shared_from_this<RecordingContext>
+        {
+        public:
+            typedef std::shared_ptr<RecordingContext> Ptr;
+
+            enum class CommandType
+            {
+                CONFIGURE_VIEWPORT,
+                CLEAR,
+                PRESENT,
+                DRAW_TRIANGLES,
+                CREATE_VERTEX_BUFFER,
+                SET_VERTEX_BUFFER,
+                UPLOAD_VERTEX_BUFFER,
+                DELETE_VERTEX_BUFFER,
+                CREATE_INDEX_BUFFER,
+                UPLOAD_INDEX_BUFFER,
+                DELETE_INDEX_BUFFER,
+                CREATE_TEXTURE,
+                UPLOAD_TEXTURE,
+                DELETE_TEXTURE,
+                SET_TEXTURE,
+                SET_SAMPLER_STATE,
+                GENERATE_MIPMAPS,
+                CREATE_SHADER,
+                COMPILE_SHADER,
+                DELETE_SHADER,
+                CREATE_PROGRAM,
+                LINK_PROGRAM,
+                DELETE_PROGRAM,
+                SET_PROGRAM,
+                SET_UNIFORM,
+                SET_BLEND_MODE,
+                SET_COLOR_MASK,
+                SET_DEPTH_TEST,
+                SET_STENCIL_TEST,
+                SET_SCISSOR_TEST,
+                SET_TRIANGLE_CULLING,
+                SET_RENDER_TARGET,
+                READ_PIXELS
+            };
+
+            static const uint NUM_COMMAND_TYPES = static_cast<uint>(CommandType::READ_PIXELS) + 1;
+
+            struct Command
+            {
+                CommandType type;
+                bool        redundant;
+                uint        target;     // resource id, uniform location, texture unit or attribute position
+                int         args[4];
+                float       values[4];
+            };
+
+        private:
+            struct TextureInfo
+            {
+                TextureType     type;
+                uint            width;
+                uint            height;
+                bool            mipMapping;
+                bool            renderTarget;
+                WrapMode        wrapMode;
+                TextureFilter   filter;
+                MipFilter       mipFilter;
+            };
+
+            struct VertexAttributeState
+            {
+                uint            vertexBuffer;
+                uint            size;
+                uint            stride;
+                uint            offset;
+                uint            divisor;
+            };
+
+            typedef std::unordered_map<std::string, std::string>           MacroMap;
+            typedef std::vector<std::pair<std::string, std::string>>       StructMembers;
+            typedef std::unordered_map<std::string, StructMembers>         StructMap;
+
+        public:
+            static const uint                                     MAX_NUM_TEXTURES;
+            static const uint                                     MAX_NUM_VERTEX_ATTRIBUTES;
+
+        private:
+            bool                                                  _errorsEnabled;
+            std::string                                           _driverInfo;
+            bool                                                  _recordCommands;
+            bool                                                  _supportsInstancing;
+
+            std::vector<Command>                                  _commands;
+            Command                                               _discardedCommand;
+            std::vector<uint>                                     _numCommands;
+            std::vector<uint>                                     _numRedundantCommands;
+            uint                                                  _numTriangles;
+            uint                                                  _numInstances;
+
+            uint                                                  _nextResourceId;
+            std::unordered_set<uint>                              _vertexBuffers;
+            std::unordered_set<uint>                              _indexBuffers;
+            std::unordered_map<uint, TextureInfo>                 _textures;
+            std::unordered_map<uint, bool>                        _shaderIsVertex;
+            std::unordered_map<uint, std::string>                 _shaderSources;
+            std::unordered_map<uint, std::vector<uint>>           _programShaders;
+            std::unordered_map<uint64_t, std::vector<float>>      _uniformValues;
+
+            uint                                                  _viewportX;
+            uint                                                  _viewportY;
+            uint                                                  _viewportWidth;
+            uint                                                  _viewportHeight;
+            uint                                                  _oldViewportX;
+            uint                                                  _oldViewportY;
+            uint                                                  _oldViewportWidth;
+            uint                                                  _oldViewportHeight;
+
+            uint                                                  _currentTarget;
+            uint                                                  _currentProgram;
+            std::vector<VertexAttributeState>                     _currentVertexAttributes;
+            std::vector<uint>                                     _currentTexture;
+            Blending::Mode                                        _currentBlendMode;
+            bool                                                  _currentColorMask;
+            bool                                                  _currentDepthMask;
+            CompareMode                                           _currentDepthFunc;
+            TriangleCulling                                       _currentTriangleCulling;
+            CompareMode                                           _currentStencilFunc;
+            int                                                   _currentStencilRef;
+            uint                                                  _currentStencilMask;
+            StencilOperation                                      _currentStencilFailOp;
+            StencilOperation                                      _currentStencilZFailOp;
+            StencilOperation                                      _currentStencilZPassOp;
+            bool                                                  _currentScissorTest;
+            ScissorBox                                            _currentScissorBox;
+
+        public:
+            static
+            Ptr
+            create()
+            {
+                return std::shared_ptr<RecordingContext>(new RecordingContext());
+            }
+
+            inline
+            bool
+            errorsEnabled()
+            {
+                return _errorsEnabled;
+            }
+
+            inline
+            void
+            errorsEnabled(bool errorsEnabled)
+            {
+                _errorsEnabled = errorsEnabled;
+            }
+
+            inline
+            const std::string&
+            driverInfo()
+            {
+                return _driverInfo;
+            }
+
+            inline
+            uint
+            renderTarget()
+            {
+                return _currentTarget;
+            }
+
+            inline
+            uint
+            viewportWidth()
+            {
+                return _viewportWidth;
+            }
+
+            inline
+            uint
+            viewportHeight()
+            {
+                return _viewportHeight;
+            }
+
+            inline
+            uint
+            currentProgram()
+            {
+                return _currentProgram;
+            }
+
+            inline
+            bool
+            supportsInstancing()
+            {
+                return _supportsInstancing;
+            }
+
+            // Disabling instancing makes it possible to test the code paths used when the extension is missing.
+            inline
+            void
+            supportsInstancing(bool value)
+            {
+                _supportsInstancing = value;
+            }
+
+            inline
+            bool
+            recordCommands() const
+            {
+                return _recordCommands;
+            }
+
+            // When disabled, only the counters are updated and the command log is left untouched.
+            inline
+            void
+            recordCommands(bool value)
+            {
+                _recordCommands = value;
+            }
+
+            inline
+            const std::vector<Command>&
+            commands() const
+            {
+                return _commands;
+            }
+
+            inline
+            uint
+            numCommands(CommandType type) const
+            {
+                return _numCommands[static_cast<uint>(type)];
+            }
+
+            inline
+            uint
+            numRedundantCommands(CommandType type) const
+            {
+                return _numRedundantCommands[static_cast<uint>(type)];
+            }
+
+            inline
+            uint
+            numDrawCalls() const
+            {
+                return numCommands(CommandType::DRAW_TRIANGLES);
+            }
+
+            inline
+            uint
+            numTriangles() const
+            {
+                return _numTriangles;
+            }
+
+            // Total number of drawn instances, a draw call that is not instanced counting as one instance.
+            inline
+            uint
+            numInstances() const
+            {
+                return _numInstances;
+            }
+
+            uint
+            numCommands() const;
+
+            uint
+            numRedundantCommands() const;
+
+            // Clears the command log and resets all the counters. The current state and the resources are kept.
+            void
+            clearCommands();
+
+            void
+            configureViewport(const uint x,
+                              const uint y,
+                              const uint width,
+                              const uint height);
+
+            void
+            clear(float red             = 0.f,
+                  float green           = 0.f,
+                  float blue            = 0.f,
+                  float alpha           = 0.f,
+                  float depth           = 1.f,
+                  unsigned int stencil  = 0,
+                  unsigned int mask     = 0xffffffff);
+
+            void
+            present();
+
+            void
+            drawTriangles(const uint indexBuffer, const int numTriangles);
+
+            void
+            drawInstancedTriangles(const uint indexBuffer, const int numTriangles, const uint numInstances);
+
+            const uint
+            createVertexBuffer(const uint size);
+
+            void
+            setVertexBufferAt(const uint    position,
+                              const uint    vertexBuffer,
+                              const uint    size,
+                              const uint    stride,
+                              const uint    offset,
+                              const uint    divisor = 0);
+
+            void
+            uploadVertexBufferData(const uint   vertexBuffer,
+                                   const uint   offset,
+                                   const uint   size,
+                                   void*        data);
+
+            void
+            deleteVertexBuffer(const uint vertexBuffer);
+
+            const uint
+            createIndexBuffer(const uint size);
+
+            void
+            uploaderIndexBufferData(const uint  indexBuffer,
+                                    const uint  offset,
+                                    const uint  size,
+                                    void*       data);
+
+            void
+            deleteIndexBuffer(const uint indexBuffer);
+
+            uint
+            createTexture(TextureType   type,
+                          unsigned int  width,
+                          unsigned int  height,
+                          bool          mipMapping,
+                          bool          optimizeForRenderToTexture = false);
+
+            uint
+            createCompressedTexture(TextureType     type,
+                                    TextureFormat   format,
+                                    unsigned int    width,
+                                    unsigned int    height,
+                                    bool            mipMapping);
+
+            void
+            uploadTexture2dData(uint            texture,
+                                unsigned int    width,
+                                unsigned int    height,
+                                unsigned int    mipLevel,
+                                void*           data);
+
+            void
+            uploadCubeTextureData(uint                texture,
+                                  CubeTexture::Face   face,
+                                  unsigned int        width,
+                                  unsigned int        height,
+                                  unsigned int        mipLevel,
+                                  void*               data);
+
+            void
+            uploadCompressedTexture2dData(uint          texture,
+                                          TextureFormat format,
+                                          unsigned int  width,
+                                          unsigned int  height,
+                                          unsigned int  size,
+                                          unsigned int  mipLevel,
+                                          void*         data);
+
+            void
+            uploadCompressedCubeTextureData(uint                texture,
+                                            CubeTexture::Face   face,
+                                            TextureFormat       format,
+                                            unsigned int        width,
+                                            unsigned int        height,
+                                            unsigned int        mipLevel,
+                                            void*               data);
+
+            void
+            activateMipMapping(uint texture);
+
+            void
+            deleteTexture(uint texture);
+
+            void
+            setTextureAt(uint   position,
+                         int    texture     = 0,
+                         int    location    = -1);
+
+            void
+            setSamplerStateAt(uint          position,
+                              WrapMode      wrapping,
+                              TextureFilter filtering,
+                              MipFilter     mipFiltering);
+
+            const uint
+            createProgram();
+
+            void
+            attachShader(const uint program, const uint shader);
+
+            void
+            linkProgram(const uint program);
+
+            void
+            deleteProgram(const uint program);
+
+            void
+            setProgram(const uint program);
+
+            void
+            compileShader(const uint shader);
+
+            void
+            setShaderSource(const uint shader, const std::string& source);
+
+            const uint
+            createVertexShader();
+
+            void
+            deleteVertexShader(const uint vertexShader);
+
+            const uint
+            createFragmentShader();
+
+            void
+            deleteFragmentShader(const uint fragmentShader);
+
+            std::shared_ptr<ProgramInputs>
+            getProgramInputs(const uint program);
+
+            void
+            setUniform(uint location, int value);
+
+            void
+            setUniform(uint location, int v1, int v2);
+
+            void
+            setUniform(uint location, int v1, int v2, int v3);
+
+            void
+            setUniform(uint location, int v1, int v2, int v3, int v4);
+
+            void
+            setUniform(uint location, float value);
+
+            void
+            setUniform(uint location, float v1, float v2);
+
+            void
+            setUniform(uint location, float v1, float v2, float v3);
+
+            void
+            setUniform(uint location, float v1, float v2, float v3, float v4);
+
+            void
+            setUniform(const uint& location, const uint& size, bool transpose, const float* values);
+
+            void
+            setUniforms(uint location, uint size, const float* values);
+
+            void
+            setUniforms2(uint location, uint size, const float* values);
+
+            void
+            setUniforms3(uint location, uint size, const float* values);
+
+            void
+            setUniforms4(uint location, uint size, const float* values);
+
+            void
+            setUniforms(uint location, uint size, const int* values);
+
+            void
+            setUniforms2(uint location, uint size, const int* values);
+
+            void
+            setUniforms3(uint location, uint size, const int* values);
+
+            void
+            setUniforms4(uint location, uint size, const int* values);
+
+            void
+            setBlendMode(Blending::Source source, Blending::Destination destination);
+
+            void
+            setBlendMode(Blending::Mode blendMode);
+
+            void
+            setColorMask(bool colorMask);
+
+            void
+            setDepthTest(bool depthMask, CompareMode depthFunc);
+
+            void
+            setStencilTest(CompareMode      stencilFunc,
+                           int              stencilRef,
+                           uint             stencilMask,
+                           StencilOperation stencilFailOp,
+                           StencilOperation stencilZFailOp,
+                           StencilOperation stencilZPassOp);
+
+            void
+            setScissorTest(bool scissorTest, const render::ScissorBox& scissorBox);
+
+            void
+            readPixels(unsigned char* pixels);
+
+            void
+            readPixels(unsigned int x, unsigned int y, unsigned int width, unsigned int height, unsigned char* pixels);
+
+            void
+            setTriangleCulling(TriangleCulling triangleCulling);
+
+            void
+            setRenderToBackBuffer();
+
+            void
+            setRenderToTexture(unsigned int texture, bool enableDepthAndStencil = false);
+
+            void
+            generateMipmaps(unsigned int texture);
+
+        private:
+            RecordingContext();
+
+            Command&
+            record(CommandType type, bool redundant, uint target = 0);
+
+            template <typename T>
+            void
+            recordUniform(uint location, uint numComponents, uint size, const T* values);
+
+            TextureInfo&
+            getTextureInfo(uint texture);
+
+            static
+            void
+            preprocess(const std::string& source, std::string& output, MacroMap& macros);
+
+            static
+            int
+            evaluateCondition(const std::string& expression, const MacroMap& macros);
+
+            static
+            void
+            fillInputs(const std::string&                   source,
+                       const MacroMap&                      macros,
+                       std::vector<std::string>&            names,
+                       std::vector<ProgramInputs::Type>&    types,
+                       std::vector<uint>&                   locations,
+                       uint&                                numUniformLocations,
+                       uint&                                numAttributeLocations);
+
+            static
+            void
+            addUniformInput(const std::string&                  name,
+                            const std::string&                  type,
+                            const StructMap&                    structs,
+                            std::vector<std::string>&           names,
+                            std::vector<ProgramInputs::Type>&   types,
+                            std::vector<uint>&                  locations,
+                            uint&                               numUniformLocations);
+
+            static
+            ProgramInputs::Type
+            convertInputType(const std::string& type);
+        };
+    }
+}
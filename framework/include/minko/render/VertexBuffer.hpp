@@ -43,10 +43,12 @@ namespace minko
             std::vector<float>                  _data;
             std::list<AttributePtr>             _attributes;
             uint                                _vertexSize;
+            uint                                _divisor;
             Vector3Ptr                          _minPosition;
             Vector3Ptr                          _maxPosition;
 
             std::shared_ptr<Signal<Ptr, int>>   _vertexSizeChanged;
+            std::shared_ptr<Signal<Ptr>>        _changed;
 
         public:
             ~VertexBuffer()
@@ -124,6 +126,21 @@ namespace minko
                 return _vertexSize;
             }
 
+            // 0 for per-vertex data, n to advance to the next element every n instances when instancing
+            inline
+            uint
+            divisor() const
+            {
+                return _divisor;
+            }
+
+            inline
+            void
+            divisor(uint value)
+            {
+                _divisor = value;
+            }
+
             inline
             std::shared_ptr<Signal<Ptr, int>>
             vertexSizeChanged()
@@ -131,6 +148,14 @@ namespace minko
                 return _vertexSizeChanged;
             }
 
+            // executed when the data is uploaded, which follows any change
+            inline
+            std::shared_ptr<Signal<Ptr>>
+            changed()
+            {
+                return _changed;
+            }
+
             inline
             uint
             numVertices() const
@@ -20,6 +20,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/Common.hpp"
 
 #include "minko/AbstractCanvas.hpp"
+#include "minko/async/TaskScheduler.hpp"
 
 using namespace minko;
 
@@ -28,3 +29,16 @@ AbstractCanvas::_defaultCanvas;
 
 std::unordered_map<std::string, AbstractCanvas::WorkerHandler>
 AbstractCanvas::_workers;
+
+std::shared_ptr<async::TaskScheduler>
+AbstractCanvas::taskScheduler()
+{
+    return async::TaskScheduler::defaultScheduler();
+}
+
+/*static*/
+std::shared_ptr<async::TaskScheduler>
+AbstractCanvas::defaultTaskScheduler()
+{
+    return _defaultCanvas ? _defaultCanvas->taskScheduler() : async::TaskScheduler::defaultScheduler();
+}
@@ -33,7 +33,7 @@ Matrix4x4Timeline::Matrix4x4Timeline(const std::string& propertyName,
                                      const std::vector<Matrix4x4Ptr>& matrices,
                                      bool interpolate):
     AbstractTimeline(propertyName, duration),
-    _matrices(),
+    _matrices(nullptr),
     _interpolate(interpolate)
 {
     initializeMatrixTimetable(timetable, matrices);
@@ -41,13 +41,9 @@ Matrix4x4Timeline::Matrix4x4Timeline(const std::string& propertyName,
 
 Matrix4x4Timeline::Matrix4x4Timeline(const Matrix4x4Timeline& matrix) :
     AbstractTimeline(matrix._propertyName, matrix._duration),
-    _matrices(matrix._matrices.size()),
+    _matrices(matrix._matrices),
     _interpolate(matrix._interpolate)
 {
-    for (uint keyId = 0; keyId < matrix._matrices.size(); ++keyId)
-    {
-        _matrices[keyId] = matrix._matrices[keyId];
-    }
 }
 
 AbstractTimeline::Ptr
@@ -69,16 +65,17 @@ Matrix4x4Timeline::initializeMatrixTimetable(const std::vector<uint>& timetable,
 
     const uint numKeys = timetable.size();
 
-    _matrices.clear();
-    _matrices.resize(numKeys);
+    auto keys = std::make_shared<MatrixTimetable>(numKeys);
 
     for (uint keyId = 0; keyId < numKeys; ++keyId)
     {
-        _matrices[keyId].first    = timetable[keyId];
-        _matrices[keyId].second    = matrices[keyId];
+        (*keys)[keyId].first    = timetable[keyId];
+        (*keys)[keyId].second    = matrices[keyId];
     }
 
-    std::sort(_matrices.begin(), _matrices.end());
+    std::sort(keys->begin(), keys->end());
+
+    _matrices = keys;
 }
 
 void
@@ -86,27 +83,29 @@ Matrix4x4Timeline::update(uint time,
                           UpdateTargetPtr data,
                           bool /*skipPropertyNameFormatting*/)
 {
-    if (_isLocked || _duration == 0 || _matrices.empty())
-        return;
-
     if (data == nullptr || !data->hasProperty(_propertyName))
         return;
 
-    auto matrix    = data->get<Matrix4x4::Ptr>(_propertyName);
+    update(time, data->get<Matrix4x4::Ptr>(_propertyName));
+}
 
-    if (matrix == nullptr)
+void
+Matrix4x4Timeline::update(uint              time,
+                          Matrix4x4::Ptr    matrix) const
+{
+    if (_isLocked || _duration == 0 || matrix == nullptr)
         return;
 
     if (_interpolate)
     {
-        matrix = interpolate(time, matrix);
+        interpolate(time, matrix);
     }
     else
     {
         const uint    t        = getTimeInRange(time, _duration + 1);
-        const uint    keyId    = getIndexForTime(t, _matrices);
+        const uint    keyId    = getIndexForTime(t, *_matrices);
 
-        matrix->copyFrom(_matrices[keyId].second);
+        matrix->copyFrom((*_matrices)[keyId].second);
     }
 }
 
@@ -114,21 +113,22 @@ Matrix4x4::Ptr
 Matrix4x4Timeline::interpolate(uint             time,
                                Matrix4x4::Ptr   output) const
 {
+    const auto&   matrices = *_matrices;
     const uint    t        = getTimeInRange(time, _duration + 1);
-    const uint    keyId    = getIndexForTime(t, _matrices);
+    const uint    keyId    = getIndexForTime(t, matrices);
 
     if (output == nullptr)
         output = Matrix4x4::create();
 
     // all matrices are sorted in order of increasing time
-    if (t < _matrices.front().first || t >= _matrices.back().first)
-        output->copyFrom(_matrices[keyId].second);
+    if (t < matrices.front().first || t >= matrices.back().first)
+        output->copyFrom(matrices[keyId].second);
     else
     {
-        assert(keyId + 1 < (int)_matrices.size());
+        assert(keyId + 1 < (int)matrices.size());
 
-        const auto& current    = _matrices[keyId];
-        const auto& next    = _matrices[keyId + 1];
+        const auto& current    = matrices[keyId];
+        const auto& next    = matrices[keyId + 1];
 
         const float ratio    = current.first < next.first
             ? (t - current.first) / (float)(next.first - current.first)
@@ -0,0 +1,482 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "minko/animation/Pose.hpp"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+# include <xmmintrin.h>
+# define MINKO_POSE_SSE
+#elif defined(__aarch64__)
+# include <arm_neon.h>
+# define MINKO_POSE_NEON
+#endif
+
+using namespace minko;
+using namespace minko::animation;
+
+namespace
+{
+    // 4 bones at a time
+#if defined(MINKO_POSE_SSE)
+    typedef __m128 Lanes;
+
+    inline Lanes load(const float* p)           { return _mm_loadu_ps(p); }
+    inline void store(float* p, Lanes a)        { _mm_storeu_ps(p, a); }
+    inline Lanes splat(float a)                 { return _mm_set1_ps(a); }
+    inline Lanes plus(Lanes a, Lanes b)         { return _mm_add_ps(a, b); }
+    inline Lanes minus(Lanes a, Lanes b)        { return _mm_sub_ps(a, b); }
+    inline Lanes times(Lanes a, Lanes b)        { return _mm_mul_ps(a, b); }
+    inline Lanes over(Lanes a, Lanes b)         { return _mm_div_ps(a, b); }
+    inline Lanes squareRoot(Lanes a)            { return _mm_sqrt_ps(a); }
+
+    // a with the sign of b
+    inline
+    Lanes
+    copySign(Lanes a, Lanes b)
+    {
+        const __m128 signMask = _mm_set1_ps(-0.0f);
+
+        return _mm_or_ps(_mm_andnot_ps(signMask, a), _mm_and_ps(signMask, b));
+    }
+#elif defined(MINKO_POSE_NEON)
+    typedef float32x4_t Lanes;
+
+    inline Lanes load(const float* p)           { return vld1q_f32(p); }
+    inline void store(float* p, Lanes a)        { vst1q_f32(p, a); }
+    inline Lanes splat(float a)                 { return vdupq_n_f32(a); }
+    inline Lanes plus(Lanes a, Lanes b)         { return vaddq_f32(a, b); }
+    inline Lanes minus(Lanes a, Lanes b)        { return vsubq_f32(a, b); }
+    inline Lanes times(Lanes a, Lanes b)        { return vmulq_f32(a, b); }
+    inline Lanes over(Lanes a, Lanes b)         { return vdivq_f32(a, b); }
+    inline Lanes squareRoot(Lanes a)            { return vsqrtq_f32(a); }
+
+    inline
+    Lanes
+    copySign(Lanes a, Lanes b)
+    {
+        return vbslq_f32(vdupq_n_u32(0x80000000), b, a);
+    }
+#else
+    struct Lanes
+    {
+        float v[4];
+    };
+
+    template <typename F>
+    inline
+    Lanes
+    apply(Lanes a, Lanes b, F f)
+    {
+        Lanes r;
+
+        for (uint i = 0; i < 4; ++i)
+            r.v[i] = f(a.v[i], b.v[i]);
+
+        return r;
+    }
+
+    inline Lanes load(const float* p)           { Lanes r; std::copy(p, p + 4, r.v); return r; }
+    inline void store(float* p, Lanes a)        { std::copy(a.v, a.v + 4, p); }
+    inline Lanes splat(float a)                 { Lanes r = { { a, a, a, a } }; return r; }
+    inline Lanes plus(Lanes a, Lanes b)         { return apply(a, b, [](float x, float y) { return x + y; }); }
+    inline Lanes minus(Lanes a, Lanes b)        { return apply(a, b, [](float x, float y) { return x - y; }); }
+    inline Lanes times(Lanes a, Lanes b)        { return apply(a, b, [](float x, float y) { return x * y; }); }
+    inline Lanes over(Lanes a, Lanes b)         { return apply(a, b, [](float x, float y) { return x / y; }); }
+    inline Lanes squareRoot(Lanes a)            { return apply(a, a, [](float x, float) { return sqrtf(x); }); }
+    inline Lanes copySign(Lanes a, Lanes b)     { return apply(a, b, [](float x, float y) { return y < 0.0f ? -fabsf(x) : fabsf(x); }); }
+#endif
+
+    // a + (b - a) * ratio
+    inline
+    Lanes
+    mix(Lanes a, Lanes b, Lanes ratio)
+    {
+        return plus(a, times(minus(b, a), ratio));
+    }
+
+    inline
+    void
+    normalize(Lanes& x, Lanes& y, Lanes& z, Lanes& w)
+    {
+        const Lanes length = squareRoot(plus(plus(times(x, x), times(y, y)), plus(times(z, z), times(w, w))));
+
+        x = over(x, length);
+        y = over(y, length);
+        z = over(z, length);
+        w = over(w, length);
+    }
+
+    inline
+    void
+    normalize(float* quaternion)
+    {
+        const float length = sqrtf(
+            quaternion[0] * quaternion[0] + quaternion[1] * quaternion[1]
+            + quaternion[2] * quaternion[2] + quaternion[3] * quaternion[3]
+        );
+
+        for (uint i = 0; i < 4; ++i)
+            quaternion[i] /= length;
+    }
+}
+
+Pose::Pose(uint numBones) :
+    _numBones(numBones),
+    _stride((numBones + 3) & ~3u),
+    _channels(NUM_CHANNELS * _stride, 0.0f),
+    _matrices(numBones << 4, 0.0f),
+    _decomposed(numBones, 1),
+    _weights(_stride, 0.0f)
+{
+    // identity transforms, the padding bones included
+    std::fill(channel(QW), channel(QW) + _stride, 1.0f);
+    std::fill(channel(SX), channel(SX) + 3 * _stride, 1.0f);
+}
+
+void
+Pose::decompose(const float* matrices)
+{
+    float translation[3];
+    float rotation[4];
+    float scale[3];
+
+    for (uint boneId = 0; boneId < _numBones; ++boneId)
+    {
+        const float* matrix = matrices + (boneId << 4);
+
+        _decomposed[boneId] = decomposeMatrix(matrix, translation, rotation, scale);
+
+        if (!_decomposed[boneId])
+        {
+            std::copy(matrix, matrix + 16, &_matrices[boneId << 4]);
+
+            // keeps the channels finite for the bones blended 4 at a time
+            translation[0] = translation[1] = translation[2] = 0.0f;
+            rotation[0] = rotation[1] = rotation[2] = 0.0f;
+            rotation[3] = 1.0f;
+            scale[0] = scale[1] = scale[2] = 1.0f;
+        }
+
+        for (uint i = 0; i < 3; ++i)
+        {
+            channel(Channel(TX + i))[boneId] = translation[i];
+            channel(Channel(SX + i))[boneId] = scale[i];
+        }
+        for (uint i = 0; i < 4; ++i)
+            channel(Channel(QX + i))[boneId] = rotation[i];
+    }
+}
+
+void
+Pose::compose(float* matrices) const
+{
+    float translation[3];
+    float rotation[4];
+    float scale[3];
+
+    for (uint boneId = 0; boneId < _numBones; ++boneId)
+    {
+        float* matrix = matrices + (boneId << 4);
+
+        if (!_decomposed[boneId])
+        {
+            std::copy(&_matrices[boneId << 4], &_matrices[boneId << 4] + 16, matrix);
+
+            continue;
+        }
+
+        for (uint i = 0; i < 3; ++i)
+        {
+            translation[i]  = channel(Channel(TX + i))[boneId];
+            scale[i]        = channel(Channel(SX + i))[boneId];
+        }
+        for (uint i = 0; i < 4; ++i)
+            rotation[i] = channel(Channel(QX + i))[boneId];
+
+        composeMatrix(translation, rotation, scale, matrix);
+    }
+}
+
+void
+Pose::blend(const Pose& pose, float weight, const std::vector<float>& boneMask)
+{
+    if (pose._numBones != _numBones)
+        throw std::invalid_argument("pose");
+
+    weight = std::min(1.0f, weight);
+    if (weight <= 0.0f)
+        return;
+
+    computeWeights(weight, boneMask);
+
+    // the bones that are not decomposed on both sides cannot be blended
+    for (uint boneId = 0; boneId < _numBones; ++boneId)
+        if (!_decomposed[boneId] || !pose._decomposed[boneId])
+        {
+            if (_weights[boneId] > .5f)
+                copyBone(pose, boneId);
+            _weights[boneId] = 0.0f;
+        }
+
+    const Lanes one = splat(1.0f);
+
+    for (uint boneId = 0; boneId < _stride; boneId += 4)
+    {
+        const Lanes ratio = load(&_weights[boneId]);
+
+        // translations and scales are interpolated linearly
+        for (auto c : { TX, TY, TZ, SX, SY, SZ })
+        {
+            float* output = channel(c) + boneId;
+
+            store(output, mix(load(output), load(pose.channel(c) + boneId), ratio));
+        }
+
+        // rotations along the shortest path
+        Lanes ax = load(channel(QX) + boneId);
+        Lanes ay = load(channel(QY) + boneId);
+        Lanes az = load(channel(QZ) + boneId);
+        Lanes aw = load(channel(QW) + boneId);
+        Lanes bx = load(pose.channel(QX) + boneId);
+        Lanes by = load(pose.channel(QY) + boneId);
+        Lanes bz = load(pose.channel(QZ) + boneId);
+        Lanes bw = load(pose.channel(QW) + boneId);
+
+        const Lanes sign = copySign(one, plus(plus(times(ax, bx), times(ay, by)), plus(times(az, bz), times(aw, bw))));
+
+        ax = mix(ax, times(sign, bx), ratio);
+        ay = mix(ay, times(sign, by), ratio);
+        az = mix(az, times(sign, bz), ratio);
+        aw = mix(aw, times(sign, bw), ratio);
+        normalize(ax, ay, az, aw);
+
+        store(channel(QX) + boneId, ax);
+        store(channel(QY) + boneId, ay);
+        store(channel(QZ) + boneId, az);
+        store(channel(QW) + boneId, aw);
+    }
+}
+
+void
+Pose::add(const Pose& pose, const Pose& reference, float weight, const std::vector<float>& boneMask)
+{
+    if (pose._numBones != _numBones || reference._numBones != _numBones)
+        throw std::invalid_argument("pose");
+
+    if (weight <= 0.0f)
+        return;
+
+    computeWeights(weight, boneMask);
+
+    for (uint boneId = 0; boneId < _numBones; ++boneId)
+        if (!_decomposed[boneId] || !pose._decomposed[boneId] || !reference._decomposed[boneId])
+            _weights[boneId] = 0.0f;
+
+    const Lanes one = splat(1.0f);
+
+    for (uint boneId = 0; boneId < _stride; boneId += 4)
+    {
+        const Lanes ratio = load(&_weights[boneId]);
+
+        for (uint i = 0; i < 3; ++i)
+        {
+            float* translation  = channel(Channel(TX + i)) + boneId;
+            float* scale        = channel(Channel(SX + i)) + boneId;
+
+            const Lanes deltaTranslation = minus(
+                load(pose.channel(Channel(TX + i)) + boneId),
+                load(reference.channel(Channel(TX + i)) + boneId)
+            );
+            const Lanes deltaScale = over(
+                load(pose.channel(Channel(SX + i)) + boneId),
+                load(reference.channel(Channel(SX + i)) + boneId)
+            );
+
+            store(translation, plus(load(translation), times(deltaTranslation, ratio)));
+            store(scale, times(load(scale), mix(one, deltaScale, ratio)));
+        }
+
+        // delta = pose * conjugate(reference)
+        const Lanes px = load(pose.channel(QX) + boneId);
+        const Lanes py = load(pose.channel(QY) + boneId);
+        const Lanes pz = load(pose.channel(QZ) + boneId);
+        const Lanes pw = load(pose.channel(QW) + boneId);
+        const Lanes rx = load(reference.channel(QX) + boneId);
+        const Lanes ry = load(reference.channel(QY) + boneId);
+        const Lanes rz = load(reference.channel(QZ) + boneId);
+        const Lanes rw = load(reference.channel(QW) + boneId);
+
+        Lanes dx = minus(plus(times(px, rw), times(pz, ry)), plus(times(pw, rx), times(py, rz)));
+        Lanes dy = minus(plus(times(py, rw), times(px, rz)), plus(times(pw, ry), times(pz, rx)));
+        Lanes dz = minus(plus(times(pz, rw), times(py, rx)), plus(times(pw, rz), times(px, ry)));
+        Lanes dw = plus(plus(times(pw, rw), times(px, rx)), plus(times(py, ry), times(pz, rz)));
+
+        // scaled from the identity along the shortest path
+        const Lanes sign = copySign(one, dw);
+
+        dx = times(times(sign, dx), ratio);
+        dy = times(times(sign, dy), ratio);
+        dz = times(times(sign, dz), ratio);
+        dw = mix(one, times(sign, dw), ratio);
+        normalize(dx, dy, dz, dw);
+
+        // rotation = delta * rotation
+        const Lanes ax = load(channel(QX) + boneId);
+        const Lanes ay = load(channel(QY) + boneId);
+        const Lanes az = load(channel(QZ) + boneId);
+        const Lanes aw = load(channel(QW) + boneId);
+
+        Lanes qx = minus(plus(plus(times(dw, ax), times(dx, aw)), times(dy, az)), times(dz, ay));
+        Lanes qy = plus(minus(times(dw, ay), times(dx, az)), plus(times(dy, aw), times(dz, ax)));
+        Lanes qz = minus(plus(plus(times(dw, az), times(dx, ay)), times(dz, aw)), times(dy, ax));
+        Lanes qw = minus(minus(times(dw, aw), times(dx, ax)), plus(times(dy, ay), times(dz, az)));
+        normalize(qx, qy, qz, qw);
+
+        store(channel(QX) + boneId, qx);
+        store(channel(QY) + boneId, qy);
+        store(channel(QZ) + boneId, qz);
+        store(channel(QW) + boneId, qw);
+    }
+}
+
+void
+Pose::computeWeights(float weight, const std::vector<float>& boneMask)
+{
+    if (!boneMask.empty() && boneMask.size() != _numBones)
+        throw std::invalid_argument("boneMask");
+
+    for (uint boneId = 0; boneId < _numBones; ++boneId)
+        _weights[boneId] = boneMask.empty() ? weight : weight * boneMask[boneId];
+}
+
+void
+Pose::copyBone(const Pose& pose, uint boneId)
+{
+    for (uint c = 0; c < NUM_CHANNELS; ++c)
+        channel(Channel(c))[boneId] = pose.channel(Channel(c))[boneId];
+
+    std::copy(&pose._matrices[boneId << 4], &pose._matrices[boneId << 4] + 16, &_matrices[boneId << 4]);
+    _decomposed[boneId] = pose._decomposed[boneId];
+}
+
+/*static*/
+bool
+Pose::decomposeMatrix(const float* m, float* translation, float* rotation, float* scale)
+{
+    // the columns of m are its 4 consecutive groups of 4 floats, the translation is the last one
+    if (m[3] != 0.0f || m[7] != 0.0f || m[11] != 0.0f || m[15] != 1.0f)
+        return false;
+
+    for (uint j = 0; j < 3; ++j)
+        scale[j] = sqrtf(m[4 * j] * m[4 * j] + m[4 * j + 1] * m[4 * j + 1] + m[4 * j + 2] * m[4 * j + 2]);
+
+    if (scale[0] < 1e-6f || scale[1] < 1e-6f || scale[2] < 1e-6f)
+        return false;
+
+    const float determinant = m[0] * (m[5] * m[10] - m[9] * m[6])
+        - m[4] * (m[1] * m[10] - m[9] * m[2])
+        + m[8] * (m[1] * m[6] - m[5] * m[2]);
+
+    if (determinant < 0.0f)
+        scale[0] = -scale[0];
+
+    // r(i, j) is the row i of the column j of the rotation
+    float r[3][3];
+
+    for (uint j = 0; j < 3; ++j)
+        for (uint i = 0; i < 3; ++i)
+            r[i][j] = m[4 * j + i] / scale[j];
+
+    float* q = rotation;
+    const float trace = r[0][0] + r[1][1] + r[2][2];
+
+    if (trace > 0.0f)
+    {
+        const float s = sqrtf(trace + 1.0f) * 2.0f;
+
+        q[3] = .25f * s;
+        q[0] = (r[2][1] - r[1][2]) / s;
+        q[1] = (r[0][2] - r[2][0]) / s;
+        q[2] = (r[1][0] - r[0][1]) / s;
+    }
+    else if (r[0][0] > r[1][1] && r[0][0] > r[2][2])
+    {
+        const float s = sqrtf(1.0f + r[0][0] - r[1][1] - r[2][2]) * 2.0f;
+
+        q[3] = (r[2][1] - r[1][2]) / s;
+        q[0] = .25f * s;
+        q[1] = (r[0][1] + r[1][0]) / s;
+        q[2] = (r[0][2] + r[2][0]) / s;
+    }
+    else if (r[1][1] > r[2][2])
+    {
+        const float s = sqrtf(1.0f + r[1][1] - r[0][0] - r[2][2]) * 2.0f;
+
+        q[3] = (r[0][2] - r[2][0]) / s;
+        q[0] = (r[0][1] + r[1][0]) / s;
+        q[1] = .25f * s;
+        q[2] = (r[1][2] + r[2][1]) / s;
+    }
+    else
+    {
+        const float s = sqrtf(1.0f + r[2][2] - r[0][0] - r[1][1]) * 2.0f;
+
+        q[3] = (r[1][0] - r[0][1]) / s;
+        q[0] = (r[0][2] + r[2][0]) / s;
+        q[1] = (r[1][2] + r[2][1]) / s;
+        q[2] = .25f * s;
+    }
+    normalize(q);
+
+    for (uint i = 0; i < 3; ++i)
+        translation[i] = m[12 + i];
+
+    return true;
+}
+
+/*static*/
+void
+Pose::composeMatrix(const float* translation, const float* rotation, const float* scale, float* m)
+{
+    const float x = rotation[0];
+    const float y = rotation[1];
+    const float z = rotation[2];
+    const float w = rotation[3];
+    const float sx = scale[0];
+    const float sy = scale[1];
+    const float sz = scale[2];
+
+    m[0]    = (1.0f - 2.0f * (y * y + z * z)) * sx;
+    m[1]    = 2.0f * (x * y + z * w) * sx;
+    m[2]    = 2.0f * (x * z - y * w) * sx;
+    m[3]    = 0.0f;
+    m[4]    = 2.0f * (x * y - z * w) * sy;
+    m[5]    = (1.0f - 2.0f * (x * x + z * z)) * sy;
+    m[6]    = 2.0f * (y * z + x * w) * sy;
+    m[7]    = 0.0f;
+    m[8]    = 2.0f * (x * z + y * w) * sz;
+    m[9]    = 2.0f * (y * z - x * w) * sz;
+    m[10]   = (1.0f - 2.0f * (x * x + y * y)) * sz;
+    m[11]   = 0.0f;
+    m[12]   = translation[0];
+    m[13]   = translation[1];
+    m[14]   = translation[2];
+    m[15]   = 1.0f;
+}
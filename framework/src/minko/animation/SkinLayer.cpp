@@ -0,0 +1,137 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "minko/animation/SkinLayer.hpp"
+#include "minko/animation/Pose.hpp"
+#include "minko/geometry/Skin.hpp"
+
+using namespace minko;
+using namespace minko::animation;
+
+SkinLayer::SkinLayer(SkinPtr skin, bool additive) :
+    _skin(skin),
+    _additive(additive),
+    _weight(1.0f),
+    _boneMask(),
+    _time(0),
+    _isFading(false),
+    _fadeStartWeight(0.0f),
+    _fadeEndWeight(0.0f),
+    _fadeDuration(0),
+    _fadeTime(0),
+    _removeAfterFade(false),
+    _pose(nullptr),
+    _poseFrameId(uint(-1)),
+    _reference(nullptr)
+{
+    if (skin == nullptr)
+        throw std::invalid_argument("skin");
+}
+
+SkinLayer::Ptr
+SkinLayer::boneMask(const std::vector<float>& value)
+{
+    if (!value.empty() && value.size() != _skin->numBones())
+        throw std::invalid_argument("value");
+
+    _boneMask = value;
+
+    return shared_from_this();
+}
+
+SkinLayer::Ptr
+SkinLayer::seek(uint time)
+{
+    _time = _skin->duration() > 0 ? time % _skin->duration() : 0;
+
+    return shared_from_this();
+}
+
+SkinLayer::Ptr
+SkinLayer::fade(float value, uint duration, bool removeAfterFade)
+{
+    _isFading           = true;
+    _fadeStartWeight    = _weight;
+    _fadeEndWeight      = value;
+    _fadeDuration       = duration;
+    _fadeTime           = 0;
+    _removeAfterFade    = removeAfterFade;
+
+    if (duration == 0)
+        _weight = value;
+
+    return shared_from_this();
+}
+
+bool
+SkinLayer::advance(uint deltaTime)
+{
+    seek(_time + deltaTime);
+
+    if (!_isFading)
+        return true;
+
+    _fadeTime = std::min(_fadeTime + deltaTime, _fadeDuration);
+    _weight = _fadeTime < _fadeDuration
+        ? _fadeStartWeight + (_fadeEndWeight - _fadeStartWeight) * float(_fadeTime) / float(_fadeDuration)
+        : _fadeEndWeight;
+
+    if (_fadeTime < _fadeDuration)
+        return true;
+
+    _isFading = false;
+
+    return !_removeAfterFade;
+}
+
+uint
+SkinLayer::frameId() const
+{
+    return _skin->getFrameId(_time);
+}
+
+const Pose&
+SkinLayer::pose()
+{
+    const uint currentFrameId = frameId();
+
+    if (_pose == nullptr)
+        _pose = Pose::create(_skin->numBones());
+
+    if (currentFrameId != _poseFrameId)
+    {
+        _pose->decompose(_skin->matrices(currentFrameId).data());
+        _poseFrameId = currentFrameId;
+    }
+
+    return *_pose;
+}
+
+const Pose&
+SkinLayer::reference()
+{
+    if (_reference == nullptr)
+    {
+        _reference = Pose::create(_skin->numBones());
+        _reference->decompose(_skin->matrices(0).data());
+    }
+
+    return *_reference;
+}
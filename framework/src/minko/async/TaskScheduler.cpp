@@ -0,0 +1,355 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "minko/async/TaskScheduler.hpp"
+
+using namespace minko;
+using namespace minko::async;
+
+namespace
+{
+    // the scheduler and the queue of the current thread when it belongs to a scheduler
+    thread_local TaskScheduler* currentScheduler    = nullptr;
+    thread_local uint           currentThreadId     = 0;
+}
+
+struct TaskScheduler::ParallelFor
+{
+    uint                    begin;
+    uint                    end;
+    uint                    grainSize;
+    uint                    numChunks;
+    RangeFunction           f;
+    std::atomic<uint>       nextChunk;
+    std::atomic<uint>       numProcessedChunks;
+    std::mutex              exceptionMutex;
+    std::exception_ptr      exception;
+
+    void
+    processChunks()
+    {
+        for (auto chunk = nextChunk++; chunk < numChunks; chunk = nextChunk++)
+        {
+            auto chunkBegin = begin + chunk * grainSize;
+
+            try
+            {
+                f(chunkBegin, std::min(chunkBegin + grainSize, end));
+            }
+            catch (...)
+            {
+                std::lock_guard<std::mutex> lock(exceptionMutex);
+
+                if (!exception)
+                    exception = std::current_exception();
+            }
+
+            ++numProcessedChunks;
+        }
+    }
+};
+
+/*static*/ TaskScheduler::Ptr TaskScheduler::_defaultScheduler = nullptr;
+/*static*/ const uint TaskScheduler::MAX_NUM_BLOCKING_THREADS = 8;
+
+TaskScheduler::TaskScheduler(uint numThreads) :
+    _nextQueue(0),
+    _numPendingTasks(0),
+    _done(false),
+    _numIdleBlockingThreads(0),
+    _blockingDone(false)
+{
+#if MINKO_PLATFORM == MINKO_PLATFORM_HTML5
+    numThreads = 0;
+#endif
+
+    for (uint threadId = 0; threadId < numThreads; ++threadId)
+        _queues.push_back(std::unique_ptr<TaskQueue>(new TaskQueue()));
+    for (uint threadId = 0; threadId < numThreads; ++threadId)
+        _threads.push_back(std::thread(&TaskScheduler::run, this, threadId));
+}
+
+TaskScheduler::~TaskScheduler()
+{
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+
+        _done = true;
+    }
+    _taskAvailable.notify_all();
+
+    {
+        std::lock_guard<std::mutex> lock(_blockingMutex);
+
+        _blockingDone = true;
+    }
+    _blockingTaskAvailable.notify_all();
+
+    // the pending tasks are executed before the threads exit
+    for (auto& thread : _threads)
+        thread.join();
+    for (auto& thread : _blockingThreads)
+        thread.join();
+}
+
+/*static*/
+TaskScheduler::Ptr
+TaskScheduler::defaultScheduler()
+{
+    static std::mutex mutex;
+
+    std::lock_guard<std::mutex> lock(mutex);
+
+    if (_defaultScheduler == nullptr)
+        _defaultScheduler = create();
+
+    return _defaultScheduler;
+}
+
+/*static*/
+void
+TaskScheduler::defaultScheduler(Ptr scheduler)
+{
+    _defaultScheduler = scheduler;
+}
+
+/*static*/
+uint
+TaskScheduler::defaultNumThreads()
+{
+#if MINKO_PLATFORM == MINKO_PLATFORM_HTML5
+    return 0;
+#else
+    return std::max(std::thread::hardware_concurrency(), 2u) - 1;
+#endif
+}
+
+void
+TaskScheduler::schedule(Task task)
+{
+    if (_threads.empty())
+    {
+        task();
+
+        return;
+    }
+
+    auto queueId = currentScheduler == this
+        ? currentThreadId
+        : _nextQueue++ % _queues.size();
+    auto& queue = *_queues[queueId];
+
+    {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        queue.tasks.push_back(std::move(task));
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+
+        ++_numPendingTasks;
+    }
+    _taskAvailable.notify_one();
+}
+
+void
+TaskScheduler::scheduleBlocking(Task task)
+{
+#if MINKO_PLATFORM == MINKO_PLATFORM_HTML5
+    task();
+#else
+    {
+        std::lock_guard<std::mutex> lock(_blockingMutex);
+
+        _blockingTasks.push_back(std::move(task));
+
+        // the idle threads already have a task each
+        if (_blockingTasks.size() > _numIdleBlockingThreads && _blockingThreads.size() < MAX_NUM_BLOCKING_THREADS)
+        {
+            _blockingThreads.push_back(std::thread(&TaskScheduler::runBlocking, this));
+
+            return;
+        }
+    }
+    _blockingTaskAvailable.notify_one();
+#endif
+}
+
+uint
+TaskScheduler::numBlockingThreads()
+{
+    std::lock_guard<std::mutex> lock(_blockingMutex);
+
+    return _blockingThreads.size();
+}
+
+void
+TaskScheduler::parallelFor(uint begin, uint end, const RangeFunction& f, uint grainSize)
+{
+    if (end <= begin)
+        return;
+
+    grainSize = std::max(grainSize, 1u);
+
+    auto numChunks = (end - begin + grainSize - 1) / grainSize;
+
+    if (numChunks == 1 || _threads.empty())
+    {
+        f(begin, end);
+
+        return;
+    }
+
+    // the helper tasks might only start once the call returned: they share the state
+    auto state = std::make_shared<ParallelFor>();
+
+    state->begin = begin;
+    state->end = end;
+    state->grainSize = grainSize;
+    state->numChunks = numChunks;
+    state->f = f;
+    state->nextChunk = 0;
+    state->numProcessedChunks = 0;
+
+    auto numHelpers = std::min<uint>(_threads.size(), numChunks - 1);
+
+    for (uint i = 0; i < numHelpers; ++i)
+        schedule([state]() { state->processChunks(); });
+
+    state->processChunks();
+
+    // every chunk has been picked up: wait for the ones still processed by other threads
+    while (state->numProcessedChunks.load() < numChunks)
+        std::this_thread::yield();
+
+    if (state->exception)
+        std::rethrow_exception(state->exception);
+}
+
+void
+TaskScheduler::postToMainThread(Task task)
+{
+    std::lock_guard<std::mutex> lock(_mainThreadMutex);
+
+    _mainThreadTasks.push_back(std::move(task));
+}
+
+uint
+TaskScheduler::pollMainThread()
+{
+    std::vector<Task> tasks;
+
+    {
+        std::lock_guard<std::mutex> lock(_mainThreadMutex);
+
+        tasks.swap(_mainThreadTasks);
+    }
+
+    // tasks posted meanwhile wait for the next poll
+    for (auto& task : tasks)
+        task();
+
+    return tasks.size();
+}
+
+void
+TaskScheduler::run(uint threadId)
+{
+    currentScheduler = this;
+    currentThreadId = threadId;
+
+    Task task;
+
+    while (true)
+    {
+        if (popTask(threadId, task))
+        {
+            task();
+            task = nullptr;
+
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+
+        _taskAvailable.wait(lock, [&]() { return _done || _numPendingTasks.load() != 0; });
+
+        if (_done && _numPendingTasks.load() == 0)
+            return;
+    }
+}
+
+bool
+TaskScheduler::popTask(uint threadId, Task& task)
+{
+    auto numQueues = _queues.size();
+
+    for (uint i = 0; i < numQueues; ++i)
+    {
+        auto& queue = *_queues[(threadId + i) % numQueues];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+
+        if (queue.tasks.empty())
+            continue;
+
+        // the own queue is processed from the most recent task, the stolen tasks are the oldest ones
+        if (i == 0)
+        {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        }
+        else
+        {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+
+        --_numPendingTasks;
+
+        return true;
+    }
+
+    return false;
+}
+
+void
+TaskScheduler::runBlocking()
+{
+    std::unique_lock<std::mutex> lock(_blockingMutex);
+
+    while (true)
+    {
+        ++_numIdleBlockingThreads;
+        _blockingTaskAvailable.wait(lock, [&]() { return _blockingDone || !_blockingTasks.empty(); });
+        --_numIdleBlockingThreads;
+
+        if (_blockingTasks.empty())
+            return;
+
+        auto task = std::move(_blockingTasks.front());
+
+        _blockingTasks.pop_front();
+        lock.unlock();
+        task();
+        task = nullptr;
+        lock.lock();
+    }
+}
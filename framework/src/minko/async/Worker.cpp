@@ -43,7 +43,7 @@ Worker::start(const std::vector<char>& input)
 void
 Worker::post(Message message)
 {
-    _impl->post(message);
+    _impl->post(std::move(message));
 }
 
 void
@@ -43,6 +43,8 @@ AbstractAnimation::AbstractAnimation(bool isLooping):
 	_isLooping(isLooping),
 	_isReversed(false),
 	_mustUpdateOnce(false),
+	_updateInterval(1),
+	_framesSinceUpdate(0),
 	_clockStart(clock()),
 	_timeFunction(),
 	_labels(),
@@ -78,6 +80,8 @@ AbstractAnimation::AbstractAnimation(const AbstractAnimation& absAnimation, cons
 	_isLooping(absAnimation._isLooping),
 	_isReversed(absAnimation._isReversed),
 	_mustUpdateOnce(absAnimation._mustUpdateOnce),
+	_updateInterval(absAnimation._updateInterval),
+	_framesSinceUpdate(0),
 	_clockStart(clock()),
 	_timeFunction(),
 	_labels(),
@@ -200,13 +204,14 @@ AbstractAnimation::setSceneManager(SceneManager::Ptr sceneManager)
 {
 	if (sceneManager && sceneManager != _sceneManager)
 	{
+		// before the scripts, so that they read the animated values of the current frame
 		_frameBeginSlot = sceneManager->frameBegin()->connect(std::bind(
 			&AbstractAnimation::frameBeginHandler, 
 			std::dynamic_pointer_cast<AbstractAnimation>(shared_from_this()),
 			std::placeholders::_1,
             std::placeholders::_2,
             std::placeholders::_3
-		));
+		), 100.f);
 
 		if (_sceneManager == nullptr)
 			_previousGlobalTime = _timeFunction(uint(sceneManager->time()));
@@ -533,9 +538,30 @@ AbstractAnimation::isInPlaybackWindow(uint time) const
 void
 AbstractAnimation::frameBeginHandler(SceneManager::Ptr sceneManager, float time, float)
 {
+	// the time elapsed during the skipped frames is caught up on the next update
+	if (_isPlaying && !_mustUpdateOnce && ++_framesSinceUpdate < _updateInterval)
+		return;
+
+	_framesSinceUpdate = 0;
 	update(uint(time));
 }
 
+AbstractAnimation::Ptr
+AbstractAnimation::updateInterval(uint value)
+{
+	if (value == 0)
+		throw std::invalid_argument("value");
+
+	if (value != _updateInterval)
+	{
+		_updateInterval = value;
+		// spreads the updates of the instances sharing the same interval over the frames
+		_framesSinceUpdate = uint(reinterpret_cast<std::uintptr_t>(this) >> 4) % value;
+	}
+
+	return std::dynamic_pointer_cast<AbstractAnimation>(shared_from_this());
+}
+
 /*virtual*/
 bool
 AbstractAnimation::update(uint rawGlobalTime)
@@ -22,6 +22,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/animation/AbstractTimeline.hpp"
 #include "minko/animation/Matrix4x4Timeline.hpp"
 #include "minko/scene/Node.hpp"
+#include "minko/data/Container.hpp"
+#include "minko/math/Matrix4x4.hpp"
 
 using namespace minko;
 using namespace minko::component;
@@ -30,14 +32,31 @@ using namespace minko::animation;
 Animation::Animation(const std::vector<AbstractTimeline::Ptr>& timelines,
                      bool isLooping):
     AbstractAnimation(isLooping),
-    _timelines(timelines)
+    _timelines(timelines),
+    _matrixBindings(),
+    _unboundTimelines(),
+    _invalidBindings(true),
+    _bindingsTargetAddedSlot(nullptr),
+    _bindingsTargetRemovedSlot(nullptr),
+    _componentSlots(),
+    _rootAnimation(nullptr),
+    _queued(false)
 {
 }
 
 Animation::Animation(const Animation& anim, const CloneOption& option) :
-    AbstractAnimation(anim),
-    _timelines(anim._timelines.size())
+    AbstractAnimation(anim, option),
+    _timelines(anim._timelines.size()),
+    _matrixBindings(),
+    _unboundTimelines(),
+    _invalidBindings(true),
+    _bindingsTargetAddedSlot(nullptr),
+    _bindingsTargetRemovedSlot(nullptr),
+    _componentSlots(),
+    _rootAnimation(nullptr),
+    _queued(false)
 {
+    // the clones of the timelines share their keys with the original ones
     for (std::size_t i = 0; i < anim._timelines.size(); i++)
     {
         auto var = anim._timelines[i]->clone();
@@ -60,6 +79,20 @@ Animation::initialize()
 {
     AbstractAnimation::initialize();
 
+    _bindingsTargetAddedSlot = targetAdded()->connect(std::bind(
+        &Animation::bindingsTargetAddedHandler,
+        std::dynamic_pointer_cast<Animation>(shared_from_this()),
+        std::placeholders::_1,
+        std::placeholders::_2
+    ));
+
+    _bindingsTargetRemovedSlot = targetRemoved()->connect(std::bind(
+        &Animation::bindingsTargetRemovedHandler,
+        std::dynamic_pointer_cast<Animation>(shared_from_this()),
+        std::placeholders::_1,
+        std::placeholders::_2
+    ));
+
     _maxTime = 0;
 
     for (auto& timeline : _timelines)
@@ -71,17 +104,136 @@ Animation::initialize()
 void
 Animation::update()
 {
+    if (_invalidBindings)
+        bind();
+
+    if (_rootAnimation != nullptr && _rootAnimation->inFrame())
+    {
+        // evaluated along with all the other animations of the scene once they have all been updated
+        if (!_queued)
+        {
+            _queued = true;
+            _rootAnimation->queue(std::dynamic_pointer_cast<Animation>(shared_from_this()));
+        }
+    }
+    else
+        evaluate();
+}
+
+void
+Animation::evaluate()
+{
+    _queued = false;
+
+    for (auto& binding : _matrixBindings)
+        binding.timeline->update(
+            _currentTime % (binding.timeline->duration() + 1), // Warning: bounds!
+            binding.matrix
+        );
+
+    for (auto& timelineAndTarget : _unboundTimelines)
+    {
+        auto& timeline = timelineAndTarget.first;
+
+        timeline->update(_currentTime % (timeline->duration() + 1), timelineAndTarget.second->data());
+    }
+}
+
+void
+Animation::bind()
+{
+    _matrixBindings.clear();
+    _unboundTimelines.clear();
+
     for (auto& target : targets())
     {
-        auto container = target->data();
+        auto data = target->data();
 
         for (auto& timeline : _timelines)
         {
-            const uint currentTime = _currentTime % (timeline->duration() + 1); // Warning: bounds!
+            auto matrixTimeline = std::dynamic_pointer_cast<Matrix4x4Timeline>(timeline);
 
-            timeline->update(currentTime, target->data());
+            if (matrixTimeline == nullptr)
+                _unboundTimelines.push_back(std::make_pair(timeline, target));
+            else if (data->hasProperty(matrixTimeline->propertyName()))
+            {
+                auto matrix = data->get<math::Matrix4x4::Ptr>(matrixTimeline->propertyName());
+
+                if (matrix != nullptr)
+                    _matrixBindings.push_back({ matrixTimeline, matrix });
+            }
         }
     }
+
+    _invalidBindings = false;
+}
+
+void
+Animation::bindingsTargetAddedHandler(AbstractComponent::Ptr    cmp,
+                                      NodePtr                   target)
+{
+    // the bound matrices are provided by the components of the target
+    auto invalidate = [=](NodePtr, NodePtr, AbstractComponent::Ptr)
+    {
+        _invalidBindings = true;
+    };
+
+    auto& slots = _componentSlots[target];
+
+    slots.push_back(target->componentAdded()->connect(invalidate));
+    slots.push_back(target->componentRemoved()->connect(invalidate));
+
+    _invalidBindings = true;
+
+    updateRootAnimation();
+}
+
+void
+Animation::bindingsTargetRemovedHandler(AbstractComponent::Ptr cmp,
+                                        NodePtr                target)
+{
+    _componentSlots.erase(target);
+    _invalidBindings = true;
+
+    updateRootAnimation();
+}
+
+/*virtual*/
+void
+Animation::addedHandler(NodePtr node, NodePtr target, NodePtr parent)
+{
+    AbstractAnimation::addedHandler(node, target, parent);
+
+    updateRootAnimation();
+}
+
+/*virtual*/
+void
+Animation::removedHandler(NodePtr node, NodePtr target, NodePtr parent)
+{
+    AbstractAnimation::removedHandler(node, target, parent);
+
+    updateRootAnimation();
+}
+
+void
+Animation::updateRootAnimation()
+{
+    auto manager = sceneManager();
+
+    if (manager == nullptr || manager->targets().empty())
+    {
+        _rootAnimation = nullptr;
+
+        return;
+    }
+
+    auto root = manager->targets()[0];
+
+    if (!root->hasComponent<RootAnimation>())
+        root->addComponent(RootAnimation::create());
+
+    _rootAnimation = root->component<RootAnimation>();
 }
 
 void
@@ -89,3 +241,99 @@ Animation::rebindDependencies(std::map<AbstractComponent::Ptr, AbstractComponent
 {
     // FIXME: Implement when animation clones are tested (without skinning).
 }
+
+Animation::RootAnimation::RootAnimation() :
+    AbstractComponent(),
+    _queue(),
+    _inFrame(false),
+    _targetAddedSlot(nullptr),
+    _targetRemovedSlot(nullptr),
+    _frameStartSlot(nullptr),
+    _frameEndSlot(nullptr)
+{
+}
+
+AbstractComponent::Ptr
+Animation::RootAnimation::clone(const CloneOption& option)
+{
+    return Animation::RootAnimation::create();
+}
+
+void
+Animation::RootAnimation::initialize()
+{
+    _targetAddedSlot = targetAdded()->connect(std::bind(
+        &Animation::RootAnimation::targetAddedHandler,
+        std::static_pointer_cast<RootAnimation>(shared_from_this()),
+        std::placeholders::_1,
+        std::placeholders::_2
+    ));
+
+    _targetRemovedSlot = targetRemoved()->connect(std::bind(
+        &Animation::RootAnimation::targetRemovedHandler,
+        std::static_pointer_cast<RootAnimation>(shared_from_this()),
+        std::placeholders::_1,
+        std::placeholders::_2
+    ));
+}
+
+void
+Animation::RootAnimation::targetAddedHandler(AbstractComponent::Ptr ctrl,
+                                             NodePtr                target)
+{
+    auto sceneManager = target->component<SceneManager>();
+
+    if (sceneManager == nullptr)
+        return;
+
+    // surrounds the frameBegin handlers of all the animations of the scene (100), and evaluates them
+    // before the ones of the scripts (0)
+    _frameStartSlot = sceneManager->frameBegin()->connect(std::bind(
+        &Animation::RootAnimation::frameStartHandler,
+        std::static_pointer_cast<RootAnimation>(shared_from_this()),
+        std::placeholders::_1,
+        std::placeholders::_2,
+        std::placeholders::_3
+    ), 1000.f);
+
+    _frameEndSlot = sceneManager->frameBegin()->connect(std::bind(
+        &Animation::RootAnimation::frameEndHandler,
+        std::static_pointer_cast<RootAnimation>(shared_from_this()),
+        std::placeholders::_1,
+        std::placeholders::_2,
+        std::placeholders::_3
+    ), 50.f);
+}
+
+void
+Animation::RootAnimation::targetRemovedHandler(AbstractComponent::Ptr   ctrl,
+                                               NodePtr                  target)
+{
+    evaluate();
+
+    _frameStartSlot = nullptr;
+    _frameEndSlot = nullptr;
+}
+
+void
+Animation::RootAnimation::frameStartHandler(SceneManagerPtr sceneManager, float time, float deltaTime)
+{
+    _inFrame = true;
+}
+
+void
+Animation::RootAnimation::frameEndHandler(SceneManagerPtr sceneManager, float time, float deltaTime)
+{
+    evaluate();
+}
+
+void
+Animation::RootAnimation::evaluate()
+{
+    _inFrame = false;
+
+    for (auto& animation : _queue)
+        animation->evaluate();
+
+    _queue.clear();
+}
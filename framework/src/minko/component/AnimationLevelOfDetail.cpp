@@ -0,0 +1,287 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "minko/component/AnimationLevelOfDetail.hpp"
+
+#include "minko/scene/Node.hpp"
+#include "minko/scene/NodeSet.hpp"
+#include "minko/component/AbstractAnimation.hpp"
+#include "minko/component/BoundingBox.hpp"
+#include "minko/component/PerspectiveCamera.hpp"
+#include "minko/component/SceneManager.hpp"
+#include "minko/component/Skinning.hpp"
+#include "minko/math/Box.hpp"
+#include "minko/math/Vector3.hpp"
+
+using namespace minko;
+using namespace minko::component;
+
+/*static*/ const std::vector<AnimationLevelOfDetail::Level> AnimationLevelOfDetail::DEFAULT_LEVELS = {
+    Level(.25f, 1, 0),
+    Level(.1f,  2, 4),
+    Level(.03f, 4, 2),
+    Level(0.f,  8, 1)
+};
+
+AnimationLevelOfDetail::AnimationLevelOfDetail(NodePtr camera, const std::vector<Level>& levels) :
+    AbstractComponent(),
+    _camera(camera),
+    _levels(levels),
+    _instances(),
+    _invalidInstances(true),
+    _targetAddedSlot(nullptr),
+    _targetRemovedSlot(nullptr),
+    _addedSlot(nullptr),
+    _removedSlot(nullptr),
+    _componentAddedSlot(nullptr),
+    _componentRemovedSlot(nullptr),
+    _frameBeginSlot(nullptr)
+{
+    if (camera == nullptr || !camera->hasComponent<PerspectiveCamera>())
+        throw std::invalid_argument("camera");
+
+    if (levels.empty())
+        throw std::invalid_argument("levels");
+
+    for (const auto& level : levels)
+        if (level.updateInterval == 0)
+            throw std::invalid_argument("levels");
+
+    std::stable_sort(_levels.begin(), _levels.end(), [](const Level& a, const Level& b)
+    {
+        return a.minScreenSize > b.minScreenSize;
+    });
+}
+
+void
+AnimationLevelOfDetail::initialize()
+{
+    _targetAddedSlot = targetAdded()->connect(std::bind(
+        &AnimationLevelOfDetail::targetAddedHandler,
+        std::static_pointer_cast<AnimationLevelOfDetail>(shared_from_this()),
+        std::placeholders::_1,
+        std::placeholders::_2
+    ));
+
+    _targetRemovedSlot = targetRemoved()->connect(std::bind(
+        &AnimationLevelOfDetail::targetRemovedHandler,
+        std::static_pointer_cast<AnimationLevelOfDetail>(shared_from_this()),
+        std::placeholders::_1,
+        std::placeholders::_2
+    ));
+}
+
+uint
+AnimationLevelOfDetail::level(AbstractAnimationPtr animation) const
+{
+    for (const auto& instance : _instances)
+        if (instance.animation == animation)
+            return instance.level;
+
+    throw std::invalid_argument("animation");
+}
+
+void
+AnimationLevelOfDetail::targetAddedHandler(AbstractComponent::Ptr ctrl, NodePtr target)
+{
+    if (target->components<AnimationLevelOfDetail>().size() > 1)
+        throw std::logic_error("The same node cannot have more than one AnimationLevelOfDetail.");
+
+    _addedSlot = target->added()->connect(std::bind(
+        &AnimationLevelOfDetail::addedHandler,
+        std::static_pointer_cast<AnimationLevelOfDetail>(shared_from_this()),
+        std::placeholders::_1,
+        std::placeholders::_2,
+        std::placeholders::_3
+    ));
+
+    _removedSlot = target->removed()->connect([=](NodePtr, NodePtr, NodePtr)
+    {
+        _invalidInstances = true;
+    });
+
+    _componentAddedSlot = target->componentAdded()->connect([=](NodePtr, NodePtr, AbstractComponent::Ptr)
+    {
+        _invalidInstances = true;
+    });
+
+    _componentRemovedSlot = target->componentRemoved()->connect([=](NodePtr, NodePtr, AbstractComponent::Ptr)
+    {
+        _invalidInstances = true;
+    });
+
+    addedHandler(nullptr, target, nullptr);
+}
+
+void
+AnimationLevelOfDetail::targetRemovedHandler(AbstractComponent::Ptr ctrl, NodePtr target)
+{
+    // the animations left behind go back to full detail
+    for (auto& instance : _instances)
+        applyLevel(instance, 0);
+
+    _instances.clear();
+    _invalidInstances = true;
+
+    _addedSlot = nullptr;
+    _removedSlot = nullptr;
+    _componentAddedSlot = nullptr;
+    _componentRemovedSlot = nullptr;
+    _frameBeginSlot = nullptr;
+}
+
+void
+AnimationLevelOfDetail::addedHandler(NodePtr node, NodePtr target, NodePtr ancestor)
+{
+    _invalidInstances = true;
+
+    // before the animations, so that their update interval is known when they are updated
+    if (_frameBeginSlot == nullptr && targets()[0]->root()->hasComponent<SceneManager>())
+        _frameBeginSlot = targets()[0]->root()->component<SceneManager>()->frameBegin()->connect(std::bind(
+            &AnimationLevelOfDetail::frameBeginHandler,
+            std::static_pointer_cast<AnimationLevelOfDetail>(shared_from_this()),
+            std::placeholders::_1,
+            std::placeholders::_2,
+            std::placeholders::_3
+        ), 500.f);
+}
+
+void
+AnimationLevelOfDetail::frameBeginHandler(SceneManagerPtr sceneManager, float time, float deltaTime)
+{
+    update();
+}
+
+void
+AnimationLevelOfDetail::update()
+{
+    if (targets().empty())
+        return;
+
+    if (_invalidInstances)
+        collectInstances();
+
+    for (auto& instance : _instances)
+    {
+        uint level = 0;
+
+        if (instance.box != nullptr)
+        {
+            const float size = screenSize(instance.box);
+
+            while (level + 1 < _levels.size() && size < _levels[level].minScreenSize)
+                ++level;
+        }
+
+        applyLevel(instance, level);
+    }
+}
+
+void
+AnimationLevelOfDetail::collectInstances()
+{
+    _invalidInstances = false;
+
+    auto nodes = scene::NodeSet::create(targets()[0])->descendants(true);
+    std::vector<Instance> instances;
+
+    for (const auto& node : nodes->nodes())
+    {
+        auto animations = node->components<AbstractAnimation>();
+
+        if (animations.empty())
+            continue;
+
+        // the nearest bounding box, on the node or below it
+        BoundingBoxPtr box = node->component<BoundingBox>();
+
+        if (box == nullptr)
+        {
+            auto boxNodes = scene::NodeSet::create(node)->descendants(false)->where([](NodePtr descendant)
+            {
+                return descendant->hasComponent<BoundingBox>();
+            });
+
+            if (!boxNodes->nodes().empty())
+                box = boxNodes->nodes().front()->component<BoundingBox>();
+        }
+
+        for (const auto& animation : animations)
+        {
+            Instance instance = { animation, box, 0 };
+
+            for (const auto& previous : _instances)
+                if (previous.animation == animation)
+                    instance.level = previous.level;
+
+            instances.push_back(instance);
+        }
+    }
+
+    // the animations that left the target go back to full detail
+    for (auto& previous : _instances)
+        if (std::none_of(instances.begin(), instances.end(), [&](const Instance& instance)
+            {
+                return instance.animation == previous.animation;
+            }))
+            applyLevel(previous, 0);
+
+    _instances.swap(instances);
+}
+
+void
+AnimationLevelOfDetail::applyLevel(Instance& instance, uint level)
+{
+    const auto& lod = _levels[level];
+
+    instance.level = level;
+    instance.animation->updateInterval(lod.updateInterval);
+
+    auto skinning = std::dynamic_pointer_cast<Skinning>(instance.animation);
+
+    if (skinning != nullptr)
+        skinning->maxNumVertexBones(lod.maxNumVertexBones);
+}
+
+float
+AnimationLevelOfDetail::screenSize(BoundingBoxPtr box) const
+{
+    auto camera         = _camera->component<PerspectiveCamera>();
+    auto worldBox       = box->box();
+    auto topRight       = worldBox->topRight();
+    auto bottomLeft     = worldBox->bottomLeft();
+    auto eye            = camera->position();
+
+    const float radius  = .5f * sqrtf(
+        (topRight->x() - bottomLeft->x()) * (topRight->x() - bottomLeft->x())
+        + (topRight->y() - bottomLeft->y()) * (topRight->y() - bottomLeft->y())
+        + (topRight->z() - bottomLeft->z()) * (topRight->z() - bottomLeft->z())
+    );
+    const float dx      = .5f * (topRight->x() + bottomLeft->x()) - eye->x();
+    const float dy      = .5f * (topRight->y() + bottomLeft->y()) - eye->y();
+    const float dz      = .5f * (topRight->z() + bottomLeft->z()) - eye->z();
+    const float distance = sqrtf(dx * dx + dy * dy + dz * dz);
+
+    if (distance <= radius)
+        return std::numeric_limits<float>::max();
+
+    // the radius of the bounding sphere compared to half the height of the frustum at its distance
+    return radius / (distance * tanf(camera->fieldOfView() * .5f));
+}
@@ -0,0 +1,610 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/component/Batching.hpp"
+
+#include "minko/scene/Node.hpp"
+#include "minko/scene/NodeSet.hpp"
+#include "minko/component/SceneManager.hpp"
+#include "minko/component/Surface.hpp"
+#include "minko/component/Transform.hpp"
+#include "minko/data/Container.hpp"
+#include "minko/geometry/Geometry.hpp"
+#include "minko/material/Material.hpp"
+#include "minko/math/Matrix4x4.hpp"
+#include "minko/render/Effect.hpp"
+#include "minko/render/IndexBuffer.hpp"
+#include "minko/render/VertexBuffer.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::math;
+
+/*static*/ const uint Batching::MIN_NUM_SURFACES  = 2;
+// indices are stored as unsigned shorts
+/*static*/ const uint Batching::MAX_NUM_VERTICES  = 65536;
+
+Batching::Batching() :
+    AbstractComponent(),
+    _buckets(),
+    _surfaceToKey(),
+    _surfaceToBatch(),
+    _surfaceToTransformChangedSlot(),
+    _surfaceToVisibilityChangedSlot(),
+    _movedSurfaces(),
+    _hiddenSurfaces(),
+    _batchNodes(),
+    _invalidSurfaces(true),
+    _numRebuilds(0),
+    _numUpdates(0),
+    _targetAddedSlot(nullptr),
+    _targetRemovedSlot(nullptr),
+    _addedSlot(nullptr),
+    _removedSlot(nullptr),
+    _componentAddedSlot(nullptr),
+    _componentRemovedSlot(nullptr),
+    _layoutsChangedSlot(nullptr),
+    _renderingBeginSlot(nullptr)
+{
+}
+
+void
+Batching::initialize()
+{
+    _targetAddedSlot = targetAdded()->connect(std::bind(
+        &Batching::targetAddedHandler,
+        std::static_pointer_cast<Batching>(shared_from_this()),
+        std::placeholders::_1,
+        std::placeholders::_2
+    ));
+
+    _targetRemovedSlot = targetRemoved()->connect(std::bind(
+        &Batching::targetRemovedHandler,
+        std::static_pointer_cast<Batching>(shared_from_this()),
+        std::placeholders::_1,
+        std::placeholders::_2
+    ));
+}
+
+uint
+Batching::numBatches() const
+{
+    uint numBatches = 0;
+
+    for (const auto& keyAndBucket : _buckets)
+        numBatches += keyAndBucket.second.batches.size();
+
+    return numBatches;
+}
+
+uint
+Batching::numSavedDrawCalls() const
+{
+    uint numSavedDrawCalls = 0;
+
+    for (const auto& keyAndBucket : _buckets)
+        for (const auto& batch : keyAndBucket.second.batches)
+        {
+            const auto& surface = batch.surfaces.front();
+
+            numSavedDrawCalls += (batch.surfaces.size() - 1) * surface->effect()->technique(surface->technique()).size();
+        }
+
+    return numSavedDrawCalls;
+}
+
+void
+Batching::targetAddedHandler(AbstractComponent::Ptr ctrl, NodePtr target)
+{
+    if (target->components<Batching>().size() > 1)
+        throw std::logic_error("The same node cannot have more than one Batching.");
+
+    _addedSlot = target->added()->connect(std::bind(
+        &Batching::addedHandler,
+        std::static_pointer_cast<Batching>(shared_from_this()),
+        std::placeholders::_1,
+        std::placeholders::_2,
+        std::placeholders::_3
+    ));
+
+    _removedSlot = target->removed()->connect([=](NodePtr, NodePtr, NodePtr)
+    {
+        _invalidSurfaces = true;
+    });
+
+    _componentAddedSlot = target->componentAdded()->connect([=](NodePtr node, NodePtr componentTarget, AbstractComponent::Ptr component)
+    {
+        // a surface that was not moving before starts following its new transform
+        if (std::dynamic_pointer_cast<Transform>(component) != nullptr)
+            for (const auto& surface : componentTarget->components<Surface>())
+                if (_surfaceToKey.count(surface) != 0)
+                    _movedSurfaces.insert(surface);
+
+        addedHandler(node, componentTarget, nullptr);
+    });
+
+    _componentRemovedSlot = target->componentRemoved()->connect([=](NodePtr, NodePtr, AbstractComponent::Ptr)
+    {
+        _invalidSurfaces = true;
+    });
+
+    _layoutsChangedSlot = target->layoutsChanged()->connect([=](NodePtr, NodePtr)
+    {
+        _invalidSurfaces = true;
+    });
+
+    addedHandler(nullptr, target, nullptr);
+}
+
+void
+Batching::targetRemovedHandler(AbstractComponent::Ptr ctrl, NodePtr target)
+{
+    for (auto& keyAndBucket : _buckets)
+        removeBatches(keyAndBucket.second);
+
+    for (const auto& surfaceAndKey : _surfaceToKey)
+        surfaceAndKey.first->batched(false);
+
+    _buckets.clear();
+    _surfaceToKey.clear();
+    _surfaceToBatch.clear();
+    _surfaceToTransformChangedSlot.clear();
+    _surfaceToVisibilityChangedSlot.clear();
+    _movedSurfaces.clear();
+    _hiddenSurfaces.clear();
+    _invalidSurfaces = true;
+
+    _addedSlot = nullptr;
+    _removedSlot = nullptr;
+    _componentAddedSlot = nullptr;
+    _componentRemovedSlot = nullptr;
+    _layoutsChangedSlot = nullptr;
+    _renderingBeginSlot = nullptr;
+}
+
+void
+Batching::addedHandler(NodePtr node, NodePtr target, NodePtr ancestor)
+{
+    _invalidSurfaces = true;
+
+    if (_renderingBeginSlot == nullptr && targets()[0]->root()->hasComponent<SceneManager>())
+        _renderingBeginSlot = targets()[0]->root()->component<SceneManager>()->renderingBegin()->connect(std::bind(
+            &Batching::renderingBeginHandler,
+            std::static_pointer_cast<Batching>(shared_from_this()),
+            std::placeholders::_1,
+            std::placeholders::_2,
+            std::placeholders::_3
+        ), 500.f);
+}
+
+void
+Batching::renderingBeginHandler(SceneManagerPtr sceneManager, uint frameId, AbsTexturePtr renderTarget)
+{
+    // the transforms have a higher priority and are up to date at this point, culling has a lower
+    // one and tests the bounding boxes of the updated batches
+    update();
+}
+
+void
+Batching::update()
+{
+    if (targets().empty())
+        return;
+
+    if (_invalidSurfaces)
+        collectSurfaces();
+
+    // a surface that only moved is updated in place, unless its batch is rebuilt anyway
+    for (const auto& surface : _movedSurfaces)
+        if (_surfaceToBatch.count(surface) != 0 && !_buckets[_surfaceToKey[surface]].invalid)
+            updateBatchedVertices(surface);
+    _movedSurfaces.clear();
+
+    for (auto bucketIt = _buckets.begin(); bucketIt != _buckets.end();)
+    {
+        if (bucketIt->second.invalid)
+            buildBatches(bucketIt->second);
+
+        if (bucketIt->second.surfaces.empty())
+            bucketIt = _buckets.erase(bucketIt);
+        else
+            ++bucketIt;
+    }
+}
+
+void
+Batching::collectSurfaces()
+{
+    _invalidSurfaces = false;
+
+    auto layoutMask = this->layoutMask();
+    auto nodes      = scene::NodeSet::create(targets()[0])->descendants(true)->where([&](NodePtr node)
+    {
+        return (node->layouts() & layoutMask) != 0 && _batchNodes.count(node) == 0;
+    });
+
+    std::vector<SurfacePtr>         surfaces;
+    std::unordered_set<SurfacePtr>  found;
+
+    for (const auto& node : nodes->nodes())
+        for (const auto& surface : node->components<Surface>())
+            if (isBatchable(surface))
+            {
+                surfaces.push_back(surface);
+                found.insert(surface);
+            }
+
+    std::vector<SurfacePtr> removed;
+
+    // a surface whose effect or layouts changed has to move to another bucket
+    for (const auto& surfaceAndKey : _surfaceToKey)
+        if (found.count(surfaceAndKey.first) == 0 || getBatchKey(surfaceAndKey.first) != surfaceAndKey.second)
+            removed.push_back(surfaceAndKey.first);
+
+    for (const auto& surface : removed)
+        removeSurface(surface);
+
+    for (const auto& surface : surfaces)
+        if (_surfaceToKey.count(surface) == 0)
+            addSurface(surface);
+}
+
+bool
+Batching::isBatchable(SurfacePtr surface) const
+{
+    auto geometry = surface->geometry();
+
+    if (surface->targets().size() != 1
+        || geometry == nullptr
+        || geometry->indices() == nullptr
+        || geometry->indices()->data().empty()
+        || geometry->vertexBuffers().empty()
+        || geometry->numVertices() > MAX_NUM_VERTICES)
+        return false;
+
+    bool hasPositions = false;
+
+    // the data must still be available on the CPU side and tightly packed
+    for (const auto& vertexBuffer : geometry->vertexBuffers())
+    {
+        uint vertexSize = 0;
+
+        for (const auto& attribute : vertexBuffer->attributes())
+            vertexSize += std::get<1>(*attribute);
+
+        if (vertexBuffer->data().empty()
+            || vertexBuffer->divisor() != 0
+            || vertexSize != vertexBuffer->vertexSize())
+            return false;
+
+        hasPositions = hasPositions || vertexBuffer->hasAttribute("position");
+    }
+
+    return hasPositions;
+}
+
+Batching::BatchKey
+Batching::getBatchKey(SurfacePtr surface) const
+{
+    std::string format;
+
+    for (const auto& vertexBuffer : surface->geometry()->vertexBuffers())
+    {
+        format += std::to_string(vertexBuffer->vertexSize()) + "(";
+        for (const auto& attribute : vertexBuffer->attributes())
+            format += std::get<0>(*attribute) + ":" + std::to_string(std::get<1>(*attribute))
+                + ":" + std::to_string(std::get<2>(*attribute)) + ",";
+        format += ")";
+    }
+
+    return BatchKey(
+        surface->material().get(),
+        surface->effect().get(),
+        surface->technique(),
+        surface->targets()[0]->layouts(),
+        format
+    );
+}
+
+void
+Batching::addSurface(SurfacePtr surface)
+{
+    auto key        = getBatchKey(surface);
+    auto& bucket    = _buckets[key];
+
+    bucket.surfaces.push_back(surface);
+    bucket.invalid = true;
+
+    _surfaceToKey[surface] = key;
+    _movedSurfaces.erase(surface);
+
+    _surfaceToTransformChangedSlot[surface] = surface->targets()[0]->data()->propertyValueChanged("transform.modelToWorldMatrix")->connect(
+        [=](ContainerPtr, const std::string&)
+        {
+            _movedSurfaces.insert(surface);
+        }
+    );
+
+    _surfaceToVisibilityChangedSlot[surface] = surface->visibilityChanged()->connect(
+        [=](SurfacePtr, std::shared_ptr<Renderer>, bool)
+        {
+            surfaceVisibilityChangedHandler(surface);
+        }
+    );
+}
+
+void
+Batching::removeSurface(SurfacePtr surface)
+{
+    auto& bucket = _buckets[_surfaceToKey[surface]];
+
+    bucket.surfaces.erase(std::find(bucket.surfaces.begin(), bucket.surfaces.end(), surface));
+    bucket.invalid = true;
+
+    _surfaceToKey.erase(surface);
+    _surfaceToTransformChangedSlot.erase(surface);
+    _surfaceToVisibilityChangedSlot.erase(surface);
+    _movedSurfaces.erase(surface);
+    _hiddenSurfaces.erase(surface);
+
+    // the batch of the surface is rebuilt without it by the next update
+    _surfaceToBatch.erase(surface);
+    surface->batched(false);
+}
+
+void
+Batching::surfaceVisibilityChangedHandler(SurfacePtr surface)
+{
+    // hidden surfaces are left out of the batches: only rebuild when that actually changes
+    if (surface->visible() == (_hiddenSurfaces.count(surface) != 0))
+        _buckets[_surfaceToKey[surface]].invalid = true;
+}
+
+void
+Batching::removeBatches(Bucket& bucket)
+{
+    for (auto& batch : bucket.batches)
+    {
+        for (const auto& surface : batch.surfaces)
+            _surfaceToBatch.erase(surface);
+
+        _batchNodes.erase(batch.node);
+        if (batch.node->parent() != nullptr)
+            batch.node->parent()->removeChild(batch.node);
+    }
+
+    bucket.batches.clear();
+}
+
+void
+Batching::buildBatches(Bucket& bucket)
+{
+    removeBatches(bucket);
+    bucket.invalid = false;
+
+    Batch   batch;
+    uint    numVertices = 0;
+
+    for (const auto& surface : bucket.surfaces)
+    {
+        if (!surface->visible())
+        {
+            _hiddenSurfaces.insert(surface);
+            continue;
+        }
+        _hiddenSurfaces.erase(surface);
+
+        auto surfaceNumVertices = surface->geometry()->numVertices();
+
+        if (!batch.surfaces.empty() && numVertices + surfaceNumVertices > MAX_NUM_VERTICES)
+        {
+            bucket.batches.push_back(batch);
+            batch = Batch();
+            numVertices = 0;
+        }
+
+        batch.surfaces.push_back(surface);
+        batch.firstVertices.push_back(numVertices);
+        numVertices += surfaceNumVertices;
+    }
+
+    if (!batch.surfaces.empty())
+        bucket.batches.push_back(batch);
+
+    // a batch of a single surface would not save any draw call
+    bucket.batches.erase(
+        std::remove_if(bucket.batches.begin(), bucket.batches.end(), [](const Batch& batch)
+        {
+            return batch.surfaces.size() < MIN_NUM_SURFACES;
+        }),
+        bucket.batches.end()
+    );
+
+    for (uint batchId = 0; batchId < bucket.batches.size(); ++batchId)
+    {
+        auto&   batch   = bucket.batches[batchId];
+        auto    surface = batch.surfaces.front();
+
+        // the batch node has no transform: its vertices are already in world space
+        batch.node = scene::Node::create("batch");
+        batch.node->layouts(surface->targets()[0]->layouts());
+        batch.node->addComponent(Surface::create(
+            surface->name(),
+            createBatchGeometry(batch),
+            surface->material(),
+            surface->effect(),
+            surface->technique()
+        ));
+
+        for (uint i = 0; i < batch.surfaces.size(); ++i)
+            _surfaceToBatch[batch.surfaces[i]] = std::make_pair(batchId, i);
+
+        _batchNodes.insert(batch.node);
+        targets()[0]->addChild(batch.node);
+    }
+
+    for (const auto& surface : bucket.surfaces)
+        surface->batched(_surfaceToBatch.count(surface) != 0);
+
+    ++_numRebuilds;
+}
+
+geometry::Geometry::Ptr
+Batching::createBatchGeometry(Batch& batch)
+{
+    auto                        firstGeometry   = batch.surfaces.front()->geometry();
+    auto                        context         = firstGeometry->indices()->context();
+    auto                        numVertices     = batch.firstVertices.back() + batch.surfaces.back()->geometry()->numVertices();
+    auto                        geometry        = geometry::Geometry::create();
+    std::vector<unsigned short> indices;
+
+    for (const auto& vertexBuffer : firstGeometry->vertexBuffers())
+    {
+        auto batchVertexBuffer = render::VertexBuffer::create(context);
+
+        for (const auto& attribute : vertexBuffer->attributes())
+            batchVertexBuffer->addAttribute(std::get<0>(*attribute), std::get<1>(*attribute), std::get<2>(*attribute));
+        batchVertexBuffer->data().resize(numVertices * vertexBuffer->vertexSize());
+
+        geometry->addVertexBuffer(batchVertexBuffer);
+    }
+
+    for (uint i = 0; i < batch.surfaces.size(); ++i)
+    {
+        const auto& surface     = batch.surfaces[i];
+        auto        firstVertex = batch.firstVertices[i];
+
+        for (auto index : surface->geometry()->indices()->data())
+            indices.push_back(index + firstVertex);
+
+        writeVertices(surface, geometry, firstVertex);
+    }
+
+    for (const auto& vertexBuffer : geometry->vertexBuffers())
+        vertexBuffer->upload();
+    geometry->indices(render::IndexBuffer::create(context, indices));
+
+    return geometry;
+}
+
+void
+Batching::updateBatchedVertices(SurfacePtr surface)
+{
+    const auto& location        = _surfaceToBatch[surface];
+    const auto& batch           = _buckets[_surfaceToKey[surface]].batches[location.first];
+    auto        firstVertex     = batch.firstVertices[location.second];
+    auto        batchGeometry   = batch.node->component<Surface>()->geometry();
+
+    writeVertices(surface, batchGeometry, firstVertex);
+
+    // only upload the vertices of the surface that moved
+    for (const auto& vertexBuffer : batchGeometry->vertexBuffers())
+        vertexBuffer->upload(firstVertex, surface->geometry()->numVertices());
+
+    ++_numUpdates;
+}
+
+void
+Batching::writeVertices(SurfacePtr surface, GeometryPtr batchGeometry, uint firstVertex)
+{
+    static const std::string    propertyName    = "transform.modelToWorldMatrix";
+
+    auto            geometry        = surface->geometry();
+    auto            targetData      = surface->targets()[0]->data();
+    auto            modelToWorld    = targetData->hasProperty(propertyName) ? targetData->get<Matrix4x4::Ptr>(propertyName) : nullptr;
+    auto            numVertices     = geometry->numVertices();
+    auto            batchBufferIt   = batchGeometry->vertexBuffers().begin();
+    const float*    m               = modelToWorld ? &modelToWorld->data()[0] : nullptr;
+    // normals are transformed by the inverse transpose of the model to world matrix, tangents by its upper 3x3
+    auto            inverse         = modelToWorld ? Matrix4x4::create(modelToWorld)->invert() : nullptr;
+    const float*    n               = inverse ? &inverse->data()[0] : nullptr;
+
+    for (const auto& vertexBuffer : geometry->vertexBuffers())
+    {
+        auto        vertexSize  = vertexBuffer->vertexSize();
+        const auto& data        = vertexBuffer->data();
+        float*      batchData   = &(*batchBufferIt++)->data()[firstVertex * vertexSize];
+
+        std::copy(data.begin(), data.begin() + numVertices * vertexSize, batchData);
+
+        if (m == nullptr)
+            continue;
+
+        for (const auto& attribute : vertexBuffer->attributes())
+        {
+            const auto& name    = std::get<0>(*attribute);
+            auto        size    = std::get<1>(*attribute);
+            auto        offset  = std::get<2>(*attribute);
+
+            if (size < 3)
+                continue;
+
+            if (name == "position")
+                for (uint i = 0; i < numVertices; ++i)
+                {
+                    float*  v   = batchData + i * vertexSize + offset;
+                    float   x   = v[0];
+                    float   y   = v[1];
+                    float   z   = v[2];
+
+                    v[0] = m[0] * x + m[1] * y + m[2] * z + m[3];
+                    v[1] = m[4] * x + m[5] * y + m[6] * z + m[7];
+                    v[2] = m[8] * x + m[9] * y + m[10] * z + m[11];
+                }
+            else if (name == "normal" || name == "tangent")
+            {
+                const bool isNormal = name == "normal";
+
+                for (uint i = 0; i < numVertices; ++i)
+                {
+                    float*  v   = batchData + i * vertexSize + offset;
+                    float   x;
+                    float   y;
+                    float   z;
+
+                    if (isNormal)
+                    {
+                        x = n[0] * v[0] + n[4] * v[1] + n[8] * v[2];
+                        y = n[1] * v[0] + n[5] * v[1] + n[9] * v[2];
+                        z = n[2] * v[0] + n[6] * v[1] + n[10] * v[2];
+                    }
+                    else
+                    {
+                        x = m[0] * v[0] + m[1] * v[1] + m[2] * v[2];
+                        y = m[4] * v[0] + m[5] * v[1] + m[6] * v[2];
+                        z = m[8] * v[0] + m[9] * v[1] + m[10] * v[2];
+                    }
+
+                    float   l   = std::sqrt(x * x + y * y + z * z);
+
+                    if (l > 0.f)
+                    {
+                        x /= l;
+                        y /= l;
+                        z /= l;
+                    }
+
+                    v[0] = x;
+                    v[1] = y;
+                    v[2] = z;
+                }
+            }
+        }
+    }
+}
@@ -32,12 +32,15 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 using namespace minko;
 using namespace minko::component;
 
-/*static*/ std::shared_ptr<math::OctTree>    Culling::_octTree;
+/*static*/ const float  Culling::DEFAULT_WORLD_SIZE = 64.f;
+/*static*/ const uint   Culling::MAX_DEPTH          = 7;
 
 Culling::Culling(ShapePtr shape,
                  const std::string& bindProperty):
     AbstractComponent(scene::Layout::Group::CULLING),
+    _octTree(nullptr),
     _frustum(shape),
+    _invalidFrustum(true),
     _bindProperty(bindProperty)
 {
 }
@@ -51,8 +54,8 @@ Culling::initialize()
         std::placeholders::_1,
         std::placeholders::_2
     ));
-    _targetRemovedSlot = targetAdded()->connect(std::bind(
-        &Culling::targetAddedHandler,
+    _targetRemovedSlot = targetRemoved()->connect(std::bind(
+        &Culling::targetRemovedHandler,
         std::static_pointer_cast<Culling>(shared_from_this()),
         std::placeholders::_1,
         std::placeholders::_2
@@ -67,11 +70,9 @@ Culling::targetAddedHandler(AbstractComponent::Ptr ctrl, NodePtr target)
     if (target->components<component::PerspectiveCamera>().size() < 1)
         throw std::logic_error("Culling must be added to a camera");
 
-
-    // compute scene bounding box
-
-    if (_octTree == nullptr)
-        _octTree = math::OctTree::create(50, 7, math::Vector3::create(0, 0, 0));
+    // the octree grows to fit the scene: its initial size does not matter much
+    _octTree = math::OctTree::create(DEFAULT_WORLD_SIZE, MAX_DEPTH, math::Vector3::create(0, 0, 0));
+    _invalidFrustum = true;
 
     if (target->root()->hasComponent<SceneManager>())
         targetAddedToSceneHandler(nullptr, target, nullptr);
@@ -94,71 +95,163 @@ Culling::targetAddedHandler(AbstractComponent::Ptr ctrl, NodePtr target)
 void
 Culling::targetRemovedHandler(AbstractComponent::Ptr ctrl, NodePtr target)
 {
-    _addedSlot            = nullptr;
-    _layoutChangedSlot    = nullptr;
+    _addedSlot              = nullptr;
+    _removedSlot            = nullptr;
+    _addedToSceneSlot       = nullptr;
+    _componentAddedSlot     = nullptr;
+    _componentRemovedSlot   = nullptr;
+    _layoutChangedSlot      = nullptr;
+    _viewMatrixChangedSlot  = nullptr;
+    _renderingBeginSlot     = nullptr;
+    _octTree                = nullptr;
 }
 
 void
 Culling::targetAddedToSceneHandler(NodePtr node, NodePtr target, NodePtr ancestor)
 {
-    if (target->root()->hasComponent<SceneManager>())
+    auto root = target->root();
+
+    if (root->hasComponent<SceneManager>())
     {
         _addedToSceneSlot = nullptr;
 
-        _layoutChangedSlot = target->root()->layoutsChanged()->connect(std::bind(
+        _layoutChangedSlot = root->layoutsChanged()->connect(std::bind(
             &Culling::layoutChangedHandler,
             std::static_pointer_cast<Culling>(shared_from_this()),
             std::placeholders::_1,
             std::placeholders::_2
         ));
 
-        _addedSlot = target->root()->added()->connect(std::bind(
+        _addedSlot = root->added()->connect(std::bind(
             &Culling::addedHandler,
             std::static_pointer_cast<Culling>(shared_from_this()),
             std::placeholders::_1,
             std::placeholders::_2,
             std::placeholders::_3
         ));
+
+        _removedSlot = root->removed()->connect(std::bind(
+            &Culling::removedHandler,
+            std::static_pointer_cast<Culling>(shared_from_this()),
+            std::placeholders::_1,
+            std::placeholders::_2,
+            std::placeholders::_3
+        ));
+
+        _componentAddedSlot = root->componentAdded()->connect(std::bind(
+            &Culling::componentAddedOrRemovedHandler,
+            std::static_pointer_cast<Culling>(shared_from_this()),
+            std::placeholders::_1,
+            std::placeholders::_2,
+            std::placeholders::_3
+        ));
+
+        _componentRemovedSlot = root->componentRemoved()->connect(std::bind(
+            &Culling::componentAddedOrRemovedHandler,
+            std::static_pointer_cast<Culling>(shared_from_this()),
+            std::placeholders::_1,
+            std::placeholders::_2,
+            std::placeholders::_3
+        ));
+
+        // transforms are updated with a higher priority: the tested bounding boxes are up to date
+        _renderingBeginSlot = root->component<SceneManager>()->renderingBegin()->connect(std::bind(
+            &Culling::renderingBeginHandler,
+            std::static_pointer_cast<Culling>(shared_from_this()),
+            std::placeholders::_1,
+            std::placeholders::_2,
+            std::placeholders::_3
+        ));
+
+        addedHandler(root, root, nullptr);
     }
 }
 
 void
 Culling::addedHandler(NodePtr node, NodePtr target, NodePtr ancestor)
 {
-    auto layoutMask = this->layoutMask();
-    scene::NodeSet::Ptr nodeSet = scene::NodeSet::create(target)->descendants(true)->where([layoutMask](NodePtr descendant)
+    auto descendants = scene::NodeSet::create(target)->descendants(true);
+
+    for (auto descendant : descendants->nodes())
+        updateNode(descendant);
+}
+
+void
+Culling::removedHandler(NodePtr node, NodePtr target, NodePtr ancestor)
+{
+    auto descendants = scene::NodeSet::create(target)->descendants(true);
+
+    for (auto descendant : descendants->nodes())
     {
-        return (descendant->layouts() & layoutMask) != 0;
-    });
+        if (_octTree->hasNode(descendant))
+        {
+            _octTree->remove(descendant);
+            setComputedVisibility(descendant, true);
+        }
+    }
+}
 
-    for (auto n : nodeSet->nodes())
-        _octTree->insert(n);
+void
+Culling::componentAddedOrRemovedHandler(NodePtr node, NodePtr target, AbstractComponent::Ptr component)
+{
+    if (std::dynamic_pointer_cast<Surface>(component))
+        updateNode(target);
 }
 
 void
 Culling::layoutChangedHandler(NodePtr node, NodePtr target)
 {
-    if ((target->layouts() & layoutMask()) != 0)
-        _octTree->insert(target);
-    else
-        _octTree->remove(target);
+    updateNode(target);
+}
+
+void
+Culling::updateNode(NodePtr node)
+{
+    if ((node->layouts() & layoutMask()) != 0 && node->hasComponent<Surface>())
+        _octTree->insert(node);
+    else if (_octTree->hasNode(node))
+    {
+        _octTree->remove(node);
+        setComputedVisibility(node, true);
+    }
 }
 
 void
 Culling::worldToScreenChangedHandler(std::shared_ptr<data::Container> data, const std::string& propertyName)
 {
-    _frustum->updateFromMatrix(data->get<std::shared_ptr<math::Matrix4x4>>(propertyName));
+    _invalidFrustum = true;
+}
+
+void
+Culling::renderingBeginHandler(SceneManagerPtr sceneManager, uint frameId, AbsTexturePtr renderTarget)
+{
+    if (!_invalidFrustum && !_octTree->hasChangedNodes())
+        return;
+
+    auto insideCallback = [&](NodePtr node)
+    {
+        setComputedVisibility(node, true);
+    };
+    auto outsideCallback = [&](NodePtr node)
+    {
+        setComputedVisibility(node, false);
+    };
+
+    if (_invalidFrustum)
+    {
+        _frustum->updateFromMatrix(targets()[0]->data()->get<std::shared_ptr<math::Matrix4x4>>(_bindProperty));
+        _octTree->testFrustum(_frustum, insideCallback, outsideCallback);
+        _invalidFrustum = false;
+    }
+    else
+        _octTree->testChangedNodes(_frustum, insideCallback, outsideCallback);
+}
 
+void
+Culling::setComputedVisibility(NodePtr node, bool visible)
+{
     auto renderer = targets()[0]->component<Renderer>();
 
-    _octTree->testFrustum(
-        _frustum,
-        [&](NodePtr node)
-        {
-            node->component<Surface>()->computedVisibility(renderer, true);
-        },
-        [&](NodePtr node)
-        {
-            node->component<Surface>()->computedVisibility(renderer, false);
-        });
-}
\ No newline at end of file
+    for (auto& surface : node->components<Surface>())
+        surface->computedVisibility(renderer, visible);
+}
@@ -22,6 +22,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/scene/Node.hpp"
 #include "minko/scene/NodeSet.hpp"
 #include "minko/component/SceneManager.hpp"
+#include "minko/async/TaskScheduler.hpp"
+#include "minko/AbstractCanvas.hpp"
 
 using namespace minko;
 using namespace minko::component;
@@ -30,12 +32,21 @@ JobManager::Job::Job() :
     _jobManager(),
     _running(false),
     _oneStepPerFrame(false),
-    _priorityChanged(Signal<float>::create())
+    _threadSafe(false),
+    _priorityChanged(Signal<float>::create()),
+    _stepping(false),
+    _numSteps(0),
+    _stepTime(0.f),
+    _maxStepTime(0.f)
 {
 }
 
 JobManager::JobManager(unsigned int loadingFramerate):
-    _loadingFramerate(loadingFramerate)
+    _loadingFramerate(loadingFramerate),
+    _invalidPriorities(false),
+    _numPushedJobs(0),
+    _frameStartTime(clock::now()),
+    _jobComplete(Signal<Ptr, Job::Ptr>::create())
 {
     _frameTime = 1.f / loadingFramerate;
 }
@@ -45,20 +56,14 @@ JobManager::pushJob(Job::Ptr job)
 {
     _jobPriorityChangedSlots.insert(std::make_pair(
         job,
-        job->priorityChanged()->connect([=](float priority) -> void 
+        job->priorityChanged()->connect([=](float priority) -> void
         {
-            auto jobIt = std::find(_jobs.begin(), _jobs.end(), job);
-
-            if (jobIt != _jobs.end())
-            {
-                _jobs.erase(jobIt);
-            }
-
-            insertJob(job);
+            // the heap is only rebuilt once before the next steps
+            _invalidPriorities = true;
         }))
     );
 
-    insertJob(job);
+    queueJob(job);
 
     return std::static_pointer_cast<JobManager>(shared_from_this());
 }
@@ -66,70 +71,124 @@ JobManager::pushJob(Job::Ptr job)
 void
 JobManager::update(NodePtr target)
 {
-    _frameStartTime = std::clock();
+    _frameStartTime = clock::now();
 }
 
 void
 JobManager::end(NodePtr target)
 {
+    // collect the jobs stepped by the task scheduler since the last frame
+    for (auto i = 0u; i < _steppingJobs.size();)
+    {
+        auto job = _steppingJobs[i];
+
+        if (job->_stepping.load())
+        {
+            ++i;
+            continue;
+        }
+
+        _steppingJobs[i] = _steppingJobs.back();
+        _steppingJobs.pop_back();
+
+        if (job->complete())
+            completeJob(job);
+        else
+            queueJob(job);
+    }
+
     if (_jobs.empty())
         return;
 
-    auto consumeTime        = float(std::clock() - _frameStartTime) / CLOCKS_PER_SEC;
-    Job::Ptr currentJob     = nullptr;
+    if (_invalidPriorities)
+    {
+        for (auto& queuedJob : _jobs)
+            queuedJob.priority = queuedJob.job->priority();
+        std::make_heap(_jobs.begin(), _jobs.end());
+        _invalidPriorities = false;
+    }
+
+    auto sceneManager   = target->root()->component<SceneManager>();
+    auto scheduler      = sceneManager ? sceneManager->taskScheduler() : AbstractCanvas::defaultTaskScheduler();
+    auto frameDuration  = std::chrono::duration_cast<clock::duration>(std::chrono::duration<float>(_frameTime));
+    auto deadline       = _frameStartTime + frameDuration;
 
-    while (consumeTime < _frameTime)
+    while (!_jobs.empty() && clock::now() < deadline)
     {
-        if (currentJob == nullptr)
-        {
-            currentJob = _jobs.back();
-
-            if (!currentJob->running())
-            {
-                currentJob->_jobManager = std::dynamic_pointer_cast<JobManager>(shared_from_this());
-                currentJob->running(true);
-                currentJob->beforeFirstStep();
-            }
-        }
+        std::pop_heap(_jobs.begin(), _jobs.end());
 
-        currentJob->step();
+        auto queuedJob  = _jobs.back();
+        auto job        = queuedJob.job;
 
-        consumeTime = (float(std::clock() - _frameStartTime) / CLOCKS_PER_SEC);
+        _jobs.pop_back();
 
-        if (currentJob->complete())
+        if (!job->running())
         {
-            _jobs.pop_back();
-            currentJob->afterLastStep();
-            _jobPriorityChangedSlots.erase(currentJob);
-            currentJob = nullptr;
+            job->_jobManager = std::dynamic_pointer_cast<JobManager>(shared_from_this());
+            job->running(true);
+            job->beforeFirstStep();
+        }
 
-            if (_jobs.empty())
-                return;
+        if (job->threadSafe() && scheduler->numThreads() != 0)
+        {
+            // the job can use as much as a frame of a scheduler thread
+            auto stepDeadline = clock::now() + frameDuration;
+
+            job->_stepping = true;
+            _steppingJobs.push_back(job);
+            scheduler->schedule([=]() { stepJob(job, stepDeadline); });
+
+            continue;
         }
+
+        stepJob(job, deadline);
+
+        if (job->complete())
+            completeJob(job);
         else
         {
-            if (currentJob->oneStepPerFrame())
-            {
-                _jobs.push_back(currentJob);
-                currentJob = nullptr;
-                consumeTime = _frameTime;
-            }
+            _jobs.push_back(queuedJob);
+            std::push_heap(_jobs.begin(), _jobs.end());
+
+            if (job->oneStepPerFrame())
+                return;
         }
     }
 }
 
+/*static*/
 void
-JobManager::insertJob(Job::Ptr job)
+JobManager::stepJob(Job::Ptr job, clock::time_point deadline)
 {
-    auto jobPosition = std::lower_bound(
-        _jobs.begin(),
-        _jobs.end(),
-        job,
-        [&](Job::Ptr left, Job::Ptr right) -> bool
-        {
-            return left->priority() < right->priority();
-        }
-    );
+    do
+    {
+        auto stepStartTime = clock::now();
+
+        job->step();
+
+        auto stepTime = std::chrono::duration<float, std::milli>(clock::now() - stepStartTime).count();
+
+        ++job->_numSteps;
+        job->_stepTime += stepTime;
+        job->_maxStepTime = std::max(job->_maxStepTime, stepTime);
+    }
+    while (!job->oneStepPerFrame() && !job->complete() && clock::now() < deadline);
+
+    job->_stepping = false;
+}
+
+void
+JobManager::queueJob(Job::Ptr job)
+{
+    _jobs.push_back(QueuedJob { job->priority(), _numPushedJobs++, job });
+    std::push_heap(_jobs.begin(), _jobs.end());
+}
+
+void
+JobManager::completeJob(Job::Ptr job)
+{
+    job->afterLastStep();
+    _jobPriorityChangedSlots.erase(job);
 
-    _jobs.insert(jobPosition, job);
+    _jobComplete->execute(std::static_pointer_cast<JobManager>(shared_from_this()), job);
 }
@@ -44,10 +44,12 @@ const unsigned int Renderer::NUM_FALLBACK_ATTEMPTS = 32;
 Renderer::Renderer(std::shared_ptr<render::AbstractTexture> renderTarget,
                    EffectPtr                                effect,
                    float                                    priority) :
+    _numDrawCalls(0),
     _backgroundColor(0),
     _viewportBox(),
     _scissorBox(),
     _enabled(true),
+    _instancing(true),
     _renderingBegin(Signal<Ptr>::create()),
     _renderingEnd(Signal<Ptr>::create()),
     _beforePresent(Signal<Ptr>::create()),
@@ -77,9 +79,11 @@ Renderer::Renderer(const Renderer& renderer, const CloneOption& option) :
 	_viewportBox(),
 	_scissorBox(),
 	_enabled(renderer._enabled),
+	_instancing(renderer._instancing),
 	_renderingBegin(Signal<Ptr>::create()),
 	_renderingEnd(Signal<Ptr>::create()),
 	_beforePresent(Signal<Ptr>::create()),
+	_numDrawCalls(0),
 	_surfaceDrawCalls(),
 	_surfaceTechniqueChangedSlot(),
 	_effect(nullptr),
@@ -314,7 +318,10 @@ Renderer::render(render::AbstractContext::Ptr    context,
     if (!_enabled)
         return;
 
-    _drawCalls = _drawCallPool->drawCalls();
+    // the draw calls are owned by the pool and iterated in place: a steady-state frame does not copy them
+    const auto& drawCalls = _drawCallPool->drawCalls();
+
+    _numDrawCalls = drawCalls.size();
 
     _renderingBegin->execute(std::static_pointer_cast<Renderer>(shared_from_this()));
 
@@ -341,7 +348,7 @@ Renderer::render(render::AbstractContext::Ptr    context,
            (_backgroundColor & 0xff) / 255.f
        );
 
-    for (auto& drawCall : _drawCalls)
+    for (const auto& drawCall : drawCalls)
         if ((drawCall->layouts() & layoutMask()) != 0)
             drawCall->render(context, rt, _viewportBox);
 
@@ -20,11 +20,14 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/component/SceneManager.hpp"
 
 #include "minko/file/AssetLibrary.hpp"
+#include "minko/file/Loader.hpp"
+#include "minko/file/Options.hpp"
 #include "minko/scene/Node.hpp"
 #include "minko/render/AbstractTexture.hpp"
 #include "minko/data/StructureProvider.hpp"
 #include "minko/data/Container.hpp"
 #include "minko/AbstractCanvas.hpp"
+#include "minko/async/TaskScheduler.hpp"
 
 using namespace minko;
 using namespace minko::component;
@@ -40,13 +43,32 @@ SceneManager::SceneManager(const std::shared_ptr<AbstractCanvas>& canvas) :
     _cullEnd(Signal<Ptr>::create()),
     _renderBegin(Signal<Ptr, uint, render::AbstractTexture::Ptr>::create()),
     _renderEnd(Signal<Ptr, uint, render::AbstractTexture::Ptr>::create()),
-    _data(data::StructureProvider::create("scene"))
+    _data(data::StructureProvider::create("scene")),
+    _taskScheduler(canvas->taskScheduler())
+{
+}
+
+SceneManager::SceneManager(const std::shared_ptr<render::AbstractContext>& context) :
+    _canvas(nullptr),
+    _frameId(0),
+    _time(0.f),
+    _assets(file::AssetLibrary::create(context)),
+    _frameBegin(Signal<Ptr, float, float>::create()),
+    _frameEnd(Signal<Ptr, float, float>::create()),
+    _cullBegin(Signal<Ptr>::create()),
+    _cullEnd(Signal<Ptr>::create()),
+    _renderBegin(Signal<Ptr, uint, render::AbstractTexture::Ptr>::create()),
+    _renderEnd(Signal<Ptr, uint, render::AbstractTexture::Ptr>::create()),
+    _data(data::StructureProvider::create("scene")),
+    _taskScheduler(AbstractCanvas::defaultTaskScheduler())
 {
 }
 
 void
 SceneManager::initialize()
 {
+    _assets->loader()->options()->taskScheduler(_taskScheduler);
+
     _targetAddedSlot = targetAdded()->connect(std::bind(
         &SceneManager::targetAddedHandler,
         std::static_pointer_cast<SceneManager>(shared_from_this()),
@@ -70,7 +92,8 @@ SceneManager::targetAddedHandler(AbstractComponent::Ptr ctrl, NodePtr target)
         throw std::logic_error("The same root node cannot have more than one SceneManager.");
 
 	target->data()->addProvider(_data);
-    target->data()->addProvider(_canvas->data());
+    if (_canvas)
+        target->data()->addProvider(_canvas->data());
 
     _addedSlot = target->added()->connect(std::bind(
         &SceneManager::addedHandler,
@@ -86,7 +109,8 @@ SceneManager::targetRemovedHandler(AbstractComponent::Ptr ctrl, NodePtr target)
 {
     _addedSlot = nullptr;
 	target->data()->removeProvider(_data);
-    target->data()->removeProvider(_canvas->data());
+    if (_canvas)
+        target->data()->removeProvider(_canvas->data());
 }
 
 void
@@ -99,6 +123,9 @@ SceneManager::addedHandler(NodePtr node, NodePtr target, NodePtr ancestor)
 void
 SceneManager::nextFrame(float time, float deltaTime, render::AbstractTexture::Ptr renderTarget)
 {
+    // the results handed back by the tasks (such as decoded assets) are available this frame
+    _taskScheduler->pollMainThread();
+
     _time = time;
     _data->set("time", _time);
 
@@ -26,6 +26,8 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include <minko/geometry/Geometry.hpp>
 #include <minko/geometry/Bone.hpp>
 #include <minko/geometry/Skin.hpp>
+#include <minko/animation/Pose.hpp>
+#include <minko/animation/SkinLayer.hpp>
 #include <minko/render/AbstractContext.hpp>
 #include <minko/math/Matrix4x4.hpp>
 #include <minko/component/Surface.hpp>
@@ -33,6 +35,16 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include <minko/component/MasterAnimation.hpp>
 #include <minko/component/Animation.hpp>
 #include <minko/component/Transform.hpp>
+#include <minko/async/TaskScheduler.hpp>
+#include <minko/AbstractCanvas.hpp>
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+# include <xmmintrin.h>
+# define MINKO_SKINNING_SSE
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+# include <arm_neon.h>
+# define MINKO_SKINNING_NEON
+#endif
 
 using namespace minko;
 using namespace minko::data;
@@ -51,6 +63,138 @@ using namespace minko::render;
 /*static*/ const std::string    Skinning::ATTRNAME_BONE_IDS_B        = "boneIdsB";
 /*static*/ const std::string    Skinning::ATTRNAME_BONE_WEIGHTS_A    = "boneWeightsA";
 /*static*/ const std::string    Skinning::ATTRNAME_BONE_WEIGHTS_B    = "boneWeightsB";
+/*static*/ const unsigned int    Skinning::MIN_NUM_VERTICES_PER_TASK    = 2048;
+/*static*/ const unsigned int    Skinning::BLENDED_FRAME_ID             = uint(-1);
+/*static*/ const unsigned int    Skinning::NO_TIME                      = uint(-1);
+
+namespace
+{
+    /**
+     * Writes the position (and the normal if any) of a vertex transformed by the sum of its
+     * weighted bone matrices. The bones are read by slots of Skin::NUM_BONES_PER_SLOT, numBones
+     * being a multiple of it, and the matrices are stored by columns.
+     */
+    inline
+    void
+    skinVertex(const float*         boneMatrices,
+               const unsigned int*  boneIds,
+               const float*         boneWeights,
+               unsigned int         numBones,
+               const float*         position,
+               float*               outputPosition,
+               const float*         normal,
+               float*               outputNormal)
+    {
+#if defined(MINKO_SKINNING_SSE)
+        __m128 c0 = _mm_setzero_ps();
+        __m128 c1 = _mm_setzero_ps();
+        __m128 c2 = _mm_setzero_ps();
+        __m128 c3 = _mm_setzero_ps();
+
+        for (unsigned int j = 0; j < numBones; j += 4)
+        {
+            const __m128 weights    = _mm_loadu_ps(boneWeights + j);
+            const __m128 w[4]       = {
+                _mm_shuffle_ps(weights, weights, _MM_SHUFFLE(0, 0, 0, 0)),
+                _mm_shuffle_ps(weights, weights, _MM_SHUFFLE(1, 1, 1, 1)),
+                _mm_shuffle_ps(weights, weights, _MM_SHUFFLE(2, 2, 2, 2)),
+                _mm_shuffle_ps(weights, weights, _MM_SHUFFLE(3, 3, 3, 3))
+            };
+
+            for (unsigned int k = 0; k < 4; ++k)
+            {
+                const float* m = boneMatrices + (boneIds[j + k] << 4);
+
+                c0 = _mm_add_ps(c0, _mm_mul_ps(w[k], _mm_loadu_ps(m)));
+                c1 = _mm_add_ps(c1, _mm_mul_ps(w[k], _mm_loadu_ps(m + 4)));
+                c2 = _mm_add_ps(c2, _mm_mul_ps(w[k], _mm_loadu_ps(m + 8)));
+                c3 = _mm_add_ps(c3, _mm_mul_ps(w[k], _mm_loadu_ps(m + 12)));
+            }
+        }
+
+        __m128 p = _mm_add_ps(_mm_mul_ps(c0, _mm_set1_ps(position[0])), c3);
+
+        p = _mm_add_ps(p, _mm_mul_ps(c1, _mm_set1_ps(position[1])));
+        p = _mm_add_ps(p, _mm_mul_ps(c2, _mm_set1_ps(position[2])));
+        _mm_storel_pi(reinterpret_cast<__m64*>(outputPosition), p);
+        _mm_store_ss(outputPosition + 2, _mm_movehl_ps(p, p));
+
+        if (normal)
+        {
+            __m128 n = _mm_mul_ps(c0, _mm_set1_ps(normal[0]));
+
+            n = _mm_add_ps(n, _mm_mul_ps(c1, _mm_set1_ps(normal[1])));
+            n = _mm_add_ps(n, _mm_mul_ps(c2, _mm_set1_ps(normal[2])));
+            _mm_storel_pi(reinterpret_cast<__m64*>(outputNormal), n);
+            _mm_store_ss(outputNormal + 2, _mm_movehl_ps(n, n));
+        }
+#elif defined(MINKO_SKINNING_NEON)
+        float32x4_t c0 = vdupq_n_f32(0.0f);
+        float32x4_t c1 = vdupq_n_f32(0.0f);
+        float32x4_t c2 = vdupq_n_f32(0.0f);
+        float32x4_t c3 = vdupq_n_f32(0.0f);
+
+        for (unsigned int j = 0; j < numBones; j += 4)
+        {
+            const float32x4_t weights   = vld1q_f32(boneWeights + j);
+            const float32x4_t w[4]      = {
+                vdupq_lane_f32(vget_low_f32(weights), 0),
+                vdupq_lane_f32(vget_low_f32(weights), 1),
+                vdupq_lane_f32(vget_high_f32(weights), 0),
+                vdupq_lane_f32(vget_high_f32(weights), 1)
+            };
+
+            for (unsigned int k = 0; k < 4; ++k)
+            {
+                const float* m = boneMatrices + (boneIds[j + k] << 4);
+
+                c0 = vmlaq_f32(c0, w[k], vld1q_f32(m));
+                c1 = vmlaq_f32(c1, w[k], vld1q_f32(m + 4));
+                c2 = vmlaq_f32(c2, w[k], vld1q_f32(m + 8));
+                c3 = vmlaq_f32(c3, w[k], vld1q_f32(m + 12));
+            }
+        }
+
+        float32x4_t p = vmlaq_n_f32(c3, c0, position[0]);
+
+        p = vmlaq_n_f32(p, c1, position[1]);
+        p = vmlaq_n_f32(p, c2, position[2]);
+        vst1_f32(outputPosition, vget_low_f32(p));
+        vst1q_lane_f32(outputPosition + 2, p, 2);
+
+        if (normal)
+        {
+            float32x4_t n = vmulq_n_f32(c0, normal[0]);
+
+            n = vmlaq_n_f32(n, c1, normal[1]);
+            n = vmlaq_n_f32(n, c2, normal[2]);
+            vst1_f32(outputNormal, vget_low_f32(n));
+            vst1q_lane_f32(outputNormal + 2, n, 2);
+        }
+#else
+        float c[16] = { 0.0f };
+
+        for (unsigned int j = 0; j < numBones; ++j)
+        {
+            const float* m = boneMatrices + (boneIds[j] << 4);
+
+            for (unsigned int i = 0; i < 16; ++i)
+                c[i] += boneWeights[j] * m[i];
+        }
+
+        outputPosition[0] = c[0] * position[0] + c[4] * position[1] + c[8]  * position[2] + c[12];
+        outputPosition[1] = c[1] * position[0] + c[5] * position[1] + c[9]  * position[2] + c[13];
+        outputPosition[2] = c[2] * position[0] + c[6] * position[1] + c[10] * position[2] + c[14];
+
+        if (normal)
+        {
+            outputNormal[0] = c[0] * normal[0] + c[4] * normal[1] + c[8]  * normal[2];
+            outputNormal[1] = c[1] * normal[0] + c[5] * normal[1] + c[9]  * normal[2];
+            outputNormal[2] = c[2] * normal[0] + c[6] * normal[1] + c[10] * normal[2];
+        }
+#endif
+    }
+}
 
 Skinning::Skinning(const Skin::Ptr                        skin,
                    SkinningMethod                        method,
@@ -68,6 +212,20 @@ Skinning::Skinning(const Skin::Ptr                        skin,
     _targetGeometry(),
     _targetInputPositions(),
     _targetInputNormals(),
+    _targetFrameId(),
+    _targetSkinnedMatrices(),
+    _movedBones(),
+    _layers(),
+    _pose(nullptr),
+    _blendedMatrices(),
+    _layersTime(NO_TIME),
+    _maxNumVertexBones(0),
+    _reducedNumVertexBones(0),
+    _reducedSlotsOffsets(),
+    _reducedSlotsBoneIds(),
+    _reducedSlotsBoneWeights(),
+    _hiddenTargets(),
+    _visibilitySlots(),
     _targetAddedSlot(nullptr)
 {
 }
@@ -83,6 +241,20 @@ Skinning::Skinning(const Skinning& skinning, const CloneOption& option) :
 	_targetGeometry(),
 	_targetInputPositions(),
 	_targetInputNormals(),
+	_targetFrameId(),
+	_targetSkinnedMatrices(),
+	_movedBones(),
+	_layers(),
+	_pose(nullptr),
+	_blendedMatrices(),
+	_layersTime(NO_TIME),
+	_maxNumVertexBones(skinning._maxNumVertexBones),
+	_reducedNumVertexBones(0),
+	_reducedSlotsOffsets(),
+	_reducedSlotsBoneIds(),
+	_reducedSlotsBoneWeights(),
+	_hiddenTargets(),
+	_visibilitySlots(),
 	_targetAddedSlot(nullptr)
 {	
 	_skin = skinning._skin->clone();
@@ -171,6 +343,17 @@ Skinning::addedHandler(Node::Ptr node, Node::Ptr target, Node::Ptr parent)
                 && geometry->vertexBuffer(ATTRNAME_NORMAL)->numVertices() == _skin->numVertices())
                 _targetInputNormals[node]    = geometry->vertexBuffer(ATTRNAME_NORMAL)->data();
 
+            auto surface    = node->component<Surface>();
+            auto weakNode   = std::weak_ptr<Node>(node);
+            auto callback   = [=](SurfacePtr, RendererPtr, bool)
+            {
+                if (auto target = weakNode.lock())
+                    visibilityChangedHandler(target);
+            };
+
+            _visibilitySlots[node].push_back(surface->visibilityChanged()->connect(callback));
+            _visibilitySlots[node].push_back(surface->computedVisibilityChanged()->connect(callback));
+
             if (_method != SkinningMethod::SOFTWARE)
             {
                 geometry->addVertexBuffer(_boneVertexBuffer);
@@ -205,6 +388,10 @@ Skinning::removedHandler(Node::Ptr node, Node::Ptr target, Node::Ptr parent)
         _targetInputPositions.erase(target);
     if (_targetInputNormals.count(target) > 0)
         _targetInputNormals.erase(target);
+    _targetFrameId.erase(target);
+    _targetSkinnedMatrices.erase(target);
+    _hiddenTargets.erase(target);
+    _visibilitySlots.erase(target);
 }
 
 VertexBuffer::Ptr
@@ -253,26 +440,192 @@ Skinning::createVertexBufferForBones() const
     return vertexBuffer;
 }
 
+Skinning::Ptr
+Skinning::addLayer(SkinLayerPtr layer)
+{
+    if (layer == nullptr || layer->skin()->numBones() != _skin->numBones())
+        throw std::invalid_argument("layer");
+
+    _layers.push_back(layer);
+
+    return std::dynamic_pointer_cast<Skinning>(shared_from_this());
+}
+
+Skinning::Ptr
+Skinning::removeLayer(SkinLayerPtr layer)
+{
+    auto it = std::find(_layers.begin(), _layers.end(), layer);
+
+    if (it == _layers.end())
+        throw std::invalid_argument("layer");
+
+    _layers.erase(it);
+
+    return std::dynamic_pointer_cast<Skinning>(shared_from_this());
+}
+
+Skinning::SkinLayerPtr
+Skinning::crossFade(SkinPtr skin, uint duration)
+{
+    // checked before the current layers start fading out
+    if (skin == nullptr || skin->numBones() != _skin->numBones())
+        throw std::invalid_argument("skin");
+
+    auto layer = animation::SkinLayer::create(skin);
+
+    for (auto& previousLayer : _layers)
+        if (!previousLayer->additive())
+            previousLayer->fade(0.0f, duration, true);
+
+    layer->weight(0.0f)->fade(1.0f, duration);
+    addLayer(layer);
+
+    return layer;
+}
+
+/*virtual*/
+bool
+Skinning::update(uint rawGlobalTime)
+{
+    // the layers have their own playheads, moving along with the global time while playing
+    const uint deltaTime = isPlaying() && _layersTime != NO_TIME && rawGlobalTime > _layersTime
+        ? rawGlobalTime - _layersTime
+        : 0;
+
+    _layersTime = rawGlobalTime;
+
+    for (uint layerId = 0; layerId < _layers.size(); )
+        if (_layers[layerId]->advance(deltaTime))
+            ++layerId;
+        else
+            _layers.erase(_layers.begin() + layerId);
+
+    return AbstractAnimation::update(rawGlobalTime);
+}
+
 void
 Skinning::update()
 {
-    const uint frameId = _skin->getFrameId(_currentTime);
+    uint                        frameId         = 0;
+    const std::vector<float>*   boneMatrices    = nullptr;
 
     for (auto& target : targets())
-        updateFrame(frameId, target);
+    {
+        // the hidden targets are skinned again as soon as they become visible
+        if (!targetVisible(target))
+        {
+            _hiddenTargets.insert(target);
+            continue;
+        }
+        _hiddenTargets.erase(target);
+
+        if (boneMatrices == nullptr)
+            boneMatrices = &currentBoneMatrices(frameId);
+
+        updateFrame(frameId, *boneMatrices, target);
+    }
+}
+
+const std::vector<float>&
+Skinning::currentBoneMatrices(uint& frameId)
+{
+    frameId = _skin->getFrameId(_currentTime);
+
+    if (_layers.empty())
+        return _skin->matrices(frameId);
+
+    const std::vector<float>& boneMatrices = blendLayers(frameId);
+
+    frameId = BLENDED_FRAME_ID;
+
+    return boneMatrices;
+}
+
+bool
+Skinning::targetVisible(Node::Ptr target) const
+{
+    auto surface = target->component<Surface>();
+
+    return surface == nullptr || (surface->visible() && surface->computedVisibility());
+}
+
+void
+Skinning::visibilityChangedHandler(Node::Ptr target)
+{
+    if (_hiddenTargets.count(target) == 0 || !targetVisible(target))
+        return;
+
+    _hiddenTargets.erase(target);
+
+    uint                        frameId         = 0;
+    const std::vector<float>&   boneMatrices    = currentBoneMatrices(frameId);
+
+    updateFrame(frameId, boneMatrices, target);
+}
+
+Skinning::Ptr
+Skinning::maxNumVertexBones(uint value)
+{
+    if (value != _maxNumVertexBones)
+    {
+        _maxNumVertexBones = value;
+        // the weights changed, every vertex must be skinned again
+        _targetFrameId.clear();
+    }
+
+    return std::dynamic_pointer_cast<Skinning>(shared_from_this());
+}
+
+const std::vector<float>&
+Skinning::blendLayers(uint frameId)
+{
+    const uint numBones = _skin->numBones();
+
+    if (_pose == nullptr)
+        _pose = animation::Pose::create(numBones);
+
+    // the layers below the topmost opaque one do not need to be evaluated
+    int firstLayerId = int(_layers.size()) - 1;
+
+    while (firstLayerId >= 0 && !_layers[firstLayerId]->opaque())
+        --firstLayerId;
+
+    if (firstLayerId < 0)
+        _pose->decompose(_skin->matrices(frameId).data());
+    else
+    {
+        auto& layer = _layers[firstLayerId];
+
+        _pose->decompose(layer->skin()->matrices(layer->frameId()).data());
+    }
+
+    for (uint layerId = firstLayerId + 1; layerId < _layers.size(); ++layerId)
+    {
+        auto& layer = _layers[layerId];
+
+        if (layer->additive())
+            _pose->add(layer->pose(), layer->reference(), layer->weight(), layer->boneMask());
+        else
+            _pose->blend(layer->pose(), layer->weight(), layer->boneMask());
+    }
+
+    _blendedMatrices.resize(numBones << 4);
+    _pose->compose(_blendedMatrices.data());
+
+    return _blendedMatrices;
 }
 
 void
-Skinning::updateFrame(unsigned int    frameId,
-                      Node::Ptr        target)
+Skinning::updateFrame(unsigned int                  frameId,
+                      const std::vector<float>&     boneMatrices,
+                      Node::Ptr                     target)
 {
     if (_targetGeometry.count(target) == 0)
         return;
 
-    assert(frameId < _skin->numFrames());
+    assert(frameId == BLENDED_FRAME_ID || frameId < _skin->numFrames());
 
     auto&                        geometry        = _targetGeometry[target];
-    const std::vector<float>&    boneMatrices    = _skin->matrices(frameId);
 
     if (_method == SkinningMethod::HARDWARE)
     {
@@ -285,105 +638,138 @@ Skinning::updateFrame(unsigned int    frameId,
         uniformArray->second        = &(boneMatrices[0]);
     }
     else
-        performSoftwareSkinning(target, boneMatrices);
+        performSoftwareSkinning(target, frameId, boneMatrices);
 }
 
 void
-Skinning::performSoftwareSkinning(Node::Ptr                    target,
-                                 const std::vector<float>&    boneMatrices)
+Skinning::performSoftwareSkinning(Node::Ptr                   target,
+                                  uint                        frameId,
+                                  const std::vector<float>&   boneMatrices)
 {
 #ifdef DEBUG_SKINNING
     assert(target && _targetGeometry.count(target) > 0 && _targetInputPositions.count(target) > 0);
 #endif //DEBUG_SKINNING
 
-    auto geometry    = _targetGeometry[target];
+    const auto          previousFrameId = _targetFrameId.find(target);
+    const bool          firstFrame      = previousFrameId == _targetFrameId.end();
+
+    // blended matrices change from one update to the other
+    if (!firstFrame && frameId != BLENDED_FRAME_ID && previousFrameId->second == frameId)
+        return;
+
+    // the matrices of a compressed skin do not outlive the frame, keep a copy of the skinned ones
+    auto&               skinnedMatrices = _targetSkinnedMatrices[target];
 
-    // transform positions
-    auto                        xyzBuffer    = geometry->vertexBuffer(ATTRNAME_POSITION);
-    VertexBuffer::AttributePtr    xyzAttr        = nullptr;
-    for (auto& attr : xyzBuffer->attributes())
-        if (std::get<0>(*attr) == ATTRNAME_POSITION)
-            xyzAttr = attr;
+    const unsigned int  numBones        = _skin->numBones();
 
-    performSoftwareSkinning(xyzAttr, xyzBuffer, _targetInputPositions[target], boneMatrices, false);
+#ifdef DEBUG_SKINNING
+    assert(boneMatrices.size() == (numBones << 4));
+#endif // DEBUG_SKINNING
+
+    // only the vertices influenced by a bone that moved since the last skinned frame change
+    _movedBones.assign(numBones, 1);
+    if (!firstFrame)
+        for (unsigned int boneId = 0; boneId < numBones; ++boneId)
+            _movedBones[boneId] = memcmp(
+                &boneMatrices[boneId << 4], &skinnedMatrices[boneId << 4], sizeof(float) * 16
+            ) != 0;
+    _targetFrameId[target]  = frameId;
+    skinnedMatrices         = boneMatrices;
+
+    auto                geometry        = _targetGeometry[target];
+    auto                xyzBuffer       = geometry->vertexBuffer(ATTRNAME_POSITION);
+    const unsigned int  xyzOffset       = std::get<2>(*xyzBuffer->attribute(ATTRNAME_POSITION));
+    const unsigned int  xyzStride       = xyzBuffer->vertexSize();
+    const float*        inputXyz        = &_targetInputPositions[target][xyzOffset];
+    float*              outputXyz       = &xyzBuffer->data()[xyzOffset];
+
+    VertexBuffer::Ptr   normalBuffer    = nullptr;
+    unsigned int        normalStride    = 0;
+    const float*        inputNormals    = nullptr;
+    float*              outputNormals   = nullptr;
 
-    // transform normals
     if (geometry->hasVertexAttribute(ATTRNAME_NORMAL) && _targetInputNormals.count(target) > 0)
     {
-        auto                        normalBuffer    = geometry->vertexBuffer(ATTRNAME_NORMAL);
-        VertexBuffer::AttributePtr    normalAttr        = nullptr;
-        for (auto& attr : normalBuffer->attributes())
-            if (std::get<0>(*attr) == ATTRNAME_NORMAL)
-                normalAttr = attr;
+        normalBuffer = geometry->vertexBuffer(ATTRNAME_NORMAL);
 
-        performSoftwareSkinning(normalAttr, normalBuffer, _targetInputNormals[target], boneMatrices, true);
+        const unsigned int normalOffset = std::get<2>(*normalBuffer->attribute(ATTRNAME_NORMAL));
+
+        normalStride    = normalBuffer->vertexSize();
+        inputNormals    = &_targetInputNormals[target][normalOffset];
+        outputNormals   = &normalBuffer->data()[normalOffset];
     }
-}
 
-void
-Skinning::performSoftwareSkinning(VertexBuffer::AttributePtr        attr,
-                                 VertexBuffer::Ptr                    vertexBuffer,
-                                 const std::vector<float>&            inputData,
-                                 const std::vector<float>&            boneMatrices,
-                                 bool                                doDeltaTransform)
-{
-#ifdef DEBUG_SKINNING
-    assert(vertexBuffer && vertexBuffer->data().size() == inputData.size());
-    assert(attr && std::get<1>(*attr) == 3);
-    assert(boneMatrices.size() == (_skin->numBones() << 4));
-#endif // DEBUG_SKINNING
+    const bool          reduced         = _maxNumVertexBones > 0 && _maxNumVertexBones < _skin->maxNumVertexBones();
 
-    const unsigned int    vertexSize        = vertexBuffer->vertexSize();
-    std::vector<float>&    outputData        = vertexBuffer->data();
-    const unsigned int    numVertices        = outputData.size() / vertexSize;
+    if (reduced && _reducedNumVertexBones != _maxNumVertexBones)
+    {
+        _skin->reducedSlots(_maxNumVertexBones, _reducedSlotsOffsets, _reducedSlotsBoneIds, _reducedSlotsBoneWeights);
+        _reducedNumVertexBones = _maxNumVertexBones;
+    }
 
-#ifdef DEBUG_SKINNING
-    assert(numVertices == _skin->numVertices());
-#endif // DEBUG_SKINNING
+    const unsigned int  numVertices     = _skin->numVertices();
+    const auto&         slotsOffsets    = reduced ? _reducedSlotsOffsets : _skin->slotsOffsets();
+    const unsigned int* boneIds         = reduced ? _reducedSlotsBoneIds.data() : _skin->slotsBoneIds().data();
+    const float*        boneWeights     = reduced ? _reducedSlotsBoneWeights.data() : _skin->slotsBoneWeights().data();
+    const unsigned char* movedBones     = _movedBones.data();
+    unsigned int        changedBegin    = numVertices;
+    unsigned int        changedEnd      = 0;
+    std::mutex          changedMutex;
 
-    unsigned int index = std::get<2>(*attr);
-    for (unsigned int vId = 0; vId < numVertices; ++vId)
+    auto skinVertices = [&](unsigned int begin, unsigned int end)
     {
-        const float x1 = inputData[index];
-        const float y1 = inputData[index+1];
-        const float z1 = inputData[index+2];
+        unsigned int first  = end;
+        unsigned int last   = begin;
 
-        float x2 = 0.0f;
-        float y2 = 0.0f;
-        float z2 = 0.0f;
-
-        const unsigned int numVertexBones = _skin->numVertexBones(vId);
-        for (unsigned int j = 0; j < numVertexBones; ++j)
+        for (unsigned int vId = begin; vId < end; ++vId)
         {
-            unsigned int    boneId        = 0;
-            float            boneWeight    = 0.0f;
-
-            _skin->vertexBoneData(vId, j, boneId, boneWeight);
+            const unsigned int slotsBegin   = slotsOffsets[vId];
+            const unsigned int slotsEnd     = slotsOffsets[vId + 1];
+            bool moved                      = firstFrame;
+
+            for (unsigned int j = slotsBegin; j < slotsEnd && !moved; ++j)
+                moved = boneWeights[j] > 0.0f && movedBones[boneIds[j]];
+
+            if (!moved)
+                continue;
+
+            skinVertex(
+                boneMatrices.data(),
+                boneIds + slotsBegin,
+                boneWeights + slotsBegin,
+                slotsEnd - slotsBegin,
+                inputXyz + vId * xyzStride,
+                outputXyz + vId * xyzStride,
+                inputNormals ? inputNormals + vId * normalStride : nullptr,
+                outputNormals ? outputNormals + vId * normalStride : nullptr
+            );
+
+            first   = std::min(first, vId);
+            last    = vId + 1;
+        }
 
-            const float*    boneMatrix    = &(boneMatrices[boneId << 4]);
+        if (first < last)
+        {
+            std::lock_guard<std::mutex> lock(changedMutex);
 
-            if (!doDeltaTransform)
-            {
-                x2 += boneWeight * (boneMatrix[0] * x1 + boneMatrix[4] * y1 + boneMatrix[8]  * z1 + boneMatrix[12]);
-                y2 += boneWeight * (boneMatrix[1] * x1 + boneMatrix[5] * y1 + boneMatrix[9]  * z1 + boneMatrix[13]);
-                z2 += boneWeight * (boneMatrix[2] * x1 + boneMatrix[6] * y1 + boneMatrix[10] * z1 + boneMatrix[14]);
-            }
-            else
-            {
-                x2 += boneWeight * (boneMatrix[0] * x1 + boneMatrix[4] * y1 + boneMatrix[8]  * z1);
-                y2 += boneWeight * (boneMatrix[1] * x1 + boneMatrix[5] * y1 + boneMatrix[9]  * z1);
-                z2 += boneWeight * (boneMatrix[2] * x1 + boneMatrix[6] * y1 + boneMatrix[10] * z1);
-            }
+            changedBegin    = std::min(changedBegin, first);
+            changedEnd      = std::max(changedEnd, last);
         }
+    };
 
-        outputData[index]    = x2;
-        outputData[index+1]    = y2;
-        outputData[index+2]    = z2;
+    auto scheduler = sceneManager() ? sceneManager()->taskScheduler() : AbstractCanvas::defaultTaskScheduler();
 
-        index += vertexSize;
-    }
+    if (numVertices < MIN_NUM_VERTICES_PER_TASK * 2 || scheduler->numThreads() == 0)
+        skinVertices(0, numVertices);
+    else
+        scheduler->parallelFor(0, numVertices, skinVertices, MIN_NUM_VERTICES_PER_TASK);
+
+    if (changedBegin >= changedEnd)
+        return;
 
-    vertexBuffer->upload();
+    xyzBuffer->upload(changedBegin, changedEnd - changedBegin);
+    if (normalBuffer && normalBuffer != xyzBuffer)
+        normalBuffer->upload(changedBegin, changedEnd - changedBegin);
 }
 
 void
@@ -51,6 +51,7 @@ Surface::Surface(std::string                name,
     _effect(effect),
     _technique(technique),
     _visible(true),
+    _batched(false),
     _rendererToVisibility(),
     _rendererToComputedVisibility(),
     _techniqueChanged(TechniqueChangedSignal::create()),
@@ -75,6 +76,7 @@ Surface::Surface(const Surface& surface, const CloneOption& option) :
 	_effect(surface._effect),
 	_technique(surface._technique),
 	_visible(surface._visible),
+	_batched(false),
 	_rendererToVisibility(surface._rendererToVisibility),
 	_rendererToComputedVisibility(surface._rendererToComputedVisibility),
 	_techniqueChanged(TechniqueChangedSignal::create()),
@@ -190,6 +192,16 @@ Surface::geometry(geometry::Geometry::Ptr newGeometry)
     _geometry = newGeometry;
 }
 
+void
+Surface::batched(bool value)
+{
+    if (_batched != value)
+    {
+        _batched = value;
+        _visibilityChanged->execute(std::static_pointer_cast<Surface>(shared_from_this()), nullptr, _visible);
+    }
+}
+
 void
 Surface::effect(render::Effect::Ptr        effect,
                 const std::string&        technique)
@@ -212,6 +224,19 @@ Surface::visible(component::Renderer::Ptr    renderer,
     }
 }
 
+bool
+Surface::computedVisibility() const
+{
+    if (_rendererToComputedVisibility.empty())
+        return true;
+
+    for (auto& rendererAndVisibility : _rendererToComputedVisibility)
+        if (rendererAndVisibility.second)
+            return true;
+
+    return false;
+}
+
 void
 Surface::computedVisibility(component::Renderer::Ptr    renderer,
                             bool                        value)
@@ -25,11 +25,68 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/data/Container.hpp"
 #include "minko/data/StructureProvider.hpp"
 #include "minko/component/SceneManager.hpp"
+#include "minko/async/TaskScheduler.hpp"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+# include <xmmintrin.h>
+# define MINKO_TRANSFORM_SSE
+#elif defined(__ARM_NEON__) || defined(__ARM_NEON)
+# include <arm_neon.h>
+# define MINKO_TRANSFORM_NEON
+#endif
 
 using namespace minko;
 using namespace minko::component;
 using namespace minko::math;
 
+/*static*/ const unsigned int Transform::RootTransform::MIN_NUM_DIRTY_NODES_PER_TASK = 2048;
+
+namespace
+{
+    // output = a * b for row-major 16 bytes aligned matrices, output must not alias a or b
+    inline
+    void
+    multiplyMatrices(const float* a, const float* b, float* output)
+    {
+#if defined(MINKO_TRANSFORM_SSE)
+        const __m128 b0 = _mm_load_ps(b);
+        const __m128 b1 = _mm_load_ps(b + 4);
+        const __m128 b2 = _mm_load_ps(b + 8);
+        const __m128 b3 = _mm_load_ps(b + 12);
+
+        for (int row = 0; row < 16; row += 4)
+        {
+            __m128 r = _mm_mul_ps(_mm_set1_ps(a[row]), b0);
+
+            r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(a[row + 1]), b1));
+            r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(a[row + 2]), b2));
+            r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(a[row + 3]), b3));
+            _mm_store_ps(output + row, r);
+        }
+#elif defined(MINKO_TRANSFORM_NEON)
+        const float32x4_t b0 = vld1q_f32(b);
+        const float32x4_t b1 = vld1q_f32(b + 4);
+        const float32x4_t b2 = vld1q_f32(b + 8);
+        const float32x4_t b3 = vld1q_f32(b + 12);
+
+        for (int row = 0; row < 16; row += 4)
+        {
+            float32x4_t r = vmulq_n_f32(b0, a[row]);
+
+            r = vmlaq_n_f32(r, b1, a[row + 1]);
+            r = vmlaq_n_f32(r, b2, a[row + 2]);
+            r = vmlaq_n_f32(r, b3, a[row + 3]);
+            vst1q_f32(output + row, r);
+        }
+#else
+        for (int row = 0; row < 16; row += 4)
+            for (int column = 0; column < 4; ++column)
+                output[row + column] = a[row] * b[column] + a[row + 1] * b[4 + column]
+                    + a[row + 2] * b[8 + column] + a[row + 3] * b[12 + column];
+#endif
+    }
+}
+
 Transform::Transform() :
     minko::component::AbstractComponent(),
     _matrix(Matrix4x4::create()),
@@ -111,6 +168,30 @@ Transform::targetRemovedHandler(AbstractComponent::Ptr ctrl,
     _removedSlot = nullptr;
 }
 
+Transform::RootTransform::RootTransform() :
+    AbstractComponent(),
+    _transforms(),
+    _modelToWorld(),
+    _nodeToId(),
+    _idToNode(),
+    _parentId(),
+    _invalidLists(true),
+    _localMatrices(),
+    _worldMatrices(),
+    _dirty(),
+    _levelOrder(),
+    _levelStart(),
+    _invalidLevels(true),
+    _changedSubtrees(),
+    _numRemovedNodes(0),
+    _nodeStack(),
+    _newIds(),
+    _nodeDepth(),
+    _targetSlots(),
+    _renderingBeginSlot(nullptr)
+{
+}
+
 AbstractComponent::Ptr
 Transform::RootTransform::clone(const CloneOption& option)
 {
@@ -189,6 +270,8 @@ Transform::RootTransform::targetRemovedHandler(AbstractComponent::Ptr     ctrl,
 {
     _targetSlots.clear();
     _renderingBeginSlot = nullptr;
+    _changedSubtrees.clear();
+    _invalidLists = true;
 }
 
 void
@@ -228,16 +311,19 @@ Transform::RootTransform::addedHandler(scene::Node::Ptr node,
                                        scene::Node::Ptr target,
                                        scene::Node::Ptr ancestor)
 {
-    auto descendants = scene::NodeSet::create(target->root())->descendants(false);
+    // the added subtree is the only place where another root transform can come from
+    auto root           = target->root();
+    auto descendants    = scene::NodeSet::create(target)->descendants(true);
     for (auto descendant : descendants->nodes())
     {
         auto rootTransformCtrl = descendant->component<RootTransform>();
 
-        if (rootTransformCtrl)
+        if (rootTransformCtrl && descendant != root)
             descendant->removeComponent(rootTransformCtrl);
     }
 
-    _invalidLists = true;
+    if (!targets().empty())
+        _changedSubtrees.push_back(std::make_pair(target, true));
 }
 
 void
@@ -245,144 +331,299 @@ Transform::RootTransform::removedHandler(scene::Node::Ptr node,
                                          scene::Node::Ptr target,
                                          scene::Node::Ptr ancestor)
 {
-    _invalidLists = true;
+    // nothing changes when the root itself (or one of its ancestors) is removed from its parent
+    for (auto n = targets()[0]; n != nullptr; n = n->parent())
+        if (n == target)
+            return;
+
+    _changedSubtrees.push_back(std::make_pair(target, false));
 }
 
 void
 Transform::RootTransform::updateTransformsList()
 {
-    _transforms        .clear();
-    _modelToWorld    .clear();
-    _nodeToId        .clear();
-    _idToNode        .clear();
-    _parentId        .clear();
-    _firstChildId    .clear();
-    _numChildren    .clear();
-
-    auto withTransforms            = scene::NodeSet::create(targets())
-        ->descendants(true, false)
-        ->where([](scene::Node::Ptr n){ return n->hasComponent<Transform>(); });
-
-    auto nodesWithTransform    = withTransforms->nodes();
-
-    juxtaposeSiblings(nodesWithTransform); // make sure siblings are at contiguous positions in the vector
-
-    _transforms        .resize(nodesWithTransform.size());
-    _modelToWorld    .resize(nodesWithTransform.size());
-    _idToNode        .resize(nodesWithTransform.size());
-    _parentId        .resize(nodesWithTransform.size(), -1);
-    _firstChildId    .resize(nodesWithTransform.size(), 0);
-    _numChildren    .resize(nodesWithTransform.size(), 0);
-
-    for (uint nodeId = 0; nodeId < nodesWithTransform.size(); ++nodeId)
+    if (_invalidLists)
+    {
+        // full rebuild: a single depth-first traversal of the scene
+        _transforms     .clear();
+        _modelToWorld   .clear();
+        _nodeToId       .clear();
+        _idToNode       .clear();
+        _parentId       .clear();
+        _localMatrices  .clear();
+        _worldMatrices  .clear();
+
+        for (auto& target : targets())
+            addSubtree(target);
+
+        _numRemovedNodes = 0;
+        _invalidLists = false;
+    }
+    else
+    {
+        // incremental update: removed nodes are only marked and appended nodes come after their parent
+        for (auto& changedSubtree : _changedSubtrees)
+            if (changedSubtree.second)
+                addSubtree(changedSubtree.first);
+            else
+                removeSubtree(changedSubtree.first);
+    }
+
+    _changedSubtrees.clear();
+
+    if (_numRemovedNodes > 0)
+        compactTransformsList();
+
+    _invalidLevels = true;
+}
+
+void
+Transform::RootTransform::addSubtree(scene::Node::Ptr subtreeRoot)
+{
+    int parentId = -1;
+
+    for (auto ancestor = subtreeRoot->parent(); ancestor != nullptr && parentId < 0; ancestor = ancestor->parent())
     {
-        auto    node        = nodesWithTransform[nodeId];
-        auto    transform    = node->component<Transform>();
-        auto    ancestor    = node->parent();
+        auto ancestorIt = _nodeToId.find(ancestor);
 
-        while (ancestor != nullptr && _nodeToId.count(ancestor) == 0)
-            ancestor = ancestor->parent();
+        if (ancestorIt != _nodeToId.end())
+            parentId = ancestorIt->second;
+    }
+
+    _nodeStack.clear();
+    _nodeStack.push_back(std::make_pair(subtreeRoot, parentId));
 
-        _nodeToId[node]            = nodeId;
+    while (!_nodeStack.empty())
+    {
+        auto node       = _nodeStack.back().first;
+        auto nodeId     = _nodeStack.back().second;
 
-        _transforms[nodeId]        = transform->_matrix;
-        _modelToWorld[nodeId]    = transform->_modelToWorld;
-        _idToNode[nodeId]        = node;
+        _nodeStack.pop_back();
 
-        if (ancestor)
+        auto transform  = node->component<Transform>();
+
+        if (transform)
         {
-            assert(_nodeToId.count(ancestor) > 0);
-            auto ancestorId = _nodeToId[ancestor];
+            auto nodeIt = _nodeToId.find(node);
+
+            // a node that is already known might have moved: it is appended again after its new parent
+            if (nodeIt != _nodeToId.end())
+                removeNode(nodeIt->second);
+
+            _parentId.push_back(nodeId);
 
-            _parentId[nodeId]    = ancestorId;
+            nodeId = _idToNode.size();
 
-            if (_numChildren[ancestorId] == 0)
-                _firstChildId[ancestorId] = nodeId;
-            ++_numChildren[ancestorId];
+            _nodeToId[node] = nodeId;
+            _idToNode.push_back(node);
+            _transforms.push_back(transform->_matrix);
+            _modelToWorld.push_back(transform->_modelToWorld);
+            _localMatrices.push_back(AlignedMatrix());
+            _worldMatrices.push_back(AlignedMatrix());
+
+            // make sure the new node is updated at the next frame
+            transform->_matrix->_hasChanged = true;
         }
+
+        const auto& children = node->children();
+
+        for (auto childIt = children.rbegin(); childIt != children.rend(); ++childIt)
+            _nodeStack.push_back(std::make_pair(*childIt, nodeId));
     }
+}
+
+void
+Transform::RootTransform::removeSubtree(scene::Node::Ptr subtreeRoot)
+{
+    _nodeStack.clear();
+    _nodeStack.push_back(std::make_pair(subtreeRoot, -1));
+
+    while (!_nodeStack.empty())
+    {
+        auto node = _nodeStack.back().first;
 
-    _invalidLists = false;
+        _nodeStack.pop_back();
+
+        auto nodeIt = _nodeToId.find(node);
+
+        if (nodeIt != _nodeToId.end())
+            removeNode(nodeIt->second);
+
+        for (auto& child : node->children())
+            _nodeStack.push_back(std::make_pair(child, -1));
+    }
 }
 
-/*static*/
 void
-Transform::RootTransform::juxtaposeSiblings(std::vector<NodePtr>& nodes)
+Transform::RootTransform::removeNode(unsigned int nodeId)
 {
-    // assumes 'nodes' is the result of a breadth-first search from the nodes
-    std::unordered_map<scene::Node::Ptr, unsigned int>    firstChild;
+    _nodeToId.erase(_idToNode[nodeId]);
+    _idToNode[nodeId] = nullptr;
+    ++_numRemovedNodes;
+}
 
-    for (unsigned int nodeId = 0; nodeId < nodes.size(); ++nodeId)
+void
+Transform::RootTransform::compactTransformsList()
+{
+    unsigned int numNodes = 0;
+
+    _newIds.resize(_idToNode.size());
+
+    // parents come first: their new id is always known when their children are moved
+    for (unsigned int nodeId = 0; nodeId < _idToNode.size(); ++nodeId)
     {
-        auto it            = nodes.begin() + nodeId;
-        auto node        = *it;
-        auto ancestor    = node->parent();
-        while (ancestor != nullptr
-            && std::find(nodes.begin(), it, ancestor) == nodes.end())
-            ancestor = ancestor->parent();
-
-        if (firstChild.count(ancestor) == 0)
-            firstChild[ancestor] = nodeId;
-        else
+        if (_idToNode[nodeId] == nullptr)
         {
-            assert(firstChild[ancestor] <= nodeId);
+            _newIds[nodeId] = -1;
+            continue;
+        }
 
-            nodes.erase(it);
-            nodes.insert(nodes.begin() + firstChild[ancestor], node);
+        auto parentId = _parentId[nodeId];
+
+        _newIds[nodeId] = numNodes;
+
+        if (numNodes != nodeId)
+        {
+            _idToNode[numNodes]     = std::move(_idToNode[nodeId]);
+            _transforms[numNodes]   = std::move(_transforms[nodeId]);
+            _modelToWorld[numNodes] = std::move(_modelToWorld[nodeId]);
+            _localMatrices[numNodes] = _localMatrices[nodeId];
+            _worldMatrices[numNodes] = _worldMatrices[nodeId];
+            _nodeToId[_idToNode[numNodes]] = numNodes;
         }
+        _parentId[numNodes] = parentId < 0 ? -1 : _newIds[parentId];
+
+        ++numNodes;
     }
+
+    _idToNode       .resize(numNodes);
+    _transforms     .resize(numNodes);
+    _modelToWorld   .resize(numNodes);
+    _parentId       .resize(numNodes);
+    _localMatrices  .resize(numNodes);
+    _worldMatrices  .resize(numNodes);
+
+    _numRemovedNodes = 0;
 }
 
 void
-Transform::RootTransform::updateTransforms()
+Transform::RootTransform::updateLevels()
 {
-    unsigned int numNodes     = _transforms.size();
-    unsigned int nodeId     = 0;
+    unsigned int numNodes   = _transforms.size();
+    unsigned int numLevels  = 0;
 
-    while (nodeId < numNodes)
+    _nodeDepth.resize(numNodes);
+    for (unsigned int nodeId = 0; nodeId < numNodes; ++nodeId)
     {
-        auto parentModelToWorldMatrix     = _modelToWorld[nodeId];
-        auto numChildren                 = _numChildren[nodeId];
-        auto firstChildId                 = _firstChildId[nodeId];
-        auto lastChildId                 = firstChildId + numChildren;
-        auto parentId                     = _parentId[nodeId];
-        auto parentTransformChanged     = parentModelToWorldMatrix->_hasChanged;
+        auto parentId   = _parentId[nodeId];
+        auto depth      = parentId < 0 ? 0 : _nodeDepth[parentId] + 1;
 
-        parentModelToWorldMatrix->_hasChanged = false;
+        _nodeDepth[nodeId] = depth;
+        numLevels = std::max(numLevels, depth + 1);
+    }
 
-        if (parentId == -1)
-        {
-            auto parentTransform = _transforms[nodeId];
-
-            if (_transforms[nodeId]->_hasChanged)
-            {
-                parentModelToWorldMatrix->copyFrom(parentTransform);
-                parentModelToWorldMatrix->_hasChanged = false;
-                parentTransform->_hasChanged = false;
-                parentTransformChanged = true;
-            }
-        }
+    // counting sort of the node ids by depth
+    _levelStart.assign(numLevels + 1, 0);
+    for (unsigned int nodeId = 0; nodeId < numNodes; ++nodeId)
+        ++_levelStart[_nodeDepth[nodeId] + 1];
+    for (unsigned int level = 0; level < numLevels; ++level)
+        _levelStart[level + 1] += _levelStart[level];
+
+    _newIds.assign(_levelStart.begin(), _levelStart.end() - 1);
+    _levelOrder.resize(numNodes);
+    for (unsigned int nodeId = 0; nodeId < numNodes; ++nodeId)
+        _levelOrder[_newIds[_nodeDepth[nodeId]]++] = nodeId;
+
+    _invalidLevels = false;
+}
+
+void
+Transform::RootTransform::updateTransforms(std::shared_ptr<async::TaskScheduler> scheduler)
+{
+    unsigned int numNodes       = _transforms.size();
+    unsigned int numDirtyNodes  = 0;
 
-        for (auto childId = firstChildId; childId < lastChildId; ++childId)
+    _dirty.resize(numNodes);
+
+    // gather the local matrices that changed since the last frame
+    for (unsigned int nodeId = 0; nodeId < numNodes; ++nodeId)
+    {
+        auto& transform = _transforms[nodeId];
+
+        _dirty[nodeId] = transform->_hasChanged;
+        if (transform->_hasChanged)
         {
-            auto modelToWorld   = _modelToWorld[childId];
-            auto transform      = _transforms[childId];
-
-            if (transform->_hasChanged || parentTransformChanged)
-            {
-                modelToWorld->lock()->copyFrom(transform)->append(parentModelToWorldMatrix)->unlock();
-                transform->_hasChanged = false;
-            }
+            std::copy(transform->_m.begin(), transform->_m.end(), _localMatrices[nodeId].m);
+            transform->_hasChanged = false;
+            ++numDirtyNodes;
         }
+    }
+
+    if (numDirtyNodes == 0)
+        return;
+
+    if (numDirtyNodes < MIN_NUM_DIRTY_NODES_PER_TASK * 2 || scheduler->numThreads() == 0)
+    {
+        // parents always come before their children
+        for (unsigned int nodeId = 0; nodeId < numNodes; ++nodeId)
+            updateNode(nodeId);
+    }
+    else
+    {
+        // the nodes of each level are split in tasks, the next level starts once they are all done
+        if (_invalidLevels)
+            updateLevels();
+
+        unsigned int numLevels = _levelStart.size() - 1;
+
+        for (unsigned int level = 0; level < numLevels; ++level)
+            scheduler->parallelFor(
+                _levelStart[level],
+                _levelStart[level + 1],
+                [&](unsigned int begin, unsigned int end)
+                {
+                    for (auto position = begin; position < end; ++position)
+                        updateNode(_levelOrder[position]);
+                },
+                MIN_NUM_DIRTY_NODES_PER_TASK
+            );
+    }
+
+    // write back the world matrices of the nodes that moved
+    for (unsigned int nodeId = 0; nodeId < numNodes; ++nodeId)
+    {
+        if (!_dirty[nodeId])
+            continue;
 
-        ++nodeId;
+        auto& modelToWorld = _modelToWorld[nodeId];
+
+        modelToWorld->initialize(_worldMatrices[nodeId].m);
+        modelToWorld->_hasChanged = false;
+    }
+}
+
+inline
+void
+Transform::RootTransform::updateNode(unsigned int nodeId)
+{
+    auto parentId = _parentId[nodeId];
+
+    if (parentId < 0)
+    {
+        if (_dirty[nodeId])
+            _worldMatrices[nodeId] = _localMatrices[nodeId];
+    }
+    else if (_dirty[nodeId] || _dirty[parentId])
+    {
+        _dirty[nodeId] = true;
+        multiplyMatrices(_worldMatrices[parentId].m, _localMatrices[nodeId].m, _worldMatrices[nodeId].m);
     }
 }
 
 void
 Transform::RootTransform::forceUpdate(scene::Node::Ptr node, bool updateTransformLists)
 {
-    if (_invalidLists || updateTransformLists)
+    if (_invalidLists || updateTransformLists || !_changedSubtrees.empty())
         updateTransformsList();
 
     auto                targetNodeId    = _nodeToId[node];
@@ -421,8 +662,8 @@ Transform::RootTransform::renderingBeginHandler(std::shared_ptr<SceneManager>
                                                 uint                                        frameId,
                                                 std::shared_ptr<render::AbstractTexture>    abstractTexture)
 {
-    if (_invalidLists)
+    if (_invalidLists || !_changedSubtrees.empty())
         updateTransformsList();
 
-    updateTransforms();
+    updateTransforms(sceneManager->taskScheduler());
 }
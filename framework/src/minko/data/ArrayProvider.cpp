@@ -25,7 +25,7 @@ using namespace minko::data;
 
 ArrayProvider::ArrayProvider(const std::string& name) :
     _name(name),
-    _indexChanged(IndexChangedSignal::create())
+    _indexChanged(nullptr)
 {
     if (_name.find(NO_STRUCT_SEP) != std::string::npos)
         throw std::invalid_argument("The name of a ArrayProvider cannot contain the following character sequence: " + NO_STRUCT_SEP);
@@ -33,7 +33,7 @@ ArrayProvider::ArrayProvider(const std::string& name) :
 
 ArrayProvider::ArrayProvider(const ArrayProvider& provider) :
 _name(provider._name),
-_indexChanged(IndexChangedSignal::create())
+_indexChanged(nullptr)
 {
 	if (_name.find(NO_STRUCT_SEP) != std::string::npos)
 		throw std::invalid_argument("The name of a ArrayProvider cannot contain the following character sequence: " + NO_STRUCT_SEP);
@@ -31,7 +31,8 @@ uint Container::CONTAINER_ID = 0;
 Container::Container() :
     std::enable_shared_from_this<Container>(),
     _providers(),
-    _propertyNameToProvider(),
+    _propertyIdToProvider(),
+    _formattedPropertyIds(),
     _arrayLengths(data::Provider::create()),
     _propertyAdded(Container::PropertyChangedSignal::create()),
     _propertyRemoved(Container::PropertyChangedSignal::create()),
@@ -77,12 +78,7 @@ Container::addProvider(Provider::Ptr provider)
             std::placeholders::_2
         )));
 
-        _providerReferenceChangedSlot[provider] = provider->propertyReferenceChanged()->connect(std::bind(
-            &Container::providerReferenceChangedHandler,
-            shared_from_this(),
-            std::placeholders::_1,
-            std::placeholders::_2
-        ));
+        connectProviderReferenceChanged(provider);
 
         for (auto property : provider->values())
             providerPropertyAddedHandler(provider, property.first);
@@ -108,6 +104,7 @@ Container::removeProvider(Provider::Ptr provider)
         _propertyAddedOrRemovedSlots.erase(provider);
         _providerValueChangedSlot.erase(provider);
         _providerReferenceChangedSlot.erase(provider);
+        _formattedPropertyIds.erase(provider);
 
         _providers.erase(std::find(_providers.begin(), _providers.end(), provider));
         _providerToIndex.erase(provider);
@@ -118,7 +115,7 @@ Container::removeProvider(Provider::Ptr provider)
 
     /*
     for (auto property : provider->values())
-        _propertyNameToProvider.erase(property.first);
+        _propertyIdToProvider.erase(property.first);
 
     if (_providerValueChangedSlot.count(provider) != 0)
         _providerValueChangedSlot.erase(provider);
@@ -210,202 +207,185 @@ Container::hasProvider(std::shared_ptr<Provider> provider) const
     return std::find(_providers.begin(), _providers.end(), provider) != _providers.end();
 }
 
-bool
-Container::hasProperty(const std::string& propertyName) const
-{
-    return _propertyNameToProvider.count(propertyName) != 0;
-}
-
 Container::PropertyChangedSignalPtr
-Container::propertyValueChanged(const std::string& propertyName)
+Container::propertyValueChanged(const PropertyId& propertyId)
 {
-    //assertPropertyExists(propertyName);
+    auto foundSignalIt = _propValueChanged.find(propertyId);
 
-    if (_propValueChanged.count(propertyName) == 0)
-    {
-        _propValueChanged[propertyName] = Signal<Container::Ptr, const std::string&>::create();
+    if (foundSignalIt != _propValueChanged.end())
+        return foundSignalIt->second;
 
-        if (_propertyNameToProvider.count(propertyName) != 0)
-        {
-            Provider::Ptr provider = _propertyNameToProvider[propertyName];
-
-            if (_providerValueChangedSlot.count(provider) == 0)
-                _providerValueChangedSlot[provider] = provider->propertyValueChanged()->connect(std::bind(
-                    &Container::providerValueChangedHandler,
-                    shared_from_this(),
-                    std::placeholders::_1,
-                    std::placeholders::_2
-                ));
-        }
-    }
+    auto signal = PropertyChangedSignal::create();
+
+    _propValueChanged[propertyId] = signal;
+
+    auto foundProviderIt = _propertyIdToProvider.find(propertyId);
+
+    if (foundProviderIt != _propertyIdToProvider.end())
+        connectProviderValueChanged(foundProviderIt->second.first);
 
-    return _propValueChanged[propertyName];
+    return signal;
 }
 
 Container::PropertyChangedSignalPtr
-Container::propertyReferenceChanged(const std::string& propertyName)
+Container::propertyReferenceChanged(const PropertyId& propertyId)
 {
-    if (_propReferenceChanged.count(propertyName) == 0)
-    {
-        _propReferenceChanged[propertyName] = Signal<Container::Ptr, const std::string&>::create();
+    auto foundSignalIt = _propReferenceChanged.find(propertyId);
 
-        if (_propertyNameToProvider.count(propertyName) != 0)
-        {
-            Provider::Ptr provider = _propertyNameToProvider[propertyName];
+    if (foundSignalIt != _propReferenceChanged.end())
+        return foundSignalIt->second;
 
-            if (_providerReferenceChangedSlot.count(provider) == 0)
-            {
-                _providerReferenceChangedSlot[provider] = provider->propertyReferenceChanged()->connect(std::bind(
-                    &Container::providerReferenceChangedHandler,
-                    shared_from_this(),
-                    std::placeholders::_1,
-                    std::placeholders::_2
-                ));
-            }
-        }
-    }
+    auto signal = PropertyChangedSignal::create();
+
+    _propReferenceChanged[propertyId] = signal;
+
+    auto foundProviderIt = _propertyIdToProvider.find(propertyId);
 
-    return _propReferenceChanged[propertyName];
+    if (foundProviderIt != _propertyIdToProvider.end())
+        connectProviderReferenceChanged(foundProviderIt->second.first);
+
+    return signal;
 }
 
 void
-Container::assertPropertyExists(const std::string& propertyName) const
+Container::connectProviderValueChanged(Provider::Ptr provider)
 {
-    if (!hasProperty(propertyName))
-        throw std::invalid_argument(propertyName);
+    if (_providerValueChangedSlot.count(provider) == 0)
+        _providerValueChangedSlot[provider] = provider->propertyValueChanged()->connect(std::bind(
+            &Container::providerValueChangedHandler,
+            shared_from_this(),
+            std::placeholders::_1,
+            std::placeholders::_2
+        ));
+}
+
+void
+Container::connectProviderReferenceChanged(Provider::Ptr provider)
+{
+    if (_providerReferenceChangedSlot.count(provider) == 0)
+        _providerReferenceChangedSlot[provider] = provider->propertyReferenceChanged()->connect(std::bind(
+            &Container::providerReferenceChangedHandler,
+            shared_from_this(),
+            std::placeholders::_1,
+            std::placeholders::_2
+        ));
 }
 
 void
 Container::providerValueChangedHandler(Provider::Ptr        provider,
-                                       const std::string&     propertyName)
+                                       const PropertyId&    providerPropertyId)
 {
-    auto formatedPropertyName = formatPropertyName(provider, propertyName);
+    if (_propValueChanged.empty())
+        return;
 
-    if (_propValueChanged.count(formatedPropertyName) != 0)
-        propertyValueChanged(formatedPropertyName)->execute(shared_from_this(), formatedPropertyName);
+    const auto  propertyId      = formatPropertyId(provider, providerPropertyId);
+    auto        foundSignalIt   = _propValueChanged.find(propertyId);
+
+    if (foundSignalIt != _propValueChanged.end())
+    {
+        // keep the signal alive even if one of its callbacks removes it from the container
+        auto signal = foundSignalIt->second;
+
+        signal->execute(shared_from_this(), propertyId.name());
+    }
 }
 
 void
 Container::providerReferenceChangedHandler(Provider::Ptr        provider,
-                                           const std::string&    propertyName)
+                                           const PropertyId&    providerPropertyId)
 {
-    auto formatedPropertyName = formatPropertyName(provider, propertyName);
+    if (_propReferenceChanged.empty())
+        return;
+
+    const auto  propertyId      = formatPropertyId(provider, providerPropertyId);
+    auto        foundSignalIt   = _propReferenceChanged.find(propertyId);
 
-    if (_propReferenceChanged.count(formatedPropertyName))
-        propertyReferenceChanged(formatedPropertyName)->execute(shared_from_this(), formatedPropertyName);
+    if (foundSignalIt != _propReferenceChanged.end())
+    {
+        auto signal = foundSignalIt->second;
+
+        signal->execute(shared_from_this(), propertyId.name());
+    }
 }
 
 void
 Container::providerPropertyAddedHandler(std::shared_ptr<Provider>     provider,
-                                        const std::string&             propertyName)
+                                        const PropertyId&             providerPropertyId)
 {
-    auto formatedPropertyName = formatPropertyName(provider, propertyName);
+    const auto propertyId = formatPropertyId(provider, providerPropertyId);
 
-    if (_propertyNameToProvider.count(formatedPropertyName) != 0)
-        throw std::logic_error("duplicate property name: " + formatedPropertyName);
+    if (_propertyIdToProvider.count(propertyId) != 0)
+        throw std::logic_error("duplicate property name: " + propertyId.name());
 
-    _propertyNameToProvider[formatedPropertyName] = provider;
+    _propertyIdToProvider[propertyId] = ProviderAndPropertyId(provider, providerPropertyId);
 
-    if (_propValueChanged.count(formatedPropertyName) != 0)
-        _providerValueChangedSlot[provider] = provider->propertyValueChanged()->connect(std::bind(
-            &Container::providerValueChangedHandler,
-            shared_from_this(),
-            std::placeholders::_1,
-            std::placeholders::_2
-        ));
+    if (_propValueChanged.count(propertyId) != 0)
+        connectProviderValueChanged(provider);
 
-    _propertyAdded->execute(shared_from_this(), formatedPropertyName);
+    _propertyAdded->execute(shared_from_this(), propertyId.name());
 
-    providerValueChangedHandler(provider, formatedPropertyName);
+    providerValueChangedHandler(provider, providerPropertyId);
 }
 
 void
 Container::providerPropertyRemovedHandler(std::shared_ptr<Provider> provider,
-                                          const std::string&        propertyName)
+                                          const PropertyId&         providerPropertyId)
 {
+    const auto  propertyId      = formatPropertyId(provider, providerPropertyId);
+    auto        foundProviderIt = _propertyIdToProvider.find(propertyId);
 
-    auto formatedPropertyName = formatPropertyName(provider, propertyName);
-
-    if (_propertyNameToProvider.count(formatedPropertyName) != 0)
+    if (foundProviderIt != _propertyIdToProvider.end())
     {
-        _propertyNameToProvider.erase(formatedPropertyName);
+        _propertyIdToProvider.erase(foundProviderIt);
 
-        if (_propValueChanged.count(formatedPropertyName) && _propValueChanged[formatedPropertyName]->numCallbacks() == 0)
-            _propValueChanged.erase(formatedPropertyName);
+        auto foundValueChangedIt = _propValueChanged.find(propertyId);
 
-        if (_propReferenceChanged.count(formatedPropertyName) && _propReferenceChanged[formatedPropertyName]->numCallbacks() == 0)
-            _propReferenceChanged.erase(formatedPropertyName);
+        if (foundValueChangedIt != _propValueChanged.end() && foundValueChangedIt->second->numCallbacks() == 0)
+            _propValueChanged.erase(foundValueChangedIt);
 
-        //_propValueChanged.erase(propertyName);
-        //_propReferenceChanged.erase(propertyName);
+        auto foundReferenceChangedIt = _propReferenceChanged.find(propertyId);
 
-        /*
-        if (_providerValueChangedSlot.count(provider) != 0)
-            for (auto property : provider->values())
-                if (_propValueChanged.count(property.first) != 0)
-                    return;
+        if (foundReferenceChangedIt != _propReferenceChanged.end() && foundReferenceChangedIt->second->numCallbacks() == 0)
+            _propReferenceChanged.erase(foundReferenceChangedIt);
 
-        providerValueChangedHandler(provider, propertyName);
-
-        std::cout << "cont[" << this << "] removes '" << propertyName << "'" << std::endl;
-        */
-
-        _propertyRemoved->execute(shared_from_this(), formatedPropertyName);
+        _propertyRemoved->execute(shared_from_this(), propertyId.name());
     }
 }
 
-std::string
-Container::formatPropertyName(ProviderPtr provider, const std::string& propertyName) const
+PropertyId
+Container::formatPropertyId(ProviderPtr provider, const PropertyId& providerPropertyId)
 {
+    // the name of a property in the container only changes with the index of its array provider,
+    // and the ids of a provider are forgotten when it is removed
+    auto& formattedPropertyIds  = _formattedPropertyIds[provider];
+    auto  foundIt               = formattedPropertyIds.find(providerPropertyId);
 
-    auto arrayProvider = std::dynamic_pointer_cast<ArrayProvider>(provider);
-
-    if (arrayProvider == nullptr)
-        return propertyName;
+    if (foundIt != formattedPropertyIds.end())
+        return foundIt->second;
 
-#ifndef MINKO_NO_GLSL_STRUCT
+    const PropertyId propertyId(formatPropertyName(provider, providerPropertyId.name()));
 
-    return arrayProvider->arrayName() + "[" + std::to_string(_providerToIndex.find(provider)->second) + "]." + propertyName;
+    formattedPropertyIds[providerPropertyId] = propertyId;
 
-#else
-
-    return arrayProvider->arrayName() + NO_STRUCT_SEP + propertyName + "[" + std::to_string(_index) + "]";
-
-#endif // MINKO_NO_GLSL_STRUCT
+    return propertyId;
 }
 
 std::string
-Container::unformatPropertyName(ProviderPtr provider, const std::string& formattedPropertyName) const
+Container::formatPropertyName(ProviderPtr provider, const std::string& propertyName) const
 {
 
     auto arrayProvider = std::dynamic_pointer_cast<ArrayProvider>(provider);
 
     if (arrayProvider == nullptr)
-        return formattedPropertyName;
-
-    if (formattedPropertyName.substr(0, arrayProvider->arrayName().size()) != arrayProvider->arrayName())
-        return unformatPropertyName(provider, formattedPropertyName);
+        return propertyName;
 
 #ifndef MINKO_NO_GLSL_STRUCT
 
-    std::size_t pos = formattedPropertyName.rfind("].");
-
-    if (pos == std::string::npos)
-        return unformatPropertyName(provider, formattedPropertyName);
-
-    return formattedPropertyName.substr(pos + 2);
+    return arrayProvider->arrayName() + "[" + std::to_string(_providerToIndex.find(provider)->second) + "]." + propertyName;
 
 #else
 
-    std::size_t pos1 = formattedPropertyName.find_first_of(NO_STRUCT_SEP);
-    std::size_t pos2 = formattedPropertyName.find_first_of('[');
-
-    if (pos1 == std::string::npos || pos2 == std::string::npos)
-        return unformatPropertyName(provider, formattedPropertyName);
-
-    pos1 += NO_STRUCT_SEP.size();
-
-    return formattedPropertyName.substr(pos1, pos2 - pos1);
+    return arrayProvider->arrayName() + NO_STRUCT_SEP + propertyName + "[" + std::to_string(_index) + "]";
 
 #endif // MINKO_NO_GLSL_STRUCT
 }
@@ -452,11 +432,11 @@ Container::filter(const std::set<data::AbstractFilter::Ptr>&    filters,
 }
 
 bool
-Container::isLengthProperty(const std::string& propertyName) const
+Container::isLengthProperty(const PropertyId& propertyId) const
 {
-    auto foundProviderIt = _propertyNameToProvider.find(propertyName);
+    auto foundProviderIt = _propertyIdToProvider.find(propertyId);
 
-    return foundProviderIt == _propertyNameToProvider.end()
+    return foundProviderIt == _propertyIdToProvider.end()
         ? false
-        : foundProviderIt->second.get() == _arrayLengths.get();
-}
\ No newline at end of file
+        : foundProviderIt->second.first.get() == _arrayLengths.get();
+}
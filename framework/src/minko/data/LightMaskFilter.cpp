@@ -119,7 +119,7 @@ LightMaskFilter::lightsChangedHandler()
 
         _providerToLight[light->data()] = light;
 
-        _layoutMaskChangedSlots.push_back(light->data()->propertyValueChanged()->connect([=](Provider::Ptr provider, const std::string& lightProperty)
+        _layoutMaskChangedSlots.push_back(light->data()->propertyValueChanged()->connect([=](Provider::Ptr provider, const PropertyId& lightProperty)
         {
             changed()->execute(shared_from_this(), nullptr);
         }));
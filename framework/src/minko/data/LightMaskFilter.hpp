@@ -23,6 +23,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/Signal.hpp"
 
 #include "minko/data/AbstractFilter.hpp"
+#include "minko/data/PropertyId.hpp"
 
 namespace minko
 {
@@ -41,7 +42,7 @@ namespace minko
             typedef std::shared_ptr<component::AbstractLight>    AbsLightPtr;
 
             typedef Signal<ContainerPtr, const std::string&>    ContainerPropertyChangedSignal;
-            typedef Signal<ProviderPtr, const std::string&>        ProviderPropertyChangedSignal;
+            typedef Signal<ProviderPtr, const PropertyId&>         ProviderPropertyChangedSignal;
 
         private:
             static std::vector<std::string>                        _numLightPropertyNames;
@@ -0,0 +1,88 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/data/PropertyId.hpp"
+
+#include <deque>
+#include <mutex>
+
+using namespace minko;
+using namespace minko::data;
+
+namespace
+{
+    // names are stored in a deque so that the references handed out by the ids remain valid
+    // while the table grows
+    struct PropertyIdTable
+    {
+        std::mutex                                  mutex;
+        std::deque<std::string>                     names;
+        std::unordered_map<std::string, uint>       nameToId;
+        const std::string*                          emptyName;
+
+        PropertyIdTable()
+        {
+            names.push_back("");
+            nameToId[""] = 0;
+            emptyName = &names.front();
+        }
+    };
+
+    PropertyIdTable&
+    propertyIdTable()
+    {
+        static PropertyIdTable table;
+
+        return table;
+    }
+}
+
+PropertyId::PropertyId() :
+    _id(0),
+    _name(propertyIdTable().emptyName)
+{
+}
+
+PropertyId::PropertyId(const std::string& name)
+{
+    auto&                       table   = propertyIdTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    auto                        foundIt = table.nameToId.find(name);
+
+    if (foundIt == table.nameToId.end())
+    {
+        _id = table.names.size();
+        table.names.push_back(name);
+        table.nameToId[name] = _id;
+    }
+    else
+        _id = foundIt->second;
+
+    _name = &table.names[_id];
+}
+
+/*static*/
+uint
+PropertyId::numIds()
+{
+    auto&                       table   = propertyIdTable();
+    std::lock_guard<std::mutex> lock(table.mutex);
+
+    return table.names.size();
+}
@@ -30,26 +30,42 @@ Provider::Provider() :
     _values(),
     _valueChangedSlots(),
     _referenceChangedSlots(),
-    _propertyAdded(Signal<Ptr, const std::string&>::create()),
-    _propValueChanged(Signal<Ptr, const std::string&>::create()),
-    _propReferenceChanged(Signal<Ptr, const std::string&>::create()),
-    _propertyRemoved(Signal<Ptr, const std::string&>::create())
+    _propertyAdded(nullptr),
+    _propValueChanged(nullptr),
+    _propReferenceChanged(nullptr),
+    _propertyRemoved(nullptr)
 {
 }
 
+Provider::Ptr
+Provider::propertySet(const PropertyId& propertyId, bool isNewValue)
+{
+    auto that = shared_from_this();
+
+    if (isNewValue && _propertyAdded)
+        _propertyAdded->execute(that, propertyId);
+    if (_propReferenceChanged)
+        _propReferenceChanged->execute(that, propertyId);
+    if (_propValueChanged)
+        _propValueChanged->execute(that, propertyId);
+
+    return that;
+}
+
 Provider::Ptr
 Provider::unset(const std::string& propertyName)
 {
-    const auto& formattedPropertyName = formatPropertyName(propertyName);
+    const PropertyId formattedPropertyId(formatPropertyName(propertyName));
 
-    if (_values.count(formattedPropertyName) != 0)
+    if (_values.count(formattedPropertyId) != 0)
     {
-        _names.erase(std::find(_names.begin(), _names.end(), formattedPropertyName));
-        _values.erase(formattedPropertyName);
-        _valueChangedSlots.erase(formattedPropertyName);
-        _referenceChangedSlots.erase(formattedPropertyName);
+        _names.erase(std::find(_names.begin(), _names.end(), formattedPropertyId));
+        _values.erase(formattedPropertyId);
+        _valueChangedSlots.erase(formattedPropertyId);
+        _referenceChangedSlots.erase(formattedPropertyId);
 
-        _propertyRemoved->execute(shared_from_this(), formattedPropertyName);
+        if (_propertyRemoved)
+            _propertyRemoved->execute(shared_from_this(), formattedPropertyId);
     }
 
     return shared_from_this();
@@ -58,47 +74,52 @@ Provider::unset(const std::string& propertyName)
 Provider::Ptr
 Provider::swap(const std::string& propertyName1, const std::string& propertyName2, bool skipPropertyNameFormatting)
 {
-    auto formattedPropertyName1    = skipPropertyNameFormatting ? propertyName1 : formatPropertyName(propertyName1);
-    auto formattedPropertyName2    = skipPropertyNameFormatting ? propertyName2 : formatPropertyName(propertyName2);
-    auto hasProperty1            = hasProperty(formattedPropertyName1, true);
-    auto hasProperty2            = hasProperty(formattedPropertyName2, true);
+    const PropertyId formattedPropertyId1(skipPropertyNameFormatting ? propertyName1 : formatPropertyName(propertyName1));
+    const PropertyId formattedPropertyId2(skipPropertyNameFormatting ? propertyName2 : formatPropertyName(propertyName2));
+    auto hasProperty1            = hasProperty(formattedPropertyId1);
+    auto hasProperty2            = hasProperty(formattedPropertyId2);
 
     if (!hasProperty1 && !hasProperty2)
         throw;
 
     if (!hasProperty1 || !hasProperty2)
     {
-        auto source = hasProperty1 ? formattedPropertyName1 : formattedPropertyName2;
-        auto destination = hasProperty1 ? formattedPropertyName2 : formattedPropertyName1;
+        auto source = hasProperty1 ? formattedPropertyId1 : formattedPropertyId2;
+        auto destination = hasProperty1 ? formattedPropertyId2 : formattedPropertyId1;
         auto namesIt = std::find(_names.begin(), _names.end(), source);
 
         *namesIt = destination;
 
-        _values[destination] = _values[source];
+        // the storage is flat: references to its values do not survive an insertion or an erasure
+        auto value = std::move(_values[source]);
+
         _values.erase(source);
+        _values[destination] = std::move(value);
+
+        auto valueChangedSlot = _valueChangedSlots[source];
 
-        _valueChangedSlots[destination] = _valueChangedSlots[source];
         _valueChangedSlots.erase(source);
+        _valueChangedSlots[destination] = valueChangedSlot;
 
-        _propertyRemoved->execute(shared_from_this(), source);
-        _propertyAdded->execute(shared_from_this(), destination);
+        propertyRemoved()->execute(shared_from_this(), source);
+        propertyAdded()->execute(shared_from_this(), destination);
     }
     else
     {
-        const auto    value1    = _values[formattedPropertyName1];
-        const auto    value2    = _values[formattedPropertyName2];
+        const auto    value1    = _values[formattedPropertyId1];
+        const auto    value2    = _values[formattedPropertyId2];
         const bool    changed = true;//!( (*value1) == (*value2) );
 
-        _values[formattedPropertyName1] = value2;
-        _values[formattedPropertyName2] = value1;
+        _values[formattedPropertyId1] = value2;
+        _values[formattedPropertyId2] = value1;
 
-        _propValueChanged->execute(shared_from_this(), formattedPropertyName1);
-        _propValueChanged->execute(shared_from_this(), formattedPropertyName2);
+        propertyValueChanged()->execute(shared_from_this(), formattedPropertyId1);
+        propertyValueChanged()->execute(shared_from_this(), formattedPropertyId2);
 
         if (changed)
         {
-            _propReferenceChanged->execute(shared_from_this(), formattedPropertyName1);
-            _propReferenceChanged->execute(shared_from_this(), formattedPropertyName2);
+            propertyReferenceChanged()->execute(shared_from_this(), formattedPropertyId1);
+            propertyReferenceChanged()->execute(shared_from_this(), formattedPropertyId2);
         }
     }
 
@@ -108,13 +129,7 @@ Provider::swap(const std::string& propertyName1, const std::string& propertyName
 bool
 Provider::hasProperty(const std::string& name, bool skipPropertyNameFormatting) const
 {
-    auto it = std::find(
-        _names.begin(),
-        _names.end(),
-        skipPropertyNameFormatting ? name : formatPropertyName(name)
-    );
-
-    return it != _names.end();
+    return hasProperty(PropertyId(skipPropertyNameFormatting ? name : formatPropertyName(name)));
 }
 
 /*virtual*/
@@ -29,6 +29,18 @@ AbstractProtocol::AbstractProtocol() :
     _options(Options::create()),
     _complete(Signal<Ptr>::create()),
     _progress(Signal<Ptr, float>::create()),
+    _chunk(Signal<Ptr, uint, uint>::create()),
     _error(Signal<Ptr>::create())
 {
 }
+
+void
+AbstractProtocol::appendChunk(const unsigned char* bytes, uint size)
+{
+    auto& data = _file->_data;
+    auto offset = data.size();
+
+    data.insert(data.end(), bytes, bytes + size);
+
+    _chunk->execute(shared_from_this(), offset, size);
+}
@@ -311,3 +311,28 @@ AssetLibrary::sound(const std::string& name, audio::Sound::Ptr sound)
 
     return std::enable_shared_from_this<AssetLibrary>::shared_from_this();
 }
+
+template <typename T>
+static
+bool
+hasValue(const std::unordered_map<std::string, std::shared_ptr<T>>& assets, const std::string& name)
+{
+    auto assetIt = assets.find(name);
+
+    // the getters insert null values for unknown names
+    return assetIt != assets.end() && assetIt->second != nullptr;
+}
+
+bool
+AssetLibrary::hasAsset(const std::string& name) const
+{
+    return hasValue(_geometries, name)
+        || hasValue(_effects, name)
+        || hasValue(_textures, name)
+        || hasValue(_cubeTextures, name)
+        || hasValue(_symbols, name)
+        || hasValue(_scripts, name)
+        || hasValue(_sounds, name)
+        || hasValue(_materials, name)
+        || _blobs.count(name) != 0;
+}
@@ -185,11 +185,50 @@ EffectParser::parse(const std::string&				    filename,
 				    const std::vector<unsigned char>&	data,
 				    std::shared_ptr<AssetLibrary>	    assetLibrary)
 {
-	Json::Value root;
+    parse(filename, resolvedFilename, options, data.data(), data.size(), assetLibrary);
+}
+
+void
+EffectParser::parse(const std::string&				    filename,
+				    const std::string&                  resolvedFilename,
+                    std::shared_ptr<Options>            options,
+				    const unsigned char*	            data,
+				    uint	                            size,
+				    std::shared_ptr<AssetLibrary>	    assetLibrary)
+{
+    decode(filename, resolvedFilename, options, data, size);
+    finalize(filename, resolvedFilename, options, assetLibrary);
+}
+
+void
+EffectParser::decode(const std::string&				    filename,
+				     const std::string&                 resolvedFilename,
+                     std::shared_ptr<Options>           options,
+				     const unsigned char*	            data,
+				     uint	                            size)
+{
 	Json::Reader reader;
 
-	if (!reader.parse((const char*)&data[0], (const char*)&data[data.size() - 1], root, false))
-		_error->execute(shared_from_this(), file::Error(resolvedFilename + ": " + reader.getFormattedErrorMessages()));
+	_root = std::make_shared<Json::Value>();
+
+	if (!reader.parse((const char*)data, (const char*)data + size - 1, *_root, false))
+		_decodeError = resolvedFilename + ": " + reader.getFormattedErrorMessages();
+}
+
+void
+EffectParser::finalize(const std::string&				filename,
+				       const std::string&               resolvedFilename,
+                       std::shared_ptr<Options>         options,
+				       std::shared_ptr<AssetLibrary>	assetLibrary)
+{
+	// the document is not needed once the effect is created
+	auto document = _root;
+	auto& root = *document;
+
+	_root = nullptr;
+
+	if (!_decodeError.empty())
+		_error->execute(shared_from_this(), file::Error(_decodeError));
 
     int pos	= resolvedFilename.find_last_of("/\\");
 
@@ -623,7 +662,7 @@ EffectParser::glslIncludeCompleteHandler(LoaderPtr 			        loader,
         options->includePaths().push_back(resolvedFilename.substr(0, pos));
 	}
 
-    parseGLSL(std::string((const char*)&file->data()[0], file->data().size()), options, blocks, blockIt);
+    parseGLSL(std::string((const char*)file->bytes(), file->size()), options, blocks, blockIt);
 
 	if (_numDependencies == _numLoadedDependencies && _effect)
 		finalize();
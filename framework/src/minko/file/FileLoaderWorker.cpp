@@ -71,7 +71,7 @@ namespace minko
 
                 file.close();
 
-                post(Message{ "complete" }.set(output));
+                post(Message{ "complete" }.set(std::move(output)));
             }
             else
             {
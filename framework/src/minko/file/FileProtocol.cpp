@@ -20,6 +20,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/file/FileProtocol.hpp"
 
 #include "minko/file/Options.hpp"
+#include "minko/file/MemoryMappedFile.hpp"
 #include "minko/Signal.hpp"
 #include "minko/AbstractCanvas.hpp"
 #include "minko/async/Worker.hpp"
@@ -66,6 +67,38 @@ FileProtocol::load()
 
     auto realFilename = cleanFilename;
 
+    if (options->memoryMapFiles())
+    {
+        auto mapping = MemoryMappedFile::create(cleanFilename, options->seekingOffset(), options->seekedLength());
+
+        // mapping a file is immediate: the pages are only read when they are parsed
+        if (mapping != nullptr)
+        {
+            mappedFile(mapping);
+
+            // streamed parsers still get the mapped bytes chunk by chunk, read in place
+            if (options->streamFiles())
+            {
+                auto length = mapping->size();
+                auto size = chunkSize(length);
+
+                for (uint chunkOffset = 0; chunkOffset < length; chunkOffset += size)
+                {
+                    auto readSize = std::min(size, length - chunkOffset);
+
+                    _chunk->execute(loader, chunkOffset, readSize);
+                    _progress->execute(loader, float(chunkOffset + readSize) / float(length));
+                }
+            }
+
+            _progress->execute(loader, 1.0);
+            _complete->execute(loader);
+            _runningLoaders.remove(loader);
+
+            return;
+        }
+    }
+
     std::fstream file(cleanFilename, flags);
 
     if (file.is_open())
@@ -76,18 +109,26 @@ FileProtocol::load()
             file.close();
             auto worker = AbstractCanvas::defaultCanvas()->getWorker("file-protocol");
 
-            _workerSlots.push_back(worker->message()->connect([=](async::Worker::Ptr, async::Worker::Message message)
+            _workerSlots.push_back(worker->message()->connect([=](async::Worker::Ptr, const async::Worker::Message& message)
             {
-                if (message.type == "complete")
+                if (message.type == "chunk")
+                {
+                    appendChunk(reinterpret_cast<const unsigned char*>(message.data.data()), message.data.size());
+                }
+                else if (message.type == "complete")
                 {
-                    void* bytes = &*message.data.begin();
-                    data().assign(static_cast<unsigned char*>(bytes), static_cast<unsigned char*>(bytes) + message.data.size());
+                    // streamed files are already assembled from their chunks
+                    if (!options->streamFiles())
+                    {
+                        const void* bytes = &*message.data.begin();
+                        data().assign(static_cast<const unsigned char*>(bytes), static_cast<const unsigned char*>(bytes) + message.data.size());
+                    }
                     _complete->execute(loader);
                     _runningLoaders.remove(loader);
                 }
                 else if (message.type == "progress")
                 {
-                    float ratio = *reinterpret_cast<float*>(&*message.data.begin());
+                    float ratio = *reinterpret_cast<const float*>(&*message.data.begin());
 
                     _progress->execute(loader, ratio);
                 }
@@ -117,6 +158,7 @@ FileProtocol::load()
             
             input.insert(input.end(), offsetByteArray.begin(), offsetByteArray.end());
             input.insert(input.end(), lengthByteArray.begin(), lengthByteArray.end());
+            input.push_back(options->streamFiles() ? 1 : 0);
             input.insert(input.end(), cleanFilename.begin(), cleanFilename.end());
 
             worker->start(input);
@@ -131,10 +173,32 @@ FileProtocol::load()
 
             _progress->execute(shared_from_this(), 0.0);
 
-			data().resize(length);
-
 			file.seekg(offset, std::ios::beg);
-			file.read((char*)&data()[0], length);
+
+            if (options->streamFiles())
+            {
+                auto size = chunkSize(length);
+                std::vector<unsigned char> chunk(size);
+
+                data().reserve(length);
+
+                for (uint chunkOffset = 0; chunkOffset < length; chunkOffset += size)
+                {
+                    auto readSize = std::min(size, length - chunkOffset);
+
+                    file.read((char*)&chunk[0], readSize);
+                    appendChunk(&chunk[0], readSize);
+
+                    _progress->execute(loader, float(chunkOffset + readSize) / float(length));
+                }
+            }
+            else
+            {
+                data().resize(length);
+
+                file.read((char*)&data()[0], length);
+            }
+
             file.close();
 
             _progress->execute(loader, 1.0);
@@ -149,6 +213,20 @@ FileProtocol::load()
     }
 }
 
+/*static*/
+uint
+FileProtocol::chunkSize(uint length)
+{
+    uint chunkSize = math::clp2((length / 50) / 1024);
+
+    if (chunkSize > 1024)
+        chunkSize = 1024;
+    else if (chunkSize <= 0)
+        chunkSize = 8;
+
+    return chunkSize * 1024;
+}
+
 bool
 FileProtocol::fileExists(const std::string& filename)
 {
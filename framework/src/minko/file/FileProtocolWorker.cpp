@@ -18,6 +18,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 */
 
 #include "minko/file/FileProtocolWorker.hpp"
+#include "minko/file/FileProtocol.hpp"
 
 using namespace minko;
 using namespace minko::file;
@@ -38,7 +39,9 @@ namespace minko
                                 (static_cast<int>(static_cast<unsigned char>((input[6]))) << 8) +
                                 static_cast<int>(static_cast<unsigned char>((input[7])));
 
-			std::string filename(input.begin() + 8, input.end());
+            auto streamed = input[8] != 0;
+
+			std::string filename(input.begin() + 9, input.end());
 
             std::vector<char> output;
 
@@ -52,14 +55,7 @@ namespace minko
             {
 				uint length = seekedLength > 0 ? seekedLength : (uint(file.tellg()) - seekingOffset);
 
-				uint chunkSize = math::clp2((length / 50) / 1024);
-
-                if (chunkSize > 1024)
-                    chunkSize = 1024;
-                else if (chunkSize <= 0)
-                    chunkSize = 8;
-
-                chunkSize *= 1024;
+				uint chunkSize = FileProtocol::chunkSize(length);
 
 				file.seekg(seekingOffset, std::ios::beg);
 
@@ -73,9 +69,20 @@ namespace minko
 					if (nextOffset > length)
 						readSize = length % chunkSize;
 
-                    output.resize(offset + readSize);
+                    if (streamed)
+                    {
+                        std::vector<char> chunk(readSize);
+
+                        file.read(&*chunk.begin(), readSize);
+
+                        post(Message { "chunk" }.set(std::move(chunk)));
+                    }
+                    else
+                    {
+                        output.resize(offset + readSize);
 
-                    file.read(&*output.begin() + offset, readSize);
+                        file.read(&*output.begin() + offset, readSize);
+                    }
 
                     auto progress = float(offset + readSize) / float(length);
 
@@ -88,7 +95,7 @@ namespace minko
 
                 file.close();
 
-                post(Message{ "complete" }.set(output));
+                post(Message{ "complete" }.set(std::move(output)));
             }
             else
             {
@@ -22,6 +22,9 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/file/AbstractProtocol.hpp"
 #include "minko/file/Options.hpp"
 #include "minko/file/AssetLibrary.hpp"
+#include "minko/file/LoadingCache.hpp"
+#include "minko/async/TaskScheduler.hpp"
+#include "minko/AbstractCanvas.hpp"
 
 #include "minko/log/Logger.hpp"
 
@@ -62,7 +65,7 @@ Loader::load()
     else
     {
         _numFiles = _filesQueue.size();
-        _protocolToProgress.clear();
+        _filenameToProgress.clear();
 
         auto queue = _filesQueue;
 
@@ -105,11 +108,27 @@ Loader::load()
 
             if (loadFile)
             {    
-                _files[filename] = protocol->file();
-    
                 _filesQueue.erase(std::find(_filesQueue.begin(), _filesQueue.end(), filename));
                 _loading.push_back(filename);
-    
+
+                auto cache = options->loadingCache();
+
+                if (cache != nullptr)
+                {
+                    auto that = shared_from_this();
+
+                    auto key = LoadingCache::key(resolvedFilename, options->seekingOffset(), options->seekedLength());
+
+                    // the file is either cached or already loaded by another request
+                    if (cache->request(key, [=](File::Ptr content)
+                        {
+                            that->cachedFileHandler(filename, resolvedFilename, options, content);
+                        }))
+                        continue;
+                }
+
+                _files[filename] = protocol->file();
+
                 _protocolSlots.push_back(protocol->error()->connect(std::bind(
                     &Loader::protocolErrorHandler,
                     shared_from_this(),
@@ -126,6 +145,13 @@ Loader::load()
                     std::placeholders::_1,
                     std::placeholders::_2
                 )));
+                _protocolChunkSlots.push_back(protocol->chunk()->connect(std::bind(
+                    &Loader::protocolChunkHandler,
+                    shared_from_this(),
+                    std::placeholders::_1,
+                    std::placeholders::_2,
+                    std::placeholders::_3
+                )));
     
                 protocol->load(filename, resolvedFilename, options);
             }
@@ -140,20 +166,27 @@ Loader::load()
 void
 Loader::protocolErrorHandler(std::shared_ptr<AbstractProtocol> protocol)
 {
-    auto error = Error("ProtocolError", "Protocol error: " + protocol->file()->filename());
+    auto cache = protocol->options()->loadingCache();
 
-    errorThrown(error);
+    if (cache != nullptr)
+        cache->fail(LoadingCache::key(
+            protocol->file()->resolvedFilename(),
+            protocol->options()->seekingOffset(),
+            protocol->options()->seekedLength()
+        ));
+
+    fileFailed(protocol->file()->filename(), Error("ProtocolError", "Protocol error: " + protocol->file()->filename()));
 }
 
 void
 Loader::protocolProgressHandler(std::shared_ptr<AbstractProtocol> protocol, float progress)
 {
-    _protocolToProgress[protocol] = progress;
+    _filenameToProgress[protocol->file()->filename()] = progress;
 
     float newTotalProgress = 0.f;
 
-    for (auto protocolAndProgress : _protocolToProgress)
-        newTotalProgress += protocolAndProgress.second / _numFiles;
+    for (auto filenameAndProgress : _filenameToProgress)
+        newTotalProgress += filenameAndProgress.second / _numFiles;
     
     if (newTotalProgress > 1.0f)
         newTotalProgress = 1.0f;
@@ -164,28 +197,101 @@ Loader::protocolProgressHandler(std::shared_ptr<AbstractProtocol> protocol, floa
     );
 }
 
+void
+Loader::protocolChunkHandler(std::shared_ptr<AbstractProtocol> protocol, uint offset, uint size)
+{
+    auto file = protocol->file();
+    auto options = protocol->options();
+    auto parserIt = _streamedFileParsers.find(file->filename());
+
+    if (parserIt == _streamedFileParsers.end())
+    {
+        auto parser = createParser(file->filename());
+
+        // the other parsers wait for the whole file, as usual
+        if (parser != nullptr && !parser->streamable())
+            parser = nullptr;
+
+        if (parser != nullptr)
+            _parserErrorSlots[parser] = parser->error()->connect(std::bind(
+                &Loader::parserErrorHandler,
+                shared_from_this(),
+                std::placeholders::_1,
+                std::placeholders::_2
+            ));
+
+        parserIt = _streamedFileParsers.emplace(file->filename(), parser).first;
+    }
+
+    auto parser = parserIt->second;
+
+    if (parser != nullptr)
+        parser->parseChunk(
+            file->filename(),
+            file->resolvedFilename(),
+            options,
+            file->bytes(),
+            offset + size,
+            options->assetLibrary()
+        );
+}
+
 void
 Loader::protocolCompleteHandler(std::shared_ptr<AbstractProtocol> protocol)
 {
-    _protocolToProgress[protocol] = 1.f;
+    auto file = protocol->file();
+    auto cache = protocol->options()->loadingCache();
+
+    // the requests waiting for this file complete before it is parsed
+    if (cache != nullptr)
+        cache->complete(LoadingCache::key(
+            file->resolvedFilename(),
+            protocol->options()->seekingOffset(),
+            protocol->options()->seekedLength()
+        ), file);
+
+    fileLoaded(file->filename(), protocol->options(), file);
+}
+
+void
+Loader::cachedFileHandler(const std::string&   filename,
+                          const std::string&   resolvedFilename,
+                          Options::Ptr         options,
+                          File::Ptr            content)
+{
+    if (content == nullptr)
+    {
+        fileFailed(filename, Error("ProtocolError", "Protocol error: " + filename));
 
-    auto filename = protocol->file()->filename();
+        return;
+    }
+
+    auto file = File::create(filename, resolvedFilename, content);
+
+    _files[filename] = file;
+
+    fileLoaded(filename, options, file);
+}
+
+void
+Loader::fileLoaded(const std::string& filename, Options::Ptr options, File::Ptr file)
+{
+    _filenameToProgress[filename] = 1.f;
 
     _loading.erase(std::find(_loading.begin(), _loading.end(), filename));
-    //_filenameToProtocol.erase(protocol->filename());
     _filenameToOptions.erase(filename);
     
     _numFilesToParse++;
 
-    LOG_DEBUG("file '" << protocol->file()->filename() << "' loaded, "
+    LOG_DEBUG("file '" << filename << "' loaded, "
         << _loading.size() << " file(s) still loading, "
         << _filesQueue.size() << " file(s) in the queue");
 
     auto parsed = processData(
         filename,
-        protocol->file()->resolvedFilename(),
-        protocol->options(),
-        protocol->file()->data()
+        file->resolvedFilename(),
+        options,
+        file
     );
 
     if (!parsed)
@@ -196,17 +302,64 @@ Loader::protocolCompleteHandler(std::shared_ptr<AbstractProtocol> protocol)
     }
 }
 
+void
+Loader::fileFailed(const std::string& filename, const Error& error)
+{
+    // a failed file does not prevent the loader from completing
+    auto loadingIt = std::find(_loading.begin(), _loading.end(), filename);
+
+    if (loadingIt != _loading.end())
+        _loading.erase(loadingIt);
+    _filenameToOptions.erase(filename);
+
+    errorThrown(error);
+
+    finalize();
+}
+
+AbstractParser::Ptr
+Loader::createParser(const std::string& filename)
+{
+    auto extension = filename.substr(filename.find_last_of('.') + 1);
+
+    std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+
+    return _options->getParser(extension);
+}
+
 bool
 Loader::processData(const std::string&                      filename,
                          const std::string&                 resolvedFilename,
                          Options::Ptr                       options,
-                         const std::vector<unsigned char>&  data)
+                         File::Ptr                          file)
 {
+    // loaders sharing a cache do not parse the same asset twice, unless they read another range
+    if (options->loadingCache() != nullptr
+        && options->seekingOffset() == 0
+        && options->seekedLength() == 0
+        && options->assetLibrary() != nullptr
+        && options->assetLibrary()->hasAsset(filename))
+    {
+        _streamedFileParsers.erase(filename);
+
+        return false;
+    }
+
     auto extension = filename.substr(filename.find_last_of('.') + 1);
 
     std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
 
-    auto parser = _options->getParser(extension);
+    AbstractParser::Ptr parser = nullptr;
+    auto streamedParserIt = _streamedFileParsers.find(filename);
+
+    // a streamed file is completed by the parser which received its chunks
+    if (streamedParserIt != _streamedFileParsers.end() && streamedParserIt->second != nullptr)
+        parser = streamedParserIt->second;
+    else
+        parser = createParser(filename);
+
+    if (streamedParserIt != _streamedFileParsers.end())
+        _streamedFileParsers.erase(streamedParserIt);
 
     if (parser)
     {
@@ -223,7 +376,15 @@ Loader::processData(const std::string&                      filename,
                                                                        std::placeholders::_2
                                                                        ));
 
-        parser->parse(filename, resolvedFilename, options, data, options->assetLibrary());
+        auto scheduler = options->taskScheduler() ? options->taskScheduler() : AbstractCanvas::defaultTaskScheduler();
+
+        if (options->parseAsynchronously() && parser->decodable() && scheduler->numThreads() > 0)
+            decodeAsynchronously(parser, filename, resolvedFilename, options, file, scheduler);
+        // memory mapped files are parsed in place
+        else if (file->memoryMapped())
+            parser->parse(filename, resolvedFilename, options, file->bytes(), file->size(), options->assetLibrary());
+        else
+            parser->parse(filename, resolvedFilename, options, file->data(), options->assetLibrary());
     }
     else
     {
@@ -232,13 +393,60 @@ Loader::processData(const std::string&                      filename,
             if (extension != "glsl")
                 LOG_DEBUG("no parser found for extension '" << extension << "'");
 
-            options->assetLibrary()->blob(filename, data);
+            options->assetLibrary()->blob(filename, file->data());
         }
     }
 
     return parser != nullptr;
 }
 
+void
+Loader::decodeAsynchronously(AbstractParser::Ptr    parser,
+                             const std::string&     filename,
+                             const std::string&     resolvedFilename,
+                             Options::Ptr           options,
+                             File::Ptr              file,
+                             async::TaskScheduler::Ptr scheduler)
+{
+    auto that = shared_from_this();
+
+    // the task holds the file, so its content remains valid while it is decoded
+    scheduler->schedule([=]()
+    {
+        std::string errorMessage;
+
+        try
+        {
+            parser->decode(filename, resolvedFilename, options, file->bytes(), file->size());
+        }
+        catch (const std::exception& e)
+        {
+            errorMessage = e.what();
+        }
+
+        scheduler->postToMainThread([=]()
+        {
+            if (errorMessage.empty())
+                parser->finalize(filename, resolvedFilename, options, options->assetLibrary());
+            else
+                that->decodeFailed(parser, Error("ParserError", filename + ": " + errorMessage));
+        });
+    });
+}
+
+void
+Loader::decodeFailed(AbstractParser::Ptr parser, const Error& error)
+{
+    // the parser will not complete: the file must not keep the loader from completing
+    --_numFilesToParse;
+    _parserCompleteSlots.erase(parser);
+    _parserErrorSlots.erase(parser);
+
+    errorThrown(error);
+
+    finalize();
+}
+
 void
 Loader::parserCompleteHandler(AbstractParser::Ptr parser)
 {
@@ -260,6 +468,7 @@ Loader::finalize()
     if (_loading.size() == 0 && _filesQueue.size() == 0 && _numFilesToParse == 0)
     {
         _protocolSlots.clear();
+        _protocolChunkSlots.clear();
         _parserErrorSlots.clear();
         _filenameToOptions.clear();
 
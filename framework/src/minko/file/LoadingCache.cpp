@@ -0,0 +1,161 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "minko/file/LoadingCache.hpp"
+
+#include "minko/file/File.hpp"
+
+using namespace minko;
+using namespace minko::file;
+
+LoadingCache::LoadingCache(uint budget) :
+    _budget(budget),
+    _size(0),
+    _numHits(0),
+    _numMisses(0),
+    _numCoalescedRequests(0)
+{
+}
+
+/*static*/
+std::string
+LoadingCache::key(const std::string& resolvedFilename, int offset, int length)
+{
+    if (offset == 0 && length == 0)
+        return resolvedFilename;
+
+    return resolvedFilename + "#" + std::to_string(offset) + "+" + std::to_string(length);
+}
+
+void
+LoadingCache::budget(uint budget)
+{
+    _budget = budget;
+
+    evict(budget);
+}
+
+bool
+LoadingCache::request(const std::string& resolvedFilename, const CompleteFunction& callback)
+{
+    auto fileIt = _files.find(resolvedFilename);
+
+    if (fileIt != _files.end())
+    {
+        ++_numHits;
+
+        _recentlyUsed.splice(_recentlyUsed.begin(), _recentlyUsed, fileIt->second.recentlyUsed);
+
+        auto file = fileIt->second.file;
+
+        callback(file);
+
+        return true;
+    }
+
+    auto pendingIt = _pending.find(resolvedFilename);
+
+    if (pendingIt != _pending.end())
+    {
+        ++_numCoalescedRequests;
+
+        pendingIt->second.push_back(callback);
+
+        return true;
+    }
+
+    ++_numMisses;
+
+    _pending[resolvedFilename];
+
+    return false;
+}
+
+void
+LoadingCache::complete(const std::string& resolvedFilename, File::Ptr file)
+{
+    remove(resolvedFilename);
+
+    // files larger than the whole budget are only shared with the pending requests
+    if (file->size() <= _budget)
+    {
+        evict(_budget - file->size());
+
+        _recentlyUsed.push_front(resolvedFilename);
+        _files[resolvedFilename] = Entry { file, _recentlyUsed.begin() };
+        _size += file->size();
+    }
+
+    auto pendingIt = _pending.find(resolvedFilename);
+
+    if (pendingIt == _pending.end())
+        return;
+
+    auto callbacks = std::move(pendingIt->second);
+
+    _pending.erase(pendingIt);
+
+    for (auto& callback : callbacks)
+        callback(file);
+}
+
+void
+LoadingCache::fail(const std::string& resolvedFilename)
+{
+    auto pendingIt = _pending.find(resolvedFilename);
+
+    if (pendingIt == _pending.end())
+        return;
+
+    auto callbacks = std::move(pendingIt->second);
+
+    _pending.erase(pendingIt);
+
+    for (auto& callback : callbacks)
+        callback(nullptr);
+}
+
+void
+LoadingCache::remove(const std::string& resolvedFilename)
+{
+    auto fileIt = _files.find(resolvedFilename);
+
+    if (fileIt == _files.end())
+        return;
+
+    _size -= fileIt->second.file->size();
+    _recentlyUsed.erase(fileIt->second.recentlyUsed);
+    _files.erase(fileIt);
+}
+
+void
+LoadingCache::clear()
+{
+    _files.clear();
+    _recentlyUsed.clear();
+    _size = 0;
+}
+
+void
+LoadingCache::evict(uint budget)
+{
+    while (_size > budget)
+        remove(_recentlyUsed.back());
+}
@@ -0,0 +1,177 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "minko/file/MemoryMappedFile.hpp"
+
+#if defined(_MSC_VER)
+# include <windows.h>
+#elif !defined(EMSCRIPTEN)
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+using namespace minko;
+using namespace minko::file;
+
+MemoryMappedFile::MemoryMappedFile() :
+    _mapping(nullptr),
+    _mappingSize(0),
+    _data(nullptr),
+    _size(0)
+#if defined(_MSC_VER)
+    , _file(INVALID_HANDLE_VALUE),
+    _fileMapping(nullptr)
+#endif
+{
+}
+
+/*static*/
+MemoryMappedFile::Ptr
+MemoryMappedFile::create(const std::string& filename, uint offset, uint length)
+{
+    auto file = std::shared_ptr<MemoryMappedFile>(new MemoryMappedFile());
+
+    return file->map(filename, offset, length) ? file : nullptr;
+}
+
+#if defined(_MSC_VER)
+
+bool
+MemoryMappedFile::map(const std::string& filename, uint offset, uint length)
+{
+    _file = CreateFileA(
+        filename.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr
+    );
+    if (_file == INVALID_HANDLE_VALUE)
+        return false;
+
+    LARGE_INTEGER fileSize;
+
+    if (!GetFileSizeEx(_file, &fileSize) || offset >= fileSize.QuadPart)
+        return false;
+
+    _size = length > 0 ? length : uint(fileSize.QuadPart - offset);
+    if (offset + _size > fileSize.QuadPart)
+        return false;
+
+    _fileMapping = CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (_fileMapping == nullptr)
+        return false;
+
+    // views start on a multiple of the allocation granularity
+    SYSTEM_INFO systemInfo;
+
+    GetSystemInfo(&systemInfo);
+
+    auto mappingOffset = offset - offset % systemInfo.dwAllocationGranularity;
+
+    _mappingSize = offset - mappingOffset + _size;
+    _mapping = MapViewOfFile(_fileMapping, FILE_MAP_READ, 0, mappingOffset, _mappingSize);
+    if (_mapping == nullptr)
+        return false;
+
+    _data = static_cast<const unsigned char*>(_mapping) + (offset - mappingOffset);
+
+    return true;
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+    if (_mapping != nullptr)
+        UnmapViewOfFile(_mapping);
+    if (_fileMapping != nullptr)
+        CloseHandle(_fileMapping);
+    if (_file != INVALID_HANDLE_VALUE)
+        CloseHandle(_file);
+}
+
+#elif !defined(EMSCRIPTEN)
+
+bool
+MemoryMappedFile::map(const std::string& filename, uint offset, uint length)
+{
+    auto fd = open(filename.c_str(), O_RDONLY);
+
+    if (fd < 0)
+        return false;
+
+    struct stat fileStat;
+
+    if (fstat(fd, &fileStat) != 0 || offset >= uint64_t(fileStat.st_size))
+    {
+        close(fd);
+
+        return false;
+    }
+
+    _size = length > 0 ? length : uint(fileStat.st_size - offset);
+    if (uint64_t(offset) + _size > uint64_t(fileStat.st_size))
+    {
+        close(fd);
+
+        return false;
+    }
+
+    // mappings start on a page boundary
+    auto pageSize       = uint(sysconf(_SC_PAGESIZE));
+    auto mappingOffset  = offset - offset % pageSize;
+
+    _mappingSize = offset - mappingOffset + _size;
+    _mapping = mmap(nullptr, _mappingSize, PROT_READ, MAP_PRIVATE, fd, mappingOffset);
+
+    // the mapping keeps its own reference to the file
+    close(fd);
+
+    if (_mapping == MAP_FAILED)
+    {
+        _mapping = nullptr;
+
+        return false;
+    }
+
+    // the whole range is about to be parsed
+    madvise(_mapping, _mappingSize, MADV_WILLNEED);
+
+    _data = static_cast<const unsigned char*>(_mapping) + (offset - mappingOffset);
+
+    return true;
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+    if (_mapping != nullptr)
+        munmap(_mapping, _mappingSize);
+}
+
+#else
+
+bool
+MemoryMappedFile::map(const std::string& filename, uint offset, uint length)
+{
+    return false;
+}
+
+MemoryMappedFile::~MemoryMappedFile()
+{
+}
+
+#endif
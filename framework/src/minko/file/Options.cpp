@@ -43,12 +43,16 @@ Options::Options() :
     _isCubeTexture(false),
     _startAnimation(true),
     _loadAsynchronously(false),
+    _memoryMapFiles(false),
+    _parseAsynchronously(false),
+    _streamFiles(false),
     _disposeIndexBufferAfterLoading(false),
     _disposeVertexBufferAfterLoading(false),
     _disposeTextureAfterLoading(false),
     _storeDataIfNotParsed(true),
     _skinningFramerate(30),
     _skinningMethod(component::SkinningMethod::HARDWARE),
+    _skinningCompressionTolerance(0.f),
     _material(nullptr),
     _effect(nullptr),
     _seekingOffset(0),
@@ -84,6 +88,7 @@ Options::Options(const Options& copy) :
     _storeDataIfNotParsed(copy._storeDataIfNotParsed),
     _skinningFramerate(copy._skinningFramerate),
     _skinningMethod(copy._skinningMethod),
+    _skinningCompressionTolerance(copy._skinningCompressionTolerance),
     _effect(copy._effect),
     _textureFormats(copy._textureFormats),
     _material(copy._material),
@@ -96,6 +101,11 @@ Options::Options(const Options& copy) :
     _effectFunction(copy._effectFunction),
     _textureFormatFunction(copy._textureFormatFunction),
     _loadAsynchronously(copy._loadAsynchronously),
+    _memoryMapFiles(copy._memoryMapFiles),
+    _parseAsynchronously(copy._parseAsynchronously),
+    _streamFiles(copy._streamFiles),
+    _loadingCache(copy._loadingCache),
+    _taskScheduler(copy._taskScheduler),
     _seekingOffset(copy._seekingOffset),
     _seekedLength(copy._seekedLength)
 {
@@ -0,0 +1,579 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "minko/geometry/BoundingVolumeHierarchy.hpp"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+# include <xmmintrin.h>
+# define MINKO_BVH_SSE
+#elif defined(__aarch64__)
+# include <arm_neon.h>
+# define MINKO_BVH_NEON
+#endif
+
+using namespace minko;
+using namespace minko::geometry;
+
+/*static*/ const uint   BoundingVolumeHierarchy::MAX_LEAF_SIZE  = 4 * BoundingVolumeHierarchy::PACKET_SIZE;
+/*static*/ const uint   BoundingVolumeHierarchy::LEAF           = 3;
+/*static*/ const float  BoundingVolumeHierarchy::EPSILON        = 0.00001f;
+
+namespace
+{
+    // the 4 triangles of a packet at a time
+#if defined(MINKO_BVH_SSE)
+    typedef __m128 Lanes;
+
+    inline Lanes load(const float* p)           { return _mm_loadu_ps(p); }
+    inline void store(float* p, Lanes a)        { _mm_storeu_ps(p, a); }
+    inline Lanes splat(float a)                 { return _mm_set1_ps(a); }
+    inline Lanes plus(Lanes a, Lanes b)         { return _mm_add_ps(a, b); }
+    inline Lanes minus(Lanes a, Lanes b)        { return _mm_sub_ps(a, b); }
+    inline Lanes times(Lanes a, Lanes b)        { return _mm_mul_ps(a, b); }
+    inline Lanes over(Lanes a, Lanes b)         { return _mm_div_ps(a, b); }
+#elif defined(MINKO_BVH_NEON)
+    typedef float32x4_t Lanes;
+
+    inline Lanes load(const float* p)           { return vld1q_f32(p); }
+    inline void store(float* p, Lanes a)        { vst1q_f32(p, a); }
+    inline Lanes splat(float a)                 { return vdupq_n_f32(a); }
+    inline Lanes plus(Lanes a, Lanes b)         { return vaddq_f32(a, b); }
+    inline Lanes minus(Lanes a, Lanes b)        { return vsubq_f32(a, b); }
+    inline Lanes times(Lanes a, Lanes b)        { return vmulq_f32(a, b); }
+    inline Lanes over(Lanes a, Lanes b)         { return vdivq_f32(a, b); }
+#else
+    struct Lanes
+    {
+        float v[4];
+    };
+
+    template <typename F>
+    inline
+    Lanes
+    apply(Lanes a, Lanes b, F f)
+    {
+        Lanes r;
+
+        for (uint i = 0; i < 4; ++i)
+            r.v[i] = f(a.v[i], b.v[i]);
+
+        return r;
+    }
+
+    inline Lanes load(const float* p)           { Lanes r; std::copy(p, p + 4, r.v); return r; }
+    inline void store(float* p, Lanes a)        { std::copy(a.v, a.v + 4, p); }
+    inline Lanes splat(float a)                 { Lanes r = { { a, a, a, a } }; return r; }
+    inline Lanes plus(Lanes a, Lanes b)         { return apply(a, b, [](float x, float y) { return x + y; }); }
+    inline Lanes minus(Lanes a, Lanes b)        { return apply(a, b, [](float x, float y) { return x - y; }); }
+    inline Lanes times(Lanes a, Lanes b)        { return apply(a, b, [](float x, float y) { return x * y; }); }
+    inline Lanes over(Lanes a, Lanes b)         { return apply(a, b, [](float x, float y) { return x / y; }); }
+#endif
+
+    inline
+    Lanes
+    dot(Lanes ax, Lanes ay, Lanes az, Lanes bx, Lanes by, Lanes bz)
+    {
+        return plus(plus(times(ax, bx), times(ay, by)), times(az, bz));
+    }
+
+    inline
+    void
+    cross(Lanes ax, Lanes ay, Lanes az, Lanes bx, Lanes by, Lanes bz, Lanes& x, Lanes& y, Lanes& z)
+    {
+        x = minus(times(ay, bz), times(az, by));
+        y = minus(times(az, bx), times(ax, bz));
+        z = minus(times(ax, by), times(ay, bx));
+    }
+
+    // half the area of the box, as only ratios of areas matter
+    inline
+    float
+    area(const float* min, const float* max)
+    {
+        const float dx = max[0] - min[0];
+        const float dy = max[1] - min[1];
+        const float dz = max[2] - min[2];
+
+        return dx * dy + dy * dz + dz * dx;
+    }
+
+    inline
+    uint
+    numPackets(uint numTriangles)
+    {
+        return (numTriangles + BoundingVolumeHierarchy::PACKET_SIZE - 1) / BoundingVolumeHierarchy::PACKET_SIZE;
+    }
+
+    inline
+    void
+    grow(float* min, float* max, const float* otherMin, const float* otherMax)
+    {
+        for (uint i = 0; i < 3; ++i)
+        {
+            min[i] = std::min(min[i], otherMin[i]);
+            max[i] = std::max(max[i], otherMax[i]);
+        }
+    }
+}
+
+BoundingVolumeHierarchy::BoundingVolumeHierarchy() :
+    _nodes(),
+    _packets(),
+    _numTriangles(0),
+    _depth(0)
+{
+}
+
+void
+BoundingVolumeHierarchy::build(const float* xyz, uint vertexSize, const std::vector<unsigned short>& indices)
+{
+    _numTriangles = indices.size() / 3;
+
+    if (_numTriangles == 0)
+        return;
+
+    std::vector<BuildTriangle> triangles(_numTriangles);
+
+    for (uint i = 0; i < _numTriangles; ++i)
+    {
+        auto& triangle = triangles[i];
+
+        triangle.triangle = i * 3;
+
+        for (uint j = 0; j < 3; ++j)
+            std::copy(xyz + indices[i * 3 + j] * vertexSize, xyz + indices[i * 3 + j] * vertexSize + 3, triangle.vertices[j]);
+
+        for (uint k = 0; k < 3; ++k)
+        {
+            triangle.min[k] = std::min(triangle.vertices[0][k], std::min(triangle.vertices[1][k], triangle.vertices[2][k]));
+            triangle.max[k] = std::max(triangle.vertices[0][k], std::max(triangle.vertices[1][k], triangle.vertices[2][k]));
+        }
+    }
+
+    _nodes.reserve(2 * numPackets(_numTriangles));
+    _packets.reserve(numPackets(_numTriangles) * 2);
+
+    buildNode(triangles, 0, _numTriangles, 0);
+
+    _nodes.shrink_to_fit();
+    _packets.shrink_to_fit();
+}
+
+void
+BoundingVolumeHierarchy::refit(const float* xyz, uint vertexSize, const std::vector<unsigned short>& indices)
+{
+    for (auto& packet : _packets)
+        for (uint j = 0; j < PACKET_SIZE; ++j)
+        {
+            const uint triangle = packet.triangles[j];
+
+            if (triangle == uint(-1))
+                continue;
+
+            const float* v0 = xyz + indices[triangle] * vertexSize;
+            const float* v1 = xyz + indices[triangle + 1] * vertexSize;
+            const float* v2 = xyz + indices[triangle + 2] * vertexSize;
+
+            for (uint k = 0; k < 3; ++k)
+            {
+                packet.v0[k][j] = v0[k];
+                packet.edge1[k][j] = v1[k] - v0[k];
+                packet.edge2[k][j] = v2[k] - v0[k];
+            }
+        }
+
+    // the children of a node are stored after it: the bounds are updated from the last node up
+    for (uint nodeId = _nodes.size(); nodeId-- > 0; )
+    {
+        auto& node = _nodes[nodeId];
+
+        if ((node.info & 3) != LEAF)
+        {
+            const auto& left = _nodes[nodeId + 1];
+
+            std::copy(left.min, left.min + 3, node.min);
+            std::copy(left.max, left.max + 3, node.max);
+            grow(node.min, node.max, _nodes[node.offset].min, _nodes[node.offset].max);
+
+            continue;
+        }
+
+        std::fill(node.min, node.min + 3, std::numeric_limits<float>::max());
+        std::fill(node.max, node.max + 3, -std::numeric_limits<float>::max());
+
+        const uint packetsEnd = node.offset + (node.info >> 2);
+
+        for (uint packetId = node.offset; packetId < packetsEnd; ++packetId)
+        {
+            const auto& packet = _packets[packetId];
+
+            for (uint j = 0; j < PACKET_SIZE; ++j)
+            {
+                if (packet.triangles[j] == uint(-1))
+                    continue;
+
+                for (uint k = 0; k < 3; ++k)
+                {
+                    const float v0 = packet.v0[k][j];
+                    const float v1 = v0 + packet.edge1[k][j];
+                    const float v2 = v0 + packet.edge2[k][j];
+
+                    node.min[k] = std::min(node.min[k], std::min(v0, std::min(v1, v2)));
+                    node.max[k] = std::max(node.max[k], std::max(v0, std::max(v1, v2)));
+                }
+            }
+        }
+    }
+}
+
+void
+BoundingVolumeHierarchy::buildNode(std::vector<BuildTriangle>& triangles, uint begin, uint end, uint depth)
+{
+    const uint index = _nodes.size();
+    Node node;
+
+    std::copy(triangles[begin].min, triangles[begin].min + 3, node.min);
+    std::copy(triangles[begin].max, triangles[begin].max + 3, node.max);
+    for (uint i = begin + 1; i < end; ++i)
+        grow(node.min, node.max, triangles[i].min, triangles[i].max);
+
+    _nodes.push_back(node);
+    _depth = std::max(_depth, depth + 1);
+
+    const uint numTriangles = end - begin;
+
+    if (numTriangles <= PACKET_SIZE || depth >= MAX_DEPTH)
+    {
+        buildLeaf(_nodes[index], triangles, begin, end);
+
+        return;
+    }
+
+    uint axis = 0;
+    uint middle = split(triangles, begin, end, node, axis);
+
+    if (middle == begin)
+    {
+        if (numTriangles <= MAX_LEAF_SIZE)
+        {
+            buildLeaf(_nodes[index], triangles, begin, end);
+
+            return;
+        }
+
+        // no split is worth it but the leaf would be too large: split in two halves along the largest axis
+        axis = 0;
+        for (uint k = 1; k < 3; ++k)
+            if (node.max[k] - node.min[k] > node.max[axis] - node.min[axis])
+                axis = k;
+
+        middle = begin + numTriangles / 2;
+        std::nth_element(
+            triangles.begin() + begin,
+            triangles.begin() + middle,
+            triangles.begin() + end,
+            [axis](const BuildTriangle& a, const BuildTriangle& b)
+            {
+                return a.min[axis] + a.max[axis] < b.min[axis] + b.max[axis];
+            }
+        );
+    }
+
+    _nodes[index].info = axis;
+
+    buildNode(triangles, begin, middle, depth + 1);
+    _nodes[index].offset = _nodes.size();
+    buildNode(triangles, middle, end, depth + 1);
+}
+
+void
+BoundingVolumeHierarchy::buildLeaf(Node& node, std::vector<BuildTriangle>& triangles, uint begin, uint end)
+{
+    const uint numLeafPackets = numPackets(end - begin);
+
+    node.offset = _packets.size();
+    node.info = (numLeafPackets << 2) | LEAF;
+
+    for (uint i = 0; i < numLeafPackets; ++i)
+    {
+        Packet packet;
+
+        for (uint j = 0; j < PACKET_SIZE; ++j)
+        {
+            const uint triangleId = begin + i * PACKET_SIZE + j;
+
+            // the lanes left empty hold degenerate triangles, which are never hit
+            if (triangleId >= end)
+            {
+                for (uint k = 0; k < 3; ++k)
+                {
+                    packet.v0[k][j] = 0.f;
+                    packet.edge1[k][j] = 0.f;
+                    packet.edge2[k][j] = 0.f;
+                }
+                packet.triangles[j] = uint(-1);
+
+                continue;
+            }
+
+            const auto& triangle = triangles[triangleId];
+
+            for (uint k = 0; k < 3; ++k)
+            {
+                packet.v0[k][j] = triangle.vertices[0][k];
+                packet.edge1[k][j] = triangle.vertices[1][k] - triangle.vertices[0][k];
+                packet.edge2[k][j] = triangle.vertices[2][k] - triangle.vertices[0][k];
+            }
+            packet.triangles[j] = triangle.triangle;
+        }
+
+        _packets.push_back(packet);
+    }
+}
+
+uint
+BoundingVolumeHierarchy::split(std::vector<BuildTriangle>& triangles, uint begin, uint end, const Node& node, uint& axis) const
+{
+    float centerMin[3] = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+    float centerMax[3] = { -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max() };
+
+    for (uint i = begin; i < end; ++i)
+        for (uint k = 0; k < 3; ++k)
+        {
+            const float center = .5f * (triangles[i].min[k] + triangles[i].max[k]);
+
+            centerMin[k] = std::min(centerMin[k], center);
+            centerMax[k] = std::max(centerMax[k], center);
+        }
+
+    // splitting costs a traversal step, then each side costs its packets weighted by its area
+    const float nodeArea = area(node.min, node.max);
+    float bestCost = nodeArea * numPackets(end - begin);
+    uint bestBin = NUM_BINS;
+
+    for (uint k = 0; k < 3; ++k)
+    {
+        if (centerMax[k] <= centerMin[k])
+            continue;
+
+        const float scale = NUM_BINS / (centerMax[k] - centerMin[k]);
+        uint binCount[NUM_BINS] = { 0 };
+        float binMin[NUM_BINS][3];
+        float binMax[NUM_BINS][3];
+
+        for (uint b = 0; b < NUM_BINS; ++b)
+            for (uint c = 0; c < 3; ++c)
+            {
+                binMin[b][c] = std::numeric_limits<float>::max();
+                binMax[b][c] = -std::numeric_limits<float>::max();
+            }
+
+        for (uint i = begin; i < end; ++i)
+        {
+            const float center = .5f * (triangles[i].min[k] + triangles[i].max[k]);
+            const uint bin = std::min(uint((center - centerMin[k]) * scale), NUM_BINS - 1);
+
+            ++binCount[bin];
+            grow(binMin[bin], binMax[bin], triangles[i].min, triangles[i].max);
+        }
+
+        // areas and counts of the bins left of each split, then right of it
+        float leftArea[NUM_BINS - 1];
+        uint leftCount[NUM_BINS - 1];
+        float min[3] = { std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+        float max[3] = { -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max() };
+        uint count = 0;
+
+        for (uint b = 0; b < NUM_BINS - 1; ++b)
+        {
+            count += binCount[b];
+            if (binCount[b] != 0)
+                grow(min, max, binMin[b], binMax[b]);
+            leftCount[b] = count;
+            leftArea[b] = count != 0 ? area(min, max) : 0.f;
+        }
+
+        std::fill(min, min + 3, std::numeric_limits<float>::max());
+        std::fill(max, max + 3, -std::numeric_limits<float>::max());
+        count = 0;
+
+        for (uint b = NUM_BINS - 1; b > 0; --b)
+        {
+            count += binCount[b];
+            if (binCount[b] != 0)
+                grow(min, max, binMin[b], binMax[b]);
+
+            if (count == 0 || leftCount[b - 1] == 0)
+                continue;
+
+            const float cost = nodeArea + leftArea[b - 1] * numPackets(leftCount[b - 1]) + area(min, max) * numPackets(count);
+
+            if (cost < bestCost)
+            {
+                bestCost = cost;
+                bestBin = b;
+                axis = k;
+            }
+        }
+    }
+
+    if (bestBin == NUM_BINS)
+        return begin;
+
+    const float scale = NUM_BINS / (centerMax[axis] - centerMin[axis]);
+    const float minCenter = centerMin[axis];
+    const uint splitAxis = axis;
+    const uint splitBin = bestBin;
+
+    auto middle = std::partition(triangles.begin() + begin, triangles.begin() + end, [=](const BuildTriangle& triangle)
+    {
+        const float center = .5f * (triangle.min[splitAxis] + triangle.max[splitAxis]);
+
+        return std::min(uint((center - minCenter) * scale), NUM_BINS - 1) < splitBin;
+    });
+
+    return middle - triangles.begin();
+}
+
+bool
+BoundingVolumeHierarchy::cast(const float*  origin,
+                              const float*  direction,
+                              float&        distance,
+                              uint&         triangle,
+                              float&        u,
+                              float&        v) const
+{
+    if (_nodes.empty())
+        return false;
+
+    const float invDirection[3] = { 1.f / direction[0], 1.f / direction[1], 1.f / direction[2] };
+    const Lanes ox = splat(origin[0]);
+    const Lanes oy = splat(origin[1]);
+    const Lanes oz = splat(origin[2]);
+    const Lanes dx = splat(direction[0]);
+    const Lanes dy = splat(direction[1]);
+    const Lanes dz = splat(direction[2]);
+    const Lanes one = splat(1.f);
+
+    auto hit = false;
+    auto minDistance = std::numeric_limits<float>::infinity();
+    uint stack[MAX_DEPTH + 2];
+    uint stackSize = 0;
+
+    stack[stackSize++] = 0;
+
+    while (stackSize != 0)
+    {
+        const uint nodeId = stack[--stackSize];
+        const auto& node = _nodes[nodeId];
+
+        // slabs test, also skipping the nodes behind the nearest hit found so far
+        auto entry = 0.f;
+        auto exit = minDistance;
+        auto outside = false;
+
+        for (uint k = 0; k < 3; ++k)
+        {
+            // a ray parallel to the slab never crosses its planes (0 * inf would be NaN): it only
+            // depends on whether the origin lies within the slab
+            if (direction[k] == 0.f)
+            {
+                outside = outside || origin[k] < node.min[k] || origin[k] > node.max[k];
+
+                continue;
+            }
+
+            const float t1 = (node.min[k] - origin[k]) * invDirection[k];
+            const float t2 = (node.max[k] - origin[k]) * invDirection[k];
+
+            entry = std::max(entry, std::min(t1, t2));
+            exit = std::min(exit, std::max(t1, t2));
+        }
+
+        if (outside || entry > exit)
+            continue;
+
+        if ((node.info & 3) != LEAF)
+        {
+            // front to back, so that the nearest hits prune the farthest nodes
+            const uint axis = node.info;
+            const bool backward = direction[axis] < 0.f;
+
+            stack[stackSize++] = backward ? nodeId + 1 : node.offset;
+            stack[stackSize++] = backward ? node.offset : nodeId + 1;
+
+            continue;
+        }
+
+        const uint packetsEnd = node.offset + (node.info >> 2);
+
+        for (uint packetId = node.offset; packetId < packetsEnd; ++packetId)
+        {
+            const auto& packet = _packets[packetId];
+
+            // Moller-Trumbore on the 4 triangles
+            const Lanes e1x = load(packet.edge1[0]);
+            const Lanes e1y = load(packet.edge1[1]);
+            const Lanes e1z = load(packet.edge1[2]);
+            const Lanes e2x = load(packet.edge2[0]);
+            const Lanes e2y = load(packet.edge2[1]);
+            const Lanes e2z = load(packet.edge2[2]);
+            const Lanes tx = minus(ox, load(packet.v0[0]));
+            const Lanes ty = minus(oy, load(packet.v0[1]));
+            const Lanes tz = minus(oz, load(packet.v0[2]));
+            Lanes px, py, pz, qx, qy, qz;
+
+            cross(dx, dy, dz, e2x, e2y, e2z, px, py, pz);
+            cross(tx, ty, tz, e1x, e1y, e1z, qx, qy, qz);
+
+            const Lanes det = dot(e1x, e1y, e1z, px, py, pz);
+            const Lanes invDet = over(one, det);
+            float dets[PACKET_SIZE];
+            float us[PACKET_SIZE];
+            float vs[PACKET_SIZE];
+            float ts[PACKET_SIZE];
+
+            store(dets, det);
+            store(us, times(dot(tx, ty, tz, px, py, pz), invDet));
+            store(vs, times(dot(dx, dy, dz, qx, qy, qz), invDet));
+            store(ts, times(dot(e2x, e2y, e2z, qx, qy, qz), invDet));
+
+            for (uint j = 0; j < PACKET_SIZE; ++j)
+            {
+                if ((dets[j] > -EPSILON && dets[j] < EPSILON)
+                    || us[j] < 0.f || us[j] > 1.f
+                    || vs[j] < 0.f || us[j] + vs[j] > 1.f
+                    || ts[j] < 0.f || !(ts[j] < minDistance))
+                    continue;
+
+                hit = true;
+                minDistance = ts[j];
+                triangle = packet.triangles[j];
+                u = us[j];
+                v = vs[j];
+            }
+        }
+    }
+
+    if (hit)
+        distance = minDistance;
+
+    return hit;
+}
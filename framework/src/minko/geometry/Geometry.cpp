@@ -19,6 +19,9 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 #include "minko/geometry/Geometry.hpp"
 
+#include "minko/AbstractCanvas.hpp"
+#include "minko/async/TaskScheduler.hpp"
+#include "minko/geometry/BoundingVolumeHierarchy.hpp"
 #include "minko/math/Vector2.hpp"
 #include "minko/math/Vector3.hpp"
 #include "minko/math/Ray.hpp"
@@ -30,11 +33,16 @@ using namespace minko::math;
 using namespace minko::geometry;
 using namespace minko::render;
 
+/*static*/ const unsigned int Geometry::MIN_NUM_RAYS_PER_TASK = 64;
+
 Geometry::Geometry() :
     _data(data::ArrayProvider::create("geometry")),
     _vertexSize(0),
     _numVertices(0),
-    _indexBuffer(nullptr)
+    _indexBuffer(nullptr),
+    _indicesChangedSlot(nullptr),
+    _boundingVolumeHierarchy(nullptr),
+    _boundingVolumeHierarchyOutdated(false)
 {
 }
 
@@ -43,8 +51,20 @@ Geometry::Geometry(const Geometry& geometry) :
 	_vertexSize(geometry._vertexSize),
 	_numVertices(geometry._numVertices),
 	_vertexBuffers(geometry._vertexBuffers),
-	_indexBuffer(geometry._indexBuffer)
+	_indexBuffer(nullptr),
+	_indicesChangedSlot(nullptr),
+	_boundingVolumeHierarchy(geometry._boundingVolumeHierarchy),
+	_boundingVolumeHierarchyOutdated(geometry._boundingVolumeHierarchyOutdated)
 {
+	for (const auto& vertexBuffer : _vertexBuffers)
+		_vbToChangedSlot[vertexBuffer] = vertexBuffer->changed()->connect(std::bind(
+			&Geometry::vertexBufferChanged,
+			this,
+			std::placeholders::_1
+		));
+
+	if (geometry._indexBuffer)
+		indices(geometry._indexBuffer);
 }
 
 std::shared_ptr<Geometry>
@@ -82,6 +102,15 @@ Geometry::addVertexBuffer(render::VertexBuffer::Ptr vertexBuffer)
         std::placeholders::_1,
         std::placeholders::_2
     ));
+
+    _vbToChangedSlot[vertexBuffer] = vertexBuffer->changed()->connect(std::bind(
+        &Geometry::vertexBufferChanged,
+        this,
+        std::placeholders::_1
+    ));
+
+    if (vertexBuffer->hasAttribute("position"))
+        _boundingVolumeHierarchy = nullptr;
 }
 
 void
@@ -102,6 +131,31 @@ Geometry::removeVertexBuffer(std::list<render::VertexBuffer::Ptr>::iterator vert
         _numVertices = 0;
 
     _vbToVertexSizeChangedSlot.erase(vertexBuffer);
+    _vbToChangedSlot.erase(vertexBuffer);
+
+    if (vertexBuffer->hasAttribute("position"))
+        _boundingVolumeHierarchy = nullptr;
+}
+
+void
+Geometry::vertexBufferChanged(VBPtr vertexBuffer)
+{
+    // positions uploaded every frame (software skinning) must not rebuild the hierarchy each time
+    if (vertexBuffer->hasAttribute("position"))
+        _boundingVolumeHierarchyOutdated = true;
+}
+
+void
+Geometry::indices(IndexBuffer::Ptr indices)
+{
+    _indexBuffer = indices;
+    _data->set("indices", indices);
+
+    _boundingVolumeHierarchy = nullptr;
+    _indicesChangedSlot = indices == nullptr ? nullptr : indices->changed()->connect([&](IndexBuffer::Ptr)
+    {
+        _boundingVolumeHierarchy = nullptr;
+    });
 }
 
 void
@@ -355,6 +409,25 @@ Geometry::removeDuplicatedVertices(std::vector<unsigned short>&        indices,
         index = oldVertexIdToNewVertexId[index];
 }
 
+Geometry::BVHPtr
+Geometry::boundingVolumeHierarchy()
+{
+    if (_boundingVolumeHierarchy == nullptr || _boundingVolumeHierarchyOutdated)
+    {
+        auto xyzBuffer = vertexBuffer("position");
+        auto xyz = &xyzBuffer->data()[0] + std::get<2>(*xyzBuffer->attribute("position"));
+
+        if (_boundingVolumeHierarchy == nullptr)
+            _boundingVolumeHierarchy = BoundingVolumeHierarchy::create(xyz, xyzBuffer->vertexSize(), _indexBuffer->data());
+        else
+            _boundingVolumeHierarchy->refit(xyz, xyzBuffer->vertexSize(), _indexBuffer->data());
+
+        _boundingVolumeHierarchyOutdated = false;
+    }
+
+    return _boundingVolumeHierarchy;
+}
+
 bool
 Geometry::cast(std::shared_ptr<math::Ray>    ray,
                float&                        distance,
@@ -363,95 +436,77 @@ Geometry::cast(std::shared_ptr<math::Ray>    ray,
                std::shared_ptr<Vector2>        hitUv,
                std::shared_ptr<Vector3>        hitNormal)
 {
-    static const auto EPSILON = 0.00001f;
-
-    auto hit = false;
-    auto& indicesData = _indexBuffer->data();
-    auto numIndices = indicesData.size();
-
-    auto xyzBuffer = vertexBuffer("position");
-    auto& xyzData = xyzBuffer->data();
-    auto xyzPtr = &xyzData[0];
-    auto xyzVertexSize = xyzBuffer->vertexSize();
-    auto xyzOffset = std::get<2>(*xyzBuffer->attribute("position"));
-
-    auto minDistance = std::numeric_limits<float>::infinity();
-    auto lambda = hitUv ? Vector2::create() : nullptr;
-    auto triangleIndice = -3;
-
-    auto v0 = Vector3::create();
-    auto v1 = Vector3::create();
-    auto v2 = Vector3::create();
-    auto edge1 = Vector3::create();
-    auto edge2 = Vector3::create();
-    auto pvec = Vector3::create();
-    auto tvec = Vector3::create();
-    auto qvec = Vector3::create();
-    auto dot = 0.f;
-    auto invDot = 0.f;
+    const float origin[3] = { ray->origin()->x(), ray->origin()->y(), ray->origin()->z() };
+    const float direction[3] = { ray->direction()->x(), ray->direction()->y(), ray->direction()->z() };
     auto u = 0.f;
     auto v = 0.f;
-    auto t = 0.f;
 
-    for (uint i = 0; i < numIndices; i += 3)
-    {
-        v0->copyFrom(xyzPtr + indicesData[i] * xyzVertexSize);
-        v1->copyFrom(xyzPtr + indicesData[i + 1] * xyzVertexSize);
-        v2->copyFrom(xyzPtr + indicesData[i + 2] * xyzVertexSize);
+    if (!boundingVolumeHierarchy()->cast(origin, direction, distance, triangle, u, v))
+        return false;
 
-        edge1->copyFrom(v1)->subtract(v0);
-        edge2->copyFrom(v2)->subtract(v0);
+    if (hitXyz)
+        hitXyz->setTo(
+            origin[0] + distance * direction[0],
+            origin[1] + distance * direction[1],
+            origin[2] + distance * direction[2]
+        );
 
-        pvec->copyFrom(ray->direction())->cross(edge2);
-        dot = edge1->dot(pvec);
+    if (hitUv)
+        getHitUv(triangle, Vector2::create(u, v), hitUv);
 
-        if (dot > -EPSILON && dot < EPSILON)
-            continue;
+    if (hitNormal)
+        getHitNormal(triangle, hitNormal);
 
-        invDot = 1.f / dot;
+    return true;
+}
 
-        tvec->copyFrom(ray->origin())->subtract(v0);
-        u = tvec->dot(pvec) * invDot;
-        if (u < 0.f || u > 1.f)
-            continue;
+uint
+Geometry::cast(const std::vector<std::shared_ptr<math::Ray>>&    rays,
+               std::vector<float>&                               distances,
+               std::vector<uint>&                                triangles)
+{
+    const uint numRays = rays.size();
+    auto bvh = boundingVolumeHierarchy();
+    std::vector<float> origins(numRays * 3);
+    std::vector<float> directions(numRays * 3);
 
-        qvec->copyFrom(tvec)->cross(edge1);
-        v = ray->direction()->dot(qvec) * invDot;
-        if (v < 0.f || u + v > 1.f)
-            continue;
+    // the rays are read here since their vectors are not meant to be shared between threads
+    for (uint i = 0; i < numRays; ++i)
+    {
+        auto origin = rays[i]->origin();
+        auto direction = rays[i]->direction();
+
+        origins[i * 3] = origin->x();
+        origins[i * 3 + 1] = origin->y();
+        origins[i * 3 + 2] = origin->z();
+        directions[i * 3] = direction->x();
+        directions[i * 3 + 1] = direction->y();
+        directions[i * 3 + 2] = direction->z();
+    }
 
-        t = edge2->dot(qvec) * invDot;
-        if (t < minDistance)
-        {
-            minDistance = t;
-            distance = t;
-            triangle = i;
-            hit = true;
+    distances.assign(numRays, std::numeric_limits<float>::infinity());
+    triangles.resize(numRays);
 
-            if (hitUv)
-            {
-                lambda->x(u);
-                lambda->y(v);
-            }
+    auto castRays = [&](uint begin, uint end)
+    {
+        auto u = 0.f;
+        auto v = 0.f;
 
-            if (hitXyz)
-            {
-                hitXyz->setTo(
-                    ray->origin()->x() + minDistance * ray->direction()->x(),
-                    ray->origin()->y() + minDistance * ray->direction()->y(),
-                    ray->origin()->z() + minDistance * ray->direction()->z()
-                    );
-            }
-        }
+        for (uint i = begin; i < end; ++i)
+            bvh->cast(&origins[i * 3], &directions[i * 3], distances[i], triangles[i], u, v);
+    };
 
-        if (hitUv)
-            getHitUv(triangle, lambda, hitUv);
+    auto scheduler = AbstractCanvas::defaultTaskScheduler();
 
-        if (hitNormal)
-            getHitNormal(triangle, hitNormal);
-    }
+    if (numRays < MIN_NUM_RAYS_PER_TASK * 2 || scheduler->numThreads() == 0)
+        castRays(0, numRays);
+    else
+        scheduler->parallelFor(0, numRays, castRays, MIN_NUM_RAYS_PER_TASK);
 
-    return hit;
+    return std::count_if(distances.begin(), distances.end(), [](float distance)
+    {
+        return distance != std::numeric_limits<float>::infinity();
+    });
 }
 
 void
@@ -22,22 +22,31 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include <minko/scene/Node.hpp>
 #include <minko/math/Matrix4x4.hpp>
 #include <minko/geometry/Bone.hpp>
+#include <minko/geometry/SkinClip.hpp>
 
 using namespace minko;
 using namespace minko::scene;
 using namespace minko::math;
 using namespace minko::geometry;
 
+/*static*/ const unsigned int Skin::NUM_BONES_PER_SLOT = 4;
+
 Skin::Skin(unsigned int numBones, unsigned int duration, unsigned int numFrames):
     _bones(numBones, nullptr),
     _numBones(numBones),
     _duration(duration),
     _timeFactor(duration > 0 ? numFrames / float(duration) : 0.0f),
     _boneMatricesPerFrame(numFrames, std::vector<float>(numBones << 4, 0.0f)),
+    _clip(nullptr),
+    _clipMatrices(),
+    _clipFrameId(-1),
     _maxNumVertexBones(0),
     _numVertexBones(),
     _vertexBones(),
-    _vertexBoneWeights()
+    _vertexBoneWeights(),
+    _slotsOffsets(),
+    _slotsBoneIds(),
+    _slotsBoneWeights()
 {
 
 }
@@ -48,10 +57,16 @@ Skin::Skin(const Skin& skin) :
 	_duration(skin._duration),
 	_timeFactor(skin._timeFactor),
 	_boneMatricesPerFrame(skin._boneMatricesPerFrame),
+	_clip(skin._clip),
+	_clipMatrices(),
+	_clipFrameId(-1),
 	_maxNumVertexBones(skin._maxNumVertexBones),
 	_numVertexBones(skin._numVertexBones),
 	_vertexBones(skin._vertexBones),
-	_vertexBoneWeights(skin._vertexBoneWeights)
+	_vertexBoneWeights(skin._vertexBoneWeights),
+	_slotsOffsets(skin._slotsOffsets),
+	_slotsBoneIds(skin._slotsBoneIds),
+	_slotsBoneWeights(skin._slotsBoneWeights)
 {
 
 }
@@ -64,11 +79,72 @@ Skin::clone()
 	return skin;
 }
 
+unsigned int
+Skin::numFrames() const
+{
+    return _clip ? _clip->numFrames() : _boneMatricesPerFrame.size();
+}
+
+void
+Skin::setBoneMatricesPerFrame(std::vector<std::vector<float>> boneMatricesPerFrame)
+{
+    _boneMatricesPerFrame   = boneMatricesPerFrame;
+    _clip                   = nullptr;
+    _clipFrameId            = -1;
+}
+
+std::vector<std::vector<float>>
+Skin::getBoneMatricesPerFrame()
+{
+    if (!_clip)
+        return _boneMatricesPerFrame;
+
+    std::vector<std::vector<float>> boneMatricesPerFrame(_clip->numFrames(), std::vector<float>(_numBones << 4));
+
+    for (unsigned int frameId = 0; frameId < boneMatricesPerFrame.size(); ++frameId)
+        _clip->matrices(frameId, boneMatricesPerFrame[frameId].data());
+
+    return boneMatricesPerFrame;
+}
+
+const std::vector<float>&
+Skin::matrices(unsigned int frameId) const
+{
+    if (!_clip)
+        return _boneMatricesPerFrame[frameId];
+
+    if (_clipFrameId != int(frameId))
+    {
+        _clipMatrices.resize(_numBones << 4);
+        _clip->matrices(frameId, _clipMatrices.data());
+        _clipFrameId = frameId;
+    }
+
+    return _clipMatrices;
+}
+
+Skin::Ptr
+Skin::compressMatrices(float tolerance)
+{
+    if (_clip)
+        return shared_from_this();
+
+    _clip = SkinClip::create(_numBones, _boneMatricesPerFrame, tolerance);
+
+    _boneMatricesPerFrame.clear();
+    _boneMatricesPerFrame.shrink_to_fit();
+
+    return shared_from_this();
+}
+
 void
 Skin::matrix(unsigned int    frameId,
              unsigned int    boneId,
              Matrix4x4::Ptr    value)
 {
+    if (_clip)
+        throw std::logic_error("The matrices of a compressed skin cannot be changed.");
+
 #ifdef DEBUG_SKINNING
     assert(frameId < numFrames() && boneId < numBones());
 #endif // DEBUG_SKINNING
@@ -127,9 +203,96 @@ Skin::reorganizeByVertices()
     for (unsigned int vId = 0; vId < numVertices; ++vId)
         _maxNumVertexBones = std::max(_maxNumVertexBones, _numVertexBones[vId]);
 
+    packSlots();
+
     return shared_from_this();
 }
 
+void
+Skin::packSlots()
+{
+    const unsigned int numVertices = _numVertexBones.size();
+
+    _slotsOffsets.resize(numVertices + 1);
+    _slotsOffsets[0] = 0;
+    for (unsigned int vId = 0; vId < numVertices; ++vId)
+    {
+        const unsigned int numSlots = (_numVertexBones[vId] + NUM_BONES_PER_SLOT - 1) / NUM_BONES_PER_SLOT;
+
+        _slotsOffsets[vId + 1] = _slotsOffsets[vId] + numSlots * NUM_BONES_PER_SLOT;
+    }
+
+    _slotsBoneIds.assign(_slotsOffsets[numVertices], 0);
+    _slotsBoneWeights.assign(_slotsOffsets[numVertices], 0.0f);
+
+    for (unsigned int vId = 0; vId < numVertices; ++vId)
+        for (unsigned int j = 0; j < _numVertexBones[vId]; ++j)
+        {
+            const unsigned int index = vertexArraysIndex(vId, j);
+
+            _slotsBoneIds[_slotsOffsets[vId] + j]       = _vertexBones[index];
+            _slotsBoneWeights[_slotsOffsets[vId] + j]   = _vertexBoneWeights[index];
+        }
+}
+
+void
+Skin::reducedSlots(unsigned int                 maxNumBones,
+                   std::vector<unsigned int>&   offsets,
+                   std::vector<unsigned int>&   boneIds,
+                   std::vector<float>&          boneWeights) const
+{
+    if (maxNumBones == 0)
+        throw std::invalid_argument("maxNumBones");
+
+    const unsigned int numVertices = _numVertexBones.size();
+    std::vector<std::pair<float, unsigned int>> influences;
+
+    offsets.resize(numVertices + 1);
+    offsets[0] = 0;
+    boneIds.clear();
+    boneWeights.clear();
+
+    for (unsigned int vId = 0; vId < numVertices; ++vId)
+    {
+        influences.clear();
+        for (unsigned int j = 0; j < _numVertexBones[vId]; ++j)
+        {
+            const unsigned int index = vertexArraysIndex(vId, j);
+
+            influences.push_back(std::make_pair(_vertexBoneWeights[index], _vertexBones[index]));
+        }
+
+        const unsigned int numBones = std::min(maxNumBones, (unsigned int)influences.size());
+
+        std::partial_sort(
+            influences.begin(),
+            influences.begin() + numBones,
+            influences.end(),
+            [](const std::pair<float, unsigned int>& a, const std::pair<float, unsigned int>& b)
+            {
+                return a.first > b.first;
+            }
+        );
+
+        float totalWeight = 0.0f;
+
+        for (unsigned int j = 0; j < numBones; ++j)
+            totalWeight += influences[j].first;
+
+        const unsigned int numSlots = (numBones + NUM_BONES_PER_SLOT - 1) / NUM_BONES_PER_SLOT;
+
+        offsets[vId + 1] = offsets[vId] + numSlots * NUM_BONES_PER_SLOT;
+        boneIds.resize(offsets[vId + 1], 0);
+        boneWeights.resize(offsets[vId + 1], 0.0f);
+
+        for (unsigned int j = 0; j < numBones; ++j)
+        {
+            boneIds[offsets[vId] + j]       = influences[j].second;
+            boneWeights[offsets[vId] + j]   = totalWeight > 0.0f ? influences[j].first / totalWeight : 0.0f;
+        }
+    }
+}
+
 unsigned short
 Skin::lastVertexId() const
 {
@@ -190,6 +353,9 @@ Skin::disposeBones()
 Skin::Ptr
 Skin::transposeMatrices()
 {
+    if (_clip)
+        throw std::logic_error("The matrices of a compressed skin cannot be changed.");
+
     for (auto& frameMatrices : _boneMatricesPerFrame)
     {
         assert(frameMatrices.size() % 16 == 0);
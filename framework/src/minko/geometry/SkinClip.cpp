@@ -0,0 +1,351 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "minko/geometry/SkinClip.hpp"
+#include "minko/animation/Pose.hpp"
+
+using namespace minko;
+using namespace minko::geometry;
+
+/*static*/ const float   SkinClip::DEFAULT_TOLERANCE = 1e-3f;
+/*static*/ const uint    SkinClip::NO_BAKED_MATRICES = uint(-1);
+
+namespace
+{
+    struct Pose
+    {
+        float translation[3];
+        float rotation[4];      // x y z w
+        float scale[3];
+        short quantizedRotation[4];
+    };
+
+    inline
+    short
+    quantize(float value)
+    {
+        return short(floorf(std::max(-1.0f, std::min(1.0f, value)) * 32767.0f + 0.5f));
+    }
+
+    inline
+    float
+    dequantize(short value)
+    {
+        return float(value) / 32767.0f;
+    }
+
+    inline
+    void
+    normalize(float* quaternion)
+    {
+        const float length = sqrtf(
+            quaternion[0] * quaternion[0] + quaternion[1] * quaternion[1]
+            + quaternion[2] * quaternion[2] + quaternion[3] * quaternion[3]
+        );
+
+        for (uint i = 0; i < 4; ++i)
+            quaternion[i] /= length;
+    }
+
+    inline
+    bool
+    decompose(const float* m, Pose& pose)
+    {
+        return animation::Pose::decomposeMatrix(m, pose.translation, pose.rotation, pose.scale);
+    }
+
+    inline
+    void
+    compose(const Pose& pose, float* m)
+    {
+        animation::Pose::composeMatrix(pose.translation, pose.rotation, pose.scale, m);
+    }
+
+    // translations and scales are interpolated linearly, rotations along the shortest path
+    void
+    interpolate(const Pose& a, const Pose& b, float ratio, Pose& output)
+    {
+        const float dot = a.rotation[0] * b.rotation[0] + a.rotation[1] * b.rotation[1]
+            + a.rotation[2] * b.rotation[2] + a.rotation[3] * b.rotation[3];
+        const float sign = dot < 0.0f ? -1.0f : 1.0f;
+
+        for (uint i = 0; i < 3; ++i)
+        {
+            output.translation[i]   = a.translation[i] + (b.translation[i] - a.translation[i]) * ratio;
+            output.scale[i]         = a.scale[i] + (b.scale[i] - a.scale[i]) * ratio;
+        }
+
+        for (uint i = 0; i < 4; ++i)
+            output.rotation[i] = a.rotation[i] + (sign * b.rotation[i] - a.rotation[i]) * ratio;
+        normalize(output.rotation);
+    }
+
+    inline
+    float
+    difference(const float* a, const float* b)
+    {
+        float maxDifference = 0.0f;
+
+        for (uint i = 0; i < 16; ++i)
+            maxDifference = std::max(maxDifference, fabsf(a[i] - b[i]));
+
+        return maxDifference;
+    }
+}
+
+SkinClip::SkinClip(uint numBones, uint numFrames) :
+    _numBones(numBones),
+    _numFrames(numFrames),
+    _keysOffsets(),
+    _keyFrames(),
+    _keyTranslations(),
+    _keyRotations(),
+    _keyScales(),
+    _bakedOffsets(),
+    _bakedMatrices()
+{
+}
+
+void
+SkinClip::compress(const std::vector<std::vector<float>>& matricesPerFrame, float tolerance)
+{
+    if (_numFrames > 65536)
+        throw std::invalid_argument("matricesPerFrame");
+
+    for (auto& frameMatrices : matricesPerFrame)
+        if (frameMatrices.size() != (_numBones << 4))
+            throw std::invalid_argument("matricesPerFrame");
+
+    std::vector<Pose>                   poses(_numFrames);
+    std::vector<bool>                   isKey(_numFrames);
+    std::vector<std::pair<uint, uint>>  segments;
+    float                               matrix[16];
+
+    _keysOffsets.assign(_numBones + 1, 0);
+    _bakedOffsets.assign(_numBones, NO_BAKED_MATRICES);
+
+    for (uint boneId = 0; boneId < _numBones; ++boneId)
+    {
+        _keysOffsets[boneId] = _keyFrames.size();
+
+        if (_numFrames == 0)
+            continue;
+
+        // decompose every frame with the rotation that will be stored
+        bool decomposable = true;
+
+        for (uint frameId = 0; frameId < _numFrames && decomposable; ++frameId)
+        {
+            const float*    original    = &matricesPerFrame[frameId][boneId << 4];
+            auto&           pose        = poses[frameId];
+
+            decomposable = decompose(original, pose);
+            if (!decomposable)
+                break;
+
+            // consecutive rotations stay in the same hemisphere
+            if (frameId > 0)
+            {
+                const float* previous = poses[frameId - 1].rotation;
+
+                if (previous[0] * pose.rotation[0] + previous[1] * pose.rotation[1]
+                    + previous[2] * pose.rotation[2] + previous[3] * pose.rotation[3] < 0.0f)
+                    for (uint i = 0; i < 4; ++i)
+                        pose.rotation[i] = -pose.rotation[i];
+            }
+
+            for (uint i = 0; i < 4; ++i)
+            {
+                pose.quantizedRotation[i]   = quantize(pose.rotation[i]);
+                pose.rotation[i]            = dequantize(pose.quantizedRotation[i]);
+            }
+            normalize(pose.rotation);
+
+            compose(pose, matrix);
+            decomposable = difference(matrix, original) <= tolerance;
+        }
+
+        if (!decomposable)
+        {
+            _bakedOffsets[boneId] = _bakedMatrices.size();
+            for (uint frameId = 0; frameId < _numFrames; ++frameId)
+                _bakedMatrices.insert(
+                    _bakedMatrices.end(),
+                    matricesPerFrame[frameId].begin() + (boneId << 4),
+                    matricesPerFrame[frameId].begin() + ((boneId + 1) << 4)
+                );
+
+            continue;
+        }
+
+        // split the segments between keys on their worst frame until they all fit
+        isKey.assign(_numFrames, false);
+        isKey[0]                = true;
+        isKey[_numFrames - 1]   = true;
+        segments.assign(1, std::make_pair(0u, _numFrames - 1));
+
+        while (!segments.empty())
+        {
+            const uint  first       = segments.back().first;
+            const uint  last        = segments.back().second;
+            uint        worstFrame  = first;
+            float       worstError  = tolerance;
+            Pose        pose;
+
+            segments.pop_back();
+
+            for (uint frameId = first + 1; frameId < last; ++frameId)
+            {
+                interpolate(poses[first], poses[last], float(frameId - first) / float(last - first), pose);
+                compose(pose, matrix);
+
+                const float error = difference(matrix, &matricesPerFrame[frameId][boneId << 4]);
+
+                if (error > worstError)
+                {
+                    worstError = error;
+                    worstFrame = frameId;
+                }
+            }
+
+            if (worstFrame != first)
+            {
+                isKey[worstFrame] = true;
+                segments.push_back(std::make_pair(first, worstFrame));
+                segments.push_back(std::make_pair(worstFrame, last));
+            }
+        }
+
+        // a bone that does not move only needs its first key
+        if (_numFrames > 1 && std::count(isKey.begin(), isKey.end(), true) == 2)
+        {
+            bool moves = false;
+
+            compose(poses[0], matrix);
+            for (uint frameId = 1; frameId < _numFrames && !moves; ++frameId)
+                moves = difference(matrix, &matricesPerFrame[frameId][boneId << 4]) > tolerance;
+
+            isKey[_numFrames - 1] = moves;
+        }
+
+        for (uint frameId = 0; frameId < _numFrames; ++frameId)
+        {
+            if (!isKey[frameId])
+                continue;
+
+            const auto& pose = poses[frameId];
+
+            _keyFrames.push_back(frameId);
+            _keyTranslations.insert(_keyTranslations.end(), pose.translation, pose.translation + 3);
+            _keyScales.insert(_keyScales.end(), pose.scale, pose.scale + 3);
+            _keyRotations.insert(_keyRotations.end(), pose.quantizedRotation, pose.quantizedRotation + 4);
+        }
+    }
+
+    _keysOffsets[_numBones] = _keyFrames.size();
+}
+
+uint
+SkinClip::size() const
+{
+    return _keysOffsets.size() * sizeof(uint)
+        + _keyFrames.size() * sizeof(unsigned short)
+        + _keyTranslations.size() * sizeof(float)
+        + _keyRotations.size() * sizeof(short)
+        + _keyScales.size() * sizeof(float)
+        + _bakedOffsets.size() * sizeof(uint)
+        + _bakedMatrices.size() * sizeof(float);
+}
+
+void
+SkinClip::matrices(uint frameId, float* output) const
+{
+    if (_numFrames == 0)
+        return;
+
+    frameId = std::min(frameId, _numFrames - 1);
+
+    for (uint boneId = 0; boneId < _numBones; ++boneId)
+    {
+        float* matrix = output + (boneId << 4);
+
+        if (_bakedOffsets[boneId] != NO_BAKED_MATRICES)
+        {
+            std::memcpy(matrix, &_bakedMatrices[_bakedOffsets[boneId] + (frameId << 4)], sizeof(float) * 16);
+
+            continue;
+        }
+
+        // last key before or at frameId
+        const unsigned short*   keyFrames   = _keyFrames.data();
+        const uint              keyId       = std::upper_bound(
+            keyFrames + _keysOffsets[boneId], keyFrames + _keysOffsets[boneId + 1], frameId
+        ) - keyFrames - 1;
+
+        if (keyId + 1 == _keysOffsets[boneId + 1] || keyFrames[keyId] == frameId)
+            keyMatrix(keyId, matrix);
+        else
+            interpolatedMatrix(
+                keyId,
+                float(frameId - keyFrames[keyId]) / float(keyFrames[keyId + 1] - keyFrames[keyId]),
+                matrix
+            );
+    }
+}
+
+void
+SkinClip::keyMatrix(uint keyId, float* output) const
+{
+    Pose pose;
+
+    for (uint i = 0; i < 3; ++i)
+    {
+        pose.translation[i] = _keyTranslations[keyId * 3 + i];
+        pose.scale[i]       = _keyScales[keyId * 3 + i];
+    }
+    for (uint i = 0; i < 4; ++i)
+        pose.rotation[i] = dequantize(_keyRotations[(keyId << 2) + i]);
+    normalize(pose.rotation);
+
+    compose(pose, output);
+}
+
+void
+SkinClip::interpolatedMatrix(uint keyId, float ratio, float* output) const
+{
+    Pose poses[2];
+
+    for (uint k = 0; k < 2; ++k)
+    {
+        for (uint i = 0; i < 3; ++i)
+        {
+            poses[k].translation[i] = _keyTranslations[(keyId + k) * 3 + i];
+            poses[k].scale[i]       = _keyScales[(keyId + k) * 3 + i];
+        }
+        for (uint i = 0; i < 4; ++i)
+            poses[k].rotation[i] = dequantize(_keyRotations[((keyId + k) << 2) + i]);
+        normalize(poses[k].rotation);
+    }
+
+    Pose pose;
+
+    interpolate(poses[0], poses[1], ratio, pose);
+    compose(pose, output);
+}
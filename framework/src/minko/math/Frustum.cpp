@@ -103,12 +103,6 @@ Frustum::testBoundingBox(math::Box::Ptr box)
         _trbResult[planeId] = pa * xtrb + pb * ytrb + pc * ztrb + pd < 0.;
     }
 
-    if ((_blfResult[(int)PlanePosition::LEFT]    && _trbResult[(int)PlanePosition::RIGHT]) ||
-        (_blfResult[(int)PlanePosition::RIGHT]    && _trbResult[(int)PlanePosition::LEFT]) ||
-        (_blfResult[(int)PlanePosition::TOP]    && _trbResult[(int)PlanePosition::BOTTOM]) ||
-        (_blfResult[(int)PlanePosition::BOTTOM] && _trbResult[(int)PlanePosition::TOP]))
-        return ShapePosition::AROUND;
-
     for (uint planeId = 0; planeId < _planes.size(); ++planeId)
     {
         if (_blfResult[planeId] &&
@@ -123,6 +117,13 @@ Frustum::testBoundingBox(math::Box::Ptr box)
             return static_cast<ShapePosition>(planeId);
     }
 
+    // only once we know the box is not entirely behind one of the planes
+    if ((_blfResult[(int)PlanePosition::LEFT]    && _trbResult[(int)PlanePosition::RIGHT]) ||
+        (_blfResult[(int)PlanePosition::RIGHT]    && _trbResult[(int)PlanePosition::LEFT]) ||
+        (_blfResult[(int)PlanePosition::TOP]    && _trbResult[(int)PlanePosition::BOTTOM]) ||
+        (_blfResult[(int)PlanePosition::BOTTOM] && _trbResult[(int)PlanePosition::TOP]))
+        return ShapePosition::AROUND;
+
     return ShapePosition::INSIDE;
 }
 
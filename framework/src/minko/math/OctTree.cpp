@@ -20,7 +20,6 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/math/OctTree.hpp"
 #include "minko/component/Surface.hpp"
 #include "minko/component/BoundingBox.hpp"
-#include "minko/geometry/Geometry.hpp"
 #include "minko/scene/Node.hpp"
 #include "minko/math/Box.hpp"
 #include "minko/component/Transform.hpp"
@@ -30,267 +29,436 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/render/TriangleCulling.hpp"
 #include "minko/math/Matrix4x4.hpp"
 #include "minko/data/Container.hpp"
-#include "minko/math/Frustum.hpp"
 
 using namespace minko;
 using namespace minko::math;
 
+/*static*/ const float OctTree::MAX_HALF_SIZE = 1e30f;
+
 OctTree::OctTree(float                            worldSize,
-                  uint                            maxDepth,
-                 std::shared_ptr<math::Vector3>    center,
-                 uint                            depth)
+                 uint                             maxDepth,
+                 std::shared_ptr<math::Vector3>   center) :
+    _maxDepth(maxDepth),
+    _octants(),
+    _items(),
+    _nodeToItem(),
+    _changedNodes(),
+    _octantStack(),
+    _box(math::Box::create())
 {
-    _worldSize  = worldSize;
-    _depth        = depth;
-    _center        = center;
-    _splitted    = false;
-    _maxDepth    = maxDepth;
+    if (worldSize <= 0.f)
+        throw std::invalid_argument("worldSize");
+
+    float rootCenter[3] = { 0.f, 0.f, 0.f };
 
-    float edgel = edgeLength();
+    if (center)
+    {
+        rootCenter[0] = center->x();
+        rootCenter[1] = center->y();
+        rootCenter[2] = center->z();
+    }
 
-    _octantBox = math::Box::create(
-        math::Vector3::create(_center->x() + edgel, _center->y() + edgel, _center->z() + edgel),
-        math::Vector3::create(_center->x() - edgel, _center->y() - edgel, _center->z() - edgel));
+    reset(rootCenter, worldSize * .5f);
 }
 
 std::shared_ptr<scene::Node>
-OctTree::generateVisual(std::shared_ptr<file::AssetLibrary>        assetLibrary,
+OctTree::generateVisual(std::shared_ptr<file::AssetLibrary>     assetLibrary,
                         std::shared_ptr<scene::Node>            rootNode)
 {
     if (!rootNode)
         rootNode = scene::Node::create();
 
-    auto node = scene::Node::create();
-
-    if (_content.size() > 0)
+    for (auto& octant : _octants)
     {
-        node->addComponent(component::Transform::create(math::Matrix4x4::create()
-                        ->appendScale(edgeLength() * 2.f - 0.1f)
-                        ->appendTranslation(_center->x(), _center->y(), _center->z())))
-                    ->addComponent(component::Surface::create(
-                        geometry::CubeGeometry::create(assetLibrary->context()),
-                        material::BasicMaterial::create()
-                            ->diffuseColor(0x00FF0030)
-                            ->blendingMode(render::Blending::Mode::ALPHA)
-                            ->triangleCulling(render::TriangleCulling::NONE),
-                        assetLibrary->effect("effect/Basic.effect")
-                    ));
-        rootNode->addChild(node);
-        debugNode = node;
+        if (octant.content.empty())
+            continue;
+
+        rootNode->addChild(scene::Node::create()
+            ->addComponent(component::Transform::create(math::Matrix4x4::create()
+                ->appendScale(octant.halfSize * 4.f - 0.1f)
+                ->appendTranslation(octant.center[0], octant.center[1], octant.center[2])))
+            ->addComponent(component::Surface::create(
+                geometry::CubeGeometry::create(assetLibrary->context()),
+                material::BasicMaterial::create()
+                    ->diffuseColor(0x00FF0030)
+                    ->blendingMode(render::Blending::Mode::ALPHA)
+                    ->triangleCulling(render::TriangleCulling::NONE),
+                assetLibrary->effect("effect/Basic.effect")
+            ))
+        );
     }
 
-    if (_splitted)
-        for (auto octant : _children)
-            octant->generateVisual(assetLibrary, rootNode);
-
     return rootNode;
 }
 
 void
-OctTree::split()
+OctTree::reset(const float* center, float halfSize)
 {
-    this->_children.resize(8);
+    Octant root;
 
-    float size = (float)_k * _worldSize / (powf(2.f, (float)_depth));
+    std::copy(center, center + 3, root.center);
+    root.halfSize = halfSize;
+    root.depth = 0;
+    root.parent = -1;
+    std::fill(root.children, root.children + 8, -1);
+    root.numNodes = 0;
 
-    for (uint x = 0; x < 2; ++x)
-    {
-        for (uint y = 0; y < 2; ++y)
-        {
-            for (uint z = 0; z < 2; ++z)
-            {
-                uint index = x + (y << 1) + (z << 2);
-
-                _children[index] = OctTree::create(
-                    _worldSize,
-                    _maxDepth,
-                    math::Vector3::create(
-                        _center->x() + (x == 0 ? -size / 2 : size / 2),
-                        _center->y() + (y == 0 ? -size / 2 : size / 2),
-                        _center->z() + (z == 0 ? -size / 2 : size / 2)),
-                    _depth + 1);
-                _children[index]->_parent = shared_from_this();
-            }
-        }
-    }
-    _splitted = true;
+    _octants.clear();
+    _octants.push_back(root);
 }
 
-OctTree::Ptr
-OctTree::insert(std::shared_ptr<scene::Node> node)
+void
+OctTree::grow(const float* towards)
 {
-    // already reference by the octTree
-    if (_nodeToOctant.find(node) != _nodeToOctant.end())
-        return shared_from_this();
-
-    if (!node->hasComponent<component::BoundingBox>())
-        node->addComponent(component::BoundingBox::create());
+    // the new root is twice as large and contains the old one as one of its children
+    const auto& root = _octants[0];
+    float center[3];
 
-    std::shared_ptr<component::BoundingBox> nodeBoundingBox = node->component<component::BoundingBox>();
-    std::shared_ptr<math::Matrix4x4>        modelToWorld    = node->component<component::Transform>()->modelToWorldMatrix(true);
+    for (uint i = 0; i < 3; ++i)
+        center[i] = root.center[i] + (towards[i] >= root.center[i] ? root.halfSize : -root.halfSize);
 
-    // insert
-    uint                                optimalDepth    = std::min(computeDepth(node), _maxDepth);
-    uint                                currentDepth    = 0;
-    OctTree::Ptr                        octant            = shared_from_this();
+    reset(center, root.halfSize * 2.f);
 
-    std::shared_ptr<math::Vector3>        newNodeCenter    = math::Vector3::create(
-        (nodeBoundingBox->box()->bottomLeft()->x() + nodeBoundingBox->box()->topRight()->x()) / 2,
-        (nodeBoundingBox->box()->bottomLeft()->y() + nodeBoundingBox->box()->topRight()->y()) / 2,
-        (nodeBoundingBox->box()->bottomLeft()->z() + nodeBoundingBox->box()->topRight()->z()) / 2);
-
-    for (currentDepth = 0; currentDepth != optimalDepth; ++currentDepth)
+    for (uint itemId = 0; itemId < _items.size(); ++itemId)
     {
-        if (!octant->_splitted)
-            octant->split();
-
-        uint xIndex = 0;
-        uint yIndex = 0;
-        uint zIndex = 0;
+        if (_items[itemId].octant < 0)
+            continue;
 
-        if (newNodeCenter->x() > octant->_center->x())
-            xIndex = 1;
+        _items[itemId].octant = -1;
+        place(itemId);
+    }
+}
 
-        if (newNodeCenter->y() > octant->_center->y())
-            yIndex = 1;
+void
+OctTree::split(uint octantId)
+{
+    float   childHalfSize   = _octants[octantId].halfSize * .5f;
+    uint    childDepth      = _octants[octantId].depth + 1;
+    float   center[3];
 
-        if (newNodeCenter->z() > octant->_center->z())
-            zIndex = 1;
+    std::copy(_octants[octantId].center, _octants[octantId].center + 3, center);
 
-        octant = octant->_children[xIndex + (yIndex << 1) + (zIndex << 2)];
+    for (uint index = 0; index < 8; ++index)
+    {
+        Octant child;
+
+        child.center[0] = center[0] + ((index & 1) ? childHalfSize : -childHalfSize);
+        child.center[1] = center[1] + ((index & 2) ? childHalfSize : -childHalfSize);
+        child.center[2] = center[2] + ((index & 4) ? childHalfSize : -childHalfSize);
+        child.halfSize = childHalfSize;
+        child.depth = childDepth;
+        child.parent = octantId;
+        std::fill(child.children, child.children + 8, -1);
+        child.numNodes = 0;
+
+        _octants[octantId].children[index] = _octants.size();
+        _octants.push_back(child);
     }
+}
+
+void
+OctTree::updateBounds(Item& item)
+{
+    auto box = item.node->component<component::BoundingBox>()->box();
+
+    item.min[0] = box->bottomLeft()->x();
+    item.min[1] = box->bottomLeft()->y();
+    item.min[2] = box->bottomLeft()->z();
+    item.max[0] = box->topRight()->x();
+    item.max[1] = box->topRight()->y();
+    item.max[2] = box->topRight()->z();
+}
 
-    octant->_content.push_back(node);
-    octant->addChildContent(node);
-    _nodeToOctant[node] = octant;
-    _matrixToNode[node->data()->get<std::shared_ptr<math::Matrix4x4>>("transform.modelToWorldMatrix")] = node;
+bool
+OctTree::fits(const Item& item, uint octantId) const
+{
+    const auto& octant = _octants[octantId];
 
-    if (_nodeToTransformChangedSlot.find(node) == _nodeToTransformChangedSlot.end())
+    for (uint i = 0; i < 3; ++i)
     {
-        _nodeToTransformChangedSlot[node] = node->data()->propertyValueChanged("transform.modelToWorldMatrix")->connect(std::bind(
-            &OctTree::nodeModelToWorldChanged,
-            shared_from_this(),
-            std::placeholders::_1,
-            std::placeholders::_2));
+        if (item.max[i] - item.min[i] > 2.f * octant.halfSize
+            || std::abs((item.min[i] + item.max[i]) * .5f - octant.center[i]) > octant.halfSize)
+            return false;
     }
 
-    return shared_from_this();
+    return true;
 }
 
-bool
-OctTree::nodeChangedOctant(std::shared_ptr<scene::Node> node)
+uint
+OctTree::computeDepth(const Item& item) const
 {
-    Ptr                                        octant            = _nodeToOctant[node];
-    std::shared_ptr<component::BoundingBox> nodeBoundingBox = node->component<component::BoundingBox>();
-    std::shared_ptr<math::Vector3>            nodeCenter        = math::Vector3::create(
-        (nodeBoundingBox->box()->bottomLeft()->x() + nodeBoundingBox->box()->topRight()->x()) / 2,
-        (nodeBoundingBox->box()->bottomLeft()->y() + nodeBoundingBox->box()->topRight()->y()) / 2,
-        (nodeBoundingBox->box()->bottomLeft()->z() + nodeBoundingBox->box()->topRight()->z()) / 2);
-
-    if (sqrt(pow(nodeCenter->x() - octant->_center->x(), 2) + pow(nodeCenter->y() - octant->_center->y(), 2) + pow(nodeCenter->z() - octant->_center->z(), 2)) < octant->edgeLength())
-        return false;
-    return true;
+    float   radius      = std::max(item.max[0] - item.min[0], std::max(item.max[1] - item.min[1], item.max[2] - item.min[2])) * .5f;
+    float   halfSize    = _octants[0].halfSize;
+    uint    depth       = 0;
+
+    while (depth < _maxDepth && radius <= halfSize * .5f)
+    {
+        halfSize *= .5f;
+        ++depth;
+    }
+
+    return depth;
 }
 
 void
-OctTree::nodeModelToWorldChanged(data::Container::Ptr    data,
-                                 const std::string&        propertyName)
+OctTree::place(uint itemId)
 {
-    /*auto node        = _matrixToNode[data->get<std::shared_ptr<math::Matrix4x4>>(propertyName)];
-    auto octant        = _nodeToOctant[node];
+    float center[3] = {
+        (_items[itemId].min[0] + _items[itemId].max[0]) * .5f,
+        (_items[itemId].min[1] + _items[itemId].max[1]) * .5f,
+        (_items[itemId].min[2] + _items[itemId].max[2]) * .5f
+    };
+
+    while (!fits(_items[itemId], 0) && _octants[0].halfSize < MAX_HALF_SIZE)
+        grow(center);
+
+    auto    depth       = computeDepth(_items[itemId]);
+    uint    octantId    = 0;
 
-    if (node && nodeChangedOctant(node)) // node is no more in the octant
+    ++_octants[0].numNodes;
+    while (_octants[octantId].depth < depth)
     {
-        _matrixToNode.erase(data->get<std::shared_ptr<math::Matrix4x4>>(propertyName));
-        _nodeToOctant.erase(node);
-        octant->_content.remove(node);
-        insert(node);
-    }*/
+        if (_octants[octantId].children[0] < 0)
+            split(octantId);
+
+        const auto& octant = _octants[octantId];
+
+        octantId = octant.children[
+            (center[0] > octant.center[0] ? 1 : 0)
+            + (center[1] > octant.center[1] ? 2 : 0)
+            + (center[2] > octant.center[2] ? 4 : 0)
+        ];
+        ++_octants[octantId].numNodes;
+    }
+
+    auto& item = _items[itemId];
+
+    item.octant = octantId;
+    item.positionInOctant = _octants[octantId].content.size();
+    _octants[octantId].content.push_back(itemId);
 }
 
 void
-OctTree::testFrustum(std::shared_ptr<math::AbstractShape>                frustum,
-                     std::function<void(std::shared_ptr<scene::Node>)>    insideFrustumCallback,
-                     std::function<void(std::shared_ptr<scene::Node>)>    outsideFustumCallback)
+OctTree::unplace(uint itemId)
 {
-    ShapePosition result                    = frustum->testBoundingBox(_octantBox);
+    auto& item      = _items[itemId];
+    auto& content   = _octants[item.octant].content;
+    auto  lastId    = content.back();
 
-    if (result == ShapePosition::AROUND || result == ShapePosition::INSIDE)
-    {
-        if (_splitted)
+    content[item.positionInOctant] = lastId;
+    _items[lastId].positionInOctant = item.positionInOctant;
+    content.pop_back();
+
+    for (auto octantId = item.octant; octantId >= 0; octantId = _octants[octantId].parent)
+        --_octants[octantId].numNodes;
+
+    item.octant = -1;
+}
+
+OctTree::Ptr
+OctTree::insert(std::shared_ptr<scene::Node> node)
+{
+    // already referenced by the octTree
+    if (hasNode(node))
+        return shared_from_this();
+
+    if (!node->hasComponent<component::BoundingBox>())
+        node->addComponent(component::BoundingBox::create());
+
+    uint                        itemId      = _items.size();
+    std::weak_ptr<scene::Node>  weakNode    = node;
+
+    _items.push_back(Item());
+
+    auto& item = _items.back();
+
+    item.node = node;
+    item.octant = -1;
+    item.positionInOctant = 0;
+    item.visibility = -1;
+    item.changed = true;
+    item.modelToWorldChangedSlot = node->data()->propertyValueChanged("transform.modelToWorldMatrix")->connect(
+        [this, weakNode](std::shared_ptr<data::Container> data, const std::string& propertyName)
         {
-            for (auto octantChild : _children)
-                octantChild->testFrustum(frustum, insideFrustumCallback, outsideFustumCallback);
+            auto node   = weakNode.lock();
+            auto itemIt = _nodeToItem.find(node);
+
+            // moved nodes are only reinserted when the tree is tested
+            if (itemIt != _nodeToItem.end() && !_items[itemIt->second].changed)
+            {
+                _items[itemIt->second].changed = true;
+                _changedNodes.push_back(node);
+            }
         }
+    );
 
-        for (auto node : _content)
-            insideFrustumCallback(node);
-    }
-    else
-    {
-        for (auto node : _childrenContent)
-            outsideFustumCallback(node);
-        for (auto node : _content)
-            insideFrustumCallback(node);
-    }
+    _nodeToItem[node] = itemId;
+    _changedNodes.push_back(node);
+
+    updateBounds(item);
+    place(itemId);
+
+    return shared_from_this();
 }
 
 OctTree::Ptr
 OctTree::remove(std::shared_ptr<scene::Node> node)
 {
-    // not reference by the octTree
-    if (_nodeToOctant.find(node) == _nodeToOctant.end())
+    auto itemIt = _nodeToItem.find(node);
+
+    // not referenced by the octTree
+    if (itemIt == _nodeToItem.end())
         return shared_from_this();
 
-    Ptr octant = _nodeToOctant[node];
+    auto itemId = itemIt->second;
+    auto lastId = _items.size() - 1;
 
-    octant->_content.remove(node);
+    unplace(itemId);
+    _nodeToItem.erase(itemIt);
 
-    _nodeToOctant.erase(node);
-    _matrixToNode.erase(node->data()->get<math::Matrix4x4::Ptr>("transform.modelToWorldMatrix"));
+    if (itemId != lastId)
+    {
+        auto& item = _items[itemId];
 
+        item = std::move(_items[lastId]);
+        _nodeToItem[item.node] = itemId;
+        if (item.octant >= 0)
+            _octants[item.octant].content[item.positionInOctant] = itemId;
+    }
+    _items.pop_back();
 
     return shared_from_this();
 }
 
-uint
-OctTree::computeDepth(std::shared_ptr<scene::Node> node)
+void
+OctTree::updateItem(uint itemId)
 {
-    component::Surface::Ptr surface = node->component<component::Surface>();
-    float                    radius    = computeRadius(node->component<component::BoundingBox>());
+    auto& item = _items[itemId];
 
-    return (uint)std::floor(std::log(_worldSize / radius) / std::log(2));
+    item.changed = false;
+    updateBounds(item);
+
+    // thanks to the loose bounds, a node only changes octant when its center leaves the cell of its octant
+    if (item.octant >= 0
+        && fits(item, item.octant)
+        && computeDepth(item) == _octants[item.octant].depth)
+        return;
+
+    if (item.octant >= 0)
+        unplace(itemId);
+    place(itemId);
 }
 
-float
-OctTree::computeRadius(std::shared_ptr<component::BoundingBox> boundingBox)
+void
+OctTree::updateChangedNodes()
 {
-    return std::max(boundingBox->box()->width() / 2.f,  std::max(boundingBox->box()->height() / 2.f, boundingBox->box()->depth() / 2.f));
+    for (auto& node : _changedNodes)
+    {
+        auto itemIt = _nodeToItem.find(node);
+
+        if (itemIt != _nodeToItem.end() && _items[itemIt->second].changed)
+            updateItem(itemIt->second);
+    }
 }
 
-float
-OctTree::edgeLength()
+bool
+OctTree::testItem(std::shared_ptr<math::AbstractShape> frustum, const Item& item)
 {
-    return (float)_k * (_worldSize / powf(2.f, (float)_depth));
+    _box->bottomLeft()->setTo(item.min[0], item.min[1], item.min[2]);
+    _box->topRight()->setTo(item.max[0], item.max[1], item.max[2]);
+
+    auto result = frustum->testBoundingBox(_box);
+
+    return result == ShapePosition::AROUND || result == ShapePosition::INSIDE;
 }
 
+void
+OctTree::setVisibility(Item&            item,
+                       bool             visible,
+                       NodeCallback&    insideCallback,
+                       NodeCallback&    outsideCallback)
+{
+    if (item.visibility == (visible ? 1 : 0))
+        return;
+
+    item.visibility = visible ? 1 : 0;
+    if (visible)
+        insideCallback(item.node);
+    else
+        outsideCallback(item.node);
+}
 
 void
-OctTree::addChildContent(NodePtr node)
+OctTree::testFrustum(std::shared_ptr<math::AbstractShape>   frustum,
+                     NodeCallback                           insideFrustumCallback,
+                     NodeCallback                           outsideFustumCallback)
 {
-    if (_parent)
+    updateChangedNodes();
+    _changedNodes.clear();
+
+    _octantStack.clear();
+    _octantStack.push_back(std::make_pair(0u, false));
+
+    while (!_octantStack.empty())
     {
-        _parent->_childrenContent.push_back(node);
-        _parent->addChildContent(node);
+        auto octantId   = _octantStack.back().first;
+        auto outside    = _octantStack.back().second;
+
+        _octantStack.pop_back();
+
+        const auto& octant = _octants[octantId];
+
+        if (octant.numNodes == 0)
+            continue;
+
+        if (!outside)
+        {
+            auto looseHalfSize = octant.halfSize * 2.f;
+
+            _box->bottomLeft()->setTo(
+                octant.center[0] - looseHalfSize, octant.center[1] - looseHalfSize, octant.center[2] - looseHalfSize
+            );
+            _box->topRight()->setTo(
+                octant.center[0] + looseHalfSize, octant.center[1] + looseHalfSize, octant.center[2] + looseHalfSize
+            );
+
+            auto result = frustum->testBoundingBox(_box);
+
+            // the whole subtree is outside: its nodes do not have to be tested one by one
+            outside = result != ShapePosition::AROUND && result != ShapePosition::INSIDE;
+        }
+
+        for (auto itemId : octant.content)
+        {
+            auto& item = _items[itemId];
+
+            setVisibility(item, !outside && testItem(frustum, item), insideFrustumCallback, outsideFustumCallback);
+        }
+
+        if (octant.children[0] >= 0)
+            for (auto childId : octant.children)
+                _octantStack.push_back(std::make_pair((uint)childId, outside));
     }
 }
 
 void
-OctTree::removeChildContent(NodePtr node)
+OctTree::testChangedNodes(std::shared_ptr<math::AbstractShape>  frustum,
+                          NodeCallback                          insideFrustumCallback,
+                          NodeCallback                          outsideFustumCallback)
 {
-    if (_parent)
+    for (auto& node : _changedNodes)
     {
-        _parent->_childrenContent.remove(node);
-        _parent->removeChildContent(node);
+        auto itemIt = _nodeToItem.find(node);
+
+        if (itemIt == _nodeToItem.end())
+            continue;
+
+        auto& item = _items[itemIt->second];
+
+        if (item.changed)
+            updateItem(itemIt->second);
+        setVisibility(item, testItem(frustum, item), insideFrustumCallback, outsideFustumCallback);
     }
-}
\ No newline at end of file
+
+    _changedNodes.clear();
+}
@@ -72,7 +72,10 @@ DrawCall::DrawCall(Pass::Ptr pass) :
     _vertexSizes(MAX_NUM_VERTEXBUFFERS, -1),
     _vertexAttributeSizes(MAX_NUM_VERTEXBUFFERS, -1),
     _vertexAttributeOffsets(MAX_NUM_VERTEXBUFFERS, -1),
+    _vertexAttributeDivisors(MAX_NUM_VERTEXBUFFERS, 0),
     _target(nullptr),
+    _numInstances(0),
+    _uniformInputs(),
     _referenceChangedSlots(),
     _macroChangedSlots(),
     _macroAddedOrRemovedSlots(),
@@ -170,28 +173,28 @@ DrawCall::bindProgramDefaultUniforms()
         return;
 
     for (auto& uniform : _program->uniformFloat())
-        _uniformFloat[uniform.first] = uniform.second;
+        setUniformInput(ProgramInputs::Type::float1, uniform.first, false).floatValue = uniform.second;
     for (auto& uniform : _program->uniformFloat2())
-        _uniformFloat2[uniform.first] = uniform.second;
+        setUniformInput(ProgramInputs::Type::float2, uniform.first, false, uniform.second, uniform.second.get());
     for (auto& uniform : _program->uniformFloat3())
-        _uniformFloat3[uniform.first] = uniform.second;
+        setUniformInput(ProgramInputs::Type::float3, uniform.first, false, uniform.second, uniform.second.get());
     for (auto& uniform : _program->uniformFloat4())
-        _uniformFloat4[uniform.first] = uniform.second;
+        setUniformInput(ProgramInputs::Type::float4, uniform.first, false, uniform.second, uniform.second.get());
 }
 
 void
 DrawCall::bindIndexBuffer()
 {
-    const std::string propertyName = _formatFunction("geometry[${geometryId}].indices");
+    const PropertyId propertyId(_formatFunction("geometry[${geometryId}].indices"));
 
     _indexBuffer        = -1;
     _numIndices            = 0;
     _indicesChangedSlot    = nullptr;
 
     // Note: index buffer can only be held by the target node's data container!
-    if (_targetData->hasProperty(propertyName))
+    if (_targetData->hasProperty(propertyId))
     {
-        auto indexBuffer    = _targetData->get<IndexBuffer::Ptr>(propertyName);
+        auto indexBuffer    = _targetData->get<IndexBuffer::Ptr>(propertyId);
         if (indexBuffer->isReady())
         {
             _indexBuffer    = indexBuffer->id();
@@ -217,10 +220,10 @@ DrawCall::bindIndexBuffer()
         });
     }
 
-    if (_referenceChangedSlots.count(propertyName) == 0)
+    if (_referenceChangedSlots.count(propertyId) == 0)
     {
-        _referenceChangedSlots[propertyName].push_back(
-            _targetData->propertyReferenceChanged(propertyName)->connect(std::bind(
+        _referenceChangedSlots[propertyId].push_back(
+            _targetData->propertyReferenceChanged(propertyId)->connect(std::bind(
                 &DrawCall::bindIndexBuffer,
                 shared_from_this())
             )
@@ -231,18 +234,18 @@ DrawCall::bindIndexBuffer()
 void
 DrawCall::bindTargetLayouts()
 {
-    const std::string propertyName = _formatFunction("node.layouts");
+    const PropertyId propertyId(_formatFunction("node.layouts"));
 
     _layouts = scene::Layout::Group::DEFAULT;
 
     // Note: index buffer can only be held by the target node's data container!
-    if (_targetData->hasProperty(propertyName))
-        _layouts = _targetData->get<Layouts>(propertyName);
+    if (_targetData->hasProperty(propertyId))
+        _layouts = _targetData->get<Layouts>(propertyId);
 
-    if (_referenceChangedSlots.count(propertyName) == 0)
+    if (_referenceChangedSlots.count(propertyId) == 0)
     {
-        _referenceChangedSlots[propertyName].push_back(
-            _targetData->propertyReferenceChanged(propertyName)->connect(std::bind(
+        _referenceChangedSlots[propertyId].push_back(
+            _targetData->propertyReferenceChanged(propertyId)->connect(std::bind(
                 &DrawCall::bindTargetLayouts,
                 shared_from_this())
             )
@@ -320,13 +323,14 @@ DrawCall::bindVertexAttribute(const std::string&    inputName,
 
     if (attributeBindings.count(inputName))
     {
-        auto propertyName        = _formatFunction(std::get<0>(attributeBindings.at(inputName)));
+        const PropertyId propertyId(_formatFunction(std::get<0>(attributeBindings.at(inputName))));
         auto source                = std::get<1>(attributeBindings.at(inputName));
         const auto& container    = getContainer(ContainerId::FILTERED, source);
 
-        if (container && container->hasProperty(propertyName))
+        if (container && container->hasProperty(propertyId))
         {
-            auto vertexBuffer = container->get<VertexBuffer::Ptr>(propertyName);
+            const auto& propertyName = propertyId.name();
+            auto vertexBuffer = container->get<VertexBuffer::Ptr>(propertyId);
             auto attributeName = propertyName.substr(propertyName.find_last_of('.') + 1);
 
 #ifdef DEBUG
@@ -341,19 +345,20 @@ DrawCall::bindVertexAttribute(const std::string&    inputName,
             _vertexAttributeSizes[vertexBufferIndex] = std::get<1>(*attribute);
             _vertexSizes[vertexBufferIndex] = vertexBuffer->vertexSize();
             _vertexAttributeOffsets[vertexBufferIndex] = std::get<2>(*attribute);
+            _vertexAttributeDivisors[vertexBufferIndex] = vertexBuffer->divisor();
         }
 
 
-        if (_referenceChangedSlots.count(propertyName) == 0)
+        if (_referenceChangedSlots.count(propertyId) == 0)
         {
             auto that = shared_from_this();
-            auto slot = container->propertyReferenceChanged(propertyName)->connect(
+            auto slot = container->propertyReferenceChanged(propertyId)->connect(
                     [=](Container::Ptr, const std::string&)
                     {
                         that->bindVertexAttribute(inputName, location, vertexBufferIndex);
                     }
                 );
-            _referenceChangedSlots[propertyName].push_back(slot);
+            _referenceChangedSlots[propertyId].push_back(slot);
         }
     }
 }
@@ -376,13 +381,13 @@ DrawCall::bindTextureSampler(const std::string&        inputName,
 
     if (uniformBindings.count(inputName))
     {
-        auto propertyName        = _formatFunction(std::get<0>(uniformBindings.at(inputName)));
+        const PropertyId propertyId(_formatFunction(std::get<0>(uniformBindings.at(inputName))));
         auto source                = std::get<1>(uniformBindings.at(inputName));
         const auto& container    = getContainer(ContainerId::FILTERED, source);
 
-        if (container && container->hasProperty(propertyName))
+        if (container && container->hasProperty(propertyId))
         {
-            auto texture    = container->get<AbstractTexture::Ptr>(propertyName);
+            auto texture    = container->get<AbstractTexture::Ptr>(propertyId);
 
             _textureIds            [textureIndex] = texture->id();
             _textureLocations    [textureIndex] = location;
@@ -391,16 +396,16 @@ DrawCall::bindTextureSampler(const std::string&        inputName,
             _textureMipFilters    [textureIndex] = std::get<2>(samplerState);
         }
 
-        if (_referenceChangedSlots.count(propertyName) == 0)
+        if (_referenceChangedSlots.count(propertyId) == 0)
         {
             auto that = shared_from_this();
-            auto slot = container->propertyReferenceChanged(propertyName)->connect(
+            auto slot = container->propertyReferenceChanged(propertyId)->connect(
                 [=](Container::Ptr, const std::string&)
                 {
                     that->bindTextureSampler(inputName, location, textureIndex, samplerState);
                 }
             );
-            _referenceChangedSlots[propertyName].push_back(slot);
+            _referenceChangedSlots[propertyId].push_back(slot);
         }
     }
 }
@@ -433,53 +438,115 @@ DrawCall::bindUniform(const std::string&    inputName,
         std::string    propertyName    = _formatFunction(std::get<0>(uniformBindings.at(bindingName)));
         auto        source            = std::get<1>(uniformBindings.at(bindingName));
         const auto& container        = getContainer(ContainerId::FILTERED, source);
+        bool        isUniformArray    = false;
 
-        if (container)
+        if (container && isArray)
+            propertyName += inputName.substr(pos); // way to handle array of GLSL structs
+
+        PropertyId  propertyId(propertyName);
+
+        if (container && !bindUniformValue(container, propertyId, type, location) && isArray)
         {
-            if (isArray)
-                propertyName += inputName.substr(pos); // way to handle array of GLSL structs
+            // This case corresponds to continuous base type arrays that are stored in data providers as std::vector<float>.
+            propertyName = _formatFunction(std::get<0>(uniformBindings.at(bindingName)));
+            propertyId = PropertyId(propertyName);
+            isUniformArray = true;
 
-            if (container->hasProperty(propertyName))
-            {
-                // This case corresponds to base types uniforms or individual members of an GLSL struct array.
-
-                if (type == ProgramInputs::Type::float1)
-                    _uniformFloat[location]        = container->get<float>(propertyName);
-                else if (type == ProgramInputs::Type::float2)
-                    _uniformFloat2[location]    = container->get<Vector2::Ptr>(propertyName);
-                else if (type == ProgramInputs::Type::float3)
-                    _uniformFloat3[location]    = container->get<Vector3::Ptr>(propertyName);
-                else if (type == ProgramInputs::Type::float4)
-                    _uniformFloat4[location]    = container->get<Vector4::Ptr>(propertyName);
-                else if (type == ProgramInputs::Type::float16)
-                    _uniformFloat16[location]    = &(container->get<Matrix4x4::Ptr>(propertyName)->data()[0]);
-                else if (type == ProgramInputs::Type::int1)
-                    _uniformInt[location]        = container->get<int>(propertyName);
-                else if (type == ProgramInputs::Type::int2)
-                    _uniformInt2[location]        = container->get<Int2>(propertyName);
-                else if (type == ProgramInputs::Type::int3)
-                    _uniformInt3[location]        = container->get<Int3>(propertyName);
-                else if (type == ProgramInputs::Type::int4)
-                    _uniformInt4[location]        = container->get<Int4>(propertyName);
-                else
-                    throw std::logic_error("unsupported uniform type.");
-            }
-            else if (isArray)
+            bindUniformArray(propertyName, container, type, location);
+        }
+
+        if (_referenceChangedSlots.count(propertyId) == 0)
+        {
+            if (isUniformArray)
+                _referenceChangedSlots[propertyId].push_back(container->propertyReferenceChanged(propertyId)->connect(std::bind(
+                    &DrawCall::bindUniform, shared_from_this(), inputName, type, location
+                )));
+            else
             {
-                // This case corresponds to continuous base type arrays that are stored in data providers as std::vector<float>.
-                propertyName = _formatFunction(std::get<0>(uniformBindings.at(bindingName)));
+                // the property name is resolved once: when its value is replaced, only the value is bound again
+                auto that = shared_from_this();
 
-                bindUniformArray(propertyName, container, type, location);
+                _referenceChangedSlots[propertyId].push_back(container->propertyReferenceChanged(propertyId)->connect(
+                    [=](Container::Ptr propertyContainer, const std::string&)
+                    {
+                        if (!that->bindUniformValue(propertyContainer, propertyId, type, location))
+                            that->bindUniform(inputName, type, location);
+                    }
+                ));
             }
         }
+    }
+}
 
-        if (_referenceChangedSlots.count(propertyName) == 0)
-        {
-            _referenceChangedSlots[propertyName].push_back(container->propertyReferenceChanged(propertyName)->connect(std::bind(
-                &DrawCall::bindUniform, shared_from_this(), inputName, type, location
-            )));
-        }
+bool
+DrawCall::bindUniformValue(Container::Ptr        container,
+                           const PropertyId&     propertyId,
+                           ProgramInputs::Type   type,
+                           int                   location)
+{
+    // This case corresponds to base types uniforms or individual members of an GLSL struct array.
+    if (!container->hasProperty(propertyId))
+        return false;
+
+    if (type == ProgramInputs::Type::float1)
+        setUniformInput(type, location, false).floatValue = container->get<float>(propertyId);
+    else if (type == ProgramInputs::Type::float2)
+    {
+        auto float2 = container->get<Vector2::Ptr>(propertyId);
+
+        setUniformInput(type, location, false, float2, float2.get());
+    }
+    else if (type == ProgramInputs::Type::float3)
+    {
+        auto float3 = container->get<Vector3::Ptr>(propertyId);
+
+        setUniformInput(type, location, false, float3, float3.get());
+    }
+    else if (type == ProgramInputs::Type::float4)
+    {
+        auto float4 = container->get<Vector4::Ptr>(propertyId);
+
+        setUniformInput(type, location, false, float4, float4.get());
+    }
+    else if (type == ProgramInputs::Type::float16)
+    {
+        auto float16 = container->get<Matrix4x4::Ptr>(propertyId);
+
+        setUniformInput(type, location, false, float16, &(float16->data()[0]));
     }
+    else if (type == ProgramInputs::Type::int1)
+        setUniformInput(type, location, false).intValues[0] = container->get<int>(propertyId);
+    else if (type == ProgramInputs::Type::int2)
+    {
+        const auto& int2 = container->get<Int2>(propertyId);
+        auto& input = setUniformInput(type, location, false);
+
+        input.intValues[0] = std::get<0>(int2);
+        input.intValues[1] = std::get<1>(int2);
+    }
+    else if (type == ProgramInputs::Type::int3)
+    {
+        const auto& int3 = container->get<Int3>(propertyId);
+        auto& input = setUniformInput(type, location, false);
+
+        input.intValues[0] = std::get<0>(int3);
+        input.intValues[1] = std::get<1>(int3);
+        input.intValues[2] = std::get<2>(int3);
+    }
+    else if (type == ProgramInputs::Type::int4)
+    {
+        const auto& int4 = container->get<Int4>(propertyId);
+        auto& input = setUniformInput(type, location, false);
+
+        input.intValues[0] = std::get<0>(int4);
+        input.intValues[1] = std::get<1>(int4);
+        input.intValues[2] = std::get<2>(int4);
+        input.intValues[3] = std::get<3>(int4);
+    }
+    else
+        throw std::logic_error("unsupported uniform type.");
+
+    return true;
 }
 
 void
@@ -506,25 +573,21 @@ DrawCall::bindFloatUniformArray(const std::string&    propertyName,
                                 ProgramInputs::Type    type,
                                 int                    location)
 {
-    if (!container->propertyHasType<UniformArrayPtr<float>>(propertyName, true))
+    if (!container->propertyHasType<UniformArrayPtr<float>>(propertyName))
         return;
 
     const auto& uniformArray = container->get<UniformArrayPtr<float>>(propertyName);
     if (uniformArray->first == 0 || uniformArray->second == nullptr)
         return;
 
-    if (type == ProgramInputs::Type::float1)
-        _uniformFloats[location] = uniformArray;
-    else if (type == ProgramInputs::Type::float2)
-        _uniformFloats2[location] = uniformArray;
-    else if (type == ProgramInputs::Type::float3)
-        _uniformFloats3[location] = uniformArray;
-    else if (type == ProgramInputs::Type::float4)
-        _uniformFloats4[location] = uniformArray;
-    else if (type == ProgramInputs::Type::float16)
-        _uniformFloats16[location] = uniformArray;
-    else
+    if (type != ProgramInputs::Type::float1
+        && type != ProgramInputs::Type::float2
+        && type != ProgramInputs::Type::float3
+        && type != ProgramInputs::Type::float4
+        && type != ProgramInputs::Type::float16)
         throw std::logic_error("unsupported uniform type.");
+
+    setUniformInput(type, location, true, uniformArray, uniformArray.get());
 }
 
 void
@@ -533,23 +596,139 @@ DrawCall::bindIntegerUniformArray(const std::string&    propertyName,
                                    ProgramInputs::Type    type,
                                   int                    location)
 {
-    if (!container->propertyHasType<UniformArrayPtr<int>>(propertyName, true))
+    if (!container->propertyHasType<UniformArrayPtr<int>>(propertyName))
         return;
 
     const auto& uniformArray = container->get<UniformArrayPtr<int>>(propertyName);
     if (uniformArray->first == 0 || uniformArray->second == nullptr)
         return;
 
-    if (type == ProgramInputs::Type::int1)
-        _uniformInts[location] = uniformArray;
-    else if (type == ProgramInputs::Type::int2)
-        _uniformInts2[location] = uniformArray;
-    else if (type == ProgramInputs::Type::int3)
-        _uniformInts3[location] = uniformArray;
-    else if (type == ProgramInputs::Type::int4)
-        _uniformInts4[location] = uniformArray;
-    else
+    if (type != ProgramInputs::Type::int1
+        && type != ProgramInputs::Type::int2
+        && type != ProgramInputs::Type::int3
+        && type != ProgramInputs::Type::int4)
         throw std::logic_error("unsupported uniform type.");
+
+    setUniformInput(type, location, true, uniformArray, uniformArray.get());
+}
+
+DrawCall::UniformInput&
+DrawCall::setUniformInput(ProgramInputs::Type       type,
+                          int                       location,
+                          bool                      isArray,
+                          std::shared_ptr<void>     owner,
+                          void*                     data)
+{
+    auto inputIt = std::find_if(_uniformInputs.begin(), _uniformInputs.end(), [&](const UniformInput& input)
+    {
+        return input.location == location;
+    });
+
+    if (inputIt == _uniformInputs.end())
+    {
+        _uniformInputs.push_back(UniformInput());
+        inputIt = _uniformInputs.end() - 1;
+    }
+
+    auto& input = *inputIt;
+
+    input.type          = type;
+    input.location      = location;
+    input.isArray       = isArray;
+    input.floatValue    = 0.f;
+    input.data          = data;
+    input.owner         = owner;
+    std::fill(input.intValues, input.intValues + 4, 0);
+
+    return input;
+}
+
+void
+DrawCall::uploadUniformInputs(const AbstractContext::Ptr& context)
+{
+    for (const auto& input : _uniformInputs)
+    {
+        const auto location = input.location;
+
+        if (input.isArray)
+        {
+            if (input.type >= ProgramInputs::Type::int1 && input.type <= ProgramInputs::Type::int4)
+            {
+                auto ints = static_cast<data::UniformArray<int>*>(input.data);
+
+                if (input.type == ProgramInputs::Type::int1)
+                    context->setUniforms(location, ints->first, ints->second);
+                else if (input.type == ProgramInputs::Type::int2)
+                    context->setUniforms2(location, ints->first, ints->second);
+                else if (input.type == ProgramInputs::Type::int3)
+                    context->setUniforms3(location, ints->first, ints->second);
+                else
+                    context->setUniforms4(location, ints->first, ints->second);
+            }
+            else
+            {
+                auto floats = static_cast<data::UniformArray<float>*>(input.data);
+
+                if (input.type == ProgramInputs::Type::float1)
+                    context->setUniforms(location, floats->first, floats->second);
+                else if (input.type == ProgramInputs::Type::float2)
+                    context->setUniforms2(location, floats->first, floats->second);
+                else if (input.type == ProgramInputs::Type::float3)
+                    context->setUniforms3(location, floats->first, floats->second);
+                else if (input.type == ProgramInputs::Type::float4)
+                    context->setUniforms4(location, floats->first, floats->second);
+                else
+                    context->setUniform(location, floats->first, false, floats->second);
+            }
+
+            continue;
+        }
+
+        switch (input.type)
+        {
+        case ProgramInputs::Type::float1:
+            context->setUniform(location, input.floatValue);
+            break;
+        case ProgramInputs::Type::float2:
+            {
+                auto float2 = static_cast<Vector2*>(input.data);
+
+                context->setUniform(location, float2->x(), float2->y());
+                break;
+            }
+        case ProgramInputs::Type::float3:
+            {
+                auto float3 = static_cast<Vector3*>(input.data);
+
+                context->setUniform(location, float3->x(), float3->y(), float3->z());
+                break;
+            }
+        case ProgramInputs::Type::float4:
+            {
+                auto float4 = static_cast<Vector4*>(input.data);
+
+                context->setUniform(location, float4->x(), float4->y(), float4->z(), float4->w());
+                break;
+            }
+        case ProgramInputs::Type::float16:
+            context->setUniform(location, 1, true, static_cast<const float*>(input.data));
+            break;
+        case ProgramInputs::Type::int1:
+            context->setUniform(location, input.intValues[0]);
+            break;
+        case ProgramInputs::Type::int2:
+            context->setUniform(location, input.intValues[0], input.intValues[1]);
+            break;
+        case ProgramInputs::Type::int3:
+            context->setUniform(location, input.intValues[0], input.intValues[1], input.intValues[2]);
+            break;
+        case ProgramInputs::Type::int4:
+            context->setUniform(location, input.intValues[0], input.intValues[1], input.intValues[2], input.intValues[3]);
+            break;
+        default:
+            break;
+        }
+    }
 }
 
 void
@@ -567,27 +746,7 @@ DrawCall::reset()
 {
     _target = nullptr;
 
-    _uniformFloat.clear();
-    _uniformFloat2.clear();
-    _uniformFloat3.clear();
-    _uniformFloat4.clear();
-    _uniformFloat16.clear();
-
-    _uniformInt.clear();
-    _uniformInt2.clear();
-    _uniformInt3.clear();
-    _uniformInt4.clear();
-
-    _uniformFloats.clear();
-    _uniformFloats2.clear();
-    _uniformFloats3.clear();
-    _uniformFloats4.clear();
-    _uniformFloats16.clear();
-
-    _uniformInts.clear();
-    _uniformInts2.clear();
-    _uniformInts3.clear();
-    _uniformInts4.clear();
+    _uniformInputs.clear();
 
     _textureIds            .clear();
     _textureLocations    .clear();
@@ -606,12 +765,14 @@ DrawCall::reset()
     _vertexSizes            .clear();
     _vertexAttributeSizes    .clear();
     _vertexAttributeOffsets    .clear();
+    _vertexAttributeDivisors    .clear();
 
     _vertexBufferIds            .resize(MAX_NUM_VERTEXBUFFERS, 0);
     _vertexBufferLocations    .resize(MAX_NUM_VERTEXBUFFERS, -1);
     _vertexSizes            .resize(MAX_NUM_VERTEXBUFFERS, -1);
     _vertexAttributeSizes    .resize(MAX_NUM_VERTEXBUFFERS, -1);
     _vertexAttributeOffsets    .resize(MAX_NUM_VERTEXBUFFERS, -1);
+    _vertexAttributeDivisors    .resize(MAX_NUM_VERTEXBUFFERS, 0);
 
     _indicesChangedSlot            = nullptr;
     _layoutsPropertyChangedSlot    = nullptr;
@@ -680,70 +841,7 @@ DrawCall::render(const AbstractContext::Ptr&    context,
 
     context->setProgram(_program->id());
 
-    // float uniforms
-    for (auto& uniformFloat : _uniformFloat)
-        context->setUniform(uniformFloat.first, uniformFloat.second);
-    for (auto& uniformFloat2 : _uniformFloat2)
-    {
-        auto& float2 = uniformFloat2.second;
-
-        context->setUniform(uniformFloat2.first, float2->x(), float2->y());
-    }
-    for (auto& uniformFloat3 : _uniformFloat3)
-    {
-        auto& float3 = uniformFloat3.second;
-
-        context->setUniform(uniformFloat3.first, float3->x(), float3->y(), float3->z());
-    }
-    for (auto& uniformFloat4 : _uniformFloat4)
-    {
-        auto& float4 = uniformFloat4.second;
-
-        context->setUniform(uniformFloat4.first, float4->x(), float4->y(), float4->z(), float4->w());
-    }
-    for (auto& uniformFloat16 : _uniformFloat16)
-        context->setUniform(uniformFloat16.first, 1, true, uniformFloat16.second);
-
-    // integer uniforms
-    for (auto& uniformInt : _uniformInt)
-        context->setUniform(uniformInt.first, uniformInt.second);
-    for (auto& uniformInt2 : _uniformInt2)
-    {
-        const auto& int2 = uniformInt2.second;
-        context->setUniform(uniformInt2.first, std::get<0>(int2), std::get<1>(int2));
-    }
-    for (auto& uniformInt3 : _uniformInt3)
-    {
-        const auto& int3 = uniformInt3.second;
-        context->setUniform(uniformInt3.first, std::get<0>(int3), std::get<1>(int3), std::get<2>(int3));
-    }
-    for (auto& uniformInt4 : _uniformInt4)
-    {
-        const auto& int4 = uniformInt4.second;
-        context->setUniform(uniformInt4.first, std::get<0>(int4), std::get<1>(int4), std::get<2>(int4), std::get<3>(int4));
-    }
-
-    // arrays of float uniforms
-    for (auto& uniformFloats : _uniformFloats)
-        context->setUniforms    (uniformFloats.first,    uniformFloats.second->first,            uniformFloats.second->second);
-    for (auto& uniformFloats2 : _uniformFloats2)
-        context->setUniforms2    (uniformFloats2.first,    uniformFloats2.second->first,            uniformFloats2.second->second);
-    for (auto& uniformFloats3 : _uniformFloats3)
-        context->setUniforms3    (uniformFloats3.first,    uniformFloats3.second->first,            uniformFloats3.second->second);
-    for (auto& uniformFloats4 : _uniformFloats4)
-        context->setUniforms4    (uniformFloats4.first,    uniformFloats4.second->first,            uniformFloats4.second->second);
-    for (auto& uniformFloats16 : _uniformFloats16)
-        context->setUniform        (uniformFloats16.first,    uniformFloats16.second->first, false,    uniformFloats16.second->second);
-
-    // arrays of integer uniforms
-    for (auto& uniformInts: _uniformInts)
-        context->setUniforms    (uniformInts.first,        uniformInts.second->first,            uniformInts.second->second);
-    for (auto& uniformInts2 : _uniformInts2)
-        context->setUniforms2    (uniformInts2.first,    uniformInts2.second->first,            uniformInts2.second->second);
-    for (auto& uniformInts3 : _uniformInts3)
-        context->setUniforms3    (uniformInts3.first,    uniformInts3.second->first,            uniformInts3.second->second);
-    for (auto& uniformInts4 : _uniformInts4)
-        context->setUniforms4    (uniformInts4.first,    uniformInts4.second->first,            uniformInts4.second->second);
+    uploadUniformInputs(context);
 
     auto textureOffset = 0;
     for (auto textureLocationAndPtr : _program->textures())
@@ -783,7 +881,8 @@ DrawCall::render(const AbstractContext::Ptr&    context,
                  vertexBufferId,
                  _vertexAttributeSizes[i],
                  _vertexSizes[i],
-                 _vertexAttributeOffsets[i]
+                 _vertexAttributeOffsets[i],
+                 _vertexAttributeDivisors[i]
             );
     }
     // second, hand over explicitly user defined vertex attributes (possible replacement of )
@@ -818,7 +917,12 @@ DrawCall::render(const AbstractContext::Ptr&    context,
     if (_program->indexBuffer() && _program->indexBuffer()->isReady())
         context->drawTriangles(_program->indexBuffer()->id(), _program->indexBuffer()->data().size() / 3);
     else if (_indexBuffer != -1)
-        context->drawTriangles(_indexBuffer, _numIndices / 3);
+    {
+        if (_numInstances > 0)
+            context->drawInstancedTriangles(_indexBuffer, _numIndices / 3, _numInstances);
+        else
+            context->drawTriangles(_indexBuffer, _numIndices / 3);
+    }
 }
 
 Container::Ptr
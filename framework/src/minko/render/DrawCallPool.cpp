@@ -29,6 +29,9 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/geometry/Geometry.hpp"
 #include "minko/data/ArrayProvider.hpp"
 #include "minko/material/Material.hpp"
+#include "minko/data/StructureProvider.hpp"
+#include "minko/render/VertexBuffer.hpp"
+#include "minko/math/Matrix4x4.hpp"
 
 using namespace minko;
 using namespace minko::math;
@@ -37,7 +40,10 @@ using namespace minko::component;
 using namespace minko::data;
 
 /*static*/ const unsigned int                                    DrawCallPool::NUM_FALLBACK_ATTEMPTS        = 32;
-/*static*/ std::unordered_map<DrawCall::Ptr, Vector3::Ptr>        DrawCallPool::_cachedDrawcallPositions;
+/*static*/ const unsigned int                                    DrawCallPool::PRIORITY_RANK_BITS           = 12;
+/*static*/ const unsigned int                                    DrawCallPool::TARGET_RANK_BITS             = 12;
+/*static*/ const unsigned int                                    DrawCallPool::MIN_NUM_INSTANCES            = 2;
+/*static*/ const unsigned int                                    DrawCallPool::NUM_INSTANCE_ATTRIBUTES      = 4;
 
 std::unordered_map<std::string, std::pair<std::string, int>>    DrawCallPool::_variablePropertyNameToPosition;
 
@@ -52,8 +58,17 @@ DrawCallPool::DrawCallPool(Renderer::Ptr renderer):
     _drawcallToMacroChangedSlot(),
     _drawcallToZSortNeededSlot(),
     _drawCalls(),
+    _sortedDrawCalls(),
+    _sortEntries(),
+    _sortBuffer(),
+    _priorities(),
+    _targetIds(),
     _dirtyDrawCalls(),
     _mustZSort(true),
+    _instancing(false),
+    _instancingGroups(),
+    _drawCallToInstancingKey(),
+    _renderedDrawCalls(),
     _surfaceToTechniqueChangedSlot(),
     _surfaceToVisibilityChangedSlots(),
     _surfaceToIndexChangedSlots(),
@@ -73,86 +88,466 @@ DrawCallPool::initialize()
     });
 }
 
-const std::list<DrawCall::Ptr>&
+const std::vector<DrawCall::Ptr>&
 DrawCallPool::drawCalls()
 {
-    const bool doZSort = _mustZSort || !_toCollect.empty();
+    const bool instancing = _renderer->instancing();
+    bool doZSort = _mustZSort || !_toCollect.empty();
+    bool drawCallsChanged = !_toCollect.empty() || !_toRemove.empty() || !_dirtyDrawCalls.empty();
+
+    if (instancing != _instancing)
+    {
+        clearInstancingGroups();
+        _instancing = instancing;
+        for (auto& drawCall : _drawCalls)
+            addToInstancingGroup(drawCall);
+        drawCallsChanged = true;
+    }
 
     for (auto& surface : _toRemove)
         cleanSurface(surface);
     _toRemove.clear();
 
-    auto dirtyDrawCalls = _dirtyDrawCalls;
-    _dirtyDrawCalls.clear();
+    std::set<DrawCall::Ptr> dirtyDrawCalls;
 
+    dirtyDrawCalls.swap(_dirtyDrawCalls);
+
+    // a refreshed draw call might not share the same program or states as its group anymore
     for (auto& d : dirtyDrawCalls)
+    {
+        removeFromInstancingGroup(d);
         refreshDrawCall(d);
+        if (_drawcallToSurface.count(d) != 0)
+            addToInstancingGroup(d);
+    }
 
     for (auto& surface : _toCollect)
     {
         auto& newDrawCalls = generateDrawCall(surface, NUM_FALLBACK_ATTEMPTS);
 
         _drawCalls.insert(_drawCalls.end(), newDrawCalls.begin(), newDrawCalls.end());
+        for (auto& drawCall : newDrawCalls)
+            addToInstancingGroup(drawCall);
     }
     _toCollect.clear();
 
-    if (doZSort)
+    if (drawCallsChanged)
     {
-        _cachedDrawcallPositions.clear();
-        _drawCalls.sort(&DrawCallPool::compareDrawCalls);
+        updateInstancingGroups();
+        doZSort = true;
     }
+    else
+        for (auto& group : _instancingGroups)
+            if (group.second.drawCall)
+                updateInstanceBuffer(group.second);
+
+    auto& drawCalls = _renderedDrawCalls.empty() ? _drawCalls : _renderedDrawCalls;
+
+    if (doZSort)
+        sortDrawCalls(drawCalls);
     _mustZSort = false;
 
-    return _drawCalls;
+    return drawCalls;
+}
+
+void
+DrawCallPool::addToInstancingGroup(DrawCall::Ptr drawCall)
+{
+    if (!_instancing)
+        return;
+
+    auto program = drawCall->program();
+
+    // draw calls can only be instanced if their effect supports it, if they share the same pass, program,
+    // geometry, material, render target and states and if z-sorting does not apply to them
+    if (drawCall->zSorted()
+        || program == nullptr
+        || drawCall->pass()->macroBindings().count("INSTANCING") == 0
+        || !program->context()->supportsInstancing())
+        return;
+
+    uint numAttributes = 0;
+
+    for (const auto& inputName : program->inputs()->names())
+        if (program->inputs()->type(inputName) == ProgramInputs::Type::attribute)
+            ++numAttributes;
+
+    if (numAttributes + NUM_INSTANCE_ATTRIBUTES > DrawCall::MAX_NUM_VERTEXBUFFERS)
+        return;
+
+    auto surface    = _drawcallToSurface[drawCall];
+    auto key        = InstancingKey(
+        drawCall->pass().get(),
+        program.get(),
+        surface->geometry().get(),
+        surface->material().get(),
+        drawCall->target().get(),
+        drawCall->layouts(),
+        drawCall->priority()
+    );
+    auto groupIt    = _instancingGroups.find(key);
+
+    if (groupIt == _instancingGroups.end())
+        groupIt = _instancingGroups.insert(std::make_pair(key, InstancingGroup())).first;
+
+    groupIt->second.drawCalls.push_back(drawCall);
+    groupIt->second.dirty = true;
+    _drawCallToInstancingKey[drawCall] = key;
+}
+
+void
+DrawCallPool::removeFromInstancingGroup(DrawCall::Ptr drawCall)
+{
+    auto keyIt = _drawCallToInstancingKey.find(drawCall);
+
+    if (keyIt == _drawCallToInstancingKey.end())
+        return;
+
+    auto& group = _instancingGroups[keyIt->second];
+
+    group.drawCalls.erase(std::find(group.drawCalls.begin(), group.drawCalls.end(), drawCall));
+    group.dirty = true;
+    _drawCallToInstancingKey.erase(keyIt);
+
+    // the instanced draw call reads the containers of its source: it must be initialized again from
+    // another member, but the instance buffer is kept
+    if (drawCall == group.source)
+    {
+        group.drawCall->unbind();
+        group.drawCall = nullptr;
+        group.source = nullptr;
+    }
+}
+
+void
+DrawCallPool::clearInstancingGroups()
+{
+    for (auto& group : _instancingGroups)
+        releaseInstancingGroup(group.second);
+    _instancingGroups.clear();
+    _drawCallToInstancingKey.clear();
+    _renderedDrawCalls.clear();
+}
+
+void
+DrawCallPool::updateInstancingGroups()
+{
+    auto numInstancedDrawCalls = 0u;
+
+    // groups whose members changed only rewrite their instances: their draw call and instance buffer
+    // are kept as long as possible, so that surfaces entering or leaving the view do not rebuild them
+
+    for (auto groupIt = _instancingGroups.begin(); groupIt != _instancingGroups.end();)
+    {
+        auto& group = groupIt->second;
+
+        if (group.dirty)
+        {
+            group.dirty = false;
+
+            if (group.drawCalls.empty())
+            {
+                releaseInstancingGroup(group);
+                groupIt = _instancingGroups.erase(groupIt);
+                continue;
+            }
+
+            if (group.drawCalls.size() < MIN_NUM_INSTANCES)
+                releaseInstancingGroup(group);
+            else
+            {
+                updateInstances(group);
+
+                if (group.drawCall == nullptr && !initializeInstancingGroup(group))
+                    releaseInstancingGroup(group);
+            }
+        }
+        else if (group.drawCall)
+            updateInstanceBuffer(group);
+
+        if (group.drawCall)
+            ++numInstancedDrawCalls;
+        ++groupIt;
+    }
+
+    _renderedDrawCalls.clear();
+
+    if (numInstancedDrawCalls == 0)
+        return;
+
+    // each group replaces its draw calls in the rendered list, where its first draw call was
+    for (const auto& drawCall : _drawCalls)
+    {
+        auto keyIt = _drawCallToInstancingKey.find(drawCall);
+
+        if (keyIt == _drawCallToInstancingKey.end())
+        {
+            _renderedDrawCalls.push_back(drawCall);
+            continue;
+        }
+
+        const auto& group = _instancingGroups[keyIt->second];
+
+        if (group.drawCall == nullptr)
+            _renderedDrawCalls.push_back(drawCall);
+        else if (group.drawCalls.front() == drawCall)
+            _renderedDrawCalls.push_back(group.drawCall);
+    }
 }
 
-/*static*/
 bool
-DrawCallPool::compareDrawCalls(DrawCall::Ptr a,
-                               DrawCall::Ptr b)
+DrawCallPool::initializeInstancingGroup(InstancingGroup& group)
+{
+    const auto& source  = group.drawCalls.front();
+    auto        surface = _drawcallToSurface[source];
+
+    group.drawCall = initializeDrawCall(surface, source->pass(), nullptr, group.data);
+
+    if (group.drawCall == nullptr)
+        return false;
+
+    // the effect does not support instancing after all
+    if (group.drawCall->program() == source->program())
+    {
+        group.drawCall->unbind();
+        group.drawCall = nullptr;
+
+        return false;
+    }
+
+    group.source = source;
+    group.drawCall->numInstances(group.drawCalls.size());
+
+    return true;
+}
+
+void
+DrawCallPool::releaseInstancingGroup(InstancingGroup& group)
 {
-    const float    aPriority            = a->priority();
-    const float    bPriority            = b->priority();
-    const bool    arePrioritiesEqual    = fabsf(aPriority - bPriority) < 1e-3f;
+    if (group.drawCall)
+        group.drawCall->unbind();
+    group.drawCall = nullptr;
+    group.source = nullptr;
+    group.modelToWorldMatrices.clear();
+    group.data = nullptr;
+    group.instanceBuffer = nullptr;
+}
+
+void
+DrawCallPool::updateInstances(InstancingGroup& group)
+{
+    static const uint   matrixSize  = 16;
+
+    const auto numInstances = group.drawCalls.size();
 
-    if (!arePrioritiesEqual)
-        return aPriority > bPriority;
+    group.modelToWorldMatrices.clear();
+    for (const auto& drawCall : group.drawCalls)
+    {
+        auto targetData = _drawcallToSurface[drawCall]->targets()[0]->data();
+
+        group.modelToWorldMatrices.push_back(targetData->hasProperty("transform.modelToWorldMatrix")
+            ? targetData->get<Matrix4x4::Ptr>("transform.modelToWorldMatrix")
+            : nullptr
+        );
+    }
 
-    if (a->zSorted() || b->zSorted())
+    if (group.instanceBuffer != nullptr && group.instanceBuffer->numVertices() >= numInstances)
     {
-        static Vector3::Ptr aPosition = Vector3::create();
-        static Vector3::Ptr bPosition = Vector3::create();
+        // the rows past the last instance are not read by the instanced draw call
+        updateInstanceBuffer(group);
 
-        getDrawcallEyePosition(a, aPosition);
-        getDrawcallEyePosition(b, bPosition);
+        if (group.drawCall)
+            group.drawCall->numInstances(numInstances);
 
-        return aPosition->z() > bPosition->z();
+        return;
+    }
+
+    // the instance buffer only grows, doubling its capacity: one row of the model to world matrix per attribute
+    const auto capacity = group.instanceBuffer
+        ? std::max<uint>(numInstances, group.instanceBuffer->numVertices() * 2)
+        : numInstances;
+    auto instanceBuffer = VertexBuffer::create(group.drawCalls.front()->program()->context());
+
+    instanceBuffer->data().resize(capacity * matrixSize, 0.f);
+    for (uint i = 0; i < NUM_INSTANCE_ATTRIBUTES; ++i)
+        instanceBuffer->addAttribute("modelToWorldMatrix" + std::to_string(i), matrixSize / NUM_INSTANCE_ATTRIBUTES);
+    instanceBuffer->divisor(1);
+
+    group.instanceBuffer = instanceBuffer;
+    updateInstanceBuffer(group);
+    // the buffer must exist on the GPU before the draw call binds it
+    if (instanceBuffer->id() == -1)
+        instanceBuffer->upload();
+
+    // an existing instanced draw call binds the new buffer when the reference changes
+    if (group.data == nullptr)
+        group.data = data::StructureProvider::create("instancing");
+    for (uint i = 0; i < NUM_INSTANCE_ATTRIBUTES; ++i)
+        group.data->set("modelToWorldMatrix" + std::to_string(i), instanceBuffer);
+
+    if (group.drawCall)
+        group.drawCall->numInstances(numInstances);
+}
+
+void
+DrawCallPool::updateInstanceBuffer(InstancingGroup& group)
+{
+    static const float  identity[]  = { 1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f };
+    static const uint   matrixSize  = 16;
+
+    auto&   instanceData    = group.instanceBuffer->data();
+    int     firstChanged    = -1;
+    int     lastChanged     = -1;
+
+    for (uint i = 0; i < group.modelToWorldMatrices.size(); ++i)
+    {
+        const auto&     matrix          = group.modelToWorldMatrices[i];
+        const float*    values          = matrix ? &matrix->data()[0] : identity;
+        float*          instanceValues  = &instanceData[i * matrixSize];
+
+        if (std::memcmp(instanceValues, values, matrixSize * sizeof(float)) != 0)
+        {
+            std::memcpy(instanceValues, values, matrixSize * sizeof(float));
+            if (firstChanged < 0)
+                firstChanged = i;
+            lastChanged = i;
+        }
+    }
+
+    // only upload the range of instances that actually moved
+    if (firstChanged >= 0)
+        group.instanceBuffer->upload(firstChanged, lastChanged - firstChanged + 1);
+}
+
+void
+DrawCallPool::sortDrawCalls(std::vector<DrawCall::Ptr>& drawCalls)
+{
+    // priorities and render targets are replaced by their rank so that they fit in the sort keys
+    _priorities.clear();
+    _targetIds.clear();
+
+    for (auto& drawCall : drawCalls)
+    {
+        auto target = drawCall->target();
+
+        _priorities.push_back(drawCall->priority());
+        _targetIds.push_back(target && target->isReady() ? target->id() : 0);
+    }
+
+    std::sort(_priorities.begin(), _priorities.end(), std::greater<float>());
+    _priorities.erase(
+        std::unique(_priorities.begin(), _priorities.end(), [](float a, float b) { return fabsf(a - b) < 1e-3f; }),
+        _priorities.end()
+    );
+    std::sort(_targetIds.begin(), _targetIds.end(), std::greater<int>());
+    _targetIds.erase(std::unique(_targetIds.begin(), _targetIds.end()), _targetIds.end());
+
+    _sortEntries.resize(drawCalls.size());
+    for (uint i = 0; i < drawCalls.size(); ++i)
+        _sortEntries[i] = SortEntry(getDrawCallSortKey(drawCalls[i]), i);
+
+    radixSort(_sortEntries, _sortBuffer);
+
+    _sortedDrawCalls.resize(drawCalls.size());
+    for (uint i = 0; i < _sortEntries.size(); ++i)
+        _sortedDrawCalls[i] = std::move(drawCalls[_sortEntries[i].second]);
+
+    drawCalls.swap(_sortedDrawCalls);
+    _sortedDrawCalls.clear();
+}
+
+uint64_t
+DrawCallPool::getDrawCallSortKey(DrawCall::Ptr drawCall)
+{
+    static const uint       zSortedBit      = 63 - PRIORITY_RANK_BITS;
+    static const uint       targetShift     = zSortedBit - TARGET_RANK_BITS;
+    static const uint64_t   maxPriorityRank = (1 << PRIORITY_RANK_BITS) - 1;
+    static const uint64_t   maxTargetRank   = (1 << TARGET_RANK_BITS) - 1;
+    static auto             eyePosition     = Vector3::create();
+
+    // higher priorities first, priorities closer than 1e-3 are considered equal
+    const uint64_t priorityRank = std::lower_bound(
+        _priorities.begin(), _priorities.end(), drawCall->priority() + 1e-3f, std::greater<float>()
+    ) - _priorities.begin();
+    // render targets with higher ids first, back buffer last
+    auto target = drawCall->target();
+    const uint64_t targetRank = std::lower_bound(
+        _targetIds.begin(), _targetIds.end(), target && target->isReady() ? target->id() : 0, std::greater<int>()
+    ) - _targetIds.begin();
+
+    uint64_t key = (std::min(priorityRank, maxPriorityRank) << (zSortedBit + 1))
+        | (std::min(targetRank, maxTargetRank) << targetShift);
+
+    if (drawCall->zSorted())
+    {
+        // back-to-front: the farther the draw call, the lower its key
+        uint depth;
+        auto z = drawCall->getEyeSpacePosition(eyePosition)->z();
+
+        std::memcpy(&depth, &z, sizeof(float));
+        depth = (depth & 0x80000000) ? ~depth : (depth | 0x80000000);
+
+        key |= (uint64_t(1) << zSortedBit) | (uint64_t(~depth) << (targetShift - 32));
     }
     else
     {
-        // ordered by target texture id, if any
-        return a->target() && (!b->target() || (a->target()->id() > b->target()->id()));
+        // group draw calls sharing the same program and the same textures
+        auto program = drawCall->program();
+        uint programId = program && program->isReady() ? program->id() : 0;
+        uint texturesHash = 0;
+
+        for (auto textureId : drawCall->textureIds())
+            texturesHash = texturesHash * 31 + textureId;
+        texturesHash ^= texturesHash >> 16;
+
+        key |= (uint64_t(programId & 0xffff) << (targetShift - 16)) | (uint64_t(texturesHash & 0xffff) << (targetShift - 32));
     }
+
+    return key;
 }
 
 /*static*/
-Vector3::Ptr
-DrawCallPool::getDrawcallEyePosition(DrawCall::Ptr drawcall,
-                                     Vector3::Ptr output)
+void
+DrawCallPool::radixSort(std::vector<SortEntry>& entries, std::vector<SortEntry>& buffer)
 {
-    const auto foundPositionIt = _cachedDrawcallPositions.find(drawcall);
+    const auto numEntries = entries.size();
+
+    if (numEntries < 2)
+        return;
+
+    uint counts[sizeof(uint64_t)][256] = {};
+
+    for (auto& entry : entries)
+        for (uint byte = 0; byte < sizeof(uint64_t); ++byte)
+            ++counts[byte][(entry.first >> (byte << 3)) & 0xff];
 
-    if (foundPositionIt != _cachedDrawcallPositions.end())
+    buffer.resize(numEntries);
+
+    // least significant byte first, each pass being stable
+    for (uint byte = 0; byte < sizeof(uint64_t); ++byte)
     {
-        if (output == nullptr)
-            output = Vector3::create(foundPositionIt->second);
-        else
-            output->copyFrom(foundPositionIt->second);
+        const auto shift = byte << 3;
+        auto& count = counts[byte];
 
-        return output;
+        // all the keys share the same value for this byte
+        if (count[(entries[0].first >> shift) & 0xff] == numEntries)
+            continue;
+
+        uint offset = 0;
+
+        for (uint i = 0; i < 256; ++i)
+        {
+            auto numKeys = count[i];
+
+            count[i] = offset;
+            offset += numKeys;
+        }
+
+        for (auto& entry : entries)
+            buffer[count[(entry.first >> shift) & 0xff]++] = entry;
+
+        entries.swap(buffer);
     }
-    else
-        return drawcall->getEyeSpacePosition(output);
 }
 
 void
@@ -209,7 +604,7 @@ DrawCallPool::addSurface(Surface::Ptr surface)
     }
 
     //if (std::find(_toCollect.begin(), _toCollect.end(), surface) == _toCollect.end())
-    if (surface->visible(_renderer))
+    if (surface->visible(_renderer) && !surface->batched())
         _toCollect.insert(surface);
     else
         _invisibleSurfaces.insert(surface);
@@ -219,6 +614,10 @@ DrawCallPool::addSurface(Surface::Ptr surface)
 void
 DrawCallPool::removeSurface(Surface::Ptr surface)
 {
+    // a surface that left the renderer must not be collected again when its visibility changes
+    _surfaceToVisibilityChangedSlots.erase(surface);
+    _invisibleSurfaces.erase(surface);
+
     auto foundSurfaceIt = _toCollect.find(surface);
 
     if (foundSurfaceIt == _toCollect.end())
@@ -261,7 +660,8 @@ DrawCallPool::visibilityChangedHandler(Surface::Ptr        surface,
     if (renderer != _renderer && renderer != nullptr)
         return;
 
-    bool visible = surface->visible(_renderer) && surface->computedVisibility(_renderer);
+    // batched surfaces are rendered by the draw calls of their batch instead of their own
+    bool visible = surface->visible(_renderer) && surface->computedVisibility(_renderer) && !surface->batched();
 
     if (visible && _invisibleSurfaces.find(surface) != _invisibleSurfaces.end()) // visible and already wasn't visible before
     {
@@ -270,7 +670,9 @@ DrawCallPool::visibilityChangedHandler(Surface::Ptr        surface,
     }
     else if (!visible && _invisibleSurfaces.find(surface) == _invisibleSurfaces.end()) // not visible but was visible before
     {
-        _toRemove.insert(surface);
+        // a surface hidden before its draw calls were even collected has nothing to remove
+        if (_toCollect.erase(surface) == 0)
+            _toRemove.insert(surface);
         _invisibleSurfaces.insert(surface);
     }
 
@@ -349,9 +751,10 @@ DrawCallPool::generateDrawCall(Surface::Ptr    surface,
 }
 
 DrawCall::Ptr
-DrawCallPool::initializeDrawCall(Surface::Ptr    surface,
-                                 Pass::Ptr        pass,
-                                 DrawCall::Ptr    drawCall)
+DrawCallPool::initializeDrawCall(Surface::Ptr               surface,
+                                 Pass::Ptr                  pass,
+                                 DrawCall::Ptr              drawCall,
+                                 StructureProvider::Ptr     instancingData)
 {
     if (pass == nullptr)
         return nullptr;
@@ -385,6 +788,11 @@ DrawCallPool::initializeDrawCall(Surface::Ptr    surface,
     rendererData    = fullRendererData->filter(rendererFilters);
     rootData        = fullRootData->filter(rootFilters);
 
+    // the filtered target container belongs to the draw call: adding the per-instance data to it
+    // does not affect the other draw calls of the target
+    if (instancingData)
+        targetData->addProvider(instancingData);
+
     // get drawcall's property name formatting function (dependent on filters!)
     auto geometryId    = targetData->getProviderIndex(surface->geometry()->data());
     auto materialId    = targetData->getProviderIndex(surface->material());
@@ -539,6 +947,14 @@ DrawCallPool::deleteDrawCalls(Surface::Ptr surface)
 {
     auto& drawCalls = _surfaceToDrawCalls[surface];
 
+    _drawCalls.erase(
+        std::remove_if(_drawCalls.begin(), _drawCalls.end(), [&](const DrawCall::Ptr& drawCall)
+        {
+            return std::find(drawCalls.begin(), drawCalls.end(), drawCall) != drawCalls.end();
+        }),
+        _drawCalls.end()
+    );
+
     while (!drawCalls.empty())
     {
         auto drawCall = drawCalls.front();
@@ -548,8 +964,8 @@ DrawCallPool::deleteDrawCalls(Surface::Ptr surface)
         _drawcallToMacroChangedSlot.erase(drawCall);
         _drawcallToZSortNeededSlot.erase(drawCall);
 
-        _drawCalls.remove(drawCall);
         _dirtyDrawCalls.erase(drawCall);
+        removeFromInstancingGroup(drawCall);
     }
 }
 
@@ -69,6 +69,12 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 # include <EGL/egl.h>
 #endif
 
+// instanced arrays are resolved at link time on desktop GL only, other platforms fall back on one draw call per instance
+#if MINKO_PLATFORM == MINKO_PLATFORM_LINUX || MINKO_PLATFORM == MINKO_PLATFORM_OSX \
+    || (MINKO_PLATFORM == MINKO_PLATFORM_WINDOWS && !defined(MINKO_PLUGIN_ANGLE) && !defined(MINKO_PLUGIN_OFFSCREEN))
+# define MINKO_GL_INSTANCED_ARRAYS
+#endif
+
 using namespace minko;
 using namespace minko::render;
 
@@ -142,18 +148,23 @@ OpenGLES2Context::OpenGLES2Context() :
     _textures(),
     _textureSizes(),
     _textureHasMipmaps(),
+    _supportsInstancing(false),
     _viewportX(0),
     _viewportY(0),
     _viewportWidth(0),
     _viewportHeight(0),
     _currentTarget(0),
     _currentIndexBuffer(0),
+    _currentArrayBuffer(0),
+    _currentVertexAttributeEnabled(8, false),
     _currentVertexBuffer(8, 0),
     _currentVertexSize(8, -1),
     _currentVertexStride(8, -1),
     _currentVertexOffset(8, -1),
-    _currentBoundTexture(0),
+    _currentVertexDivisor(8, 0),
+    _currentActiveTexture(0),
     _currentTexture(8, 0),
+    _currentTextureTarget(8, 0),
     _currentProgram(0),
     _currentTriangleCulling(TriangleCulling::BACK),
     _currentWrapMode(),
@@ -168,8 +179,22 @@ OpenGLES2Context::OpenGLES2Context() :
     _currentStencilMask(0x1),
     _currentStencilFailOp(StencilOperation::UNSET),
     _currentStencilZFailOp(StencilOperation::UNSET),
-    _currentStencilZPassOp(StencilOperation::UNSET)
-{
+    _currentStencilZPassOp(StencilOperation::UNSET),
+    _currentScissorTest(false),
+    _currentScissorBox(),
+    _currentClearDepth(1.f),
+    _currentClearStencil(0),
+    _uniformValues(),
+    _currentUniformValues(nullptr),
+    _numIssuedStateChanges(0),
+    _numSkippedStateChanges(0)
+{
+    _currentClearColor[0] = 0.f;
+    _currentClearColor[1] = 0.f;
+    _currentClearColor[2] = 0.f;
+    _currentClearColor[3] = 0.f;
+    _currentUniformValues = &_uniformValues[0];
+
 #if (MINKO_PLATFORM == MINKO_PLATFORM_WINDOWS) && !defined(MINKO_PLUGIN_ANGLE) && !defined(MINKO_PLUGIN_OFFSCREEN)
     glewInit();
 #endif
@@ -192,6 +217,10 @@ OpenGLES2Context::OpenGLES2Context() :
         + " " + std::string(glRenderer ? glRenderer : "(unknown renderer)")
         + " " + std::string(glVersion ? glVersion : "(unknown version)");
 
+#ifdef MINKO_GL_INSTANCED_ARRAYS
+    _supportsInstancing = supportsExtension("GL_ARB_instanced_arrays") && supportsExtension("GL_ARB_draw_instanced");
+#endif
+
     // init. viewport x, y, width and height
     std::vector<int> viewportSettings(4);
     glGetIntegerv(GL_VIEWPORT, &viewportSettings[0]);
@@ -232,7 +261,7 @@ OpenGLES2Context::configureViewport(const uint x,
                                     const uint width,
                                     const uint height)
 {
-    if (x != _viewportX || y != _viewportY || width != _viewportWidth || height != _viewportHeight)
+    if (stateChanged(x != _viewportX || y != _viewportY || width != _viewportWidth || height != _viewportHeight))
     {
         _viewportX = x;
         _viewportY = y;
@@ -259,7 +288,16 @@ OpenGLES2Context::clear(float     red,
     // The initial values are all 0.
     //
     // glClearColor specify clear values for the color buffers
-    glClearColor(red, green, blue, alpha);
+    if (stateChanged(red != _currentClearColor[0] || green != _currentClearColor[1]
+        || blue != _currentClearColor[2] || alpha != _currentClearColor[3]))
+    {
+        _currentClearColor[0] = red;
+        _currentClearColor[1] = green;
+        _currentClearColor[2] = blue;
+        _currentClearColor[3] = alpha;
+
+        glClearColor(red, green, blue, alpha);
+    }
 
     // http://www.opengl.org/sdk/docs/man/xhtml/glClearDepth.xml
     //
@@ -268,11 +306,16 @@ OpenGLES2Context::clear(float     red,
     // depth Specifies the depth value used when the depth buffer is cleared. The initial value is 1.
     //
     // glClearDepth specify the clear value for the depth buffer
+    if (stateChanged(depth != _currentClearDepth))
+    {
+        _currentClearDepth = depth;
+
 #ifdef GL_ES_VERSION_2_0
-    glClearDepthf(depth);
+        glClearDepthf(depth);
 #else
-    glClearDepth(depth);
+        glClearDepth(depth);
 #endif
+    }
 
     // http://www.opengl.org/sdk/docs/man/xhtml/glClearStencil.xml
     //
@@ -281,7 +324,12 @@ OpenGLES2Context::clear(float     red,
     //
     // glClearStencil specify the clear value for the stencil buffer
 #ifndef MINKO_NO_STENCIL
-    glClearStencil(stencil);
+    if (stateChanged(stencil != _currentClearStencil))
+    {
+        _currentClearStencil = stencil;
+
+        glClearStencil(stencil);
+    }
 #endif
 
     // http://www.opengl.org/sdk/docs/man/xhtml/glClear.xml
@@ -293,7 +341,7 @@ OpenGLES2Context::clear(float     red,
     //
     // glClear clear buffers to preset values
     mask = (GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT) & mask;
-    if (mask & GL_DEPTH_BUFFER_BIT)
+    if ((mask & GL_DEPTH_BUFFER_BIT) && stateChanged(!_currentDepthMask))
         glDepthMask(_currentDepthMask = true);
     glClear(mask);
 }
@@ -312,12 +360,7 @@ OpenGLES2Context::present()
 void
 OpenGLES2Context::drawTriangles(const uint indexBuffer, const int numTriangles)
 {
-    if (_currentIndexBuffer != indexBuffer)
-    {
-        _currentIndexBuffer = indexBuffer;
-
-        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
-    }
+    bindElementArrayBuffer(indexBuffer);
 
     // http://www.opengl.org/sdk/docs/man/xhtml/glDrawElements.xml
     //
@@ -333,6 +376,26 @@ OpenGLES2Context::drawTriangles(const uint indexBuffer, const int numTriangles)
     checkForErrors();
 }
 
+void
+OpenGLES2Context::drawInstancedTriangles(const uint indexBuffer, const int numTriangles, const uint numInstances)
+{
+    if (!_supportsInstancing)
+        throw std::logic_error("Hardware instancing is not supported by this context.");
+
+    bindElementArrayBuffer(indexBuffer);
+
+#ifdef MINKO_GL_INSTANCED_ARRAYS
+    // http://www.opengl.org/registry/specs/ARB/draw_instanced.txt
+    //
+    // void glDrawElementsInstancedARB(GLenum mode, GLsizei count, GLenum type, const GLvoid* indices, GLsizei primcount);
+    // behaves like glDrawElements called primcount times, attributes with a non-zero divisor advancing once
+    // every divisor instances
+    glDrawElementsInstancedARB(GL_TRIANGLES, numTriangles * 3, GL_UNSIGNED_SHORT, (void*)0, numInstances);
+#endif
+
+    checkForErrors();
+}
+
 const uint
 OpenGLES2Context::createVertexBuffer(const uint size)
 {
@@ -359,6 +422,8 @@ OpenGLES2Context::createVertexBuffer(const uint size)
     // glBindBuffer binds a buffer object to the specified buffer binding point.
     glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
 
+    _currentArrayBuffer = vertexBuffer;
+
     // http://www.opengl.org/sdk/docs/man/xhtml/glBufferData.xml
     //
     // void glBufferData(GLenum target, GLsizeiptr size, const GLvoid* data, GLenum usage)
@@ -383,7 +448,7 @@ OpenGLES2Context::uploadVertexBufferData(const uint vertexBuffer,
                                          const uint size,
                                          void*                 data)
 {
-    glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+    bindArrayBuffer(vertexBuffer);
 
     // http://www.opengl.org/sdk/docs/man/xhtml/glBufferSubData.xml
     //
@@ -402,10 +467,14 @@ OpenGLES2Context::uploadVertexBufferData(const uint vertexBuffer,
 void
 OpenGLES2Context::deleteVertexBuffer(const uint vertexBuffer)
 {
+    // the attributes still reference the deleted buffer and must be re-specified before being used again
     for (auto& currentVertexBuffer : _currentVertexBuffer)
         if (currentVertexBuffer == vertexBuffer)
             currentVertexBuffer = 0;
 
+    if (_currentArrayBuffer == vertexBuffer)
+        _currentArrayBuffer = 0;
+
     _vertexBuffers.erase(std::find(_vertexBuffers.begin(), _vertexBuffers.end(), vertexBuffer));
 
     // http://www.opengl.org/sdk/docs/man/xhtml/glDeleteBuffers.xml
@@ -427,41 +496,61 @@ OpenGLES2Context::setVertexBufferAt(const uint    position,
                                     const uint    vertexBuffer,
                                     const uint    size,
                                     const uint    stride,
-                                    const uint    offset)
+                                    const uint    offset,
+                                    const uint    divisor)
 {
-    auto currentVertexBuffer = _currentVertexBuffer[position];
+    const bool enabled = vertexBuffer > 0;
 
-    if (currentVertexBuffer == vertexBuffer
-        && _currentVertexSize[position] == size
-        && _currentVertexStride[position] == stride
-        && _currentVertexOffset[position] == position)
-        return ;
+    if (divisor != 0 && !_supportsInstancing)
+        throw std::invalid_argument("divisor");
 
-    _currentVertexBuffer[position] = vertexBuffer;
-    _currentVertexSize[position] = size;
-    _currentVertexStride[position] = stride;
-    _currentVertexOffset[position] = offset;
-
-    if (vertexBuffer > 0)
-        glEnableVertexAttribArray(position);
-    else
+    if (stateChanged(_currentVertexAttributeEnabled[position] != enabled))
     {
-        glDisableVertexAttribArray(position);
+        _currentVertexAttributeEnabled[position] = enabled;
 
+        if (enabled)
+            glEnableVertexAttribArray(position);
+        else
+            glDisableVertexAttribArray(position);
+    }
+
+    // the pointer of a disabled attribute is kept as is and will be reused if it is enabled again
+    if (!enabled)
         return;
+
+    if (stateChanged(_currentVertexBuffer[position] != vertexBuffer
+        || _currentVertexSize[position] != size
+        || _currentVertexStride[position] != stride
+        || _currentVertexOffset[position] != offset))
+    {
+        _currentVertexBuffer[position] = vertexBuffer;
+        _currentVertexSize[position] = size;
+        _currentVertexStride[position] = stride;
+        _currentVertexOffset[position] = offset;
+
+        bindArrayBuffer(vertexBuffer);
+
+        // http://www.khronos.org/opengles/sdk/docs/man/xhtml/glVertexAttribPointer.xml
+        glVertexAttribPointer(
+            position,
+            size,
+            GL_FLOAT,
+            GL_FALSE,
+            sizeof(GLfloat) * stride,
+            (void*)(sizeof(GLfloat) * offset)
+        );
     }
 
-    glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+    // only attributes used for instancing ever change their divisor: do not count the other ones as skipped changes
+    if (_currentVertexDivisor[position] != divisor && stateChanged(true))
+    {
+        _currentVertexDivisor[position] = divisor;
 
-    // http://www.khronos.org/opengles/sdk/docs/man/xhtml/glVertexAttribPointer.xml
-    glVertexAttribPointer(
-        position,
-        size,
-        GL_FLOAT,
-        GL_FALSE,
-        sizeof(GLfloat) * stride,
-        (void*)(sizeof(GLfloat) * offset)
-    );
+#ifdef MINKO_GL_INSTANCED_ARRAYS
+        // http://www.opengl.org/registry/specs/ARB/instanced_arrays.txt
+        glVertexAttribDivisorARB(position, divisor);
+#endif
+    }
 
     checkForErrors();
 }
@@ -491,9 +580,7 @@ OpenGLES2Context::uploaderIndexBufferData(const uint     indexBuffer,
                                           const uint     size,
                                           void*                    data)
 {
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
-
-    _currentIndexBuffer = indexBuffer;
+    bindElementArrayBuffer(indexBuffer);
 
     glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, offset * sizeof(GLushort), size * sizeof(GLushort), data);
 
@@ -550,9 +637,7 @@ OpenGLES2Context::createTexture(TextureType    type,
         ? GL_TEXTURE_2D
         : GL_TEXTURE_CUBE_MAP;
 
-    glBindTexture(glTarget, texture);
-
-    _currentBoundTexture = texture;
+    bindTexture(glTarget, texture);
 
     // default sampler states
     glTexParameteri(glTarget, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -672,9 +757,7 @@ OpenGLES2Context::createCompressedTexture(TextureType     type,
         ? GL_TEXTURE_2D
         : GL_TEXTURE_CUBE_MAP;
 
-    glBindTexture(glTarget, texture);
-
-    _currentBoundTexture = texture;
+    bindTexture(glTarget, texture);
 
     // default sampler states
     glTexParameteri(glTarget, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -715,11 +798,9 @@ OpenGLES2Context::uploadTexture2dData(uint         texture,
 {
     assert(getTextureType(texture) == TextureType::Texture2D);
 
-    glBindTexture(GL_TEXTURE_2D, texture);
+    bindTexture(GL_TEXTURE_2D, texture);
     glTexImage2D(GL_TEXTURE_2D, mipLevel, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
 
-    _currentBoundTexture = texture;
-
     checkForErrors();
 }
 
@@ -733,7 +814,7 @@ OpenGLES2Context::uploadCubeTextureData(uint                texture,
 {
     assert(getTextureType(texture) == TextureType::CubeTexture);
 
-    glBindTexture(GL_TEXTURE_CUBE_MAP, texture);
+    bindTexture(GL_TEXTURE_CUBE_MAP, texture);
 
     GLenum cubeFace;
     switch (face)
@@ -763,8 +844,6 @@ OpenGLES2Context::uploadCubeTextureData(uint                texture,
 
     glTexImage2D(cubeFace, mipLevel, GL_RGBA, width, height, 0, GL_RGBA, GL_UNSIGNED_BYTE, data);
 
-    _currentBoundTexture = texture;
-
     checkForErrors();
 }
 
@@ -781,11 +860,9 @@ OpenGLES2Context::uploadCompressedTexture2dData(uint          texture,
 
     const auto& formats = availableTextureFormats();
 
-    glBindTexture(GL_TEXTURE_2D, texture);
+    bindTexture(GL_TEXTURE_2D, texture);
     glCompressedTexImage2D(GL_TEXTURE_2D, mipLevel, formats.at(format), width, height, 0, size, data);
 
-    _currentBoundTexture = texture;
-
     checkForErrors();
 }
 
@@ -832,8 +909,11 @@ OpenGLES2Context::deleteTexture(uint texture)
     _currentMipFilter.erase(texture);
 
     for (unsigned int pos = 0; pos < _currentTexture.size(); ++pos)
-        _currentTexture[pos] = (_currentTexture[pos] == texture ? 0 : _currentTexture[pos]);
-    _currentBoundTexture = (_currentBoundTexture == texture ? 0 : _currentBoundTexture);
+        if (_currentTexture[pos] == texture)
+        {
+            _currentTexture[pos] = 0;
+            _currentTextureTarget[pos] = 0;
+        }
 
     checkForErrors();
 }
@@ -851,22 +931,23 @@ OpenGLES2Context::setTextureAt(uint    position,
     if (position >= _currentTexture.size())
         return;
 
-    const auto glTarget    = getTextureType(texture) == TextureType::Texture2D
+    const uint glTarget    = getTextureType(texture) == TextureType::Texture2D
         ? GL_TEXTURE_2D
         : GL_TEXTURE_CUBE_MAP;
 
-    if (_currentTexture[position] != texture ||
-        _currentBoundTexture != texture)
+    if (stateChanged(_currentTexture[position] != texture || _currentTextureTarget[position] != glTarget))
     {
-        glActiveTexture(GL_TEXTURE0 + position);
+        setActiveTexture(position);
         glBindTexture(glTarget, texture);
 
-        _currentTexture[position]    = texture;
-        _currentBoundTexture        = texture;
+        _currentTexture[position] = texture;
+        _currentTextureTarget[position] = glTarget;
     }
 
-    if (textureIsValid && location >= 0)
-        glUniform1i(location, position);
+    const int unit = position;
+
+    if (textureIsValid && location >= 0 && uniformChanged(location, 1, &unit))
+        glUniform1i(location, unit);
 
     checkForErrors();
 }
@@ -882,18 +963,15 @@ OpenGLES2Context::setSamplerStateAt(uint            position,
         ? GL_TEXTURE_2D
         : GL_TEXTURE_CUBE_MAP;
 
-    auto active    = false;
-
     // disable mip mapping if mip maps are not available
     if (!_textureHasMipmaps[texture])
         mipFiltering = MipFilter::NONE;
 
-    if (_currentWrapMode[texture] != wrapping)
+    if (stateChanged(_currentWrapMode[texture] != wrapping))
     {
         _currentWrapMode[texture] = wrapping;
 
-        glActiveTexture(GL_TEXTURE0 + position);
-        active = true;
+        setActiveTexture(position);
 
         switch (wrapping)
         {
@@ -908,13 +986,12 @@ OpenGLES2Context::setSamplerStateAt(uint            position,
         }
     }
 
-    if (_currentTextureFilter[texture] != filtering || _currentMipFilter[texture] != mipFiltering)
+    if (stateChanged(_currentTextureFilter[texture] != filtering || _currentMipFilter[texture] != mipFiltering))
     {
         _currentTextureFilter[texture] = filtering;
         _currentMipFilter[texture] = mipFiltering;
 
-        if (!active)
-            glActiveTexture(GL_TEXTURE0 + position);
+        setActiveTexture(position);
 
         switch (filtering)
         {
@@ -982,6 +1059,9 @@ OpenGLES2Context::linkProgram(const uint program)
 {
     glLinkProgram(program);
 
+    // linking resets all the uniforms to their default values
+    _uniformValues[program].clear();
+
 #ifdef DEBUG
     auto errors = getProgramInfoLogs(program);
 
@@ -999,6 +1079,13 @@ OpenGLES2Context::deleteProgram(const uint program)
 {
     _programs.erase(std::find(_programs.begin(), _programs.end(), program));
 
+    if (_currentProgram == program)
+    {
+        _currentProgram = 0;
+        _currentUniformValues = &_uniformValues[0];
+    }
+    _uniformValues.erase(program);
+
     glDeleteProgram(program);
 
     checkForErrors();
@@ -1030,10 +1117,11 @@ OpenGLES2Context::compileShader(const uint shader)
 void
 OpenGLES2Context::setProgram(const uint program)
 {
-    if (_currentProgram == program)
+    if (!stateChanged(_currentProgram != program))
         return;
 
     _currentProgram = program;
+    _currentUniformValues = &_uniformValues[program];
 
     glUseProgram(program);
 
@@ -1301,118 +1389,149 @@ OpenGLES2Context::getProgramInfoLogs(const uint program)
 void
 OpenGLES2Context::setUniform(uint location, int value)
 {
-    glUniform1i(location, value);
+    if (uniformChanged(location, 1, &value))
+        glUniform1i(location, value);
     checkForErrors();
 }
 
 void
 OpenGLES2Context::setUniform(uint location, int v1, int v2)
 {
-    glUniform2i(location, v1, v2);
+    const int values[] = { v1, v2 };
+
+    if (uniformChanged(location, 2, values))
+        glUniform2i(location, v1, v2);
     checkForErrors();
 }
 
 void
 OpenGLES2Context::setUniform(uint location, int v1, int v2, int v3)
 {
-    glUniform3i(location, v1, v2, v3);
+    const int values[] = { v1, v2, v3 };
+
+    if (uniformChanged(location, 3, values))
+        glUniform3i(location, v1, v2, v3);
     checkForErrors();
 }
 
 void
 OpenGLES2Context::setUniform(uint location, int v1, int v2, int v3, int v4)
 {
-    glUniform4i(location, v1, v2, v3, v4);
+    const int values[] = { v1, v2, v3, v4 };
+
+    if (uniformChanged(location, 4, values))
+        glUniform4i(location, v1, v2, v3, v4);
     checkForErrors();
 }
 
 void
 OpenGLES2Context::setUniform(uint location, float value)
 {
-    glUniform1f(location, value);
+    if (uniformChanged(location, 1, &value))
+        glUniform1f(location, value);
     checkForErrors();
 }
 
 void
 OpenGLES2Context::setUniform(uint location, float v1, float v2)
 {
-    glUniform2f(location, v1, v2);
+    const float values[] = { v1, v2 };
+
+    if (uniformChanged(location, 2, values))
+        glUniform2f(location, v1, v2);
     checkForErrors();
 }
 
 void
 OpenGLES2Context::setUniform(uint location, float v1, float v2, float v3)
 {
-    glUniform3f(location, v1, v2, v3);
+    const float values[] = { v1, v2, v3 };
+
+    if (uniformChanged(location, 3, values))
+        glUniform3f(location, v1, v2, v3);
     checkForErrors();
 }
 
 void
 OpenGLES2Context::setUniform(uint location, float v1, float v2, float v3, float v4)
 {
-    glUniform4f(location, v1, v2, v3, v4);
+    const float values[] = { v1, v2, v3, v4 };
+
+    if (uniformChanged(location, 4, values))
+        glUniform4f(location, v1, v2, v3, v4);
     checkForErrors();
 }
 
 void
 OpenGLES2Context::setUniforms(uint location, uint size, const float* values)
 {
-    glUniform1fv(location, size, values);
+    if (uniformChanged(location, size, values))
+        glUniform1fv(location, size, values);
     checkForErrors();
 }
 
 void
 OpenGLES2Context::setUniforms2(uint location, uint size, const float* values)
 {
-    glUniform2fv(location, size, values);
+    if (uniformChanged(location, size * 2, values))
+        glUniform2fv(location, size, values);
     checkForErrors();
 }
 
 void
 OpenGLES2Context::setUniforms3(uint location, uint size, const float* values)
 {
-    glUniform3fv(location, size, values);
+    if (uniformChanged(location, size * 3, values))
+        glUniform3fv(location, size, values);
     checkForErrors();
 }
 
 void
 OpenGLES2Context::setUniforms4(uint location, uint size, const float* values)
 {
-    glUniform4fv(location, size, values);
+    if (uniformChanged(location, size * 4, values))
+        glUniform4fv(location, size, values);
     checkForErrors();
 }
 
 void
 OpenGLES2Context::setUniforms(uint location, uint size, const int* values)
 {
-    glUniform1iv(location, size, values);
+    if (uniformChanged(location, size, values))
+        glUniform1iv(location, size, values);
     checkForErrors();
 }
 
 void
 OpenGLES2Context::setUniforms2(uint location, uint size, const int* values)
 {
-    glUniform2iv(location, size, values);
+    if (uniformChanged(location, size * 2, values))
+        glUniform2iv(location, size, values);
     checkForErrors();
 }
 
 void
 OpenGLES2Context::setUniforms3(uint location, uint size, const int* values)
 {
-    glUniform3iv(location, size, values);
+    if (uniformChanged(location, size * 3, values))
+        glUniform3iv(location, size, values);
     checkForErrors();
 }
 
 void
 OpenGLES2Context::setUniforms4(uint location, uint size, const int* values)
 {
-    glUniform4iv(location, size, values);
+    if (uniformChanged(location, size * 4, values))
+        glUniform4iv(location, size, values);
     checkForErrors();
 }
 
 void
 OpenGLES2Context::setUniform(const uint& location, const uint& size, bool transpose, const float* values)
 {
+    if (!uniformChanged(location, size << 4, values, transpose ? 1 : 0))
+        return;
+
 #ifdef GL_ES_VERSION_2_0
 
     if (transpose)
@@ -1461,7 +1580,7 @@ OpenGLES2Context::setUniform(const uint& location, const uint& size, bool transp
 void
 OpenGLES2Context::setBlendMode(Blending::Source source, Blending::Destination destination)
 {
-    if ((static_cast<uint>(source) | static_cast<uint>(destination)) != static_cast<uint>(_currentBlendMode))
+    if (stateChanged((static_cast<uint>(source) | static_cast<uint>(destination)) != static_cast<uint>(_currentBlendMode)))
     {
         _currentBlendMode = (Blending::Mode)((uint)source | (uint)destination);
 
@@ -1477,7 +1596,7 @@ OpenGLES2Context::setBlendMode(Blending::Source source, Blending::Destination de
 void
 OpenGLES2Context::setBlendMode(Blending::Mode blendMode)
 {
-    if (blendMode != _currentBlendMode)
+    if (stateChanged(blendMode != _currentBlendMode))
     {
         _currentBlendMode = blendMode;
 
@@ -1493,12 +1612,17 @@ OpenGLES2Context::setBlendMode(Blending::Mode blendMode)
 void
 OpenGLES2Context::setDepthTest(bool depthMask, CompareMode depthFunc)
 {
-    if (depthMask != _currentDepthMask || depthFunc != _currentDepthFunc)
+    if (stateChanged(depthMask != _currentDepthMask))
     {
         _currentDepthMask = depthMask;
-        _currentDepthFunc = depthFunc;
 
         glDepthMask(depthMask);
+    }
+
+    if (stateChanged(depthFunc != _currentDepthFunc))
+    {
+        _currentDepthFunc = depthFunc;
+
         glDepthFunc(_compareFuncs[depthFunc]);
     }
 
@@ -1508,7 +1632,7 @@ OpenGLES2Context::setDepthTest(bool depthMask, CompareMode depthFunc)
 void
 OpenGLES2Context::setColorMask(bool colorMask)
 {
-    if (_currentColorMask != colorMask)
+    if (stateChanged(_currentColorMask != colorMask))
     {
         _currentColorMask = colorMask;
 
@@ -1527,9 +1651,9 @@ OpenGLES2Context::setStencilTest(CompareMode stencilFunc,
                                  StencilOperation stencilZPassOp)
 {
 #ifndef MINKO_NO_STENCIL
-    if (stencilFunc != _currentStencilFunc
+    if (stateChanged(stencilFunc != _currentStencilFunc
         || stencilRef != _currentStencilRef
-        || stencilMask != _currentStencilMask)
+        || stencilMask != _currentStencilMask))
     {
         _currentStencilFunc    = stencilFunc;
         _currentStencilRef    = stencilRef;
@@ -1540,9 +1664,9 @@ OpenGLES2Context::setStencilTest(CompareMode stencilFunc,
 
     checkForErrors();
 
-    if (stencilFailOp != _currentStencilFailOp
+    if (stateChanged(stencilFailOp != _currentStencilFailOp
         || stencilZFailOp != _currentStencilZFailOp
-        || stencilZPassOp != _currentStencilZPassOp)
+        || stencilZPassOp != _currentStencilZPassOp))
     {
         _currentStencilFailOp    = stencilFailOp;
         _currentStencilZFailOp    = stencilZFailOp;
@@ -1568,14 +1692,22 @@ void
 OpenGLES2Context::setScissorTest(bool                        scissorTest,
                                  const render::ScissorBox&    scissorBox)
 {
-    if (scissorTest)
+    if (stateChanged(scissorTest != _currentScissorTest))
     {
-        glEnable(GL_SCISSOR_TEST);
+        _currentScissorTest = scissorTest;
+
+        if (scissorTest)
+            glEnable(GL_SCISSOR_TEST);
+        else
+            glDisable(GL_SCISSOR_TEST);
+    }
 
+    if (scissorTest)
+    {
         int        x = 0;
         int        y = 0;
-        uint    width = 0;
-        uint    height = 0;
+        int        width = 0;
+        int        height = 0;
 
         if (scissorBox.width < 0 || scissorBox.height < 0)
         {
@@ -1592,10 +1724,17 @@ OpenGLES2Context::setScissorTest(bool                        scissorTest,
             height    = scissorBox.height;
         }
 
-        glScissor(x, y, width, height);
+        if (stateChanged(x != _currentScissorBox.x || y != _currentScissorBox.y
+            || width != _currentScissorBox.width || height != _currentScissorBox.height))
+        {
+            _currentScissorBox.x = x;
+            _currentScissorBox.y = y;
+            _currentScissorBox.width = width;
+            _currentScissorBox.height = height;
+
+            glScissor(x, y, width, height);
+        }
     }
-    else
-        glDisable(GL_SCISSOR_TEST);
 
     checkForErrors();
 }
@@ -1611,7 +1750,7 @@ OpenGLES2Context::readPixels(unsigned char* pixels)
 void
 OpenGLES2Context::setTriangleCulling(TriangleCulling triangleCulling)
 {
-    if (triangleCulling == _currentTriangleCulling)
+    if (!stateChanged(triangleCulling != _currentTriangleCulling))
         return;
 
     if (_currentTriangleCulling == TriangleCulling::NONE)
@@ -1640,7 +1779,7 @@ OpenGLES2Context::setTriangleCulling(TriangleCulling triangleCulling)
 void
 OpenGLES2Context::setRenderToBackBuffer()
 {
-    if (_currentTarget == 0)
+    if (!stateChanged(_currentTarget != 0))
         return;
 
     glBindFramebuffer(GL_FRAMEBUFFER, 0);
@@ -1655,7 +1794,7 @@ OpenGLES2Context::setRenderToBackBuffer()
 void
 OpenGLES2Context::setRenderToTexture(uint texture, bool enableDepthAndStencil)
 {
-    if (texture == _currentTarget)
+    if (!stateChanged(texture != _currentTarget))
         return;
 
     if (_frameBuffers.count(texture) == 0)
@@ -1773,11 +1912,9 @@ OpenGLES2Context::getError()
 void
 OpenGLES2Context::generateMipmaps(uint texture)
 {
-    glBindTexture(GL_TEXTURE_2D, texture);
+    bindTexture(GL_TEXTURE_2D, texture);
     glGenerateMipmap(GL_TEXTURE_2D);
 
-    _currentBoundTexture = texture;
-
     checkForErrors();
 }
 
@@ -1883,3 +2020,49 @@ OpenGLES2Context::availableTextureFormats()
 
     return formats;
 }
+
+void
+OpenGLES2Context::setActiveTexture(uint position)
+{
+    if (stateChanged(_currentActiveTexture != position))
+    {
+        _currentActiveTexture = position;
+
+        glActiveTexture(GL_TEXTURE0 + position);
+    }
+}
+
+void
+OpenGLES2Context::bindTexture(uint glTarget, uint texture)
+{
+    if (stateChanged(_currentTexture[_currentActiveTexture] != texture
+                     || _currentTextureTarget[_currentActiveTexture] != glTarget))
+    {
+        _currentTexture[_currentActiveTexture] = texture;
+        _currentTextureTarget[_currentActiveTexture] = glTarget;
+
+        glBindTexture(glTarget, texture);
+    }
+}
+
+void
+OpenGLES2Context::bindArrayBuffer(uint vertexBuffer)
+{
+    if (stateChanged(_currentArrayBuffer != vertexBuffer))
+    {
+        _currentArrayBuffer = vertexBuffer;
+
+        glBindBuffer(GL_ARRAY_BUFFER, vertexBuffer);
+    }
+}
+
+void
+OpenGLES2Context::bindElementArrayBuffer(uint indexBuffer)
+{
+    if (stateChanged(_currentIndexBuffer != indexBuffer))
+    {
+        _currentIndexBuffer = indexBuffer;
+
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexBuffer);
+    }
+}
@@ -62,7 +62,7 @@ ProgramSignature::build(Pass::Ptr                pass,
         const auto&    macroName        = macroBinding.first;
         auto        macroDefault    = macroBinding.second;
 
-        const auto& propertyName    = formatNameFunc(std::get<0>(macroDefault));
+        const PropertyId propertyId(formatNameFunc(std::get<0>(macroDefault)));
         auto        source            = std::get<1>(macroDefault);
         auto        container        = source == BindingSource::TARGET
             ? targetData
@@ -76,8 +76,8 @@ ProgramSignature::build(Pass::Ptr                pass,
         if (foundExplicitDefIt == explicitDefinitions.end())
         {
             // no explicit definition
-            macroExists        = container->hasProperty(propertyName);
-            isMacroInteger    = macroExists && container->propertyHasType<int>(propertyName, true);
+            macroExists        = container->hasProperty(propertyId);
+            isMacroInteger    = macroExists && container->propertyHasType<int>(propertyId);
             defaultMacro    = std::get<2>(macroBinding.second);
         }
         else
@@ -113,7 +113,7 @@ ProgramSignature::build(Pass::Ptr                pass,
                 const int    max        = std::get<4>(macroBinding.second);
 
                 int            value    = isMacroInteger
-                    ? container->get<int>(propertyName)
+                    ? container->get<int>(propertyId)
                     : defaultMacro.value.value;
 
 #ifdef DEACTIVATE_FALLBACK
@@ -0,0 +1,1409 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "minko/render/RecordingContext.hpp"
+
+#include "minko/render/CompareMode.hpp"
+#include "minko/render/WrapMode.hpp"
+#include "minko/render/TextureFilter.hpp"
+#include "minko/render/MipFilter.hpp"
+#include "minko/render/TriangleCulling.hpp"
+#include "minko/render/StencilOperation.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+/*static*/ const uint RecordingContext::NUM_COMMAND_TYPES;
+/*static*/ const uint RecordingContext::MAX_NUM_TEXTURES            = 8;
+/*static*/ const uint RecordingContext::MAX_NUM_VERTEX_ATTRIBUTES   = 8;
+
+RecordingContext::RecordingContext() :
+    _errorsEnabled(false),
+    _driverInfo("Minko RecordingContext"),
+    _recordCommands(true),
+    _supportsInstancing(true),
+    _commands(),
+    _discardedCommand(),
+    _numCommands(NUM_COMMAND_TYPES, 0),
+    _numRedundantCommands(NUM_COMMAND_TYPES, 0),
+    _numTriangles(0),
+    _numInstances(0),
+    _nextResourceId(1),
+    _vertexBuffers(),
+    _indexBuffers(),
+    _textures(),
+    _shaderIsVertex(),
+    _shaderSources(),
+    _programShaders(),
+    _uniformValues(),
+    _viewportX(0),
+    _viewportY(0),
+    _viewportWidth(0),
+    _viewportHeight(0),
+    _oldViewportX(0),
+    _oldViewportY(0),
+    _oldViewportWidth(0),
+    _oldViewportHeight(0),
+    _currentTarget(0),
+    _currentProgram(0),
+    _currentVertexAttributes(MAX_NUM_VERTEX_ATTRIBUTES),
+    _currentTexture(MAX_NUM_TEXTURES, 0),
+    _currentBlendMode(Blending::Mode::DEFAULT),
+    _currentColorMask(true),
+    _currentDepthMask(true),
+    _currentDepthFunc(CompareMode::LESS),
+    _currentTriangleCulling(TriangleCulling::BACK),
+    _currentStencilFunc(CompareMode::ALWAYS),
+    _currentStencilRef(0),
+    _currentStencilMask(0x1),
+    _currentStencilFailOp(StencilOperation::KEEP),
+    _currentStencilZFailOp(StencilOperation::KEEP),
+    _currentStencilZPassOp(StencilOperation::KEEP),
+    _currentScissorTest(false),
+    _currentScissorBox()
+{
+    for (auto& attribute : _currentVertexAttributes)
+    {
+        attribute.vertexBuffer = 0;
+        attribute.size = 0;
+        attribute.stride = 0;
+        attribute.offset = 0;
+        attribute.divisor = 0;
+    }
+}
+
+uint
+RecordingContext::numCommands() const
+{
+    uint total = 0;
+
+    for (auto n : _numCommands)
+        total += n;
+
+    return total;
+}
+
+uint
+RecordingContext::numRedundantCommands() const
+{
+    uint total = 0;
+
+    for (auto n : _numRedundantCommands)
+        total += n;
+
+    return total;
+}
+
+void
+RecordingContext::clearCommands()
+{
+    _commands.clear();
+    std::fill(_numCommands.begin(), _numCommands.end(), 0);
+    std::fill(_numRedundantCommands.begin(), _numRedundantCommands.end(), 0);
+    _numTriangles = 0;
+    _numInstances = 0;
+}
+
+RecordingContext::Command&
+RecordingContext::record(CommandType type, bool redundant, uint target)
+{
+    ++_numCommands[static_cast<uint>(type)];
+    if (redundant)
+        ++_numRedundantCommands[static_cast<uint>(type)];
+
+    if (_recordCommands)
+        _commands.push_back(Command());
+
+    auto& command = _recordCommands ? _commands.back() : _discardedCommand;
+
+    command.type = type;
+    command.redundant = redundant;
+    command.target = target;
+    std::fill(command.args, command.args + 4, 0);
+    std::fill(command.values, command.values + 4, 0.f);
+
+    return command;
+}
+
+template <typename T>
+void
+RecordingContext::recordUniform(uint location, uint numComponents, uint size, const T* values)
+{
+    static_assert(sizeof(T) == sizeof(float), "uniform values must be 32 bits wide");
+
+    const auto numValues    = numComponents * size;
+    auto& currentValues     = _uniformValues[(static_cast<uint64_t>(_currentProgram) << 32) | location];
+    auto redundant          = currentValues.size() == numValues
+        && std::memcmp(&currentValues[0], values, numValues * sizeof(float)) == 0;
+
+    if (!redundant)
+    {
+        currentValues.resize(numValues);
+        std::memcpy(&currentValues[0], values, numValues * sizeof(float));
+    }
+
+    auto& command = record(CommandType::SET_UNIFORM, redundant, location);
+
+    command.args[0] = numComponents;
+    command.args[1] = size;
+    for (uint i = 0; i < 4 && i < numValues; ++i)
+        command.values[i] = static_cast<float>(values[i]);
+}
+
+void
+RecordingContext::configureViewport(const uint x,
+                                    const uint y,
+                                    const uint width,
+                                    const uint height)
+{
+    auto redundant = x == _viewportX && y == _viewportY && width == _viewportWidth && height == _viewportHeight;
+
+    _viewportX = x;
+    _viewportY = y;
+    _viewportWidth = width;
+    _viewportHeight = height;
+
+    auto& command = record(CommandType::CONFIGURE_VIEWPORT, redundant);
+
+    command.args[0] = x;
+    command.args[1] = y;
+    command.args[2] = width;
+    command.args[3] = height;
+}
+
+void
+RecordingContext::clear(float   red,
+                        float   green,
+                        float   blue,
+                        float   alpha,
+                        float   depth,
+                        uint    stencil,
+                        uint    mask)
+{
+    auto& command = record(CommandType::CLEAR, false, mask);
+
+    command.args[0] = stencil;
+    command.values[0] = red;
+    command.values[1] = green;
+    command.values[2] = blue;
+    command.values[3] = alpha;
+
+    _currentDepthMask = true;
+}
+
+void
+RecordingContext::present()
+{
+    record(CommandType::PRESENT, false);
+
+    setRenderToBackBuffer();
+}
+
+void
+RecordingContext::drawTriangles(const uint indexBuffer, const int numTriangles)
+{
+    if (_errorsEnabled && _indexBuffers.count(indexBuffer) == 0)
+        throw std::invalid_argument("indexBuffer");
+
+    auto& command = record(CommandType::DRAW_TRIANGLES, false, indexBuffer);
+
+    command.args[0] = numTriangles;
+    command.args[1] = _currentProgram;
+    command.args[2] = 1;
+
+    _numTriangles += numTriangles;
+    ++_numInstances;
+}
+
+void
+RecordingContext::drawInstancedTriangles(const uint indexBuffer, const int numTriangles, const uint numInstances)
+{
+    if (!_supportsInstancing)
+        throw std::logic_error("Hardware instancing is not supported by this context.");
+    if (_errorsEnabled && _indexBuffers.count(indexBuffer) == 0)
+        throw std::invalid_argument("indexBuffer");
+
+    // recorded as a regular draw call: one draw call for all the instances
+    auto& command = record(CommandType::DRAW_TRIANGLES, false, indexBuffer);
+
+    command.args[0] = numTriangles;
+    command.args[1] = _currentProgram;
+    command.args[2] = numInstances;
+
+    _numTriangles += numTriangles * numInstances;
+    _numInstances += numInstances;
+}
+
+const uint
+RecordingContext::createVertexBuffer(const uint size)
+{
+    auto vertexBuffer = _nextResourceId++;
+
+    _vertexBuffers.insert(vertexBuffer);
+
+    record(CommandType::CREATE_VERTEX_BUFFER, false, vertexBuffer).args[0] = size;
+
+    return vertexBuffer;
+}
+
+void
+RecordingContext::setVertexBufferAt(const uint    position,
+                                    const uint    vertexBuffer,
+                                    const uint    size,
+                                    const uint    stride,
+                                    const uint    offset,
+                                    const uint    divisor)
+{
+    if (position >= _currentVertexAttributes.size())
+        throw std::invalid_argument("position");
+    if (divisor != 0 && !_supportsInstancing)
+        throw std::invalid_argument("divisor");
+
+    auto& attribute = _currentVertexAttributes[position];
+    auto redundant  = attribute.vertexBuffer == vertexBuffer
+        && (vertexBuffer == 0
+            || (attribute.size == size && attribute.stride == stride && attribute.offset == offset
+                && attribute.divisor == divisor));
+
+    attribute.vertexBuffer = vertexBuffer;
+    attribute.size = size;
+    attribute.stride = stride;
+    attribute.offset = offset;
+    attribute.divisor = divisor;
+
+    auto& command = record(CommandType::SET_VERTEX_BUFFER, redundant, position);
+
+    command.args[0] = vertexBuffer;
+    command.args[1] = size;
+    command.args[2] = stride;
+    command.args[3] = offset;
+    command.values[0] = static_cast<float>(divisor);
+}
+
+void
+RecordingContext::uploadVertexBufferData(const uint   vertexBuffer,
+                                         const uint   offset,
+                                         const uint   size,
+                                         void*        data)
+{
+    auto& command = record(CommandType::UPLOAD_VERTEX_BUFFER, false, vertexBuffer);
+
+    command.args[0] = offset;
+    command.args[1] = size;
+}
+
+void
+RecordingContext::deleteVertexBuffer(const uint vertexBuffer)
+{
+    for (auto& attribute : _currentVertexAttributes)
+        if (attribute.vertexBuffer == vertexBuffer)
+            attribute.vertexBuffer = 0;
+
+    _vertexBuffers.erase(vertexBuffer);
+
+    record(CommandType::DELETE_VERTEX_BUFFER, false, vertexBuffer);
+}
+
+const uint
+RecordingContext::createIndexBuffer(const uint size)
+{
+    auto indexBuffer = _nextResourceId++;
+
+    _indexBuffers.insert(indexBuffer);
+
+    record(CommandType::CREATE_INDEX_BUFFER, false, indexBuffer).args[0] = size;
+
+    return indexBuffer;
+}
+
+void
+RecordingContext::uploaderIndexBufferData(const uint  indexBuffer,
+                                          const uint  offset,
+                                          const uint  size,
+                                          void*       data)
+{
+    auto& command = record(CommandType::UPLOAD_INDEX_BUFFER, false, indexBuffer);
+
+    command.args[0] = offset;
+    command.args[1] = size;
+}
+
+void
+RecordingContext::deleteIndexBuffer(const uint indexBuffer)
+{
+    _indexBuffers.erase(indexBuffer);
+
+    record(CommandType::DELETE_INDEX_BUFFER, false, indexBuffer);
+}
+
+uint
+RecordingContext::createTexture(TextureType     type,
+                                unsigned int    width,
+                                unsigned int    height,
+                                bool            mipMapping,
+                                bool            optimizeForRenderToTexture)
+{
+    if (!((width != 0) && !(width & (width - 1))))
+        throw std::invalid_argument("width");
+    if (!((height != 0) && !(height & (height - 1))))
+        throw std::invalid_argument("height");
+
+    auto texture = _nextResourceId++;
+    auto& info = _textures[texture];
+
+    info.type = type;
+    info.width = width;
+    info.height = height;
+    info.mipMapping = mipMapping;
+    info.renderTarget = optimizeForRenderToTexture;
+    info.wrapMode = WrapMode::CLAMP;
+    info.filter = TextureFilter::NEAREST;
+    info.mipFilter = MipFilter::NONE;
+
+    auto& command = record(CommandType::CREATE_TEXTURE, false, texture);
+
+    command.args[0] = width;
+    command.args[1] = height;
+    command.args[2] = static_cast<int>(type);
+
+    return texture;
+}
+
+uint
+RecordingContext::createCompressedTexture(TextureType     type,
+                                          TextureFormat   format,
+                                          unsigned int    width,
+                                          unsigned int    height,
+                                          bool            mipMapping)
+{
+    auto texture = createTexture(type, width, height, mipMapping, false);
+
+    if (_recordCommands)
+        _commands.back().args[3] = static_cast<int>(format);
+
+    return texture;
+}
+
+RecordingContext::TextureInfo&
+RecordingContext::getTextureInfo(uint texture)
+{
+    auto foundTextureIt = _textures.find(texture);
+
+    if (foundTextureIt == _textures.end())
+        throw std::invalid_argument("texture");
+
+    return foundTextureIt->second;
+}
+
+void
+RecordingContext::uploadTexture2dData(uint            texture,
+                                      unsigned int    width,
+                                      unsigned int    height,
+                                      unsigned int    mipLevel,
+                                      void*           data)
+{
+    assert(getTextureInfo(texture).type == TextureType::Texture2D);
+
+    auto& command = record(CommandType::UPLOAD_TEXTURE, false, texture);
+
+    command.args[0] = width;
+    command.args[1] = height;
+    command.args[2] = mipLevel;
+}
+
+void
+RecordingContext::uploadCubeTextureData(uint                texture,
+                                        CubeTexture::Face   face,
+                                        unsigned int        width,
+                                        unsigned int        height,
+                                        unsigned int        mipLevel,
+                                        void*               data)
+{
+    assert(getTextureInfo(texture).type == TextureType::CubeTexture);
+
+    auto& command = record(CommandType::UPLOAD_TEXTURE, false, texture);
+
+    command.args[0] = width;
+    command.args[1] = height;
+    command.args[2] = mipLevel;
+    command.args[3] = static_cast<int>(face);
+}
+
+void
+RecordingContext::uploadCompressedTexture2dData(uint          texture,
+                                                TextureFormat format,
+                                                unsigned int  width,
+                                                unsigned int  height,
+                                                unsigned int  size,
+                                                unsigned int  mipLevel,
+                                                void*         data)
+{
+    uploadTexture2dData(texture, width, height, mipLevel, data);
+}
+
+void
+RecordingContext::uploadCompressedCubeTextureData(uint                texture,
+                                                  CubeTexture::Face   face,
+                                                  TextureFormat       format,
+                                                  unsigned int        width,
+                                                  unsigned int        height,
+                                                  unsigned int        mipLevel,
+                                                  void*               data)
+{
+    uploadCubeTextureData(texture, face, width, height, mipLevel, data);
+}
+
+void
+RecordingContext::activateMipMapping(uint texture)
+{
+    getTextureInfo(texture).mipMapping = true;
+}
+
+void
+RecordingContext::deleteTexture(uint texture)
+{
+    _textures.erase(texture);
+
+    for (auto& currentTexture : _currentTexture)
+        if (currentTexture == texture)
+            currentTexture = 0;
+
+    if (_currentTarget == texture)
+        setRenderToBackBuffer();
+
+    record(CommandType::DELETE_TEXTURE, false, texture);
+}
+
+void
+RecordingContext::setTextureAt(uint   position,
+                               int    texture,
+                               int    location)
+{
+    if (texture <= 0 || position >= _currentTexture.size())
+        return;
+
+    getTextureInfo(texture);
+
+    auto redundant = _currentTexture[position] == static_cast<uint>(texture);
+
+    _currentTexture[position] = texture;
+
+    auto& command = record(CommandType::SET_TEXTURE, redundant, position);
+
+    command.args[0] = texture;
+    command.args[1] = location;
+
+    if (location >= 0)
+        setUniform(location, static_cast<int>(position));
+}
+
+void
+RecordingContext::setSamplerStateAt(uint          position,
+                                    WrapMode      wrapping,
+                                    TextureFilter filtering,
+                                    MipFilter     mipFiltering)
+{
+    auto& info = getTextureInfo(_currentTexture[position]);
+
+    if (!info.mipMapping)
+        mipFiltering = MipFilter::NONE;
+
+    auto redundant = info.wrapMode == wrapping && info.filter == filtering && info.mipFilter == mipFiltering;
+
+    info.wrapMode = wrapping;
+    info.filter = filtering;
+    info.mipFilter = mipFiltering;
+
+    auto& command = record(CommandType::SET_SAMPLER_STATE, redundant, position);
+
+    command.args[0] = static_cast<int>(wrapping);
+    command.args[1] = static_cast<int>(filtering);
+    command.args[2] = static_cast<int>(mipFiltering);
+}
+
+const uint
+RecordingContext::createProgram()
+{
+    auto program = _nextResourceId++;
+
+    _programShaders[program];
+
+    record(CommandType::CREATE_PROGRAM, false, program);
+
+    return program;
+}
+
+void
+RecordingContext::attachShader(const uint program, const uint shader)
+{
+    if (_shaderSources.count(shader) == 0)
+        throw std::invalid_argument("shader");
+
+    _programShaders.at(program).push_back(shader);
+}
+
+void
+RecordingContext::linkProgram(const uint program)
+{
+    if (_programShaders.count(program) == 0)
+        throw std::invalid_argument("program");
+
+    record(CommandType::LINK_PROGRAM, false, program);
+}
+
+void
+RecordingContext::deleteProgram(const uint program)
+{
+    _programShaders.erase(program);
+
+    for (auto it = _uniformValues.begin(); it != _uniformValues.end();)
+        if ((it->first >> 32) == program)
+            it = _uniformValues.erase(it);
+        else
+            ++it;
+
+    if (_currentProgram == program)
+        _currentProgram = 0;
+
+    record(CommandType::DELETE_PROGRAM, false, program);
+}
+
+void
+RecordingContext::setProgram(const uint program)
+{
+    auto redundant = _currentProgram == program;
+
+    _currentProgram = program;
+
+    record(CommandType::SET_PROGRAM, redundant, program);
+}
+
+void
+RecordingContext::compileShader(const uint shader)
+{
+    if (_shaderSources.count(shader) == 0)
+        throw std::invalid_argument("shader");
+
+    record(CommandType::COMPILE_SHADER, false, shader);
+}
+
+void
+RecordingContext::setShaderSource(const uint shader, const std::string& source)
+{
+    if (_shaderSources.count(shader) == 0)
+        throw std::invalid_argument("shader");
+
+    _shaderSources[shader] = source;
+}
+
+const uint
+RecordingContext::createVertexShader()
+{
+    auto shader = _nextResourceId++;
+
+    _shaderIsVertex[shader] = true;
+    _shaderSources[shader] = "";
+
+    record(CommandType::CREATE_SHADER, false, shader).args[0] = 1;
+
+    return shader;
+}
+
+void
+RecordingContext::deleteVertexShader(const uint vertexShader)
+{
+    _shaderIsVertex.erase(vertexShader);
+    _shaderSources.erase(vertexShader);
+
+    record(CommandType::DELETE_SHADER, false, vertexShader);
+}
+
+const uint
+RecordingContext::createFragmentShader()
+{
+    auto shader = _nextResourceId++;
+
+    _shaderIsVertex[shader] = false;
+    _shaderSources[shader] = "";
+
+    record(CommandType::CREATE_SHADER, false, shader).args[0] = 0;
+
+    return shader;
+}
+
+void
+RecordingContext::deleteFragmentShader(const uint fragmentShader)
+{
+    deleteVertexShader(fragmentShader);
+}
+
+std::shared_ptr<ProgramInputs>
+RecordingContext::getProgramInputs(const uint program)
+{
+    std::vector<std::string>            names;
+    std::vector<ProgramInputs::Type>    types;
+    std::vector<uint>                   locations;
+    uint                                numUniformLocations     = 0;
+    uint                                numAttributeLocations   = 0;
+
+    setProgram(program);
+
+    for (auto shader : _programShaders.at(program))
+    {
+        MacroMap    macros;
+        std::string source;
+
+        preprocess(_shaderSources.at(shader), source, macros);
+        fillInputs(source, macros, names, types, locations, numUniformLocations, numAttributeLocations);
+    }
+
+    return ProgramInputs::create(shared_from_this(), program, names, types, locations);
+}
+
+void
+RecordingContext::setUniform(uint location, int value)
+{
+    recordUniform(location, 1, 1, &value);
+}
+
+void
+RecordingContext::setUniform(uint location, int v1, int v2)
+{
+    int values[] = { v1, v2 };
+
+    recordUniform(location, 2, 1, values);
+}
+
+void
+RecordingContext::setUniform(uint location, int v1, int v2, int v3)
+{
+    int values[] = { v1, v2, v3 };
+
+    recordUniform(location, 3, 1, values);
+}
+
+void
+RecordingContext::setUniform(uint location, int v1, int v2, int v3, int v4)
+{
+    int values[] = { v1, v2, v3, v4 };
+
+    recordUniform(location, 4, 1, values);
+}
+
+void
+RecordingContext::setUniform(uint location, float value)
+{
+    recordUniform(location, 1, 1, &value);
+}
+
+void
+RecordingContext::setUniform(uint location, float v1, float v2)
+{
+    float values[] = { v1, v2 };
+
+    recordUniform(location, 2, 1, values);
+}
+
+void
+RecordingContext::setUniform(uint location, float v1, float v2, float v3)
+{
+    float values[] = { v1, v2, v3 };
+
+    recordUniform(location, 3, 1, values);
+}
+
+void
+RecordingContext::setUniform(uint location, float v1, float v2, float v3, float v4)
+{
+    float values[] = { v1, v2, v3, v4 };
+
+    recordUniform(location, 4, 1, values);
+}
+
+void
+RecordingContext::setUniform(const uint& location, const uint& size, bool transpose, const float* values)
+{
+    recordUniform(location, 16, size, values);
+}
+
+void
+RecordingContext::setUniforms(uint location, uint size, const float* values)
+{
+    recordUniform(location, 1, size, values);
+}
+
+void
+RecordingContext::setUniforms2(uint location, uint size, const float* values)
+{
+    recordUniform(location, 2, size, values);
+}
+
+void
+RecordingContext::setUniforms3(uint location, uint size, const float* values)
+{
+    recordUniform(location, 3, size, values);
+}
+
+void
+RecordingContext::setUniforms4(uint location, uint size, const float* values)
+{
+    recordUniform(location, 4, size, values);
+}
+
+void
+RecordingContext::setUniforms(uint location, uint size, const int* values)
+{
+    recordUniform(location, 1, size, values);
+}
+
+void
+RecordingContext::setUniforms2(uint location, uint size, const int* values)
+{
+    recordUniform(location, 2, size, values);
+}
+
+void
+RecordingContext::setUniforms3(uint location, uint size, const int* values)
+{
+    recordUniform(location, 3, size, values);
+}
+
+void
+RecordingContext::setUniforms4(uint location, uint size, const int* values)
+{
+    recordUniform(location, 4, size, values);
+}
+
+void
+RecordingContext::setBlendMode(Blending::Source source, Blending::Destination destination)
+{
+    setBlendMode(source | destination);
+}
+
+void
+RecordingContext::setBlendMode(Blending::Mode blendMode)
+{
+    auto redundant = _currentBlendMode == blendMode;
+
+    _currentBlendMode = blendMode;
+
+    record(CommandType::SET_BLEND_MODE, redundant).args[0] = static_cast<int>(blendMode);
+}
+
+void
+RecordingContext::setColorMask(bool colorMask)
+{
+    auto redundant = _currentColorMask == colorMask;
+
+    _currentColorMask = colorMask;
+
+    record(CommandType::SET_COLOR_MASK, redundant).args[0] = colorMask;
+}
+
+void
+RecordingContext::setDepthTest(bool depthMask, CompareMode depthFunc)
+{
+    auto redundant = _currentDepthMask == depthMask && _currentDepthFunc == depthFunc;
+
+    _currentDepthMask = depthMask;
+    _currentDepthFunc = depthFunc;
+
+    auto& command = record(CommandType::SET_DEPTH_TEST, redundant);
+
+    command.args[0] = depthMask;
+    command.args[1] = static_cast<int>(depthFunc);
+}
+
+void
+RecordingContext::setStencilTest(CompareMode      stencilFunc,
+                                 int              stencilRef,
+                                 uint             stencilMask,
+                                 StencilOperation stencilFailOp,
+                                 StencilOperation stencilZFailOp,
+                                 StencilOperation stencilZPassOp)
+{
+    auto redundant = _currentStencilFunc == stencilFunc
+        && _currentStencilRef == stencilRef
+        && _currentStencilMask == stencilMask
+        && _currentStencilFailOp == stencilFailOp
+        && _currentStencilZFailOp == stencilZFailOp
+        && _currentStencilZPassOp == stencilZPassOp;
+
+    _currentStencilFunc = stencilFunc;
+    _currentStencilRef = stencilRef;
+    _currentStencilMask = stencilMask;
+    _currentStencilFailOp = stencilFailOp;
+    _currentStencilZFailOp = stencilZFailOp;
+    _currentStencilZPassOp = stencilZPassOp;
+
+    auto& command = record(CommandType::SET_STENCIL_TEST, redundant);
+
+    command.args[0] = static_cast<int>(stencilFunc);
+    command.args[1] = stencilRef;
+    command.args[2] = stencilMask;
+}
+
+void
+RecordingContext::setScissorTest(bool scissorTest, const render::ScissorBox& scissorBox)
+{
+    auto redundant = _currentScissorTest == scissorTest
+        && (!scissorTest
+            || (_currentScissorBox.x == scissorBox.x
+                && _currentScissorBox.y == scissorBox.y
+                && _currentScissorBox.width == scissorBox.width
+                && _currentScissorBox.height == scissorBox.height));
+
+    _currentScissorTest = scissorTest;
+    _currentScissorBox = scissorBox;
+
+    auto& command = record(CommandType::SET_SCISSOR_TEST, redundant, scissorTest);
+
+    command.args[0] = scissorBox.x;
+    command.args[1] = scissorBox.y;
+    command.args[2] = scissorBox.width;
+    command.args[3] = scissorBox.height;
+}
+
+void
+RecordingContext::readPixels(unsigned char* pixels)
+{
+    readPixels(_viewportX, _viewportY, _viewportWidth, _viewportHeight, pixels);
+}
+
+void
+RecordingContext::readPixels(unsigned int x, unsigned int y, unsigned int width, unsigned int height, unsigned char* pixels)
+{
+    std::memset(pixels, 0, width * height * 4);
+
+    auto& command = record(CommandType::READ_PIXELS, false);
+
+    command.args[0] = x;
+    command.args[1] = y;
+    command.args[2] = width;
+    command.args[3] = height;
+}
+
+void
+RecordingContext::setTriangleCulling(TriangleCulling triangleCulling)
+{
+    auto redundant = _currentTriangleCulling == triangleCulling;
+
+    _currentTriangleCulling = triangleCulling;
+
+    record(CommandType::SET_TRIANGLE_CULLING, redundant).args[0] = static_cast<int>(triangleCulling);
+}
+
+void
+RecordingContext::setRenderToBackBuffer()
+{
+    if (_currentTarget == 0)
+        return;
+
+    _currentTarget = 0;
+    configureViewport(_oldViewportX, _oldViewportY, _oldViewportWidth, _oldViewportHeight);
+
+    record(CommandType::SET_RENDER_TARGET, false, 0);
+}
+
+void
+RecordingContext::setRenderToTexture(uint texture, bool enableDepthAndStencil)
+{
+    if (texture == _currentTarget)
+        return;
+
+    auto& info = getTextureInfo(texture);
+
+    if (!info.renderTarget)
+        throw std::logic_error("this texture cannot be used for RTT");
+
+    if (!_currentTarget)
+    {
+        _oldViewportX = _viewportX;
+        _oldViewportY = _viewportY;
+        _oldViewportWidth = _viewportWidth;
+        _oldViewportHeight = _viewportHeight;
+    }
+
+    _currentTarget = texture;
+
+    record(CommandType::SET_RENDER_TARGET, false, texture).args[0] = enableDepthAndStencil;
+
+    configureViewport(0, 0, info.width, info.height);
+}
+
+void
+RecordingContext::generateMipmaps(uint texture)
+{
+    getTextureInfo(texture).mipMapping = true;
+
+    record(CommandType::GENERATE_MIPMAPS, false, texture);
+}
+
+/*static*/
+void
+RecordingContext::preprocess(const std::string& source, std::string& output, MacroMap& macros)
+{
+    // strip comments first so that directives and declarations can be parsed line by line
+    std::string code;
+
+    code.reserve(source.size());
+    for (uint i = 0; i < source.size(); ++i)
+    {
+        if (source[i] == '/' && i + 1 < source.size() && source[i + 1] == '/')
+        {
+            while (i < source.size() && source[i] != '\n')
+                ++i;
+            code += '\n';
+        }
+        else if (source[i] == '/' && i + 1 < source.size() && source[i + 1] == '*')
+        {
+            for (i += 2; i + 1 < source.size() && !(source[i] == '*' && source[i + 1] == '/'); ++i)
+                if (source[i] == '\n')
+                    code += '\n';
+            ++i;
+        }
+        else if (source[i] != '\r')
+            code += source[i];
+    }
+
+    // each conditional block is described by (block is active, a branch has already been taken)
+    std::vector<std::pair<bool, bool>>  conditions;
+    std::istringstream                  lines(code);
+    std::string                         line;
+
+    output.clear();
+
+    while (std::getline(lines, line))
+    {
+        auto first      = line.find_first_not_of(" \t");
+        auto active     = conditions.empty() || conditions.back().first;
+
+        if (first == std::string::npos || line[first] != '#')
+        {
+            if (active)
+                output += line + '\n';
+
+            continue;
+        }
+
+        std::istringstream  directive(line.substr(first + 1));
+        std::string         keyword;
+        std::string         expression;
+
+        directive >> keyword;
+        std::getline(directive, expression);
+
+        auto parentActive = conditions.size() < 2 || conditions[conditions.size() - 2].first;
+
+        if (keyword == "ifdef" || keyword == "ifndef" || keyword == "if")
+        {
+            auto value = false;
+
+            if (active)
+            {
+                std::istringstream name(expression);
+                std::string macroName;
+
+                name >> macroName;
+
+                if (keyword == "ifdef")
+                    value = macros.count(macroName) != 0;
+                else if (keyword == "ifndef")
+                    value = macros.count(macroName) == 0;
+                else
+                    value = evaluateCondition(expression, macros) != 0;
+            }
+
+            conditions.push_back(std::make_pair(active && value, active && value));
+        }
+        else if (keyword == "elif" && !conditions.empty())
+        {
+            auto& condition = conditions.back();
+            auto value      = parentActive && !condition.second && evaluateCondition(expression, macros) != 0;
+
+            condition.first = value;
+            condition.second = condition.second || value;
+        }
+        else if (keyword == "else" && !conditions.empty())
+        {
+            auto& condition = conditions.back();
+
+            condition.first = parentActive && !condition.second;
+            condition.second = true;
+        }
+        else if (keyword == "endif" && !conditions.empty())
+            conditions.pop_back();
+        else if (active && keyword == "define")
+        {
+            std::istringstream  definition(expression);
+            std::string         macroName;
+            std::string         macroValue;
+
+            definition >> macroName;
+            std::getline(definition, macroValue);
+
+            auto parenthesis = macroName.find('(');
+
+            if (parenthesis != std::string::npos)
+                macroName = macroName.substr(0, parenthesis);
+
+            auto valueStart = macroValue.find_first_not_of(" \t");
+
+            macros[macroName] = valueStart == std::string::npos ? "" : macroValue.substr(valueStart);
+        }
+        else if (active && keyword == "undef")
+        {
+            std::istringstream  name(expression);
+            std::string         macroName;
+
+            name >> macroName;
+            macros.erase(macroName);
+        }
+    }
+}
+
+/*static*/
+int
+RecordingContext::evaluateCondition(const std::string& expression, const MacroMap& macros)
+{
+    // tokenize
+    std::vector<std::string> tokens;
+
+    for (uint i = 0; i < expression.size();)
+    {
+        auto c = expression[i];
+
+        if (std::isspace(c))
+            ++i;
+        else if (std::isalnum(c) || c == '_')
+        {
+            auto start = i;
+
+            while (i < expression.size() && (std::isalnum(expression[i]) || expression[i] == '_'))
+                ++i;
+            tokens.push_back(expression.substr(start, i - start));
+        }
+        else if (i + 1 < expression.size()
+            && (expression.compare(i, 2, "&&") == 0 || expression.compare(i, 2, "||") == 0
+                || expression.compare(i, 2, "==") == 0 || expression.compare(i, 2, "!=") == 0
+                || expression.compare(i, 2, "<=") == 0 || expression.compare(i, 2, ">=") == 0))
+        {
+            tokens.push_back(expression.substr(i, 2));
+            i += 2;
+        }
+        else
+            tokens.push_back(std::string(1, expression[i++]));
+    }
+
+    // recursive descent evaluation, from the lowest to the highest precedence
+    uint position = 0;
+
+    auto peek = [&]() -> const std::string&
+    {
+        static const std::string end;
+
+        return position < tokens.size() ? tokens[position] : end;
+    };
+
+    std::function<int(int)> evaluate;
+
+    auto evaluateOperand = [&]() -> int
+    {
+        const auto token = peek();
+
+        ++position;
+
+        if (token == "!")
+            return !evaluate(6);
+        if (token == "-")
+            return -evaluate(6);
+        if (token == "(")
+        {
+            auto value = evaluate(0);
+
+            ++position; // ')'
+
+            return value;
+        }
+        if (token == "defined")
+        {
+            auto parenthesis = peek() == "(";
+
+            if (parenthesis)
+                ++position;
+
+            auto value = macros.count(peek()) != 0;
+
+            ++position;
+            if (parenthesis)
+                ++position;
+
+            return value;
+        }
+        if (!token.empty() && std::isdigit(token[0]))
+            return std::atoi(token.c_str());
+
+        auto foundMacroIt = macros.find(token);
+
+        return foundMacroIt != macros.end() && !foundMacroIt->second.empty()
+            ? evaluateCondition(foundMacroIt->second, macros)
+            : 0;
+    };
+
+    static const std::vector<std::vector<std::string>> operators = {
+        { "||" },
+        { "&&" },
+        { "==", "!=" },
+        { "<", ">", "<=", ">=" },
+        { "+", "-" },
+        { "*", "/", "%" }
+    };
+
+    evaluate = [&](int level) -> int
+    {
+        if (level >= static_cast<int>(operators.size()))
+            return evaluateOperand();
+
+        auto value = evaluate(level + 1);
+
+        while (std::find(operators[level].begin(), operators[level].end(), peek()) != operators[level].end())
+        {
+            const auto op   = peek();
+
+            ++position;
+
+            auto rhs        = evaluate(level + 1);
+
+            if (op == "||")         value = value || rhs;
+            else if (op == "&&")    value = value && rhs;
+            else if (op == "==")    value = value == rhs;
+            else if (op == "!=")    value = value != rhs;
+            else if (op == "<")     value = value < rhs;
+            else if (op == ">")     value = value > rhs;
+            else if (op == "<=")    value = value <= rhs;
+            else if (op == ">=")    value = value >= rhs;
+            else if (op == "+")     value = value + rhs;
+            else if (op == "-")     value = value - rhs;
+            else if (op == "*")     value = value * rhs;
+            else if (op == "/")     value = rhs != 0 ? value / rhs : 0;
+            else if (op == "%")     value = rhs != 0 ? value % rhs : 0;
+        }
+
+        return value;
+    };
+
+    return evaluate(0);
+}
+
+/*static*/
+void
+RecordingContext::fillInputs(const std::string&                 source,
+                             const MacroMap&                    macros,
+                             std::vector<std::string>&          names,
+                             std::vector<ProgramInputs::Type>&  types,
+                             std::vector<uint>&                 locations,
+                             uint&                              numUniformLocations,
+                             uint&                              numAttributeLocations)
+{
+    std::vector<std::string> tokens;
+
+    for (uint i = 0; i < source.size();)
+    {
+        auto c = source[i];
+
+        if (std::isspace(c))
+            ++i;
+        else if (std::isalnum(c) || c == '_')
+        {
+            auto start = i;
+
+            while (i < source.size() && (std::isalnum(source[i]) || source[i] == '_' || source[i] == '.'))
+                ++i;
+            tokens.push_back(source.substr(start, i - start));
+        }
+        else
+            tokens.push_back(std::string(1, source[i++]));
+    }
+
+    auto arraySize = [&](const std::string& token) -> int
+    {
+        return std::isdigit(token[0]) ? std::atoi(token.c_str()) : evaluateCondition(token, macros);
+    };
+
+    // read a "type name[size], name[size], ...;" declaration starting at tokens[i], returns (name, type) pairs
+    auto readDeclaration = [&](uint& i, StructMembers& declarations)
+    {
+        static const std::set<std::string> qualifiers = { "lowp", "mediump", "highp", "const", "uniform", "attribute" };
+
+        while (i < tokens.size() && qualifiers.count(tokens[i]))
+            ++i;
+
+        if (i >= tokens.size())
+            return;
+
+        auto type = tokens[i++];
+
+        while (i < tokens.size() && tokens[i] != ";")
+        {
+            if (tokens[i] == ",")
+            {
+                ++i;
+                continue;
+            }
+
+            auto name = tokens[i++];
+
+            if (i + 2 < tokens.size() && tokens[i] == "[")
+            {
+                name += "[" + std::to_string(arraySize(tokens[i + 1])) + "]";
+                i += 3;
+            }
+
+            declarations.push_back(std::make_pair(name, type));
+        }
+        ++i;
+    };
+
+    StructMap   structs;
+    int         depth   = 0;
+
+    for (uint i = 0; i < tokens.size();)
+    {
+        const auto& token = tokens[i];
+
+        if (token == "{")
+        {
+            ++depth;
+            ++i;
+        }
+        else if (token == "}")
+        {
+            --depth;
+            ++i;
+        }
+        else if (depth == 0 && token == "struct" && i + 2 < tokens.size() && tokens[i + 2] == "{")
+        {
+            auto& members = structs[tokens[i + 1]];
+
+            for (i += 3; i < tokens.size() && tokens[i] != "}";)
+                readDeclaration(i, members);
+            // skip closing brace, the optional instance name and the semicolon
+            while (i < tokens.size() && tokens[i] != ";")
+                ++i;
+            ++i;
+        }
+        else if (depth == 0 && (token == "uniform" || token == "attribute"))
+        {
+            StructMembers declarations;
+
+            readDeclaration(i, declarations);
+
+            for (auto& nameAndType : declarations)
+            {
+                auto& name = nameAndType.first;
+
+                if (std::find(names.begin(), names.end(), name) != names.end()
+                    || std::find(names.begin(), names.end(), name.substr(0, name.find('[')) + "[0]") != names.end())
+                    continue;
+
+                if (token == "attribute")
+                {
+                    names.push_back(name);
+                    types.push_back(ProgramInputs::Type::attribute);
+                    locations.push_back(numAttributeLocations++);
+                }
+                else
+                    addUniformInput(name, nameAndType.second, structs, names, types, locations, numUniformLocations);
+            }
+        }
+        else
+            ++i;
+    }
+}
+
+/*static*/
+void
+RecordingContext::addUniformInput(const std::string&                name,
+                                  const std::string&                type,
+                                  const StructMap&                  structs,
+                                  std::vector<std::string>&         names,
+                                  std::vector<ProgramInputs::Type>& types,
+                                  std::vector<uint>&                locations,
+                                  uint&                             numUniformLocations)
+{
+    auto isArray    = name.back() == ']';
+    auto bracket    = isArray ? name.rfind('[') : std::string::npos;
+    auto baseName   = name.substr(0, bracket);
+    auto size       = isArray ? std::atoi(name.c_str() + bracket + 1) : 0;
+    auto foundStructIt = structs.find(type);
+
+    if (foundStructIt != structs.end())
+    {
+        // GLSL reports each member of each array element as a separate uniform
+        for (int i = 0; i < std::max(size, 1); ++i)
+        {
+            auto prefix = size > 0 ? baseName + "[" + std::to_string(i) + "]" : baseName;
+
+            for (auto& member : foundStructIt->second)
+                addUniformInput(prefix + "." + member.first, member.second, structs, names, types, locations, numUniformLocations);
+        }
+
+        return;
+    }
+
+    auto inputType = convertInputType(type);
+
+    if (inputType == ProgramInputs::Type::unknown)
+        return;
+
+    // arrays of base types are reported by their first element, just like OpenGL does
+    names.push_back(size > 0 ? baseName + "[0]" : baseName);
+    types.push_back(inputType);
+    locations.push_back(numUniformLocations);
+
+    numUniformLocations += std::max(size, 1);
+}
+
+/*static*/
+ProgramInputs::Type
+RecordingContext::convertInputType(const std::string& type)
+{
+    static const std::unordered_map<std::string, ProgramInputs::Type> glslTypes = {
+        { "float",          ProgramInputs::Type::float1 },
+        { "vec2",           ProgramInputs::Type::float2 },
+        { "vec3",           ProgramInputs::Type::float3 },
+        { "vec4",           ProgramInputs::Type::float4 },
+        { "int",            ProgramInputs::Type::int1 },
+        { "ivec2",          ProgramInputs::Type::int2 },
+        { "ivec3",          ProgramInputs::Type::int3 },
+        { "ivec4",          ProgramInputs::Type::int4 },
+        { "bool",           ProgramInputs::Type::bool1 },
+        { "bvec2",          ProgramInputs::Type::bool2 },
+        { "bvec3",          ProgramInputs::Type::bool3 },
+        { "bvec4",          ProgramInputs::Type::bool4 },
+        { "mat3",           ProgramInputs::Type::float9 },
+        { "mat4",           ProgramInputs::Type::float16 },
+        { "sampler2D",      ProgramInputs::Type::sampler2d },
+        { "samplerCube",    ProgramInputs::Type::samplerCube }
+    };
+
+    auto foundTypeIt = glslTypes.find(type);
+
+    return foundTypeIt != glslTypes.end() ? foundTypeIt->second : ProgramInputs::Type::unknown;
+}
@@ -34,7 +34,9 @@ VertexBuffer::VertexBuffer(std::shared_ptr<AbstractContext> context) :
     std::enable_shared_from_this<VertexBuffer>(),
     _data(),
     _vertexSize(0),
-    _vertexSizeChanged(Signal<Ptr, int>::create())
+    _divisor(0),
+    _vertexSizeChanged(Signal<Ptr, int>::create()),
+    _changed(Signal<Ptr>::create())
 {
 }
 
@@ -45,7 +47,9 @@ VertexBuffer::VertexBuffer(std::shared_ptr<AbstractContext>    context,
     AbstractResource(context),
     _data(data + offset, data + offset + size),
     _vertexSize(0),
-    _vertexSizeChanged(Signal<Ptr, int>::create())
+    _divisor(0),
+    _vertexSizeChanged(Signal<Ptr, int>::create()),
+    _changed(Signal<Ptr>::create())
 {
     upload();
 }
@@ -56,7 +60,9 @@ VertexBuffer::VertexBuffer(std::shared_ptr<AbstractContext>        context,
     AbstractResource(context),
     _data(begin, end),
     _vertexSize(0),
-    _vertexSizeChanged(Signal<Ptr, int>::create())
+    _divisor(0),
+    _vertexSizeChanged(Signal<Ptr, int>::create()),
+    _changed(Signal<Ptr>::create())
 {
     upload();
 }
@@ -65,7 +71,9 @@ VertexBuffer::VertexBuffer(std::shared_ptr<AbstractContext> context, float* begi
     AbstractResource(context),
     _data(begin, end),
     _vertexSize(0),
-    _vertexSizeChanged(Signal<Ptr, int>::create())
+    _divisor(0),
+    _vertexSizeChanged(Signal<Ptr, int>::create()),
+    _changed(Signal<Ptr>::create())
 {
     upload();
 }
@@ -82,10 +90,14 @@ VertexBuffer::upload(uint offset, uint numVertices)
     _context->uploadVertexBufferData(
         _id,
         offset * _vertexSize,
-        numVertices == 0 ? _data.size() : numVertices * _vertexSize,
-        &_data[0]
+        numVertices == 0 ? _data.size() - offset * _vertexSize : numVertices * _vertexSize,
+        &_data[offset * _vertexSize]
     );
 
+    // the constructors upload before any shared pointer exists
+    if (_changed->numCallbacks() != 0)
+        _changed->execute(shared_from_this());
+
     //updatePositionBounds();
 }
 
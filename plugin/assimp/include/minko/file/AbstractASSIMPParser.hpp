@@ -105,6 +105,8 @@ namespace minko
             LoaderToErrorSlotMap                                    _loaderErrorSlots;
 
             Assimp::Importer*                                       _importer;
+            const aiScene*                                          _scene;
+            std::list<Error>                                        _decodeErrors;
 
         public:
 
@@ -117,6 +119,31 @@ namespace minko
                   const std::vector<unsigned char>&    data,
                   std::shared_ptr<AssetLibrary>        assetLibrary);
 
+            // The referenced files (such as OBJ material libraries) are loaded through the
+            // IOHandler, which uses the Loader and its file protocols: they are not thread safe,
+            // so this parser always decodes on the main thread.
+            inline
+            bool
+            decodable()
+            {
+                return false;
+            }
+
+            // Imports the scene with ASSIMP, including the files it references (such as OBJ
+            // material libraries). The textures are loaded and the nodes are created by finalize().
+            void
+            decode(const std::string&               filename,
+                   const std::string&               resolvedFilename,
+                   std::shared_ptr<Options>         options,
+                   const unsigned char*             data,
+                   uint                             size);
+
+            void
+            finalize(const std::string&             filename,
+                     const std::string&             resolvedFilename,
+                     std::shared_ptr<Options>       options,
+                     std::shared_ptr<AssetLibrary>  assetLibrary);
+
         protected:
 
             AbstractASSIMPParser();
@@ -112,7 +112,8 @@ AbstractASSIMPParser::AbstractASSIMPParser() :
     _meshNames(),
     _loaderCompleteSlots(),
     _loaderErrorSlots(),
-    _importer(nullptr)
+    _importer(nullptr),
+    _scene(nullptr)
 {
 }
 
@@ -126,6 +127,17 @@ AbstractASSIMPParser::parse(const std::string&                    filename,
                             std::shared_ptr<Options>            options,
                             const std::vector<unsigned char>&    data,
                             std::shared_ptr<AssetLibrary>        assetLibrary)
+{
+    decode(filename, resolvedFilename, options, data.data(), data.size());
+    finalize(filename, resolvedFilename, options, assetLibrary);
+}
+
+void
+AbstractASSIMPParser::decode(const std::string&                 filename,
+                             const std::string&                 resolvedFilename,
+                             std::shared_ptr<Options>           options,
+                             const unsigned char*               data,
+                             uint                               size)
 {
 #ifdef DEBUG
     std::cout << "AbstractASSIMPParser::parse()" << std::endl;
@@ -144,18 +156,17 @@ AbstractASSIMPParser::parse(const std::string&                    filename,
     }
 
     _filename        = filename;
-    _assetLibrary    = assetLibrary;
     _options        = options;
 
     //fixme : find a way to handle loading dependencies asynchronously
     auto ioHandlerOptions = options->clone();
     ioHandlerOptions->loadAsynchronously(false);
 
-    auto ioHandler = new IOHandler(ioHandlerOptions, _assetLibrary);
+    auto ioHandler = new IOHandler(ioHandlerOptions, nullptr);
 
     ioHandler->errorFunction([this](IOHandler& self, const Error& error) -> void
     {
-        this->error()->execute(shared_from_this(), error);
+        _decodeErrors.push_back(error);
     });
 
     _importer->SetIOHandler(ioHandler);
@@ -164,9 +175,9 @@ AbstractASSIMPParser::parse(const std::string&                    filename,
     std::cout << "AbstractASSIMPParser: preparing to parse" << std::endl;
 #endif // DEBUG
 
-    const aiScene* scene = _importer->ReadFileFromMemory(
-        &data[0],
-        data.size(),
+    _scene = _importer->ReadFileFromMemory(
+        data,
+        size,
         //| aiProcess_GenSmoothNormals // assertion is raised by assimp
         aiProcess_JoinIdenticalVertices
         | aiProcess_GenSmoothNormals
@@ -181,12 +192,28 @@ AbstractASSIMPParser::parse(const std::string&                    filename,
         resolvedFilename.c_str()
     );
 
-    if (!scene)
-        _error->execute(shared_from_this(), Error(_importer->GetErrorString()));
+    if (!_scene)
+        _decodeErrors.push_back(Error(_importer->GetErrorString()));
 
 #ifdef DEBUG
     std::cout << "AbstractASSIMPParser: scene parsed" << std::endl;
 #endif // DEBUG
+}
+
+void
+AbstractASSIMPParser::finalize(const std::string&               filename,
+                               const std::string&               resolvedFilename,
+                               std::shared_ptr<Options>         options,
+                               std::shared_ptr<AssetLibrary>    assetLibrary)
+{
+    _assetLibrary    = assetLibrary;
+
+    for (const auto& error : _decodeErrors)
+        _error->execute(shared_from_this(), error);
+
+    _decodeErrors.clear();
+
+    auto scene = _scene;
 
     parseDependencies(resolvedFilename, scene);
 
@@ -891,9 +918,13 @@ AbstractASSIMPParser::createSkin(const aiMesh* aimesh)
         skeletonRoot->addChild(n);
     }
 
+    skin->reorganizeByVertices()->transposeMatrices();
+    if (_options->skinningCompressionTolerance() > 0.f)
+        skin->compressMatrices(_options->skinningCompressionTolerance());
+
     // add skinning component to mesh
     meshNode->addComponent(Skinning::create(
-		skin->reorganizeByVertices()->transposeMatrices(),
+		skin,
         _options->skinningMethod(),
         _assetLibrary->context(),
         skeletonRoot
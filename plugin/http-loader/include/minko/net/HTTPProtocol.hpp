@@ -76,6 +76,10 @@ namespace minko
             std::list<Any>
             _workerSlots;
 
+            // the data of a streamed file is assembled from its chunks
+            bool
+            _streamed;
+
             static
             std::list<std::shared_ptr<HTTPProtocol>>
             _runningLoaders;
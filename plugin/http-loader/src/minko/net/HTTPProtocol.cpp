@@ -40,7 +40,8 @@ HTTPProtocol::_runningLoaders;
 uint
 HTTPProtocol::_uid = 0;
 
-HTTPProtocol::HTTPProtocol()
+HTTPProtocol::HTTPProtocol() :
+    _streamed(false)
 {
 }
 
@@ -86,7 +87,8 @@ HTTPProtocol::completeHandler(void* arg, void* data, unsigned int size)
 
     std::shared_ptr<HTTPProtocol> loader = *iterator;
 
-    loader->data().assign(static_cast<unsigned char*>(data), static_cast<unsigned char*>(data) + size);
+    if (!loader->_streamed)
+        loader->data().assign(static_cast<unsigned char*>(data), static_cast<unsigned char*>(data) + size);
 
     loader->_progress->execute(loader, 1.0);
     loader->_complete->execute(loader);
@@ -223,14 +225,20 @@ HTTPProtocol::load()
     {
         auto worker = AbstractCanvas::defaultCanvas()->getWorker("http");
 
-        _workerSlots.push_back(worker->message()->connect([=](Worker::Ptr, Worker::Message message) {
-            if (message.type == "complete")
+        _streamed = options()->streamFiles();
+
+        _workerSlots.push_back(worker->message()->connect([=](Worker::Ptr, const Worker::Message& message) {
+            if (message.type == "chunk")
+            {
+                appendChunk(reinterpret_cast<const unsigned char*>(message.data.data()), message.data.size());
+            }
+            else if (message.type == "complete")
             {
-                completeHandler(loader.get(), &*message.data.begin(), message.data.size());
+                completeHandler(loader.get(), const_cast<char*>(&*message.data.begin()), message.data.size());
             }
             else if (message.type == "progress")
             {
-                float ratio = *reinterpret_cast<float*>(&*message.data.begin());
+                float ratio = *reinterpret_cast<const float*>(&*message.data.begin());
                 progressHandler(loader.get(), int(ratio * 100.f), 100);
             }
             else if (message.type == "error")
@@ -239,7 +247,9 @@ HTTPProtocol::load()
             }
         }));
 
-        std::vector<char> input(resolvedFilename().begin(), resolvedFilename().end());
+        std::vector<char> input(1, _streamed ? 1 : 0);
+
+        input.insert(input.end(), resolvedFilename().begin(), resolvedFilename().end());
         worker->start(input);
     }
     else
@@ -261,11 +271,18 @@ HTTPProtocol::load()
             progressHandler(loader.get(), int(p * 100.f), 100);
         });
 
+        _streamed = options()->streamFiles();
+
+        auto chunkSlot = request.chunk()->connect([&](const char* bytes, uint size) {
+            if (_streamed)
+                appendChunk(reinterpret_cast<const unsigned char*>(bytes), size);
+        });
+
         request.run();
 
         std::vector<char>& output = request.output();
 
-        completeHandler(loader.get(), &*output.begin(), output.size());
+        completeHandler(loader.get(), output.data(), output.size());
     }
 #endif
 }
@@ -59,6 +59,13 @@ namespace minko
                     return _complete;
                 }
 
+            // Executed with each block of bytes as it is received.
+            Signal<const char*, uint>::Ptr
+            chunk()
+            {
+                return _chunk;
+            }
+
             static
                 size_t
                 curlWriteHandler(void* data, size_t size, size_t chunks, void* arg);
@@ -78,6 +85,7 @@ namespace minko
             std::vector<char> _output;
             Signal<float>::Ptr _progress;
             Signal<int>::Ptr _error;
+            Signal<const char*, uint>::Ptr _chunk;
             Signal<const std::vector<char>&>::Ptr _complete;
             
             std::string _username;
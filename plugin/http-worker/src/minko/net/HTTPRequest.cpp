@@ -31,6 +31,7 @@ HTTPRequest::HTTPRequest(const std::string& url,
     _url(url),
     _progress(Signal<float>::create()),
     _error(Signal<int>::create()),
+    _chunk(Signal<const char*, uint>::create()),
     _complete(Signal<const std::vector<char>&>::create()),
     _username(username),
     _password(password)
@@ -106,6 +107,8 @@ HTTPRequest::curlWriteHandler(void* data, size_t size, size_t chunks, void* arg)
     // Adding the chunk to the end of the vector.
     std::copy(source, source + size, output.begin() + position);
 
+    request->chunk()->execute(source, size);
+
     return size;
 }
 
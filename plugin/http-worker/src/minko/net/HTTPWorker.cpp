@@ -28,14 +28,17 @@ namespace minko
     namespace net
     {
         MINKO_DEFINE_WORKER(HTTPWorker, {
-            std::string url(input.begin(), input.end());
+            // the first byte tells whether the file is streamed
+            auto streamed = input[0] != 0;
+
+            std::string url(input.begin() + 1, input.end());
 
             HTTPRequest request(url);
 
             auto _0 = request.progress()->connect([&](float p) {
                 Message message { "progress" };
                 message.set(p);
-                post(message);
+                post(std::move(message));
             });
 
             auto _1 = request.error()->connect([&](int e) {
@@ -44,8 +47,14 @@ namespace minko
 
             auto _2 = request.complete()->connect([&](const std::vector<char>& output) {
                 Message message { "complete" };
-                message.set(output);
-                post(message);
+                if (!streamed)
+                    message.set(output);
+                post(std::move(message));
+            });
+
+            auto _3 = request.chunk()->connect([&](const char* bytes, uint size) {
+                if (streamed)
+                    post(Message { "chunk" }.set(std::vector<char>(bytes, bytes + size)));
             });
 
             request.run();
@@ -34,6 +34,12 @@ namespace minko
         public:
             typedef std::shared_ptr<JPEGParser> Ptr;
 
+        private:
+            std::shared_ptr<unsigned char>  _pixels;
+            int                             _width;
+            int                             _height;
+            int                             _numComponents;
+
         public:
             inline static
             Ptr
@@ -49,8 +55,39 @@ namespace minko
                   const std::vector<unsigned char>&    data,
                   std::shared_ptr<AssetLibrary>    AssetLibrary);
 
+            void
+            parse(const std::string&                filename,
+                  const std::string&                resolvedFilename,
+                  std::shared_ptr<Options>          options,
+                  const unsigned char*              data,
+                  uint                              size,
+                  std::shared_ptr<AssetLibrary>     assetLibrary);
+
+            inline
+            bool
+            decodable()
+            {
+                return true;
+            }
+
+            void
+            decode(const std::string&               filename,
+                   const std::string&               resolvedFilename,
+                   std::shared_ptr<Options>         options,
+                   const unsigned char*             data,
+                   uint                             size);
+
+            void
+            finalize(const std::string&             filename,
+                     const std::string&             resolvedFilename,
+                     std::shared_ptr<Options>       options,
+                     std::shared_ptr<AssetLibrary>  assetLibrary);
+
         private:
-            JPEGParser()
+            JPEGParser() :
+                _width(0),
+                _height(0),
+                _numComponents(0)
             {
             }
         };
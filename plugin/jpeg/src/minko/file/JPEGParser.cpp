@@ -36,20 +36,55 @@ JPEGParser::parse(const std::string&                filename,
                   const std::vector<unsigned char>&    data,
                   std::shared_ptr<AssetLibrary>        assetLibrary)
 {
-    int width;
-    int height;
-    int comps;
+    parse(filename, resolvedFilename, options, data.data(), data.size(), assetLibrary);
+}
 
+void
+JPEGParser::parse(const std::string&                filename,
+                  const std::string&                resolvedFilename,
+                  std::shared_ptr<Options>          options,
+                  const unsigned char*              data,
+                  uint                              size,
+                  std::shared_ptr<AssetLibrary>     assetLibrary)
+{
+    decode(filename, resolvedFilename, options, data, size);
+    finalize(filename, resolvedFilename, options, assetLibrary);
+}
+
+void
+JPEGParser::decode(const std::string&               filename,
+                   const std::string&               resolvedFilename,
+                   std::shared_ptr<Options>         options,
+                   const unsigned char*             data,
+                   uint                             size)
+{
     // Loads a JPEG image from a memory buffer.
     // req_comps can be 1 (grayscale), 3 (RGB), or 4 (RGBA).
     // On return, width/height will be set to the image's dimensions, and actual_comps will be set
     // to either 1 (grayscale) or 3 (RGB).
     auto bmpData = jpgd::decompress_jpeg_image_from_memory(
-        (const unsigned char*)&data[0], data.size(), &width, &height, &comps, 3
+        data, size, &_width, &_height, &_numComponents, 3
     );
 
+    _pixels = std::shared_ptr<unsigned char>(bmpData, free);
+}
+
+void
+JPEGParser::finalize(const std::string&             filename,
+                     const std::string&             resolvedFilename,
+                     std::shared_ptr<Options>       options,
+                     std::shared_ptr<AssetLibrary>  assetLibrary)
+{
+    if (_pixels == nullptr)
+    {
+        _error->execute(shared_from_this(), Error("file '" + filename + "' loading error (invalid JPEG data)"));
+        _complete->execute(shared_from_this());
+
+        return;
+    }
+
     auto format = render::TextureFormat::RGBA;
-    if (comps == 3 || comps == 1)
+    if (_numComponents == 3 || _numComponents == 1)
         format    = render::TextureFormat::RGB;
 
     render::AbstractTexture::Ptr texture = nullptr;
@@ -58,8 +93,8 @@ JPEGParser::parse(const std::string&                filename,
     {
         auto texture2d = render::Texture::create(
             options->context(),
-            width,
-            height,
+            _width,
+            _height,
             options->generateMipmaps(),
             false,
             options->resizeSmoothly(),
@@ -74,8 +109,8 @@ JPEGParser::parse(const std::string&                filename,
     {
         auto cubeTexture = render::CubeTexture::create(
             options->context(),
-            width,
-            height,
+            _width,
+            _height,
             options->generateMipmaps(),
             false,
             options->resizeSmoothly(),
@@ -87,12 +122,12 @@ JPEGParser::parse(const std::string&                filename,
         assetLibrary->cubeTexture(filename, cubeTexture);
     }
 
-    texture->data(bmpData);
+    texture->data(_pixels.get());
     texture->upload();
     if (options->disposeTextureAfterLoading())
         texture->disposeData();
 
-    free(bmpData);
+    _pixels = nullptr;
 
     complete()->execute(shared_from_this());
 }
@@ -33,6 +33,12 @@ namespace minko
         public:
             typedef std::shared_ptr<PNGParser> Ptr;
 
+        private:
+            std::vector<unsigned char>  _pixels;
+            uint                        _width;
+            uint                        _height;
+            std::string                 _decodeError;
+
         public:
             inline static
             Ptr
@@ -48,8 +54,38 @@ namespace minko
                   const std::vector<unsigned char>&    data,
                   std::shared_ptr<AssetLibrary>    AssetLibrary);
 
+            void
+            parse(const std::string&                filename,
+                  const std::string&                resolvedFilename,
+                  std::shared_ptr<Options>          options,
+                  const unsigned char*              data,
+                  uint                              size,
+                  std::shared_ptr<AssetLibrary>     assetLibrary);
+
+            inline
+            bool
+            decodable()
+            {
+                return true;
+            }
+
+            void
+            decode(const std::string&               filename,
+                   const std::string&               resolvedFilename,
+                   std::shared_ptr<Options>         options,
+                   const unsigned char*             data,
+                   uint                             size);
+
+            void
+            finalize(const std::string&             filename,
+                     const std::string&             resolvedFilename,
+                     std::shared_ptr<Options>       options,
+                     std::shared_ptr<AssetLibrary>  assetLibrary);
+
         private:
-            PNGParser()
+            PNGParser() :
+                _width(0),
+                _height(0)
             {
             }
         };
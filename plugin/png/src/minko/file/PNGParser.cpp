@@ -36,17 +36,43 @@ PNGParser::parse(const std::string&                 filename,
                  const std::vector<unsigned char>&  data,
                  std::shared_ptr<AssetLibrary>      assetLibrary)
 {
-    std::vector<unsigned char> out;
-    unsigned int width;
-    unsigned int height;
+    parse(filename, resolvedFilename, options, data.data(), data.size(), assetLibrary);
+}
 
-    unsigned error = lodepng::decode(out, width, height, &*data.begin(), data.size());
+void
+PNGParser::parse(const std::string&                 filename,
+                 const std::string&                 resolvedFilename,
+                 std::shared_ptr<Options>           options,
+                 const unsigned char*               data,
+                 uint                               size,
+                 std::shared_ptr<AssetLibrary>      assetLibrary)
+{
+    decode(filename, resolvedFilename, options, data, size);
+    finalize(filename, resolvedFilename, options, assetLibrary);
+}
+
+void
+PNGParser::decode(const std::string&                filename,
+                  const std::string&                resolvedFilename,
+                  std::shared_ptr<Options>          options,
+                  const unsigned char*              data,
+                  uint                              size)
+{
+    unsigned error = lodepng::decode(_pixels, _width, _height, data, size);
 
     if (error)
-    {
-        const char* text = lodepng_error_text(error);
+        _decodeError = lodepng_error_text(error);
+}
 
-        _error->execute(shared_from_this(), Error("file '" + filename + "' loading error (" + text + ")"));
+void
+PNGParser::finalize(const std::string&              filename,
+                    const std::string&              resolvedFilename,
+                    std::shared_ptr<Options>        options,
+                    std::shared_ptr<AssetLibrary>   assetLibrary)
+{
+    if (!_decodeError.empty())
+    {
+        _error->execute(shared_from_this(), Error("file '" + filename + "' loading error (" + _decodeError + ")"));
         _complete->execute(shared_from_this());
         
         return;
@@ -58,8 +84,8 @@ PNGParser::parse(const std::string&                 filename,
     {
         auto texture2d = render::Texture::create(
             options->context(),
-            width,
-            height,
+            _width,
+            _height,
             options->generateMipmaps(),
             false,
             options->resizeSmoothly(),
@@ -74,8 +100,8 @@ PNGParser::parse(const std::string&                 filename,
     {
         auto cubeTexture = render::CubeTexture::create(
             options->context(),
-            width,
-            height,
+            _width,
+            _height,
             options->generateMipmaps(),
             false,
             options->resizeSmoothly(),
@@ -87,11 +113,15 @@ PNGParser::parse(const std::string&                 filename,
         assetLibrary->cubeTexture(filename, cubeTexture);
     }
 
-    texture->data(&*out.begin());
+    texture->data(&*_pixels.begin());
     texture->upload();
     
     if (options->disposeTextureAfterLoading())
         texture->disposeData();
 
+    // the texture keeps its own copy of the pixels
+    _pixels.clear();
+    _pixels.shrink_to_fit();
+
     complete()->execute(shared_from_this());
 }
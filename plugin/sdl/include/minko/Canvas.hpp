@@ -33,6 +33,7 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 #include "minko/input/Joystick.hpp"
 #include "minko/input/Touch.hpp"
 #include "minko/async/Worker.hpp"
+#include "minko/async/TaskScheduler.hpp"
 
 #include "minko/SDLBackend.hpp"
 
@@ -110,6 +111,7 @@ namespace minko
         Signal<AbstractCanvas::Ptr, std::shared_ptr<input::Joystick>>::Ptr      _joystickAdded;
         Signal<AbstractCanvas::Ptr, std::shared_ptr<input::Joystick>>::Ptr      _joystickRemoved;
 
+        std::shared_ptr<async::TaskScheduler>                                   _taskScheduler;
         std::list<std::shared_ptr<async::Worker>>                               _activeWorkers;
         std::list<Any>                                                          _workerCompleteSlots;
 
@@ -309,6 +311,13 @@ namespace minko
         WorkerPtr
         getWorker(const std::string& name);
 
+        inline
+        std::shared_ptr<async::TaskScheduler>
+        taskScheduler()
+        {
+            return _taskScheduler;
+        }
+
         bool
         isWorkerRegistered(const std::string& name)
         {
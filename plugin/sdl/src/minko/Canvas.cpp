@@ -113,6 +113,9 @@ Canvas::initialize()
     initializeContext();
     initializeInputs();
 
+    // the canvas owns the scheduler of its workers and of the tasks of its scenes
+    _taskScheduler = TaskScheduler::create();
+
 #if MINKO_PLATFORM != MINKO_PLATFORM_HTML5
     registerWorker<file::FileProtocolWorker>("file-protocol");
 #endif
@@ -94,7 +94,7 @@ namespace minko
         protected:
             void
             extractDependencies(AssetLibraryPtr                            assetLibrary,
-                                  const std::vector<unsigned char>&        data,
+                                const unsigned char*                    data,
                                 short                                    dataOffset,
                                 unsigned int                            dependenciesSize,
                                 std::shared_ptr<Options>                options,
@@ -121,23 +121,23 @@ namespace minko
 
             bool
             readHeader(const std::string&                   filename,
-                       const std::vector<unsigned char>&    data,
+                       const unsigned char*                 data,
                        int                                  extension = 0x00);
 
             int
-            readInt(const std::vector<unsigned char>& data, int offset)
+            readInt(const unsigned char* data, int offset)
             {
                 return (int)(data[offset] << 24 | data[offset + 1] << 16 | data[offset + 2] << 8 | data[offset + 3]);
             }
 
             unsigned int
-            readUInt(const std::vector<unsigned char>& data, int offset)
+            readUInt(const unsigned char* data, int offset)
             {
                 return (unsigned int)(data[offset] << 24 | data[offset + 1] << 16 | data[offset + 2] << 8 | data[offset + 3]);
             }
 
             short
-            readShort(const std::vector<unsigned char>& data, int offset)
+            readShort(const unsigned char* data, int offset)
             {
                 return (short)(data[offset] << 8 | data[offset + 1]);
             }
@@ -58,6 +58,10 @@ namespace minko
         private:
             static std::unordered_map<int8_t, ComponentReadFunction>    _componentIdToReadFunction;
 
+            bool                                                        _headerParsed;
+            bool                                                        _dependenciesParsed;
+            bool                                                        _invalidHeader;
+
         public:
             inline static
             Ptr
@@ -78,7 +82,41 @@ namespace minko
                   const std::vector<unsigned char>& data,
                   AssetLibraryPtr                   assetLibrary);
 
+            void
+            parse(const std::string&                filename,
+                  const std::string&                resolvedFilename,
+                  std::shared_ptr<Options>          options,
+                  const unsigned char*              data,
+                  uint                              size,
+                  AssetLibraryPtr                   assetLibrary);
+
+            inline
+            bool
+            streamable()
+            {
+                return true;
+            }
+
+            // Loads the dependencies as soon as they are received, while the rest of the file
+            // is still loading.
+            void
+            parseChunk(const std::string&           filename,
+                       const std::string&           resolvedFilename,
+                       std::shared_ptr<Options>     options,
+                       const unsigned char*         data,
+                       uint                         size,
+                       AssetLibraryPtr              assetLibrary);
+
         private:
+            // Returns false when the header is invalid.
+            bool
+            parseHeaderAndDependencies(const std::string&       filename,
+                                       const std::string&       resolvedFilename,
+                                       std::shared_ptr<Options> options,
+                                       const unsigned char*     data,
+                                       uint                     size,
+                                       AssetLibraryPtr          assetLibrary);
+
             std::shared_ptr<scene::Node>
             parseNode(std::vector<SerializedNode>&  nodePack,
                       std::vector<std::string>&     componentPack,
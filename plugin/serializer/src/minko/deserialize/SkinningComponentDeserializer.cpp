@@ -127,8 +127,12 @@ SkinningComponentDeserializer::computeSkinning(file::Options::Ptr
     // Transform and Animation components.
     //clean(skeletonRoot);
 
+    skin->reorganizeByVertices()->transposeMatrices();
+    if (options->skinningCompressionTolerance() > 0.f)
+        skin->compressMatrices(options->skinningCompressionTolerance());
+
     return Skinning::create(
-        skin->reorganizeByVertices()->transposeMatrices(),
+        skin,
         options->skinningMethod(),
         context,
         skeletonRoot,
@@ -89,7 +89,7 @@ AbstractSerializerParser::parse(const std::string&                    filename,
 
 void
 AbstractSerializerParser::extractDependencies(AssetLibraryPtr                        assetLibrary,
-                                              const std::vector<unsigned char>&        data,
+                                              const unsigned char*                    data,
                                               short                                    dataOffset,
                                               unsigned int                            dependenciesSize,
                                               std::shared_ptr<Options>                options,
@@ -115,7 +115,7 @@ AbstractSerializerParser::extractDependencies(AssetLibraryPtr
 
         offset += 4;
 
-        msgpack::unpack((char*)&data[offset], assetSize, NULL, &mempool, &msgpackObject);
+        msgpack::unpack((const char*)data + offset, assetSize, NULL, &mempool, &msgpackObject);
         msgpackObject.convert(&serializedAsset);
 
         deserializeAsset(serializedAsset, assetLibrary, options, assetFilePath);
@@ -185,7 +185,9 @@ AbstractSerializerParser::deserializeAsset(SerializedAsset&                asset
 
         auto completeSlot = assetLoader->complete()->connect([&](Loader::Ptr assetLoaderThis)
         {
-            data = assetLoaderThis->files().at(assetCompletePath)->data();
+            auto file = assetLoaderThis->files().at(assetCompletePath);
+
+            data.assign(file->bytes(), file->bytes() + file->size());
         });
 
         assetLoader
@@ -307,7 +309,7 @@ AbstractSerializerParser::extractFolderPath(const std::string& filepath)
 
 bool
 AbstractSerializerParser::readHeader(const std::string&                    filename,
-                                     const std::vector<unsigned char>&     data,
+                                     const unsigned char*                  data,
                                      int                                   extension)
 {
     _magicNumber = readInt(data, 0);
@@ -110,13 +110,13 @@ GeometryParser::parse(const std::string&                filename,
                       const std::vector<unsigned char>&    data,
                       std::shared_ptr<AssetLibrary>        assetLibrary)
 {
-    if (!readHeader(filename, data, 0x47))
+    if (!readHeader(filename, data.data(), 0x47))
         return;
 
     msgpack::object            msgpackObject;
     msgpack::zone            mempool;
     std::string                folderPathName = extractFolderPath(resolvedFilename);
-    extractDependencies(assetLibrary, data, _headerSize, _dependenciesSize, options, folderPathName);
+    extractDependencies(assetLibrary, data.data(), _headerSize, _dependenciesSize, options, folderPathName);
     geometry::Geometry::Ptr geom    = geometry::Geometry::create();
     SerializedGeometry        serializedGeometry;
 
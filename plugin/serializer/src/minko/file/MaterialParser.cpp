@@ -61,13 +61,13 @@ MaterialParser::parse(const std::string&                filename,
                       const std::vector<unsigned char>&    data,
                       AssetLibraryPtr                    assetLibrary)
 {
-    if (!readHeader(filename, data, 0x4D))
+    if (!readHeader(filename, data.data(), 0x4D))
         return;
 
     msgpack::object        msgpackObject;
     msgpack::zone        mempool;
     std::string         folderpath = extractFolderPath(resolvedFilename);
-    extractDependencies(assetLibrary, data, _headerSize, _dependenciesSize, options, folderpath);
+    extractDependencies(assetLibrary, data.data(), _headerSize, _dependenciesSize, options, folderpath);
 
     msgpack::type::tuple<std::vector<ComplexProperty>, std::vector<BasicProperty>> serializedMaterial;
     msgpack::unpack((char*)&data[_headerSize + _dependenciesSize], _sceneDataSize, NULL, &mempool, &msgpackObject);
@@ -42,7 +42,10 @@ using namespace minko::math;
 std::unordered_map<int8_t, SceneParser::ComponentReadFunction> SceneParser::_componentIdToReadFunction;
 
 
-SceneParser::SceneParser()
+SceneParser::SceneParser() :
+    _headerParsed(false),
+    _dependenciesParsed(false),
+    _invalidHeader(false)
 {
     _geometryParser = file::GeometryParser::create();
     _materialParser = file::MaterialParser::create();
@@ -129,26 +132,34 @@ SceneParser::parse(const std::string&                    filename,
                    const std::vector<unsigned char>&    data,
                    AssetLibraryPtr                        assetLibrary)
 {
-    _dependencies->options(options);
+    parse(filename, resolvedFilename, options, data.data(), data.size(), assetLibrary);
+}
 
-    if (!readHeader(filename, data))
+void
+SceneParser::parse(const std::string&                    filename,
+                   const std::string&                    resolvedFilename,
+                   std::shared_ptr<Options>                options,
+                   const unsigned char*                    data,
+                   uint                                    size,
+                   AssetLibraryPtr                        assetLibrary)
+{
+    if (!parseHeaderAndDependencies(filename, resolvedFilename, options, data, size, assetLibrary))
         return;
 
-    std::string         folderPath = extractFolderPath(resolvedFilename);
+    if (!_dependenciesParsed)
+    {
+        _error->execute(shared_from_this(), Error("InvalidFile", "Invalid scene file '" + filename + "': truncated file"));
 
-    extractDependencies(assetLibrary, data, _headerSize, _dependenciesSize, options, folderPath);
+        return;
+    }
 
     msgpack::object        deserialized;
     msgpack::zone        mempool;
-    msgpack::unpack((char*)&data[_headerSize + _dependenciesSize], _sceneDataSize, NULL, &mempool, &deserialized);
+    msgpack::unpack((const char*)data + _headerSize + _dependenciesSize, _sceneDataSize, NULL, &mempool, &deserialized);
 
     msgpack::type::tuple<std::vector<std::string>, std::vector<SerializedNode>> dst;
     deserialized.convert(&dst);
 
-    std::vector<unsigned char>* d = (std::vector<unsigned char>*)&data;
-    d->clear();
-    d->shrink_to_fit();
-
     assetLibrary->symbol(filename, parseNode(dst.a1, dst.a0, assetLibrary, options));
 
     if (_jobList.size() > 0)
@@ -164,6 +175,57 @@ SceneParser::parse(const std::string&                    filename,
     complete()->execute(shared_from_this());
 }
 
+void
+SceneParser::parseChunk(const std::string&              filename,
+                        const std::string&              resolvedFilename,
+                        std::shared_ptr<Options>        options,
+                        const unsigned char*            data,
+                        uint                            size,
+                        AssetLibraryPtr                 assetLibrary)
+{
+    parseHeaderAndDependencies(filename, resolvedFilename, options, data, size, assetLibrary);
+}
+
+bool
+SceneParser::parseHeaderAndDependencies(const std::string&          filename,
+                                        const std::string&          resolvedFilename,
+                                        std::shared_ptr<Options>    options,
+                                        const unsigned char*        data,
+                                        uint                        size,
+                                        AssetLibraryPtr             assetLibrary)
+{
+    if (_invalidHeader)
+        return false;
+
+    if (!_headerParsed)
+    {
+        if (size < MINKO_SCENE_HEADER_SIZE)
+            return true;
+
+        _dependencies->options(options);
+
+        if (!readHeader(filename, data))
+        {
+            _invalidHeader = true;
+
+            return false;
+        }
+
+        _headerParsed = true;
+    }
+
+    if (!_dependenciesParsed && size >= uint(_headerSize) + _dependenciesSize)
+    {
+        std::string folderPath = extractFolderPath(resolvedFilename);
+
+        extractDependencies(assetLibrary, data, _headerSize, _dependenciesSize, options, folderPath);
+
+        _dependenciesParsed = true;
+    }
+
+    return true;
+}
+
 scene::Node::Ptr
 SceneParser::parseNode(std::vector<SerializedNode>&            nodePack,
                        std::vector<std::string>&            componentPack,
@@ -0,0 +1,130 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "AnyTest.hpp"
+
+using namespace minko;
+
+TEST_F(AnyTest, Empty)
+{
+	Any a;
+
+	ASSERT_TRUE(a.empty());
+	ASSERT_TRUE(a.type() == typeid(void));
+	ASSERT_EQ(Any::cast<int>(&a), nullptr);
+}
+
+TEST_F(AnyTest, Scalar)
+{
+	Any a = 42;
+
+	ASSERT_FALSE(a.empty());
+	ASSERT_TRUE(a.type() == typeid(int));
+	ASSERT_EQ(Any::cast<int>(a), 42);
+	ASSERT_EQ(Any::cast<float>(&a), nullptr);
+	ASSERT_THROW(Any::cast<float>(a), std::bad_cast);
+}
+
+TEST_F(AnyTest, LargeValue)
+{
+	typedef std::array<float, 16> Float16;
+
+	Float16 m;
+
+	for (auto i = 0u; i < m.size(); ++i)
+		m[i] = float(i);
+
+	Any a = m;
+	Any b = a;
+
+	Any::cast<Float16>(&a)->at(0) = 42.f;
+
+	ASSERT_EQ(Any::cast<Float16>(b), m);
+	ASSERT_EQ(Any::cast<Float16>(a)[0], 42.f);
+	ASSERT_EQ(Any::cast<Float16>(a)[15], 15.f);
+}
+
+TEST_F(AnyTest, SharedPtrOwnership)
+{
+	auto v = std::make_shared<int>(42);
+
+	{
+		Any a = v;
+		Any b = a;
+
+		ASSERT_EQ(v.use_count(), 3);
+
+		Any c = std::move(b);
+
+		ASSERT_TRUE(b.empty());
+		ASSERT_EQ(v.use_count(), 3);
+		ASSERT_EQ(Any::cast<std::shared_ptr<int>>(c), v);
+	}
+
+	ASSERT_EQ(v.use_count(), 1);
+}
+
+TEST_F(AnyTest, AssignOtherType)
+{
+	auto v = std::make_shared<int>(42);
+	Any a = v;
+
+	a = 23.f;
+
+	ASSERT_EQ(v.use_count(), 1);
+	ASSERT_EQ(Any::cast<float>(a), 23.f);
+
+	a = std::string("foo");
+
+	ASSERT_EQ(Any::cast<std::string>(a), "foo");
+}
+
+TEST_F(AnyTest, AssignSameType)
+{
+	std::vector<int> values(10, 2);
+	Any a = std::vector<int>(100, 1);
+	auto data = Any::cast<std::vector<int>>(&a)->data();
+
+	// the held vector is assigned in place and keeps its storage
+	a = values;
+
+	ASSERT_EQ(Any::cast<std::vector<int>>(&a)->data(), data);
+	ASSERT_EQ(Any::cast<std::vector<int>>(a), values);
+}
+
+TEST_F(AnyTest, Swap)
+{
+	Any a = 42;
+	Any b = std::string("foo");
+
+	a.swap(b);
+
+	ASSERT_EQ(Any::cast<std::string>(a), "foo");
+	ASSERT_EQ(Any::cast<int>(b), 42);
+}
+
+TEST_F(AnyTest, CastConst)
+{
+	const Any a = std::make_shared<int>(42);
+	Any b = std::string("foo");
+
+	ASSERT_EQ(*Any::cast<std::shared_ptr<int>>(a), 42);
+	ASSERT_EQ(*Any::cast<const std::string>(&b), "foo");
+	ASSERT_EQ(Any::cast<const int>(&b), nullptr);
+}
@@ -187,3 +187,186 @@ TEST_F(SignalTest, LockRemove)
 	ASSERT_EQ(v, 42);
 	ASSERT_EQ(w, 42);
 }
+
+TEST_F(SignalTest, Priority)
+{
+	auto s = Signal<>::create();
+	std::vector<int> order;
+	auto slot1 = s->connect([&]() { order.push_back(1); }, 0.f);
+	auto slot2 = s->connect([&]() { order.push_back(2); }, 10.f);
+	auto slot3 = s->connect([&]() { order.push_back(3); }, 0.f);
+	auto slot4 = s->connect([&]() { order.push_back(4); }, 10.f);
+	auto slot5 = s->connect([&]() { order.push_back(5); }, -1.f);
+
+	s->execute();
+
+	ASSERT_EQ(order, std::vector<int>({ 2, 4, 1, 3, 5 }));
+}
+
+TEST_F(SignalTest, LockAddThenRemove)
+{
+	auto s = Signal<int>::create();
+	auto v = 0;
+	Signal<int>::Slot slot2;
+	auto slot1 = s->connect([&](int i)
+	{
+		slot2 = s->connect([&](int i) { v = i; });
+		slot2 = nullptr;
+	});
+
+	s->execute(42);
+	s->execute(42);
+
+	ASSERT_EQ(s->numCallbacks(), 1);
+	ASSERT_EQ(v, 0);
+}
+
+TEST_F(SignalTest, DisconnectAfterCompaction)
+{
+	auto s = Signal<>::create();
+	auto v = 0;
+	std::vector<Signal<>::Slot> slots;
+
+	for (auto i = 0; i < 10; ++i)
+		slots.push_back(s->connect([&, i]() { v += i; }));
+	for (auto i = 0; i < 9; ++i)
+		slots[i] = nullptr;
+
+	s->execute();
+
+	ASSERT_EQ(s->numCallbacks(), 1);
+	ASSERT_EQ(v, 9);
+
+	slots[9] = nullptr;
+	s->execute();
+
+	ASSERT_EQ(s->numCallbacks(), 0);
+	ASSERT_EQ(v, 9);
+}
+
+TEST_F(SignalTest, UnlockAfterCallbackThrows)
+{
+	auto s = Signal<int>::create();
+	auto v = 0;
+	Signal<int>::Slot slot2;
+	Signal<int>::Slot slot3;
+	auto slot1 = s->connect([&](int i)
+	{
+		if (slot2 == nullptr)
+			slot2 = s->connect([&](int i) { v = i; });
+		slot3 = nullptr;
+
+		if (i < 0)
+			throw std::runtime_error("error");
+	});
+
+	slot3 = s->connect([&](int i) { });
+
+	ASSERT_THROW(s->execute(-1), std::runtime_error);
+
+	// the connection and the disconnection pending during the failed execution are applied
+	ASSERT_EQ(s->numCallbacks(), 2);
+
+	s->execute(42);
+
+	ASSERT_EQ(v, 42);
+}
+
+TEST_F(SignalTest, ConnectDisconnectMany)
+{
+	const auto numSlots = 1000u;
+
+	auto s = Signal<int>::create();
+	auto v = 0u;
+	std::vector<Signal<int>::Slot> slots;
+
+	for (auto i = 0u; i < numSlots; ++i)
+		slots.push_back(s->connect([&, i](int) { v += i; }, float(i % 3)));
+
+	// disconnect every other slot: the remaining callbacks survive the compactions
+	for (auto i = 0u; i < numSlots; i += 2)
+		slots[i] = nullptr;
+
+	ASSERT_EQ(s->numCallbacks(), numSlots / 2);
+
+	s->execute(0);
+
+	ASSERT_EQ(v, (numSlots / 2) * (numSlots / 2));
+
+	while (!slots.empty())
+		slots.pop_back();
+
+	ASSERT_EQ(s->numCallbacks(), 0);
+}
+
+TEST_F(SignalTest, ExecuteManyTimes)
+{
+	const auto numSlots = 16u;
+	const auto numExecutions = 1000u;
+
+	auto s = Signal<std::shared_ptr<int>, const std::string&>::create();
+	auto v = 0u;
+	auto value = std::make_shared<int>(1);
+	std::string name = "property";
+	std::vector<Signal<std::shared_ptr<int>, const std::string&>::Slot> slots;
+
+	for (auto i = 0u; i < numSlots; ++i)
+		slots.push_back(s->connect([&](std::shared_ptr<int> p, const std::string& n) { v += *p; }));
+
+	for (auto i = 0u; i < numExecutions; ++i)
+		s->execute(value, name);
+
+	ASSERT_EQ(v, numSlots * numExecutions);
+}
+
+// opt-in: run with --gtest_also_run_disabled_tests --gtest_filter=*Benchmark*
+TEST_F(SignalTest, DISABLED_DisconnectBenchmark)
+{
+	const auto numSlots = 50000u;
+
+	auto s = Signal<int>::create();
+	auto v = 0;
+	std::vector<Signal<int>::Slot> slots;
+
+	slots.reserve(numSlots);
+
+	auto start = std::chrono::high_resolution_clock::now();
+
+	for (auto i = 0u; i < numSlots; ++i)
+		slots.push_back(s->connect([&](int i) { v += i; }));
+	while (!slots.empty())
+		slots.pop_back();
+
+	auto duration = std::chrono::duration<double, std::nano>(std::chrono::high_resolution_clock::now() - start);
+
+	RecordProperty("nsPerConnectDisconnect", std::to_string(duration.count() / numSlots));
+
+	ASSERT_EQ(s->numCallbacks(), 0);
+}
+
+TEST_F(SignalTest, DISABLED_ExecuteBenchmark)
+{
+	const auto numSlots = 16u;
+	const auto numExecutions = 100000u;
+
+	auto s = Signal<std::shared_ptr<int>, const std::string&>::create();
+	auto v = 0u;
+	auto value = std::make_shared<int>(1);
+	std::string name = "property";
+	std::vector<Signal<std::shared_ptr<int>, const std::string&>::Slot> slots;
+
+	for (auto i = 0u; i < numSlots; ++i)
+		slots.push_back(s->connect([&](std::shared_ptr<int> p, const std::string& n) { v += *p; }));
+
+	auto start = std::chrono::high_resolution_clock::now();
+
+	for (auto i = 0u; i < numExecutions; ++i)
+		s->execute(value, name);
+
+	auto duration = std::chrono::duration<double, std::nano>(std::chrono::high_resolution_clock::now() - start);
+
+	RecordProperty("nsPerExecute", std::to_string(duration.count() / numExecutions));
+	RecordProperty("numSlots", int(numSlots));
+
+	ASSERT_EQ(v, numSlots * numExecutions);
+}
@@ -0,0 +1,166 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "PoseTest.hpp"
+
+#include "minko/animation/Pose.hpp"
+
+using namespace minko;
+using namespace minko::animation;
+
+namespace
+{
+	// rotation of angle radians around y
+	std::vector<float>
+	boneMatrix(float tx, float ty, float tz, float angle, float scale = 1.f)
+	{
+		const float translation[3] = { tx, ty, tz };
+		const float rotation[4] = { 0.f, sinf(angle * .5f), 0.f, cosf(angle * .5f) };
+		const float scales[3] = { scale, scale, scale };
+		std::vector<float> matrix(16);
+
+		Pose::composeMatrix(translation, rotation, scales, matrix.data());
+
+		return matrix;
+	}
+
+	std::vector<float>
+	concat(const std::vector<std::vector<float>>& matrices)
+	{
+		std::vector<float> output;
+
+		for (auto& matrix : matrices)
+			output.insert(output.end(), matrix.begin(), matrix.end());
+
+		return output;
+	}
+
+	void
+	assertMatricesNear(const std::vector<float>& expected, const std::vector<float>& matrices)
+	{
+		ASSERT_EQ(expected.size(), matrices.size());
+		for (uint i = 0; i < expected.size(); ++i)
+			ASSERT_NEAR(expected[i], matrices[i], 1e-5f);
+	}
+}
+
+TEST_F(PoseTest, DecomposeCompose)
+{
+	std::vector<std::vector<float>> bones;
+
+	for (uint boneId = 0; boneId < 7; ++boneId)
+		bones.push_back(boneMatrix(float(boneId), -2.f * boneId, .5f, .3f * boneId, 1.f + .1f * boneId));
+
+	auto matrices = concat(bones);
+	auto pose = Pose::create(bones.size());
+	std::vector<float> output(matrices.size());
+
+	pose->decompose(matrices.data());
+	pose->compose(output.data());
+
+	assertMatricesNear(matrices, output);
+}
+
+TEST_F(PoseTest, Blend)
+{
+	auto a = concat({ boneMatrix(0.f, 0.f, 0.f, 0.f), boneMatrix(1.f, 0.f, 0.f, 0.f, 2.f) });
+	auto b = concat({ boneMatrix(2.f, 4.f, 0.f, 1.f), boneMatrix(3.f, 0.f, 0.f, 0.f, 4.f) });
+	auto pose = Pose::create(2);
+	auto other = Pose::create(2);
+	std::vector<float> output(a.size());
+
+	pose->decompose(a.data());
+	other->decompose(b.data());
+	pose->blend(*other, .5f, {});
+	pose->compose(output.data());
+
+	assertMatricesNear(concat({ boneMatrix(1.f, 2.f, 0.f, .5f), boneMatrix(2.f, 0.f, 0.f, 0.f, 3.f) }), output);
+
+	pose->blend(*other, 1.f, {});
+	pose->compose(output.data());
+
+	assertMatricesNear(b, output);
+}
+
+TEST_F(PoseTest, BlendWithBoneMask)
+{
+	auto a = concat({ boneMatrix(0.f, 0.f, 0.f, 0.f), boneMatrix(0.f, 0.f, 0.f, 0.f) });
+	auto b = concat({ boneMatrix(2.f, 0.f, 0.f, 0.f), boneMatrix(2.f, 0.f, 0.f, 0.f) });
+	auto pose = Pose::create(2);
+	auto other = Pose::create(2);
+	std::vector<float> output(a.size());
+
+	pose->decompose(a.data());
+	other->decompose(b.data());
+	pose->blend(*other, 1.f, { .5f, 0.f });
+	pose->compose(output.data());
+
+	assertMatricesNear(concat({ boneMatrix(1.f, 0.f, 0.f, 0.f), boneMatrix(0.f, 0.f, 0.f, 0.f) }), output);
+}
+
+TEST_F(PoseTest, Add)
+{
+	auto base = concat({ boneMatrix(1.f, 0.f, 0.f, .2f) });
+	auto reference = concat({ boneMatrix(5.f, 5.f, 5.f, .4f, 2.f) });
+	auto additive = concat({ boneMatrix(5.f, 7.f, 5.f, 1.4f, 4.f) });
+	auto pose = Pose::create(1);
+	auto referencePose = Pose::create(1);
+	auto additivePose = Pose::create(1);
+	std::vector<float> output(base.size());
+
+	pose->decompose(base.data());
+	referencePose->decompose(reference.data());
+	additivePose->decompose(additive.data());
+
+	pose->add(*additivePose, *referencePose, .5f, {});
+	pose->compose(output.data());
+
+	assertMatricesNear(boneMatrix(1.f, 1.f, 0.f, .7f, 1.5f), output);
+
+	pose->add(*additivePose, *referencePose, .5f, {});
+	pose->compose(output.data());
+
+	assertMatricesNear(boneMatrix(1.f, 2.f, 0.f, 1.2f, 2.25f), output);
+}
+
+TEST_F(PoseTest, BlendProjectedBone)
+{
+	auto projected = boneMatrix(0.f, 0.f, 0.f, 0.f);
+	projected[3] = .1f;
+
+	auto a = concat({ boneMatrix(0.f, 0.f, 0.f, 0.f), projected });
+	auto b = concat({ boneMatrix(2.f, 0.f, 0.f, 0.f), boneMatrix(2.f, 0.f, 0.f, 0.f) });
+	auto pose = Pose::create(2);
+	auto other = Pose::create(2);
+	std::vector<float> output(a.size());
+
+	pose->decompose(a.data());
+	other->decompose(b.data());
+
+	pose->blend(*other, .25f, {});
+	pose->compose(output.data());
+
+	assertMatricesNear(concat({ boneMatrix(.5f, 0.f, 0.f, 0.f), projected }), output);
+
+	pose->blend(*other, .75f, {});
+	pose->compose(output.data());
+
+	assertMatricesNear(concat({ boneMatrix(1.625f, 0.f, 0.f, 0.f), boneMatrix(2.f, 0.f, 0.f, 0.f) }), output);
+}
@@ -0,0 +1,225 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "TaskSchedulerTest.hpp"
+
+using namespace minko;
+using namespace minko::async;
+
+TEST_F(TaskSchedulerTest, Create)
+{
+	auto scheduler = TaskScheduler::create(3);
+
+	ASSERT_EQ(scheduler->numThreads(), 3);
+}
+
+TEST_F(TaskSchedulerTest, ScheduleWithoutThreads)
+{
+	auto scheduler = TaskScheduler::create(0);
+	auto v = 0;
+
+	scheduler->schedule([&]() { v = 42; });
+
+	ASSERT_EQ(v, 42);
+}
+
+TEST_F(TaskSchedulerTest, Schedule)
+{
+	const auto numTasks = 1000;
+
+	std::atomic<int> v(0);
+
+	{
+		auto scheduler = TaskScheduler::create(4);
+
+		for (auto i = 0; i < numTasks; ++i)
+			scheduler->schedule([&]() { ++v; });
+	}
+
+	// the pending tasks are executed before the scheduler is destroyed
+	ASSERT_EQ(v.load(), numTasks);
+}
+
+TEST_F(TaskSchedulerTest, ScheduleFromTask)
+{
+	std::atomic<int> v(0);
+
+	{
+		auto scheduler = TaskScheduler::create(2);
+
+		for (auto i = 0; i < 10; ++i)
+			scheduler->schedule([&]()
+			{
+				for (auto j = 0; j < 10; ++j)
+					scheduler->schedule([&]() { ++v; });
+			});
+	}
+
+	ASSERT_EQ(v.load(), 100);
+}
+
+TEST_F(TaskSchedulerTest, ParallelFor)
+{
+	auto scheduler = TaskScheduler::create(4);
+	std::vector<int> values(10007, 0);
+
+	scheduler->parallelFor(0, values.size(), [&](uint begin, uint end)
+	{
+		for (auto i = begin; i < end; ++i)
+			values[i] += i;
+	}, 100);
+
+	for (auto i = 0u; i < values.size(); ++i)
+		ASSERT_EQ(values[i], i);
+}
+
+TEST_F(TaskSchedulerTest, ParallelForEmptyRange)
+{
+	auto scheduler = TaskScheduler::create(2);
+	auto numCalls = 0;
+
+	scheduler->parallelFor(10, 10, [&](uint begin, uint end) { ++numCalls; });
+
+	ASSERT_EQ(numCalls, 0);
+}
+
+TEST_F(TaskSchedulerTest, NestedParallelFor)
+{
+	auto scheduler = TaskScheduler::create(2);
+	std::atomic<int> v(0);
+
+	scheduler->parallelFor(0, 8, [&](uint begin, uint end)
+	{
+		for (auto i = begin; i < end; ++i)
+			scheduler->parallelFor(0, 100, [&](uint b, uint e) { v += e - b; }, 10);
+	});
+
+	ASSERT_EQ(v.load(), 800);
+}
+
+TEST_F(TaskSchedulerTest, ParallelForException)
+{
+	auto scheduler = TaskScheduler::create(2);
+
+	try
+	{
+		scheduler->parallelFor(0, 100, [&](uint begin, uint end)
+		{
+			if (begin <= 50 && 50 < end)
+				throw std::runtime_error("parallelFor");
+		});
+
+		ASSERT_TRUE(false);
+	}
+	catch (const std::runtime_error& e)
+	{
+		ASSERT_EQ(std::string(e.what()), "parallelFor");
+	}
+}
+
+TEST_F(TaskSchedulerTest, PostToMainThread)
+{
+	auto scheduler = TaskScheduler::create(2);
+	auto mainThreadId = std::this_thread::get_id();
+	auto numExecuted = 0;
+	std::atomic<bool> posted(false);
+
+	scheduler->schedule([&]()
+	{
+		scheduler->postToMainThread([&]()
+		{
+			ASSERT_EQ(std::this_thread::get_id(), mainThreadId);
+			++numExecuted;
+		});
+		posted = true;
+	});
+
+	while (!posted)
+		std::this_thread::yield();
+
+	ASSERT_EQ(numExecuted, 0);
+	ASSERT_EQ(scheduler->pollMainThread(), 1);
+	ASSERT_EQ(numExecuted, 1);
+	ASSERT_EQ(scheduler->pollMainThread(), 0);
+}
+
+TEST_F(TaskSchedulerTest, BlockingTasksDoNotHoldThePool)
+{
+	auto scheduler = TaskScheduler::create(1);
+	std::atomic<bool> released(false);
+	std::atomic<bool> computed(false);
+	std::atomic<uint> numBlockingTasksDone(0);
+
+	for (auto i = 0; i < 3; ++i)
+		scheduler->scheduleBlocking([&]()
+		{
+			while (!released)
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			++numBlockingTasksDone;
+		});
+	scheduler->schedule([&]() { computed = true; });
+
+	for (auto i = 0; i < 10000 && !computed; ++i)
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+	// the pool thread is free while every blocking task waits on its own thread
+	ASSERT_TRUE(computed);
+	ASSERT_EQ(numBlockingTasksDone.load(), 0u);
+	ASSERT_EQ(scheduler->numBlockingThreads(), 3u);
+
+	released = true;
+
+	for (auto i = 0; i < 10000 && numBlockingTasksDone.load() != 3; ++i)
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+	ASSERT_EQ(numBlockingTasksDone.load(), 3u);
+
+	scheduler->scheduleBlocking([&]() { ++numBlockingTasksDone; });
+	scheduler = nullptr;
+
+	// the pending blocking tasks run before the scheduler is destroyed
+	ASSERT_EQ(numBlockingTasksDone.load(), 4u);
+}
+
+TEST_F(TaskSchedulerTest, SceneManagerUsesTheSchedulerOfItsCanvas)
+{
+	auto canvas = MinkoTests::canvas();
+	auto sceneManager = component::SceneManager::create(canvas);
+
+	ASSERT_NE(canvas->taskScheduler(), nullptr);
+	ASSERT_NE(canvas->taskScheduler(), TaskScheduler::defaultScheduler());
+	ASSERT_EQ(sceneManager->taskScheduler(), canvas->taskScheduler());
+	ASSERT_EQ(sceneManager->assets()->loader()->options()->taskScheduler(), canvas->taskScheduler());
+	ASSERT_EQ(AbstractCanvas::defaultTaskScheduler(), canvas->taskScheduler());
+}
+
+TEST_F(TaskSchedulerTest, SceneManagerRunsTheTasksPostedToTheMainThread)
+{
+	auto sceneManager = component::SceneManager::create(MinkoTests::canvas());
+	auto numCalls = 0;
+
+	sceneManager->taskScheduler()->postToMainThread([&]() { ++numCalls; });
+
+	ASSERT_EQ(numCalls, 0);
+
+	sceneManager->nextFrame(0.f, 0.f);
+
+	ASSERT_EQ(numCalls, 1);
+}
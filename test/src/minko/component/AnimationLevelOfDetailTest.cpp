@@ -0,0 +1,117 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "AnimationLevelOfDetailTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::math;
+using namespace minko::animation;
+using namespace minko::component;
+using namespace minko::scene;
+
+namespace
+{
+	// an animation holding its node at the given depth
+	Animation::Ptr
+	createAnimation(float z)
+	{
+		std::vector<uint> timetable = { 0, 1000 };
+		std::vector<Matrix4x4::Ptr> matrices = {
+			Matrix4x4::create()->appendTranslation(0.f, 0.f, z),
+			Matrix4x4::create()->appendTranslation(0.f, 0.f, z)
+		};
+
+		return Animation::create({ Matrix4x4Timeline::create("transform.matrix", 1000, timetable, matrices, false) });
+	}
+
+	Node::Ptr
+	createCamera()
+	{
+		return Node::create("camera")
+			->addComponent(Transform::create())
+			->addComponent(PerspectiveCamera::create(1.f, .785f));
+	}
+}
+
+TEST_F(AnimationLevelOfDetailTest, CameraWithoutPerspective)
+{
+	try
+	{
+		AnimationLevelOfDetail::create(Node::create());
+	}
+	catch (const std::invalid_argument&)
+	{
+		SUCCEED();
+		return;
+	}
+
+	FAIL();
+}
+
+TEST_F(AnimationLevelOfDetailTest, LevelsFromScreenSize)
+{
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto root = Node::create()->addComponent(sceneManager);
+	auto camera = createCamera();
+	auto lod = AnimationLevelOfDetail::create(camera);
+	std::vector<Animation::Ptr> animations = { createAnimation(-2.f), createAnimation(-20.f), createAnimation(-500.f) };
+
+	root->addChild(camera);
+
+	for (auto animation : animations)
+	{
+		auto node = Node::create()
+			->addComponent(Transform::create())
+			->addComponent(animation);
+
+		// the box can also be found below the animated node
+		if (animation == animations.back())
+			node->addChild(Node::create()->addComponent(Transform::create())->addComponent(BoundingBox::create(1.f, Vector3::create())));
+		else
+			node->addComponent(BoundingBox::create(1.f, Vector3::create()));
+
+		root->addChild(node);
+		animation->play();
+	}
+
+	auto unbounded = createAnimation(-500.f);
+
+	root->addChild(Node::create()->addComponent(Transform::create())->addComponent(unbounded));
+	root->addComponent(lod);
+
+	// the first frame puts the nodes in place, the second one reads their boxes
+	sceneManager->nextFrame(0.f, 0.f);
+	sceneManager->nextFrame(0.f, 0.f);
+
+	ASSERT_EQ(0, lod->level(animations[0]));
+	ASSERT_EQ(1, lod->level(animations[1]));
+	ASSERT_EQ(3, lod->level(animations[2]));
+	ASSERT_EQ(0, lod->level(unbounded));
+	ASSERT_EQ(1, animations[0]->updateInterval());
+	ASSERT_EQ(2, animations[1]->updateInterval());
+	ASSERT_EQ(8, animations[2]->updateInterval());
+
+	root->removeComponent(lod);
+
+	for (auto animation : animations)
+		ASSERT_EQ(1, animation->updateInterval());
+}
@@ -0,0 +1,198 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "AnimationTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::math;
+using namespace minko::animation;
+using namespace minko::component;
+using namespace minko::scene;
+
+namespace
+{
+	Matrix4x4Timeline::Ptr
+	createTranslationTimeline(bool interpolate = false)
+	{
+		std::vector<uint> timetable = { 0, 500, 1000 };
+		std::vector<Matrix4x4::Ptr> matrices = {
+			Matrix4x4::create()->appendTranslation(0.f, 0.f, 0.f),
+			Matrix4x4::create()->appendTranslation(1.f, 0.f, 0.f),
+			Matrix4x4::create()->appendTranslation(2.f, 0.f, 0.f)
+		};
+
+		return Matrix4x4Timeline::create("transform.matrix", 1000, timetable, matrices, interpolate);
+	}
+
+	// Records the translation of its target when it is updated.
+	class TranslationReader :
+		public AbstractScript
+	{
+	public:
+		typedef std::shared_ptr<TranslationReader> Ptr;
+
+		float x;
+
+		static
+		Ptr
+		create()
+		{
+			auto script = Ptr(new TranslationReader());
+
+			script->initialize();
+
+			return script;
+		}
+
+	protected:
+		void
+		update(Node::Ptr target)
+		{
+			x = target->component<Transform>()->matrix()->translation()->x();
+		}
+
+	private:
+		TranslationReader() :
+			x(-1.f)
+		{
+		}
+	};
+}
+
+TEST_F(AnimationTest, ClonedTimelinesShareKeys)
+{
+	auto timeline = createTranslationTimeline();
+	auto animation = Animation::create({ timeline });
+	auto clone = std::dynamic_pointer_cast<Animation>(animation->clone(CloneOption::DEEP));
+	auto clonedTimeline = std::static_pointer_cast<Matrix4x4Timeline>(clone->timeline(0));
+
+	ASSERT_NE(timeline, clonedTimeline);
+	ASSERT_EQ(timeline->matrices(), clonedTimeline->matrices());
+}
+
+TEST_F(AnimationTest, UpdateTransformMatrix)
+{
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto root = Node::create()->addComponent(sceneManager);
+	auto animation = Animation::create({ createTranslationTimeline() });
+	auto node = Node::create()
+		->addComponent(Transform::create())
+		->addComponent(animation);
+
+	root->addChild(node);
+
+	animation->seek(600)->stop();
+	sceneManager->nextFrame(0.f, 0.f);
+
+	ASSERT_TRUE(root->hasComponent<Animation::RootAnimation>());
+	ASSERT_FLOAT_EQ(node->component<Transform>()->matrix()->translation()->x(), 1.f);
+
+	animation->seek(1000)->stop();
+	sceneManager->nextFrame(0.f, 0.f);
+
+	ASSERT_FLOAT_EQ(node->component<Transform>()->matrix()->translation()->x(), 2.f);
+}
+
+TEST_F(AnimationTest, ScriptsReadAnimatedValuesOfTheCurrentFrame)
+{
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto root = Node::create()->addComponent(sceneManager);
+	auto animation = Animation::create({ createTranslationTimeline() });
+	auto script = TranslationReader::create();
+	auto node = Node::create()
+		->addComponent(Transform::create())
+		->addComponent(script)
+		->addComponent(animation);
+
+	root->addChild(node);
+
+	animation->seek(600)->stop();
+	sceneManager->nextFrame(0.f, 0.f);
+
+	ASSERT_FLOAT_EQ(script->x, 1.f);
+
+	animation->seek(1000)->stop();
+	sceneManager->nextFrame(0.f, 0.f);
+
+	ASSERT_FLOAT_EQ(script->x, 2.f);
+}
+
+TEST_F(AnimationTest, UpdateInstancesOfTheSameClip)
+{
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto root = Node::create()->addComponent(sceneManager);
+	auto animation = Animation::create({ createTranslationTimeline() });
+	std::vector<Node::Ptr> nodes;
+
+	for (auto i = 0; i < 10; ++i)
+	{
+		auto instance = i == 0
+			? animation
+			: std::dynamic_pointer_cast<Animation>(animation->clone(CloneOption::DEEP));
+		auto node = Node::create()
+			->addComponent(Transform::create())
+			->addComponent(instance);
+
+		root->addChild(node);
+		nodes.push_back(node);
+
+		instance->seek(i % 2 == 0 ? 0 : 500)->stop();
+	}
+
+	sceneManager->nextFrame(0.f, 0.f);
+
+	for (auto i = 0; i < 10; ++i)
+		ASSERT_FLOAT_EQ(nodes[i]->component<Transform>()->matrix()->translation()->x(), i % 2 == 0 ? 0.f : 1.f);
+}
+
+TEST_F(AnimationTest, UpdateInterval)
+{
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto root = Node::create()->addComponent(sceneManager);
+	auto animation = Animation::create({ createTranslationTimeline(true) });
+	auto node = Node::create()
+		->addComponent(Transform::create())
+		->addComponent(animation);
+
+	root->addChild(node);
+	animation->updateInterval(3)->play();
+
+	float x = node->component<Transform>()->matrix()->translation()->x();
+	uint numUpdates = 0;
+
+	for (uint i = 1; i <= 6; ++i)
+	{
+		sceneManager->nextFrame(i * 100.f, 100.f);
+
+		auto newX = node->component<Transform>()->matrix()->translation()->x();
+
+		if (newX != x)
+		{
+			// the skipped frames are caught up
+			ASSERT_FLOAT_EQ(i * .2f, newX);
+			++numUpdates;
+		}
+		x = newX;
+	}
+
+	ASSERT_EQ(2, numUpdates);
+}
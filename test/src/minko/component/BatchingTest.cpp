@@ -0,0 +1,328 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "BatchingTest.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::math;
+using namespace minko::render;
+
+scene::Node::Ptr
+BatchingTest::createScene(RecordingContext::Ptr context)
+{
+    auto sceneManager = SceneManager::create(context);
+
+    sceneManager->assets()->loader()->queue("effect/Basic.effect");
+    sceneManager->assets()->loader()->load();
+
+    auto root = scene::Node::create("root")->addComponent(sceneManager);
+
+    root->addChild(scene::Node::create("camera")
+        ->addComponent(Renderer::create())
+        ->addComponent(Transform::create())
+        ->addComponent(PerspectiveCamera::create(1.f))
+    );
+
+    return root;
+}
+
+std::vector<scene::Node::Ptr>
+BatchingTest::createMeshes(scene::Node::Ptr root, material::Material::Ptr material, uint numMeshes)
+{
+    auto assets = root->component<SceneManager>()->assets();
+    std::vector<scene::Node::Ptr> meshes;
+
+    // each mesh has its own geometry so that instancing does not apply
+    for (uint i = 0; i < numMeshes; ++i)
+    {
+        auto mesh = scene::Node::create()
+            ->addComponent(Transform::create(Matrix4x4::create()->appendTranslation(float(i), 0.f, -10.f)))
+            ->addComponent(Surface::create(
+                geometry::CubeGeometry::create(assets->context()),
+                material,
+                assets->effect("effect/Basic.effect")
+            ));
+
+        root->addChild(mesh);
+        meshes.push_back(mesh);
+    }
+
+    return meshes;
+}
+
+void
+BatchingTest::nextFrame(scene::Node::Ptr root, RecordingContext::Ptr context)
+{
+    context->clearCommands();
+    root->component<SceneManager>()->nextFrame(0.f, 0.f);
+}
+
+TEST_F(BatchingTest, MergeSurfacesSharingMaterial)
+{
+    auto context = RecordingContext::create();
+    auto root = createScene(context);
+    auto batching = Batching::create();
+
+    root->addComponent(batching);
+    createMeshes(root, material::BasicMaterial::create(), 10);
+    nextFrame(root, context);
+
+    ASSERT_EQ(context->numDrawCalls(), 1);
+    ASSERT_EQ(batching->numBatches(), 1);
+    ASSERT_EQ(batching->numBatchedSurfaces(), 10);
+    ASSERT_EQ(batching->numSavedDrawCalls(), 9);
+}
+
+TEST_F(BatchingTest, OneBatchPerMaterial)
+{
+    auto context = RecordingContext::create();
+    auto root = createScene(context);
+    auto batching = Batching::create();
+
+    root->addComponent(batching);
+    createMeshes(root, material::BasicMaterial::create(), 3);
+    createMeshes(root, material::BasicMaterial::create(), 4);
+    createMeshes(root, material::BasicMaterial::create(), 1);
+    nextFrame(root, context);
+
+    ASSERT_EQ(context->numDrawCalls(), 3);
+    ASSERT_EQ(batching->numBatches(), 2);
+    ASSERT_EQ(batching->numBatchedSurfaces(), 7);
+    ASSERT_EQ(batching->numSavedDrawCalls(), 5);
+}
+
+TEST_F(BatchingTest, VerticesArePreTransformed)
+{
+    auto context = RecordingContext::create();
+    auto root = createScene(context);
+    auto batching = Batching::create();
+
+    root->addComponent(batching);
+
+    auto meshes = createMeshes(root, material::BasicMaterial::create(), 2);
+
+    nextFrame(root, context);
+
+    auto batch = root->children().back();
+    auto geometry = meshes[1]->component<Surface>()->geometry();
+    auto numVertices = geometry->numVertices();
+    auto& vertices = geometry->vertexBuffer("position")->data();
+    auto& batchVertices = batch->component<Surface>()->geometry()->vertexBuffer("position")->data();
+    auto vertexSize = geometry->vertexBuffer("position")->vertexSize();
+
+    ASSERT_EQ(batch->name(), "batch");
+    ASSERT_EQ(batch->component<Surface>()->geometry()->numVertices(), 2 * numVertices);
+    ASSERT_EQ(batch->component<Surface>()->geometry()->indices()->data().size(), 2 * geometry->indices()->data().size());
+
+    for (uint i = 0; i < numVertices; ++i)
+    {
+        auto batchVertex = &batchVertices[(numVertices + i) * vertexSize];
+
+        ASSERT_FLOAT_EQ(batchVertex[0], vertices[i * vertexSize] + 1.f);
+        ASSERT_FLOAT_EQ(batchVertex[1], vertices[i * vertexSize + 1]);
+        ASSERT_FLOAT_EQ(batchVertex[2], vertices[i * vertexSize + 2] - 10.f);
+    }
+}
+
+TEST_F(BatchingTest, TangentsAreTransformedByTheModelMatrix)
+{
+    auto context = RecordingContext::create();
+    auto root = createScene(context);
+    auto batching = Batching::create();
+    auto assets = root->component<SceneManager>()->assets();
+    auto material = material::BasicMaterial::create();
+
+    root->addComponent(batching);
+
+    std::vector<scene::Node::Ptr> meshes;
+
+    // a non-uniform scale followed by a rotation: the inverse transpose does not preserve the tangents
+    for (uint i = 0; i < 2; ++i)
+    {
+        auto geometry = geometry::CubeGeometry::create(assets->context());
+
+        geometry->computeTangentSpace(false);
+
+        auto mesh = scene::Node::create()
+            ->addComponent(Transform::create(Matrix4x4::create()
+                ->appendScale(2.f, 1.f, 1.f)
+                ->appendRotationZ(float(M_PI) / 4.f)
+                ->appendTranslation(float(i), 0.f, -10.f)
+            ))
+            ->addComponent(Surface::create(geometry, material, assets->effect("effect/Basic.effect")));
+
+        root->addChild(mesh);
+        meshes.push_back(mesh);
+    }
+
+    nextFrame(root, context);
+
+    auto batch = root->children().back();
+    auto geometry = meshes[1]->component<Surface>()->geometry();
+    auto numVertices = geometry->numVertices();
+    auto& tangents = geometry->vertexBuffer("tangent")->data();
+    auto& batchTangents = batch->component<Surface>()->geometry()->vertexBuffer("tangent")->data();
+    auto m = &meshes[1]->component<Transform>()->modelToWorldMatrix()->data()[0];
+
+    ASSERT_EQ(batch->name(), "batch");
+
+    for (uint i = 0; i < numVertices; ++i)
+    {
+        auto t = &tangents[i * 3];
+        auto batchTangent = &batchTangents[(numVertices + i) * 3];
+        float x = m[0] * t[0] + m[1] * t[1] + m[2] * t[2];
+        float y = m[4] * t[0] + m[5] * t[1] + m[6] * t[2];
+        float z = m[8] * t[0] + m[9] * t[1] + m[10] * t[2];
+        float l = std::sqrt(x * x + y * y + z * z);
+
+        ASSERT_NEAR(batchTangent[0], x / l, 1e-5f);
+        ASSERT_NEAR(batchTangent[1], y / l, 1e-5f);
+        ASSERT_NEAR(batchTangent[2], z / l, 1e-5f);
+    }
+}
+
+TEST_F(BatchingTest, MovedSurfaceIsUpdatedInPlace)
+{
+    auto context = RecordingContext::create();
+    auto root = createScene(context);
+    auto batching = Batching::create();
+
+    root->addComponent(batching);
+
+    auto meshes = createMeshes(root, material::BasicMaterial::create(), 4);
+
+    nextFrame(root, context);
+    nextFrame(root, context);
+
+    ASSERT_EQ(batching->numRebuilds(), 1);
+    ASSERT_EQ(context->numCommands(RecordingContext::CommandType::UPLOAD_VERTEX_BUFFER), 0);
+
+    meshes[2]->component<Transform>()->matrix()->appendTranslation(0.f, 1.f, 0.f);
+    nextFrame(root, context);
+
+    auto geometry = meshes[2]->component<Surface>()->geometry();
+    auto vertexSize = geometry->vertexBuffer("position")->vertexSize();
+    auto& batchVertices = root->children().back()->component<Surface>()->geometry()->vertexBuffer("position")->data();
+
+    // only the vertices of the moved surface are uploaded, the batch is not rebuilt
+    ASSERT_EQ(batching->numRebuilds(), 1);
+    ASSERT_EQ(batching->numUpdates(), 1);
+    ASSERT_EQ(context->numCommands(RecordingContext::CommandType::UPLOAD_VERTEX_BUFFER), 1);
+    ASSERT_EQ(context->commands().front().type, RecordingContext::CommandType::UPLOAD_VERTEX_BUFFER);
+    ASSERT_EQ(context->commands().front().args[0], 2 * geometry->numVertices() * vertexSize);
+    ASSERT_EQ(context->commands().front().args[1], geometry->numVertices() * vertexSize);
+    ASSERT_FLOAT_EQ(
+        batchVertices[2 * geometry->numVertices() * vertexSize + 1],
+        geometry->vertexBuffer("position")->data()[1] + 1.f
+    );
+    ASSERT_EQ(context->numDrawCalls(), 1);
+}
+
+TEST_F(BatchingTest, HiddenSurfaceLeavesBatch)
+{
+    auto context = RecordingContext::create();
+    auto root = createScene(context);
+    auto batching = Batching::create();
+
+    root->addComponent(batching);
+
+    auto meshes = createMeshes(root, material::BasicMaterial::create(), 3);
+
+    nextFrame(root, context);
+    meshes[0]->component<Surface>()->visible(false);
+    nextFrame(root, context);
+
+    ASSERT_EQ(batching->numRebuilds(), 2);
+    ASSERT_EQ(batching->numBatchedSurfaces(), 2);
+    ASSERT_FALSE(meshes[0]->component<Surface>()->batched());
+    ASSERT_EQ(context->numDrawCalls(), 1);
+
+    meshes[1]->component<Surface>()->visible(false);
+    nextFrame(root, context);
+
+    // a single surface is not worth a batch
+    ASSERT_EQ(batching->numBatches(), 0);
+    ASSERT_FALSE(meshes[2]->component<Surface>()->batched());
+    ASSERT_EQ(context->numDrawCalls(), 1);
+
+    meshes[0]->component<Surface>()->visible(true);
+    meshes[1]->component<Surface>()->visible(true);
+    nextFrame(root, context);
+
+    ASSERT_EQ(batching->numBatchedSurfaces(), 3);
+    ASSERT_EQ(context->numDrawCalls(), 1);
+}
+
+TEST_F(BatchingTest, RemovedSurfaceLeavesBatch)
+{
+    auto context = RecordingContext::create();
+    auto root = createScene(context);
+    auto batching = Batching::create();
+
+    root->addComponent(batching);
+
+    auto meshes = createMeshes(root, material::BasicMaterial::create(), 3);
+
+    nextFrame(root, context);
+    root->removeChild(meshes[0]);
+    nextFrame(root, context);
+
+    ASSERT_EQ(batching->numBatchedSurfaces(), 2);
+    ASSERT_FALSE(meshes[0]->component<Surface>()->batched());
+    ASSERT_EQ(context->numDrawCalls(), 1);
+}
+
+TEST_F(BatchingTest, LayoutMask)
+{
+    auto context = RecordingContext::create();
+    auto root = createScene(context);
+    auto batching = Batching::create();
+
+    batching->layoutMask(scene::Layout::Group::DEFAULT);
+    root->addComponent(batching);
+
+    auto meshes = createMeshes(root, material::BasicMaterial::create(), 4);
+
+    meshes[0]->layouts(scene::Layout::Group::CULLING);
+    nextFrame(root, context);
+
+    ASSERT_EQ(batching->numBatchedSurfaces(), 3);
+    ASSERT_EQ(context->numDrawCalls(), 2);
+}
+
+TEST_F(BatchingTest, RemoveBatching)
+{
+    auto context = RecordingContext::create();
+    auto root = createScene(context);
+    auto batching = Batching::create();
+
+    root->addComponent(batching);
+    createMeshes(root, material::BasicMaterial::create(), 5);
+    nextFrame(root, context);
+
+    ASSERT_EQ(context->numDrawCalls(), 1);
+
+    root->removeComponent(batching);
+    nextFrame(root, context);
+
+    ASSERT_EQ(context->numDrawCalls(), 5);
+    ASSERT_EQ(root->children().size(), 6);
+}
@@ -0,0 +1,146 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "CullingTest.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::math;
+using namespace minko::render;
+
+scene::Node::Ptr
+CullingTest::createScene(RecordingContext::Ptr context)
+{
+    auto sceneManager = SceneManager::create(context);
+
+    sceneManager->assets()->loader()->queue("effect/Basic.effect");
+    sceneManager->assets()->loader()->load();
+
+    auto root = scene::Node::create("root")->addComponent(sceneManager);
+
+    // looking down -z from the origin
+    root->addChild(scene::Node::create("camera")
+        ->addComponent(Renderer::create())
+        ->addComponent(Transform::create())
+        ->addComponent(PerspectiveCamera::create(1.f))
+        ->addComponent(Culling::create(Frustum::create(), "camera.worldToScreenMatrix"))
+    );
+
+    return root;
+}
+
+scene::Node::Ptr
+CullingTest::createMesh(scene::Node::Ptr root, float x, float y, float z)
+{
+    auto assets = root->component<SceneManager>()->assets();
+    // each mesh has its own geometry so that instancing does not apply
+    auto mesh = scene::Node::create()
+        ->addComponent(Transform::create(Matrix4x4::create()->appendTranslation(x, y, z)))
+        ->addComponent(Surface::create(
+            geometry::CubeGeometry::create(assets->context()),
+            material::BasicMaterial::create(),
+            assets->effect("effect/Basic.effect")
+        ));
+
+    mesh->layouts(mesh->layouts() | scene::Layout::Group::CULLING);
+    root->addChild(mesh);
+
+    return mesh;
+}
+
+void
+CullingTest::nextFrame(scene::Node::Ptr root, RecordingContext::Ptr context)
+{
+    context->clearCommands();
+    root->component<SceneManager>()->nextFrame(0.f, 0.f);
+}
+
+TEST_F(CullingTest, SurfacesOutsideFrustumAreNotRendered)
+{
+    auto context = RecordingContext::create();
+    auto root = createScene(context);
+
+    createMesh(root, -2.f, 0.f, -10.f);
+    createMesh(root, 0.f, 0.f, -10.f);
+    createMesh(root, 2.f, 0.f, -10.f);
+    createMesh(root, 0.f, 0.f, 10.f);
+    createMesh(root, 50.f, 0.f, -10.f);
+    nextFrame(root, context);
+
+    ASSERT_EQ(context->numDrawCalls(), 3);
+}
+
+TEST_F(CullingTest, MovingSurfaceIsCulled)
+{
+    auto context = RecordingContext::create();
+    auto root = createScene(context);
+    auto mesh = createMesh(root, 0.f, 0.f, -10.f);
+
+    createMesh(root, 2.f, 0.f, -10.f);
+    nextFrame(root, context);
+
+    ASSERT_EQ(context->numDrawCalls(), 2);
+
+    mesh->component<Transform>()->matrix()->appendTranslation(0.f, 0.f, 20.f);
+    nextFrame(root, context);
+
+    ASSERT_EQ(context->numDrawCalls(), 1);
+
+    // far away in front of the camera: the octree has to grow
+    mesh->component<Transform>()->matrix()->appendTranslation(0.f, 0.f, -500.f);
+    nextFrame(root, context);
+
+    ASSERT_EQ(context->numDrawCalls(), 2);
+}
+
+TEST_F(CullingTest, CameraRotation)
+{
+    auto context = RecordingContext::create();
+    auto root = createScene(context);
+    auto camera = root->children()[0];
+
+    createMesh(root, 0.f, 0.f, -10.f);
+    createMesh(root, 0.f, 0.f, 10.f);
+    createMesh(root, 1.f, 0.f, 10.f);
+    nextFrame(root, context);
+
+    ASSERT_EQ(context->numDrawCalls(), 1);
+
+    camera->component<Transform>()->matrix()->appendRotationY(3.1415f);
+    nextFrame(root, context);
+
+    ASSERT_EQ(context->numDrawCalls(), 2);
+}
+
+TEST_F(CullingTest, RemovedFromCullingLayout)
+{
+    auto context = RecordingContext::create();
+    auto root = createScene(context);
+    auto mesh = createMesh(root, 0.f, 0.f, 10.f);
+
+    nextFrame(root, context);
+
+    ASSERT_EQ(context->numDrawCalls(), 0);
+
+    mesh->layouts(mesh->layouts() & ~scene::Layout::Group::CULLING);
+    nextFrame(root, context);
+
+    ASSERT_EQ(context->numDrawCalls(), 1);
+    ASSERT_FALSE(root->children()[0]->component<Culling>()->octTree()->hasNode(mesh));
+}
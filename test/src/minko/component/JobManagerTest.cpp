@@ -0,0 +1,184 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "JobManagerTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::component;
+
+namespace
+{
+	class TestJob :
+		public JobManager::Job
+	{
+	public:
+		typedef std::shared_ptr<TestJob> Ptr;
+
+	public:
+		uint						stepsLeft;
+		float						jobPriority;
+		std::vector<std::string>*	log;
+		std::string					name;
+		std::thread::id				stepThreadId;
+		std::thread::id				afterLastStepThreadId;
+
+	public:
+		static
+		Ptr
+		create(const std::string& name, uint numSteps, float priority, std::vector<std::string>* log)
+		{
+			auto job = Ptr(new TestJob());
+
+			job->name = name;
+			job->stepsLeft = numSteps;
+			job->jobPriority = priority;
+			job->log = log;
+
+			return job;
+		}
+
+		bool
+		complete()
+		{
+			return stepsLeft == 0;
+		}
+
+		void
+		beforeFirstStep()
+		{
+		}
+
+		void
+		step()
+		{
+			stepThreadId = std::this_thread::get_id();
+			--stepsLeft;
+			if (log != nullptr)
+				log->push_back(name);
+		}
+
+		float
+		priority()
+		{
+			return jobPriority;
+		}
+
+		void
+		changePriority(float value)
+		{
+			jobPriority = value;
+			priorityChanged()->execute(value);
+		}
+
+		void
+		afterLastStep()
+		{
+			afterLastStepThreadId = std::this_thread::get_id();
+		}
+	};
+}
+
+TEST_F(JobManagerTest, StepUntilComplete)
+{
+	auto root = scene::Node::create()->addComponent(SceneManager::create(MinkoTests::canvas()));
+	auto jobManager = JobManager::create(1);
+	auto job = TestJob::create("a", 10, 0.f, nullptr);
+	auto numCompleteJobs = 0;
+	auto _ = jobManager->jobComplete()->connect([&](JobManager::Ptr, JobManager::Job::Ptr j)
+	{
+		ASSERT_EQ(j, job);
+		++numCompleteJobs;
+	});
+
+	root->addComponent(jobManager);
+	jobManager->pushJob(job);
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+
+	ASSERT_TRUE(job->complete());
+	ASSERT_EQ(numCompleteJobs, 1);
+	ASSERT_EQ(jobManager->numJobs(), 0);
+	ASSERT_EQ(job->numSteps(), 10);
+	ASSERT_TRUE(job->maxStepTime() <= job->stepTime());
+}
+
+TEST_F(JobManagerTest, PriorityOrder)
+{
+	auto root = scene::Node::create()->addComponent(SceneManager::create(MinkoTests::canvas()));
+	auto jobManager = JobManager::create(1);
+	std::vector<std::string> log;
+	auto a = TestJob::create("a", 2, 1.f, &log);
+	auto b = TestJob::create("b", 2, 2.f, &log);
+	auto c = TestJob::create("c", 2, 1.f, &log);
+
+	root->addComponent(jobManager);
+	jobManager->pushJob(a)->pushJob(b)->pushJob(c);
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+
+	ASSERT_EQ(log, std::vector<std::string>({ "b", "b", "a", "a", "c", "c" }));
+}
+
+TEST_F(JobManagerTest, PriorityChanged)
+{
+	auto root = scene::Node::create()->addComponent(SceneManager::create(MinkoTests::canvas()));
+	auto jobManager = JobManager::create(1);
+	std::vector<std::string> log;
+	auto a = TestJob::create("a", 2, 2.f, &log);
+	auto b = TestJob::create("b", 2, 1.f, &log);
+
+	a->oneStepPerFrame(true);
+	b->oneStepPerFrame(true);
+
+	root->addComponent(jobManager);
+	jobManager->pushJob(a)->pushJob(b);
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+	b->changePriority(3.f);
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+
+	ASSERT_EQ(log, std::vector<std::string>({ "a", "b", "b", "a" }));
+}
+
+TEST_F(JobManagerTest, ThreadSafeJob)
+{
+	auto root = scene::Node::create()->addComponent(SceneManager::create(MinkoTests::canvas()));
+	auto jobManager = JobManager::create(1);
+	auto job = TestJob::create("a", 10, 0.f, nullptr);
+
+	job->threadSafe(true);
+
+	root->addComponent(jobManager);
+	jobManager->pushJob(job);
+
+	for (auto i = 0; i < 1000 && jobManager->numJobs() != 0; ++i)
+	{
+		root->component<SceneManager>()->nextFrame(0.f, 0.f);
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	ASSERT_EQ(jobManager->numJobs(), 0);
+	ASSERT_TRUE(job->complete());
+	ASSERT_EQ(job->numSteps(), 10);
+	ASSERT_EQ(job->afterLastStepThreadId, std::this_thread::get_id());
+	if (root->component<SceneManager>()->taskScheduler()->numThreads() != 0)
+		ASSERT_NE(job->stepThreadId, std::this_thread::get_id());
+}
@@ -0,0 +1,95 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "RendererTest.hpp"
+
+#include "minko/AllocationCounter.hpp"
+#include "minko/render/DrawCallPool.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::math;
+using namespace minko::render;
+
+TEST_F(RendererTest, SteadyStateRenderDoesNotAllocate)
+{
+    auto context = RecordingContext::create();
+    auto sceneManager = SceneManager::create(context);
+    auto assets = sceneManager->assets();
+
+    assets->loader()->queue("effect/Basic.effect");
+    assets->loader()->load();
+
+    auto root = scene::Node::create("root")->addComponent(sceneManager);
+    auto renderer = Renderer::create();
+    auto geometry = geometry::CubeGeometry::create(context);
+
+    root->addChild(scene::Node::create("camera")
+        ->addComponent(renderer)
+        ->addComponent(Transform::create())
+        ->addComponent(PerspectiveCamera::create(1.f))
+    );
+
+    for (auto i = 0u; i < 100u; ++i)
+    {
+        auto material = material::BasicMaterial::create();
+
+        material->diffuseColor(Vector4::create(i / 100.f, 0.f, 0.f, 1.f));
+        // mix opaque and z-sorted draw calls
+        material->zSorted(i % 2 == 0);
+
+        root->addChild(scene::Node::create()
+            ->addComponent(Transform::create(Matrix4x4::create()->appendTranslation(0.f, 0.f, -10.f - i)))
+            ->addComponent(Surface::create(geometry, material, assets->effect("effect/Basic.effect")))
+        );
+    }
+
+    context->recordCommands(false);
+    sceneManager->nextFrame(0.f, 0.f);
+    renderer->render(context);
+
+    const auto& drawCalls = renderer->drawCallPool()->drawCalls();
+    const auto storage = drawCalls.data();
+    std::vector<long> useCounts;
+
+    for (const auto& drawCall : drawCalls)
+        useCounts.push_back(drawCall.use_count());
+
+    auto numAllocations = 0u;
+
+    {
+        AllocationCounter counter;
+
+        for (auto i = 0; i < 10; ++i)
+            renderer->render(context);
+
+        numAllocations = counter.numAllocations();
+    }
+
+    ASSERT_EQ(renderer->numDrawCalls(), 100u);
+    ASSERT_EQ(numAllocations, 0u);
+    // the pool's vector is iterated in place: it is neither reallocated nor copied, so no extra
+    // reference to any draw call is kept between frames
+    ASSERT_EQ(&renderer->drawCallPool()->drawCalls(), &drawCalls);
+    ASSERT_EQ(drawCalls.data(), storage);
+    ASSERT_EQ(drawCalls.size(), useCounts.size());
+    for (auto i = 0u; i < drawCalls.size(); ++i)
+        ASSERT_EQ(drawCalls[i].use_count(), useCounts[i]);
+}
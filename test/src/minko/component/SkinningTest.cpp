@@ -0,0 +1,399 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "SkinningTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+#include "minko/geometry/Bone.hpp"
+#include "minko/geometry/Skin.hpp"
+#include "minko/animation/SkinLayer.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::geometry;
+using namespace minko::math;
+
+namespace
+{
+	// vertices: [x y z nx ny nz]
+	scene::Node::Ptr
+	createSkinnedScene(std::vector<float> vertices, Skinning::Ptr skinning)
+	{
+		auto context = MinkoTests::canvas()->context();
+		auto sceneManager = SceneManager::create(context);
+
+		sceneManager->assets()->loader()->queue("effect/Basic.effect");
+		sceneManager->assets()->loader()->load();
+
+		auto root = scene::Node::create("root")->addComponent(sceneManager);
+		auto geometry = Geometry::create();
+		auto vertexBuffer = render::VertexBuffer::create(context, vertices);
+
+		vertexBuffer->addAttribute("position", 3, 0);
+		vertexBuffer->addAttribute("normal", 3, 3);
+		geometry->addVertexBuffer(vertexBuffer);
+
+		auto mesh = scene::Node::create("mesh")
+			->addComponent(Surface::create(
+				geometry,
+				material::BasicMaterial::create(),
+				sceneManager->assets()->effect("effect/Basic.effect")
+			))
+			->addComponent(skinning);
+
+		root->addChild(mesh);
+
+		return root;
+	}
+
+	void
+	skinFrame(scene::Node::Ptr root, Skinning::Ptr skinning, uint time)
+	{
+		skinning->seek(time)->stop();
+		root->component<SceneManager>()->nextFrame(0.f, 0.f);
+	}
+
+	// scalar skinning of the vertices, as the shaders do it
+	std::vector<float>
+	referenceSkinning(Skin::Ptr skin, const std::vector<float>& vertices, uint frameId)
+	{
+		const auto& matrices = skin->matrices(frameId);
+		std::vector<float> output(vertices.size(), 0.f);
+
+		for (uint vId = 0; vId < skin->numVertices(); ++vId)
+			for (uint j = 0; j < skin->numVertexBones(vId); ++j)
+			{
+				uint boneId = 0;
+				float weight = 0.f;
+
+				skin->vertexBoneData(vId, j, boneId, weight);
+
+				const float* m = &matrices[boneId << 4];
+				const float* v = &vertices[vId * 6];
+				float* o = &output[vId * 6];
+
+				for (uint i = 0; i < 3; ++i)
+				{
+					o[i] += weight * (m[i] * v[0] + m[4 + i] * v[1] + m[8 + i] * v[2] + m[12 + i]);
+					o[3 + i] += weight * (m[i] * v[3] + m[4 + i] * v[4] + m[8 + i] * v[5]);
+				}
+			}
+
+		return output;
+	}
+}
+
+TEST_F(SkinningTest, SoftwareSkinning)
+{
+	std::vector<float> vertices = {
+		1.f, 0.f, 0.f,	0.f, 1.f, 0.f,
+		0.f, 1.f, 0.f,	1.f, 0.f, 0.f,
+		0.f, 0.f, 1.f,	0.f, 0.f, 1.f
+	};
+
+	auto skin = Skin::create(2, 1000, 2);
+
+	skin->bone(0, Bone::create(Matrix4x4::create(), { 0, 1 }, { 1.f, .5f }));
+	skin->bone(1, Bone::create(Matrix4x4::create(), { 1, 2 }, { .5f, 1.f }));
+	skin->matrix(0, 0, Matrix4x4::create());
+	skin->matrix(0, 1, Matrix4x4::create());
+	skin->matrix(1, 0, Matrix4x4::create()->appendTranslation(1.f, 2.f, 3.f));
+	skin->matrix(1, 1, Matrix4x4::create()->appendScale(2.f, 3.f, 4.f));
+	skin->reorganizeByVertices()->transposeMatrices();
+
+	auto skinning = Skinning::create(skin, SkinningMethod::SOFTWARE, MinkoTests::canvas()->context(), nullptr);
+	auto root = createSkinnedScene(vertices, skinning);
+	auto& data = root->children()[0]->component<Surface>()->geometry()->vertexBuffer("position")->data();
+
+	skinFrame(root, skinning, 0);
+
+	ASSERT_EQ(vertices, data);
+
+	skinFrame(root, skinning, 600);
+
+	std::vector<float> expected = {
+		2.f, 2.f, 3.f,	0.f, 1.f, 0.f,
+		.5f, 3.f, 1.5f,	1.5f, 0.f, 0.f,
+		0.f, 0.f, 4.f,	0.f, 0.f, 4.f
+	};
+
+	for (uint i = 0; i < expected.size(); ++i)
+		ASSERT_FLOAT_EQ(expected[i], data[i]);
+}
+
+TEST_F(SkinningTest, SoftwareSkinningFallback)
+{
+	const uint numVertices = 10000;
+	const uint numBones = Skinning::MAX_NUM_BONES_PER_VERTEX + 3;
+	const uint numFrames = 4;
+
+	std::vector<float> vertices(numVertices * 6);
+
+	for (uint i = 0; i < vertices.size(); ++i)
+		vertices[i] = float(i % 17) - 8.f;
+
+	auto skin = Skin::create(numBones, 1000, numFrames);
+
+	for (uint boneId = 0; boneId < numBones; ++boneId)
+	{
+		std::vector<unsigned short> vertexIds;
+		std::vector<float> vertexWeights;
+
+		// the last bones only influence the first vertices
+		for (uint vId = 0; vId < numVertices; ++vId)
+			if (boneId < 3 || vId < 100)
+			{
+				vertexIds.push_back(vId);
+				vertexWeights.push_back(1.f / float(boneId + 1));
+			}
+
+		skin->bone(boneId, Bone::create(Matrix4x4::create(), vertexIds, vertexWeights));
+
+		for (uint frameId = 0; frameId < numFrames; ++frameId)
+			skin->matrix(frameId, boneId, Matrix4x4::create()
+				->appendScale(1.f + boneId * .1f, 1.f, 1.f + frameId * .2f)
+				->appendRotationY(float(frameId + boneId))
+				->appendTranslation(float(frameId), float(boneId), 0.f)
+			);
+	}
+	skin->reorganizeByVertices()->transposeMatrices();
+
+	ASSERT_GT(skin->maxNumVertexBones(), Skinning::MAX_NUM_BONES_PER_VERTEX);
+
+	auto skinning = Skinning::create(skin, SkinningMethod::HARDWARE, MinkoTests::canvas()->context(), nullptr);
+	auto root = createSkinnedScene(vertices, skinning);
+	auto& data = root->children()[0]->component<Surface>()->geometry()->vertexBuffer("position")->data();
+
+	for (uint frameId : { 2u, 3u, 0u })
+	{
+		skinFrame(root, skinning, frameId * 250);
+
+		auto expected = referenceSkinning(skin, vertices, frameId);
+
+		for (uint i = 0; i < expected.size(); ++i)
+			ASSERT_NEAR(expected[i], data[i], 1e-4f * (1.f + std::abs(expected[i])));
+	}
+}
+
+TEST_F(SkinningTest, SoftwareSkinningCompressedSkin)
+{
+	std::vector<float> vertices = {
+		1.f, 0.f, 0.f,	0.f, 1.f, 0.f,
+		0.f, 1.f, 0.f,	1.f, 0.f, 0.f,
+		0.f, 0.f, 1.f,	0.f, 0.f, 1.f
+	};
+	const uint numFrames = 30;
+
+	auto skin = Skin::create(2, 1000, numFrames);
+
+	skin->bone(0, Bone::create(Matrix4x4::create(), { 0, 1 }, { 1.f, .5f }));
+	skin->bone(1, Bone::create(Matrix4x4::create(), { 1, 2 }, { .5f, 1.f }));
+	for (uint frameId = 0; frameId < numFrames; ++frameId)
+	{
+		skin->matrix(frameId, 0, Matrix4x4::create()->appendRotationY(.1f * frameId));
+		skin->matrix(frameId, 1, Matrix4x4::create()->appendTranslation(.1f * frameId, 0.f, 0.f));
+	}
+	skin->reorganizeByVertices()->transposeMatrices();
+
+	auto baked = skin->getBoneMatricesPerFrame();
+
+	skin->compressMatrices(1e-4f);
+
+	auto skinning = Skinning::create(skin, SkinningMethod::SOFTWARE, MinkoTests::canvas()->context(), nullptr);
+	auto root = createSkinnedScene(vertices, skinning);
+	auto& data = root->children()[0]->component<Surface>()->geometry()->vertexBuffer("position")->data();
+	auto bakedSkin = Skin::create(2, 1000, numFrames);
+
+	bakedSkin->setBoneMatricesPerFrame(baked);
+	bakedSkin->bone(0, skin->bone(0));
+	bakedSkin->bone(1, skin->bone(1));
+	bakedSkin->reorganizeByVertices();
+
+	for (uint frameId : { 5u, 17u, 29u })
+	{
+		skinFrame(root, skinning, skin->duration() * frameId / numFrames + 1);
+
+		auto expected = referenceSkinning(bakedSkin, vertices, frameId);
+
+		for (uint i = 0; i < expected.size(); ++i)
+			ASSERT_NEAR(expected[i], data[i], 1e-3f);
+	}
+}
+
+TEST_F(SkinningTest, SoftwareSkinningCrossFade)
+{
+	std::vector<float> vertices = {
+		1.f, 0.f, 0.f,	0.f, 1.f, 0.f
+	};
+
+	auto createSkin = [](float x)
+	{
+		auto skin = Skin::create(1, 1000, 2);
+
+		skin->bone(0, Bone::create(Matrix4x4::create(), { 0 }, { 1.f }));
+		skin->matrix(0, 0, Matrix4x4::create()->appendTranslation(x, 0.f, 0.f));
+		skin->matrix(1, 0, Matrix4x4::create()->appendTranslation(x, 0.f, 0.f));
+		skin->reorganizeByVertices()->transposeMatrices();
+
+		return skin;
+	};
+
+	auto idle = createSkin(0.f);
+	auto run = createSkin(2.f);
+	auto skinning = Skinning::create(idle, SkinningMethod::SOFTWARE, MinkoTests::canvas()->context(), nullptr);
+	auto root = createSkinnedScene(vertices, skinning);
+	auto sceneManager = root->component<SceneManager>();
+	auto& data = root->children()[0]->component<Surface>()->geometry()->vertexBuffer("position")->data();
+
+	skinning->play();
+	sceneManager->nextFrame(0.f, 0.f);
+	ASSERT_FLOAT_EQ(1.f, data[0]);
+
+	auto runLayer = skinning->crossFade(run, 1000);
+
+	sceneManager->nextFrame(500.f, 500.f);
+	ASSERT_FLOAT_EQ(.5f, runLayer->weight());
+	ASSERT_FLOAT_EQ(2.f, data[0]);
+
+	sceneManager->nextFrame(1000.f, 500.f);
+	ASSERT_FLOAT_EQ(3.f, data[0]);
+
+	// the faded out layers are removed
+	skinning->crossFade(idle, 100);
+	sceneManager->nextFrame(1100.f, 100.f);
+	ASSERT_EQ(1u, skinning->layers().size());
+	ASSERT_FLOAT_EQ(1.f, data[0]);
+
+	// a skin with other bones does not fade the current layers out
+	ASSERT_THROW(skinning->crossFade(Skin::create(2, 1000, 2), 100), std::invalid_argument);
+	sceneManager->nextFrame(1200.f, 100.f);
+	ASSERT_EQ(1u, skinning->layers().size());
+	ASSERT_FLOAT_EQ(1.f, skinning->layers()[0]->weight());
+}
+
+TEST_F(SkinningTest, SoftwareSkinningAdditiveLayer)
+{
+	std::vector<float> vertices = {
+		1.f, 0.f, 0.f,	0.f, 1.f, 0.f
+	};
+
+	auto base = Skin::create(1, 1000, 2);
+	auto lean = Skin::create(1, 1000, 2);
+
+	base->bone(0, Bone::create(Matrix4x4::create(), { 0 }, { 1.f }));
+	base->matrix(0, 0, Matrix4x4::create()->appendTranslation(1.f, 0.f, 0.f));
+	base->matrix(1, 0, Matrix4x4::create()->appendTranslation(1.f, 0.f, 0.f));
+	base->reorganizeByVertices()->transposeMatrices();
+
+	lean->bone(0, base->bone(0));
+	lean->matrix(0, 0, Matrix4x4::create()->appendTranslation(5.f, 0.f, 0.f));
+	lean->matrix(1, 0, Matrix4x4::create()->appendTranslation(5.f, 4.f, 0.f));
+	lean->reorganizeByVertices()->transposeMatrices();
+
+	auto skinning = Skinning::create(base, SkinningMethod::SOFTWARE, MinkoTests::canvas()->context(), nullptr);
+	auto root = createSkinnedScene(vertices, skinning);
+	auto& data = root->children()[0]->component<Surface>()->geometry()->vertexBuffer("position")->data();
+
+	skinning->addLayer(animation::SkinLayer::create(lean, true)->seek(600)->weight(.5f));
+	skinFrame(root, skinning, 0);
+
+	ASSERT_FLOAT_EQ(2.f, data[0]);
+	ASSERT_FLOAT_EQ(2.f, data[1]);
+
+	ASSERT_THROW(skinning->addLayer(animation::SkinLayer::create(Skin::create(2, 1000, 2))), std::invalid_argument);
+}
+
+TEST_F(SkinningTest, SoftwareSkinningHiddenSurface)
+{
+	std::vector<float> vertices = {
+		1.f, 0.f, 0.f,	0.f, 1.f, 0.f,
+		0.f, 1.f, 0.f,	1.f, 0.f, 0.f,
+		0.f, 0.f, 1.f,	0.f, 0.f, 1.f
+	};
+
+	auto skin = Skin::create(2, 1000, 2);
+
+	skin->bone(0, Bone::create(Matrix4x4::create(), { 0, 1 }, { 1.f, .5f }));
+	skin->bone(1, Bone::create(Matrix4x4::create(), { 1, 2 }, { .5f, 1.f }));
+	skin->matrix(0, 0, Matrix4x4::create());
+	skin->matrix(0, 1, Matrix4x4::create());
+	skin->matrix(1, 0, Matrix4x4::create()->appendTranslation(1.f, 2.f, 3.f));
+	skin->matrix(1, 1, Matrix4x4::create()->appendScale(2.f, 3.f, 4.f));
+	skin->reorganizeByVertices()->transposeMatrices();
+
+	auto skinning = Skinning::create(skin, SkinningMethod::SOFTWARE, MinkoTests::canvas()->context(), nullptr);
+	auto root = createSkinnedScene(vertices, skinning);
+	auto surface = root->children()[0]->component<Surface>();
+	auto& data = surface->geometry()->vertexBuffer("position")->data();
+
+	skinFrame(root, skinning, 0);
+	surface->visible(false);
+	skinFrame(root, skinning, 600);
+
+	ASSERT_EQ(vertices, data);
+
+	// skinned as soon as it shows up again
+	surface->visible(true);
+
+	std::vector<float> expected = {
+		2.f, 2.f, 3.f,	0.f, 1.f, 0.f,
+		.5f, 3.f, 1.5f,	1.5f, 0.f, 0.f,
+		0.f, 0.f, 4.f,	0.f, 0.f, 4.f
+	};
+
+	for (uint i = 0; i < expected.size(); ++i)
+		ASSERT_FLOAT_EQ(expected[i], data[i]);
+}
+
+TEST_F(SkinningTest, SoftwareSkinningReducedBones)
+{
+	std::vector<float> vertices = {
+		1.f, 0.f, 0.f,	0.f, 1.f, 0.f,
+		0.f, 1.f, 0.f,	1.f, 0.f, 0.f,
+		0.f, 0.f, 1.f,	0.f, 0.f, 1.f
+	};
+
+	auto skin = Skin::create(2, 1000, 2);
+
+	skin->bone(0, Bone::create(Matrix4x4::create(), { 0, 1 }, { 1.f, .75f }));
+	skin->bone(1, Bone::create(Matrix4x4::create(), { 1, 2 }, { .25f, 1.f }));
+	skin->matrix(0, 0, Matrix4x4::create());
+	skin->matrix(0, 1, Matrix4x4::create());
+	skin->matrix(1, 0, Matrix4x4::create()->appendTranslation(1.f, 2.f, 3.f));
+	skin->matrix(1, 1, Matrix4x4::create()->appendScale(2.f, 3.f, 4.f));
+	skin->reorganizeByVertices()->transposeMatrices();
+
+	auto skinning = Skinning::create(skin, SkinningMethod::SOFTWARE, MinkoTests::canvas()->context(), nullptr);
+	auto root = createSkinnedScene(vertices, skinning);
+	auto& data = root->children()[0]->component<Surface>()->geometry()->vertexBuffer("position")->data();
+
+	skinning->maxNumVertexBones(1);
+	skinFrame(root, skinning, 600);
+
+	// the second vertex only keeps its heaviest bone, with its whole weight
+	std::vector<float> expected = {
+		2.f, 2.f, 3.f,	0.f, 1.f, 0.f,
+		1.f, 3.f, 3.f,	1.f, 0.f, 0.f,
+		0.f, 0.f, 4.f,	0.f, 0.f, 4.f
+	};
+
+	for (uint i = 0; i < expected.size(); ++i)
+		ASSERT_FLOAT_EQ(expected[i], data[i]);
+}
@@ -329,3 +329,223 @@ TEST_F(TransformTest, Clone)
 
 	ASSERT_FALSE(n2->component<Transform>()->matrix()->equals(n1->component<Transform>()->matrix()));
 }
+
+TEST_F(TransformTest, AddSubtreeToExistingHierarchy)
+{
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto root = Node::create()->addComponent(sceneManager);
+	auto a = Node::create("a")->addComponent(Transform::create(Matrix4x4::create()->appendTranslation(1.f, 0.f, 0.f)));
+	auto b = Node::create("b");
+	auto c = Node::create("c")->addComponent(Transform::create(Matrix4x4::create()->appendTranslation(0.f, 1.f, 0.f)));
+
+	root->addChild(a);
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	// 'b' has no transform: 'c' must be attached to 'a'
+	b->addChild(c);
+	a->addChild(b);
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	ASSERT_TRUE(c->component<Transform>()->modelToWorld(Vector3::create())->equals(Vector3::create(1.f, 1.f, 0.f)));
+
+	a->component<Transform>()->matrix()->appendTranslation(0.f, 0.f, 1.f);
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	ASSERT_TRUE(c->component<Transform>()->modelToWorld(Vector3::create())->equals(Vector3::create(1.f, 1.f, 1.f)));
+}
+
+TEST_F(TransformTest, MovedSubtreeFollowsNewParent)
+{
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto root = Node::create()->addComponent(sceneManager);
+	auto a = Node::create("a")->addComponent(Transform::create(Matrix4x4::create()->appendTranslation(1.f, 0.f, 0.f)));
+	auto b = Node::create("b")->addComponent(Transform::create(Matrix4x4::create()->appendTranslation(5.f, 0.f, 0.f)));
+	auto c = Node::create("c")->addComponent(Transform::create(Matrix4x4::create()->appendTranslation(0.f, 1.f, 0.f)));
+	auto d = Node::create("d")->addComponent(Transform::create(Matrix4x4::create()->appendTranslation(0.f, 0.f, 1.f)));
+
+	root->addChild(a)->addChild(b);
+	a->addChild(c);
+	c->addChild(d);
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	ASSERT_TRUE(d->component<Transform>()->modelToWorld(Vector3::create())->equals(Vector3::create(1.f, 1.f, 1.f)));
+
+	// neither 'c' nor 'd' changed but their parent did
+	b->addChild(c);
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	ASSERT_TRUE(c->component<Transform>()->modelToWorld(Vector3::create())->equals(Vector3::create(5.f, 1.f, 0.f)));
+	ASSERT_TRUE(d->component<Transform>()->modelToWorld(Vector3::create())->equals(Vector3::create(5.f, 1.f, 1.f)));
+
+	b->component<Transform>()->matrix()->appendTranslation(1.f, 0.f, 0.f);
+	a->component<Transform>()->matrix()->appendTranslation(1.f, 0.f, 0.f);
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	ASSERT_TRUE(d->component<Transform>()->modelToWorld(Vector3::create())->equals(Vector3::create(6.f, 1.f, 1.f)));
+}
+
+TEST_F(TransformTest, RemovedSubtreeIsNotUpdated)
+{
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto root = Node::create()->addComponent(sceneManager);
+	auto a = Node::create("a")->addComponent(Transform::create());
+	auto b = Node::create("b")->addComponent(Transform::create());
+	auto c = Node::create("c")->addComponent(Transform::create());
+
+	root->addChild(a);
+	a->addChild(b);
+	a->addChild(c);
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	a->removeChild(b);
+	a->component<Transform>()->matrix()->appendTranslation(1.f, 0.f, 0.f);
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	ASSERT_TRUE(b->component<Transform>()->modelToWorld(Vector3::create())->equals(Vector3::create(0.f, 0.f, 0.f)));
+	ASSERT_TRUE(c->component<Transform>()->modelToWorld(Vector3::create())->equals(Vector3::create(1.f, 0.f, 0.f)));
+}
+
+TEST_F(TransformTest, AddRemoveSubtrees)
+{
+	const auto numGroups = 50u;
+	const auto numNodesPerGroup = 20u;
+	const auto numIterations = 5u;
+
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto root = Node::create()->addComponent(sceneManager);
+	auto createGroup = [&](float x)
+	{
+		auto group = Node::create()->addComponent(Transform::create(Matrix4x4::create()->appendTranslation(x, 0.f, 0.f)));
+
+		for (auto i = 0u; i < numNodesPerGroup; ++i)
+			group->addChild(Node::create()->addComponent(Transform::create(Matrix4x4::create()->appendTranslation(0.f, float(i), 0.f))));
+
+		return group;
+	};
+
+	for (auto i = 0u; i < numGroups; ++i)
+		root->addChild(createGroup(float(i)));
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	auto group = createGroup(-1.f);
+
+	for (auto i = 0u; i < numIterations; ++i)
+	{
+		root->addChild(group);
+		group->component<Transform>()->matrix()->appendTranslation(0.f, 0.f, 1.f);
+		sceneManager->nextFrame(0.0f, 0.0f);
+
+		ASSERT_TRUE(group->children()[10]->component<Transform>()->modelToWorld(Vector3::create())->equals(Vector3::create(-1.f, 10.f, float(i + 1))));
+
+		root->removeChild(group);
+		sceneManager->nextFrame(0.0f, 0.0f);
+
+		// the other subtrees are still updated once the removed one left the root's lists
+		root->children()[numGroups - 1]->component<Transform>()->matrix()->appendTranslation(0.f, 1.f, 0.f);
+		sceneManager->nextFrame(0.0f, 0.0f);
+
+		ASSERT_TRUE(root->children()[numGroups - 1]->children()[0]->component<Transform>()->modelToWorld(Vector3::create())->equals(Vector3::create(float(numGroups - 1), float(i + 1), 0.f)));
+	}
+}
+
+TEST_F(TransformTest, LargeHierarchyModelToWorld)
+{
+	const auto numChains = 300u;
+	const auto chainLength = 40u;
+
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto root = Node::create()->addComponent(sceneManager);
+	std::vector<Node::Ptr> leaves;
+
+	for (auto i = 0u; i < numChains; ++i)
+	{
+		auto parent = root;
+
+		for (auto j = 0u; j < chainLength; ++j)
+		{
+			auto node = Node::create()->addComponent(Transform::create(
+				Matrix4x4::create()->appendRotationY(.1f * float(i % 7))->appendTranslation(float(i), 1.f, 0.f)
+			));
+
+			parent->addChild(node);
+			parent = node;
+		}
+		leaves.push_back(parent);
+	}
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	// move every other chain root so that only part of the hierarchy is dirty
+	for (auto i = 0u; i < numChains; i += 2)
+		root->children()[i]->component<Transform>()->matrix()->appendTranslation(0.f, 0.f, 2.f);
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	for (auto leaf : leaves)
+	{
+		auto expected = Matrix4x4::create();
+
+		for (auto node = leaf; node != root; node = node->parent())
+			expected->append(node->component<Transform>()->matrix());
+
+		auto& actual = leaf->component<Transform>()->modelToWorldMatrix()->data();
+
+		for (auto i = 0u; i < 16; ++i)
+			ASSERT_NEAR(expected->data()[i], actual[i], 1e-3f * std::max(1.f, std::abs(expected->data()[i])));
+	}
+}
+
+TEST_F(TransformTest, AnimatedHierarchy)
+{
+	const auto numSkeletons = 20u;
+	const auto numBonesPerLevel = 9u;
+	const auto numLevels = 11u;
+	const auto numFrames = 5u;
+
+	auto sceneManager = SceneManager::create(MinkoTests::canvas());
+	auto root = Node::create()->addComponent(sceneManager);
+	std::vector<Matrix4x4::Ptr> bones;
+	std::vector<Node::Ptr> leaves;
+
+	// skeletons of 100 bones: a root with 9 chains of 11 bones
+	for (auto i = 0u; i < numSkeletons; ++i)
+	{
+		auto skeleton = Node::create()->addComponent(Transform::create(Matrix4x4::create()->appendTranslation(float(i), 0.f, 0.f)));
+
+		for (auto j = 0u; j < numBonesPerLevel; ++j)
+		{
+			auto parent = skeleton;
+
+			for (auto k = 0u; k < numLevels; ++k)
+			{
+				auto bone = Node::create()->addComponent(Transform::create());
+
+				bones.push_back(bone->component<Transform>()->matrix());
+				parent->addChild(bone);
+				parent = bone;
+			}
+			leaves.push_back(parent);
+		}
+		root->addChild(skeleton);
+	}
+	sceneManager->nextFrame(0.0f, 0.0f);
+
+	for (auto frame = 0u; frame < numFrames; ++frame)
+	{
+		for (auto& bone : bones)
+			bone->identity()->appendRotationZ(.01f * float(frame))->appendTranslation(0.f, 1.f, 0.f);
+
+		sceneManager->nextFrame(0.0f, 0.0f);
+
+		for (auto leaf : leaves)
+		{
+			auto expected = Matrix4x4::create();
+
+			for (auto node = leaf; node != root; node = node->parent())
+				expected->append(node->component<Transform>()->matrix());
+
+			auto& actual = leaf->component<Transform>()->modelToWorldMatrix()->data();
+
+			for (auto i = 0u; i < 16; ++i)
+				ASSERT_NEAR(expected->data()[i], actual[i], 1e-3f * std::max(1.f, std::abs(expected->data()[i])));
+		}
+	}
+}
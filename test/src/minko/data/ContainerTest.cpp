@@ -247,3 +247,53 @@ TEST_F(ContainerTest, ArrayRemoveAdd)
 	ASSERT_TRUE(c->hasProvider(array2));
 	ASSERT_FALSE(c->hasProvider(array3));
 }
+
+TEST_F(ContainerTest, GetSetWithPropertyId)
+{
+	auto c = Container::create();
+	auto p = Provider::create();
+	PropertyId foo("foo");
+
+	p->set(foo, 42);
+	c->addProvider(p);
+
+	ASSERT_TRUE(c->hasProperty(foo));
+	ASSERT_EQ(c->get<int>(foo), 42);
+
+	c->set<int>(foo, 23);
+
+	ASSERT_EQ(p->get<int>("foo"), 23);
+	ASSERT_EQ(c->get<int>("foo"), 23);
+}
+
+TEST_F(ContainerTest, ArrayPropertyValueChangedAfterIndexChanged)
+{
+	auto array1 = ArrayProvider::create("array");
+	auto array2 = ArrayProvider::create("array");
+	auto c = Container::create();
+	int v = 0;
+
+	array1->set("foo", 1);
+	array2->set("foo", 2);
+
+	c->addProvider(array1);
+	c->addProvider(array2);
+
+	auto _ = c->propertyValueChanged("array[1].foo")->connect(
+		[&](Container::Ptr container, const std::string& propertyName)
+		{
+			v = container->get<int>(propertyName);
+		}
+	);
+
+	array2->set("foo", 3);
+	ASSERT_EQ(v, 3);
+
+	// array2 moves to index 0
+	c->removeProvider(array1);
+	array2->set("foo", 4);
+
+	ASSERT_EQ(v, 3);
+	ASSERT_EQ(c->get<int>("array[0].foo"), 4);
+	ASSERT_FALSE(c->hasProperty("array[1].foo"));
+}
@@ -0,0 +1,98 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "PropertyIdMapTest.hpp"
+
+using namespace minko;
+using namespace minko::data;
+
+TEST_F(PropertyIdMapTest, InsertFind)
+{
+	PropertyIdMap<int> map;
+	PropertyId foo("foo");
+	PropertyId bar("bar");
+
+	ASSERT_TRUE(map.empty());
+	ASSERT_TRUE(map.find(foo) == map.end());
+
+	map[foo] = 42;
+	map[bar] = 23;
+
+	ASSERT_EQ(map.size(), 2u);
+	ASSERT_EQ(map.count(foo), 1u);
+	ASSERT_EQ(map.find(foo)->second, 42);
+	ASSERT_EQ(map.find(bar)->second, 23);
+	ASSERT_EQ(map.count(PropertyId("baz")), 0u);
+}
+
+TEST_F(PropertyIdMapTest, ManyEntries)
+{
+	const auto numEntries = 1000;
+	PropertyIdMap<int> map;
+
+	for (auto i = 0; i < numEntries; ++i)
+		map[PropertyId("propertyIdMapTest" + std::to_string(i))] = i;
+
+	ASSERT_EQ(map.size(), uint(numEntries));
+	for (auto i = 0; i < numEntries; ++i)
+		ASSERT_EQ(map.find(PropertyId("propertyIdMapTest" + std::to_string(i)))->second, i);
+}
+
+TEST_F(PropertyIdMapTest, Erase)
+{
+	const auto numEntries = 1000;
+	PropertyIdMap<int> map;
+
+	for (auto i = 0; i < numEntries; ++i)
+		map[PropertyId("propertyIdMapTest" + std::to_string(i))] = i;
+
+	for (auto i = 0; i < numEntries; i += 3)
+		ASSERT_EQ(map.erase(PropertyId("propertyIdMapTest" + std::to_string(i))), 1u);
+	ASSERT_EQ(map.erase(PropertyId("propertyIdMapTest0")), 0u);
+
+	for (auto i = 0; i < numEntries; ++i)
+	{
+		auto it = map.find(PropertyId("propertyIdMapTest" + std::to_string(i)));
+
+		if (i % 3 == 0)
+			ASSERT_TRUE(it == map.end());
+		else
+			ASSERT_EQ(it->second, i);
+	}
+
+	ASSERT_EQ(map.size(), uint(numEntries - (numEntries + 2) / 3));
+	ASSERT_EQ(std::distance(map.begin(), map.end()), int(map.size()));
+}
+
+TEST_F(PropertyIdMapTest, Copy)
+{
+	PropertyIdMap<std::string> map;
+	PropertyId foo("foo");
+
+	map[foo] = "bar";
+
+	auto copy = map;
+
+	copy[foo] = "baz";
+	copy[PropertyId("qux")] = "quux";
+
+	ASSERT_EQ(map.size(), 1u);
+	ASSERT_EQ(map.find(foo)->second, "bar");
+	ASSERT_EQ(copy.find(foo)->second, "baz");
+}
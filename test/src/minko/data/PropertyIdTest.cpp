@@ -0,0 +1,75 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "PropertyIdTest.hpp"
+
+using namespace minko;
+using namespace minko::data;
+
+TEST_F(PropertyIdTest, SameNameSameId)
+{
+	PropertyId a("transform.modelToWorldMatrix");
+	PropertyId b(std::string("transform.") + "modelToWorldMatrix");
+
+	ASSERT_EQ(a, b);
+	ASSERT_EQ(a.id(), b.id());
+	ASSERT_EQ(&a.name(), &b.name());
+}
+
+TEST_F(PropertyIdTest, DifferentNamesDifferentIds)
+{
+	PropertyId a("material[0].diffuseColor");
+	PropertyId b("material[1].diffuseColor");
+
+	ASSERT_NE(a, b);
+	ASSERT_EQ(a.name(), "material[0].diffuseColor");
+	ASSERT_EQ(b.name(), "material[1].diffuseColor");
+}
+
+TEST_F(PropertyIdTest, DefaultIsEmptyName)
+{
+	PropertyId a;
+
+	ASSERT_EQ(a, PropertyId(""));
+	ASSERT_TRUE(a.name().empty());
+}
+
+TEST_F(PropertyIdTest, InternFromThreads)
+{
+	const uint numThreads = 4;
+	const uint numNames = 1000;
+	std::vector<std::vector<uint>> ids(numThreads);
+	std::vector<std::thread> threads;
+
+	for (uint i = 0; i < numThreads; ++i)
+		threads.push_back(std::thread([&, i]()
+		{
+			for (uint j = 0; j < numNames; ++j)
+				ids[i].push_back(PropertyId("propertyIdTest" + std::to_string(j)).id());
+		}));
+
+	for (auto& thread : threads)
+		thread.join();
+
+	for (uint i = 1; i < numThreads; ++i)
+		ASSERT_EQ(ids[i], ids[0]);
+
+	for (uint j = 0; j < numNames; ++j)
+		ASSERT_EQ(PropertyId("propertyIdTest" + std::to_string(j)).id(), ids[0][j]);
+}
@@ -177,3 +177,121 @@ TEST_F(ProviderTest, Swap)
 	ASSERT_EQ(vFoo, 24);
 	ASSERT_EQ(vBar, 42);
 }
+
+TEST_F(ProviderTest, SetFloatManyTimes)
+{
+	const auto numProperties = 16u;
+	const auto numIterations = 1000u;
+
+	auto p = Provider::create();
+	std::vector<PropertyId> propertyIds;
+
+	for (auto i = 0u; i < numProperties; ++i)
+	{
+		propertyIds.push_back(PropertyId("float" + std::to_string(i)));
+		p->set(propertyIds.back(), 0.f);
+	}
+
+	for (auto i = 0u; i < numIterations; ++i)
+		p->set(propertyIds[i % numProperties], float(i));
+
+	ASSERT_EQ(p->propertyNames().size(), numProperties);
+	for (auto i = 0u; i < numProperties; ++i)
+		ASSERT_EQ(p->get<float>(propertyIds[i]), float(numIterations - numProperties + i));
+}
+
+TEST_F(ProviderTest, CloneMaterial)
+{
+	const auto numClones = 100u;
+
+	auto source = material::BasicMaterial::create();
+
+	source
+		->fogColor(0xff0000ff)
+		->fogDensity(0.1f)
+		->fogStart(1.f)
+		->fogEnd(100.f)
+		->fogType(render::FogType::Linear)
+		->blendingMode(render::Blending::Mode::ALPHA)
+		->depthMask(true)
+		->depthFunction(render::CompareMode::LESS)
+		->triangleCulling(render::TriangleCulling::BACK)
+		->priority(render::Priority::TRANSPARENT)
+		->zSorted(true);
+
+	std::vector<material::Material::Ptr> clones;
+
+	for (auto i = 0u; i < numClones; ++i)
+		clones.push_back(material::Material::create(source));
+
+	// the clones own their values: changing one of them leaves the source and the other clones untouched
+	clones.front()->set("fogDensity", 0.5f);
+
+	ASSERT_EQ(clones.back()->propertyNames(), source->propertyNames());
+	ASSERT_EQ(clones.back()->get<float>("fogDensity"), 0.1f);
+	ASSERT_EQ(clones.front()->get<float>("fogDensity"), 0.5f);
+	ASSERT_EQ(source->get<float>("fogDensity"), 0.1f);
+}
+
+// opt-in: run with --gtest_also_run_disabled_tests --gtest_filter=*Benchmark*
+TEST_F(ProviderTest, DISABLED_SetFloatBenchmark)
+{
+	const auto numProperties = 16u;
+	const auto numIterations = 100000u;
+
+	auto p = Provider::create();
+	std::vector<PropertyId> propertyIds;
+
+	for (auto i = 0u; i < numProperties; ++i)
+	{
+		propertyIds.push_back(PropertyId("float" + std::to_string(i)));
+		p->set(propertyIds.back(), 0.f);
+	}
+
+	auto start = std::chrono::high_resolution_clock::now();
+
+	for (auto i = 0u; i < numIterations; ++i)
+		p->set(propertyIds[i % numProperties], float(i));
+
+	auto duration = std::chrono::duration<double, std::nano>(std::chrono::high_resolution_clock::now() - start);
+
+	RecordProperty("nsPerSetFloat", std::to_string(duration.count() / numIterations));
+
+	ASSERT_EQ(p->get<float>(propertyIds[(numIterations - 1) % numProperties]), float(numIterations - 1));
+}
+
+TEST_F(ProviderTest, DISABLED_CloneMaterialBenchmark)
+{
+	const auto numClones = 10000u;
+
+	auto source = material::BasicMaterial::create();
+
+	source
+		->fogColor(0xff0000ff)
+		->fogDensity(0.1f)
+		->fogStart(1.f)
+		->fogEnd(100.f)
+		->fogType(render::FogType::Linear)
+		->blendingMode(render::Blending::Mode::ALPHA)
+		->depthMask(true)
+		->depthFunction(render::CompareMode::LESS)
+		->triangleCulling(render::TriangleCulling::BACK)
+		->priority(render::Priority::TRANSPARENT)
+		->zSorted(true);
+
+	std::vector<material::Material::Ptr> clones;
+
+	clones.reserve(numClones);
+
+	auto start = std::chrono::high_resolution_clock::now();
+
+	for (auto i = 0u; i < numClones; ++i)
+		clones.push_back(material::Material::create(source));
+
+	auto duration = std::chrono::duration<double, std::micro>(std::chrono::high_resolution_clock::now() - start);
+
+	RecordProperty("usPerMaterialClone", std::to_string(duration.count() / numClones));
+	RecordProperty("numProperties", int(source->propertyNames().size()));
+
+	ASSERT_EQ(clones.back()->propertyNames(), source->propertyNames());
+}
@@ -0,0 +1,274 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "LoaderTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::file;
+
+namespace
+{
+	// Records the chunks it receives.
+	class StreamedParser :
+		public AbstractParser
+	{
+	public:
+		static std::vector<uint>	chunkSizes;
+		static std::vector<uint>	parsedSizes;
+		static AbstractParser*		chunkParser;
+		static AbstractParser*		completeParser;
+
+		static
+		std::shared_ptr<StreamedParser>
+		create()
+		{
+			return std::shared_ptr<StreamedParser>(new StreamedParser());
+		}
+
+		bool
+		streamable()
+		{
+			return true;
+		}
+
+		void
+		parseChunk(const std::string&				filename,
+				   const std::string&				resolvedFilename,
+				   std::shared_ptr<Options>			options,
+				   const unsigned char*				data,
+				   uint								size,
+				   std::shared_ptr<AssetLibrary>	assetLibrary)
+		{
+			chunkSizes.push_back(size);
+			chunkParser = this;
+		}
+
+		void
+		parse(const std::string&				filename,
+			  const std::string&				resolvedFilename,
+			  std::shared_ptr<Options>			options,
+			  const std::vector<unsigned char>&	data,
+			  std::shared_ptr<AssetLibrary>		assetLibrary)
+		{
+			parsedSizes.push_back(data.size());
+			completeParser = this;
+
+			complete()->execute(shared_from_this());
+		}
+	};
+
+	std::vector<uint>	StreamedParser::chunkSizes;
+	std::vector<uint>	StreamedParser::parsedSizes;
+	AbstractParser*		StreamedParser::chunkParser = nullptr;
+	AbstractParser*		StreamedParser::completeParser = nullptr;
+
+	// Fails to decode any file.
+	class InvalidParser :
+		public AbstractParser
+	{
+	public:
+		static
+		std::shared_ptr<InvalidParser>
+		create()
+		{
+			return std::shared_ptr<InvalidParser>(new InvalidParser());
+		}
+
+		bool
+		decodable()
+		{
+			return true;
+		}
+
+		void
+		decode(const std::string&				filename,
+			   const std::string&				resolvedFilename,
+			   std::shared_ptr<Options>			options,
+			   const unsigned char*				data,
+			   uint								size)
+		{
+			throw std::runtime_error("invalid data");
+		}
+
+		void
+		parse(const std::string&				filename,
+			  const std::string&				resolvedFilename,
+			  std::shared_ptr<Options>			options,
+			  const std::vector<unsigned char>&	data,
+			  std::shared_ptr<AssetLibrary>		assetLibrary)
+		{
+			decode(filename, resolvedFilename, options, data.data(), data.size());
+		}
+	};
+
+	std::vector<unsigned char>
+	writeFile(const std::string& filename, uint size)
+	{
+		std::vector<unsigned char> content(size);
+
+		for (auto i = 0u; i < size; ++i)
+			content[i] = (unsigned char)(i * 13);
+
+		std::ofstream file(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+
+		file.write((const char*)content.data(), content.size());
+
+		return content;
+	}
+
+	bool
+	pollUntil(async::TaskScheduler::Ptr scheduler, const bool& done)
+	{
+		auto start = std::chrono::steady_clock::now();
+
+		while (!done && std::chrono::steady_clock::now() - start < std::chrono::seconds(10))
+		{
+			scheduler->pollMainThread();
+			std::this_thread::yield();
+		}
+
+		return done;
+	}
+}
+
+TEST_F(LoaderTest, ParseAsynchronously)
+{
+	auto assets = component::SceneManager::create(MinkoTests::canvas())->assets();
+	auto scheduler = assets->loader()->options()->taskScheduler();
+
+	if (scheduler->numThreads() == 0)
+	{
+		scheduler = async::TaskScheduler::create(1);
+		assets->loader()->options()->taskScheduler(scheduler);
+	}
+
+	auto complete = false;
+	auto _ = assets->loader()->complete()->connect([&](Loader::Ptr) { complete = true; });
+
+	assets->loader()->options()->parseAsynchronously(true);
+	assets->loader()->queue("effect/Basic.effect")->load();
+
+	// the effect is only created once the main thread is polled
+	ASSERT_FALSE(complete);
+	ASSERT_EQ(assets->effect("effect/Basic.effect"), nullptr);
+	ASSERT_TRUE(pollUntil(scheduler, complete));
+	ASSERT_NE(assets->effect("effect/Basic.effect"), nullptr);
+}
+
+TEST_F(LoaderTest, ParseAsynchronouslyWithoutThreads)
+{
+	auto assets = component::SceneManager::create(MinkoTests::canvas())->assets();
+	auto complete = false;
+	auto _ = assets->loader()->complete()->connect([&](Loader::Ptr) { complete = true; });
+
+	assets->loader()->options()
+		->taskScheduler(async::TaskScheduler::create(0))
+		->parseAsynchronously(true);
+	assets->loader()->queue("effect/Basic.effect")->load();
+
+	ASSERT_TRUE(complete);
+	ASSERT_NE(assets->effect("effect/Basic.effect"), nullptr);
+}
+
+TEST_F(LoaderTest, CompleteAfterAsynchronousDecodeError)
+{
+	auto assets = component::SceneManager::create(MinkoTests::canvas())->assets();
+	auto scheduler = async::TaskScheduler::create(1);
+	auto complete = false;
+	auto numErrors = 0;
+	auto _ = assets->loader()->complete()->connect([&](Loader::Ptr) { complete = true; });
+	auto __ = assets->loader()->error()->connect([&](Loader::Ptr, const Error&) { ++numErrors; });
+
+	writeFile("loader-test.invalid", 100);
+	assets->loader()->options()
+		->taskScheduler(scheduler)
+		->parseAsynchronously(true)
+		->registerParser<InvalidParser>("invalid");
+	assets->loader()->queue("loader-test.invalid")->load();
+
+	ASSERT_TRUE(pollUntil(scheduler, complete));
+	ASSERT_EQ(numErrors, 1);
+}
+
+TEST_F(LoaderTest, StreamFile)
+{
+	auto assets = component::SceneManager::create(MinkoTests::canvas())->assets();
+	auto complete = false;
+	auto _ = assets->loader()->complete()->connect([&](Loader::Ptr) { complete = true; });
+
+	StreamedParser::chunkSizes.clear();
+	StreamedParser::parsedSizes.clear();
+
+	writeFile("loader-test.streamed", 20000);
+	assets->loader()->options()
+		->streamFiles(true)
+		->registerParser<StreamedParser>("streamed");
+	assets->loader()->queue("loader-test.streamed")->load();
+
+	// 20 kB are read in 8 kB chunks
+	ASSERT_TRUE(complete);
+	ASSERT_EQ(StreamedParser::chunkSizes, std::vector<uint>({ 8192, 16384, 20000 }));
+	ASSERT_EQ(StreamedParser::parsedSizes, std::vector<uint>({ 20000 }));
+	ASSERT_EQ(StreamedParser::chunkParser, StreamedParser::completeParser);
+}
+
+TEST_F(LoaderTest, StreamMemoryMappedFile)
+{
+	auto assets = component::SceneManager::create(MinkoTests::canvas())->assets();
+	auto complete = false;
+	auto _ = assets->loader()->complete()->connect([&](Loader::Ptr) { complete = true; });
+
+	StreamedParser::chunkSizes.clear();
+	StreamedParser::parsedSizes.clear();
+
+	writeFile("loader-test.streamed", 20000);
+	assets->loader()->options()
+		->streamFiles(true)
+		->memoryMapFiles(true)
+		->registerParser<StreamedParser>("streamed");
+	assets->loader()->queue("loader-test.streamed")->load();
+
+	// the mapping is read in place, in the same chunks as a regular file
+	ASSERT_TRUE(complete);
+	ASSERT_TRUE(assets->loader()->files().at("loader-test.streamed")->memoryMapped());
+	ASSERT_EQ(StreamedParser::chunkSizes, std::vector<uint>({ 8192, 16384, 20000 }));
+	ASSERT_EQ(StreamedParser::parsedSizes, std::vector<uint>({ 20000 }));
+}
+
+TEST_F(LoaderTest, StreamFileWithoutStreamableParser)
+{
+	auto assets = component::SceneManager::create(MinkoTests::canvas())->assets();
+	auto content = writeFile("loader-test.bin", 20000);
+	auto numChunks = 0;
+
+	assets->loader()->options()->streamFiles(true);
+
+	auto protocol = assets->loader()->options()->getProtocol("file");
+	auto _ = protocol->chunk()->connect([&](AbstractProtocol::Ptr, uint offset, uint size) { ++numChunks; });
+
+	protocol->load("loader-test.bin", "loader-test.bin", assets->loader()->options());
+	assets->loader()->queue("loader-test.bin")->load();
+
+	ASSERT_EQ(numChunks, 3);
+	ASSERT_EQ(protocol->file()->data(), content);
+	ASSERT_EQ(assets->blob("loader-test.bin"), content);
+}
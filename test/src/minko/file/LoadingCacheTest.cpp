@@ -0,0 +1,257 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "LoadingCacheTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::file;
+
+namespace
+{
+	void
+	writeFile(const std::string& filename, uint size, unsigned char value)
+	{
+		std::ofstream file(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+
+		file.write(std::vector<char>(size, (char)value).data(), size);
+	}
+
+	// Completes its loads only when told to, to keep requests in flight.
+	class DeferredProtocol :
+		public AbstractProtocol
+	{
+	public:
+		typedef std::shared_ptr<DeferredProtocol> Ptr;
+
+		static std::list<Ptr> loading;
+
+		static
+		Ptr
+		create()
+		{
+			return std::shared_ptr<DeferredProtocol>(new DeferredProtocol());
+		}
+
+		void
+		load()
+		{
+			loading.push_back(std::static_pointer_cast<DeferredProtocol>(shared_from_this()));
+		}
+
+		bool
+		fileExists(const std::string& filename)
+		{
+			return true;
+		}
+
+		void
+		finish(const std::vector<unsigned char>& content)
+		{
+			data() = content;
+
+			_complete->execute(shared_from_this());
+		}
+
+		void
+		fail()
+		{
+			_error->execute(shared_from_this());
+		}
+	};
+
+	std::list<DeferredProtocol::Ptr> DeferredProtocol::loading;
+}
+
+TEST_F(LoadingCacheTest, SecondLoadIsAHit)
+{
+	auto cache = LoadingCache::create();
+	auto options = AssetLibrary::create(MinkoTests::canvas()->context())->loader()->options();
+
+	options->loadingCache(cache);
+	writeFile("loading-cache-test.bin", 100, 1);
+
+	auto loader1 = Loader::create(options);
+
+	loader1->queue("loading-cache-test.bin")->load();
+
+	// the second loader must not read the file again
+	writeFile("loading-cache-test.bin", 100, 2);
+
+	auto loader2 = Loader::create(options);
+	auto complete = false;
+	auto _ = loader2->complete()->connect([&](Loader::Ptr) { complete = true; });
+
+	loader2->queue("loading-cache-test.bin")->load();
+
+	auto file = loader2->files().at("loading-cache-test.bin");
+
+	ASSERT_TRUE(complete);
+	ASSERT_EQ(file->filename(), "loading-cache-test.bin");
+	ASSERT_EQ(file->data(), std::vector<unsigned char>(100, 1));
+	ASSERT_EQ(file->bytes(), loader1->files().at("loading-cache-test.bin")->bytes());
+	ASSERT_EQ(cache->numMisses(), 1);
+	ASSERT_EQ(cache->numHits(), 1);
+	ASSERT_EQ(cache->size(), 100);
+}
+
+TEST_F(LoadingCacheTest, RangesAreCachedSeparately)
+{
+	auto cache = LoadingCache::create();
+	auto options = AssetLibrary::create(MinkoTests::canvas()->context())->loader()->options();
+
+	options->loadingCache(cache);
+	writeFile("loading-cache-test.bin", 100, 1);
+
+	auto loader1 = Loader::create(options);
+
+	loader1->queue("loading-cache-test.bin")->load();
+
+	auto loader2 = Loader::create(options);
+	auto complete = false;
+	auto _ = loader2->complete()->connect([&](Loader::Ptr) { complete = true; });
+
+	// reading a range of the file must not return the cached whole file
+	loader2
+		->queue("loading-cache-test.bin", options->clone()->seekingOffset(10)->seekedLength(20))
+		->load();
+
+	ASSERT_TRUE(complete);
+	ASSERT_EQ(loader2->files().at("loading-cache-test.bin")->data(), std::vector<unsigned char>(20, 1));
+	ASSERT_EQ(cache->numMisses(), 2);
+	ASSERT_EQ(cache->numHits(), 0);
+	ASSERT_TRUE(cache->hasFile(LoadingCache::key(loader1->files().at("loading-cache-test.bin")->resolvedFilename(), 10, 20)));
+	ASSERT_EQ(cache->size(), 120);
+}
+
+TEST_F(LoadingCacheTest, ConcurrentRequestsAreCoalesced)
+{
+	auto cache = LoadingCache::create();
+	auto options = AssetLibrary::create(MinkoTests::canvas()->context())->loader()->options();
+
+	options->loadingCache(cache);
+	options->registerProtocol<DeferredProtocol>("deferred");
+
+	auto numComplete = 0;
+	auto loader1 = Loader::create(options);
+	auto loader2 = Loader::create(options);
+	auto _1 = loader1->complete()->connect([&](Loader::Ptr) { ++numComplete; });
+	auto _2 = loader2->complete()->connect([&](Loader::Ptr) { ++numComplete; });
+
+	loader1->queue("deferred://loading-cache-test.bin")->load();
+	loader2->queue("deferred://loading-cache-test.bin")->load();
+
+	ASSERT_EQ(DeferredProtocol::loading.size(), 1);
+	ASSERT_TRUE(cache->loading(DeferredProtocol::loading.front()->file()->resolvedFilename()));
+	ASSERT_EQ(cache->numCoalescedRequests(), 1);
+	ASSERT_EQ(numComplete, 0);
+
+	DeferredProtocol::loading.front()->finish(std::vector<unsigned char>(10, 3));
+	DeferredProtocol::loading.clear();
+
+	ASSERT_EQ(numComplete, 2);
+	ASSERT_EQ(loader2->files().at("deferred://loading-cache-test.bin")->data(), std::vector<unsigned char>(10, 3));
+	ASSERT_EQ(cache->numMisses(), 1);
+	ASSERT_EQ(cache->numHits(), 0);
+}
+
+TEST_F(LoadingCacheTest, FailedLoadFailsCoalescedRequests)
+{
+	auto cache = LoadingCache::create();
+	auto options = AssetLibrary::create(MinkoTests::canvas()->context())->loader()->options();
+
+	options->loadingCache(cache);
+	options->registerProtocol<DeferredProtocol>("deferred");
+
+	auto numErrors = 0;
+	auto numComplete = 0;
+	auto loader1 = Loader::create(options);
+	auto loader2 = Loader::create(options);
+	auto _1 = loader1->error()->connect([&](Loader::Ptr, const Error&) { ++numErrors; });
+	auto _2 = loader2->error()->connect([&](Loader::Ptr, const Error&) { ++numErrors; });
+	auto _3 = loader1->complete()->connect([&](Loader::Ptr) { ++numComplete; });
+	auto _4 = loader2->complete()->connect([&](Loader::Ptr) { ++numComplete; });
+
+	loader1->queue("deferred://loading-cache-test.bin")->load();
+	loader2->queue("deferred://loading-cache-test.bin")->load();
+
+	DeferredProtocol::loading.front()->fail();
+	DeferredProtocol::loading.clear();
+
+	// both loaders still complete once their failed file is given up
+	ASSERT_EQ(numErrors, 2);
+	ASSERT_EQ(numComplete, 2);
+	ASSERT_EQ(cache->numFiles(), 0);
+}
+
+TEST_F(LoadingCacheTest, LeastRecentlyUsedFilesAreEvicted)
+{
+	auto cache = LoadingCache::create(250);
+	auto options = AssetLibrary::create(MinkoTests::canvas()->context())->loader()->options();
+
+	options->loadingCache(cache);
+	writeFile("loading-cache-test-1.bin", 100, 1);
+	writeFile("loading-cache-test-2.bin", 100, 2);
+	writeFile("loading-cache-test-3.bin", 100, 3);
+
+	Loader::create(options)->queue("loading-cache-test-1.bin")->queue("loading-cache-test-2.bin")->load();
+	// makes the first file the most recently used one
+	Loader::create(options)->queue("loading-cache-test-1.bin")->load();
+	Loader::create(options)->queue("loading-cache-test-3.bin")->load();
+
+	auto resolved = [&](const std::string& filename)
+	{
+		return options->uriFunction()(File::sanitizeFilename(filename));
+	};
+
+	ASSERT_EQ(cache->size(), 200);
+	ASSERT_TRUE(cache->hasFile(resolved("loading-cache-test-1.bin")));
+	ASSERT_FALSE(cache->hasFile(resolved("loading-cache-test-2.bin")));
+	ASSERT_TRUE(cache->hasFile(resolved("loading-cache-test-3.bin")));
+
+	cache->budget(150);
+
+	ASSERT_EQ(cache->size(), 100);
+	ASSERT_FALSE(cache->hasFile(resolved("loading-cache-test-1.bin")));
+}
+
+TEST_F(LoadingCacheTest, ExistingAssetsAreNotParsedAgain)
+{
+	auto assets = component::SceneManager::create(MinkoTests::canvas())->assets();
+	auto cache = LoadingCache::create();
+
+	assets->loader()->options()->loadingCache(cache);
+	assets->loader()->queue("effect/Basic.effect")->load();
+
+	auto effect = assets->effect("effect/Basic.effect");
+
+	ASSERT_NE(effect, nullptr);
+	ASSERT_TRUE(assets->hasAsset("effect/Basic.effect"));
+
+	auto numHits = cache->numHits();
+	auto loader = Loader::create(assets->loader());
+
+	loader->queue("effect/Basic.effect")->load();
+
+	ASSERT_EQ(assets->effect("effect/Basic.effect"), effect);
+	ASSERT_EQ(cache->numHits(), numHits + 1);
+	ASSERT_FALSE(loader->loading());
+}
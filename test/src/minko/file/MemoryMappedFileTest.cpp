@@ -0,0 +1,103 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "MemoryMappedFileTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::file;
+
+namespace
+{
+	std::vector<unsigned char>
+	writeFile(const std::string& filename, uint size)
+	{
+		std::vector<unsigned char> content(size);
+
+		for (auto i = 0u; i < size; ++i)
+			content[i] = (unsigned char)(i * 7 + i / 256);
+
+		std::ofstream file(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+
+		file.write((const char*)content.data(), content.size());
+
+		return content;
+	}
+}
+
+TEST_F(MemoryMappedFileTest, MapWholeFile)
+{
+	auto content = writeFile("memory-mapped-file-test.bin", 10000);
+	auto mappedFile = MemoryMappedFile::create("memory-mapped-file-test.bin");
+
+	ASSERT_NE(mappedFile, nullptr);
+	ASSERT_EQ(mappedFile->size(), content.size());
+	ASSERT_EQ(std::vector<unsigned char>(mappedFile->data(), mappedFile->data() + mappedFile->size()), content);
+}
+
+TEST_F(MemoryMappedFileTest, MapRange)
+{
+	auto content = writeFile("memory-mapped-file-test.bin", 10000);
+	auto mappedFile = MemoryMappedFile::create("memory-mapped-file-test.bin", 5003, 100);
+
+	ASSERT_NE(mappedFile, nullptr);
+	ASSERT_EQ(mappedFile->size(), 100);
+	ASSERT_EQ(
+		std::vector<unsigned char>(mappedFile->data(), mappedFile->data() + mappedFile->size()),
+		std::vector<unsigned char>(content.begin() + 5003, content.begin() + 5103)
+	);
+}
+
+TEST_F(MemoryMappedFileTest, MapInvalidRange)
+{
+	writeFile("memory-mapped-file-test.bin", 100);
+
+	ASSERT_EQ(MemoryMappedFile::create("memory-mapped-file-test.bin", 100), nullptr);
+	ASSERT_EQ(MemoryMappedFile::create("memory-mapped-file-test.bin", 50, 51), nullptr);
+	ASSERT_EQ(MemoryMappedFile::create("memory-mapped-file-test-missing.bin"), nullptr);
+}
+
+TEST_F(MemoryMappedFileTest, LoadBlob)
+{
+	auto content = writeFile("memory-mapped-file-test.bin", 10000);
+	auto assets = component::SceneManager::create(MinkoTests::canvas())->assets();
+
+	assets->loader()->options()->memoryMapFiles(true);
+	assets->loader()->queue("memory-mapped-file-test.bin")->load();
+
+	auto file = assets->loader()->files().at("memory-mapped-file-test.bin");
+
+	ASSERT_TRUE(file->memoryMapped());
+	ASSERT_EQ(file->size(), content.size());
+	ASSERT_EQ(assets->blob("memory-mapped-file-test.bin"), content);
+}
+
+TEST_F(MemoryMappedFileTest, LoadEffect)
+{
+	auto sceneManager = component::SceneManager::create(MinkoTests::canvas());
+	auto assets = sceneManager->assets();
+
+	assets->loader()->options()->memoryMapFiles(true);
+	assets->loader()->queue("effect/Basic.effect")->load();
+
+	ASSERT_TRUE(assets->loader()->files().at("effect/Basic.effect")->memoryMapped());
+	ASSERT_NE(assets->effect("effect/Basic.effect"), nullptr);
+}
@@ -0,0 +1,192 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "BoundingVolumeHierarchyTest.hpp"
+
+#include "minko/MinkoTests.hpp"
+
+using namespace minko;
+using namespace minko::geometry;
+
+namespace
+{
+	// a size x size grid of squares on the z = 0 plane, 2 triangles each
+	void
+	createGrid(uint size, std::vector<float>& xyz, std::vector<unsigned short>& indices)
+	{
+		for (uint y = 0; y <= size; ++y)
+			for (uint x = 0; x <= size; ++x)
+			{
+				xyz.push_back(float(x));
+				xyz.push_back(float(y));
+				xyz.push_back(0.f);
+			}
+
+		for (uint y = 0; y < size; ++y)
+			for (uint x = 0; x < size; ++x)
+			{
+				unsigned short i = y * (size + 1) + x;
+
+				indices.insert(indices.end(), { i, (unsigned short)(i + 1), (unsigned short)(i + size + 2) });
+				indices.insert(indices.end(), { i, (unsigned short)(i + size + 2), (unsigned short)(i + size + 1) });
+			}
+	}
+}
+
+TEST_F(BoundingVolumeHierarchyTest, Build)
+{
+	std::vector<float> xyz;
+	std::vector<unsigned short> indices;
+
+	createGrid(64, xyz, indices);
+
+	auto bvh = BoundingVolumeHierarchy::create(&xyz[0], 3, indices);
+
+	ASSERT_EQ(64 * 64 * 2, bvh->numTriangles());
+	ASSERT_LT(bvh->numNodes(), bvh->numTriangles() / 2);
+	ASSERT_LE(bvh->depth(), 16u);
+}
+
+TEST_F(BoundingVolumeHierarchyTest, CastGrid)
+{
+	std::vector<float> xyz;
+	std::vector<unsigned short> indices;
+
+	createGrid(64, xyz, indices);
+
+	auto bvh = BoundingVolumeHierarchy::create(&xyz[0], 3, indices);
+	const float direction[3] = { 0.f, 0.f, -1.f };
+
+	for (uint y = 0; y < 64; ++y)
+		for (uint x = 0; x < 64; ++x)
+		{
+			// below the diagonal of each square, so in its first triangle
+			const float origin[3] = { x + .75f, y + .25f, 3.f };
+			auto distance = 0.f;
+			uint triangle = 0;
+			auto u = 0.f;
+			auto v = 0.f;
+
+			ASSERT_TRUE(bvh->cast(origin, direction, distance, triangle, u, v));
+			ASSERT_FLOAT_EQ(3.f, distance);
+			ASSERT_EQ((y * 64 + x) * 6, triangle);
+			ASSERT_FLOAT_EQ(.5f, u);
+			ASSERT_FLOAT_EQ(.25f, v);
+		}
+}
+
+TEST_F(BoundingVolumeHierarchyTest, CastRefitGrid)
+{
+	std::vector<float> xyz;
+	std::vector<unsigned short> indices;
+
+	createGrid(64, xyz, indices);
+
+	auto bvh = BoundingVolumeHierarchy::create(&xyz[0], 3, indices);
+	auto numNodes = bvh->numNodes();
+
+	// the grid moves 10 units along x and 1 unit up
+	for (uint i = 0; i < xyz.size(); i += 3)
+	{
+		xyz[i] += 10.f;
+		xyz[i + 2] = 1.f;
+	}
+
+	bvh->refit(&xyz[0], 3, indices);
+
+	const float direction[3] = { 0.f, 0.f, -1.f };
+
+	ASSERT_EQ(numNodes, bvh->numNodes());
+
+	for (uint y = 0; y < 64; ++y)
+		for (uint x = 0; x < 64; ++x)
+		{
+			const float origin[3] = { x + 10.75f, y + .25f, 3.f };
+			auto distance = 0.f;
+			uint triangle = 0;
+			auto u = 0.f;
+			auto v = 0.f;
+
+			ASSERT_TRUE(bvh->cast(origin, direction, distance, triangle, u, v));
+			ASSERT_FLOAT_EQ(2.f, distance);
+			ASSERT_EQ((y * 64 + x) * 6, triangle);
+		}
+}
+
+TEST_F(BoundingVolumeHierarchyTest, CastStackedTriangles)
+{
+	std::vector<float> xyz;
+	std::vector<unsigned short> indices;
+
+	// the same triangle 100 times at increasing depths, and 100 more at the same place
+	for (uint i = 0; i < 200; ++i)
+	{
+		const float z = i < 100 ? -float(i) : -50.f;
+
+		xyz.insert(xyz.end(), { 0.f, 0.f, z, 1.f, 0.f, z, 0.f, 1.f, z });
+		indices.insert(indices.end(), { (unsigned short)(i * 3), (unsigned short)(i * 3 + 1), (unsigned short)(i * 3 + 2) });
+	}
+
+	auto bvh = BoundingVolumeHierarchy::create(&xyz[0], 3, indices);
+	const float origin[3] = { .25f, .25f, -10.5f };
+	const float direction[3] = { 0.f, 0.f, -1.f };
+	auto distance = 0.f;
+	uint triangle = 0;
+	auto u = 0.f;
+	auto v = 0.f;
+
+	ASSERT_TRUE(bvh->cast(origin, direction, distance, triangle, u, v));
+	ASSERT_FLOAT_EQ(.5f, distance);
+	ASSERT_EQ(11 * 3, triangle);
+}
+
+TEST_F(BoundingVolumeHierarchyTest, CastAlongBoxPlanes)
+{
+	std::vector<float> xyz;
+	std::vector<unsigned short> indices;
+
+	createGrid(64, xyz, indices);
+
+	auto bvh = BoundingVolumeHierarchy::create(&xyz[0], 3, indices);
+	const float direction[3] = { 0.f, 0.f, -1.f };
+	auto distance = 0.f;
+	uint triangle = 0;
+	auto u = 0.f;
+	auto v = 0.f;
+
+	// origins lying exactly on the planes of the boxes, where the ray does not move along x/y
+	for (uint i = 0; i <= 64; i += 8)
+	{
+		const float origin[3] = { float(i), 10.25f, 3.f };
+
+		ASSERT_TRUE(bvh->cast(origin, direction, distance, triangle, u, v));
+		ASSERT_FLOAT_EQ(3.f, distance);
+	}
+
+	const float outside[3] = { 64.5f, 10.25f, 3.f };
+
+	ASSERT_FALSE(bvh->cast(outside, direction, distance, triangle, u, v));
+
+	// parallel to the grid, above it
+	const float above[3] = { -1.f, 10.25f, 1.f };
+	const float sideways[3] = { 1.f, 0.f, 0.f };
+
+	ASSERT_FALSE(bvh->cast(above, sideways, distance, triangle, u, v));
+}
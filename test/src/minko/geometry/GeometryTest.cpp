@@ -23,6 +23,67 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SO
 
 using namespace minko;
 using namespace minko::geometry;
+using namespace minko::math;
+
+namespace
+{
+	// a square of 2 triangles on the z = 0 plane, from -1 to 1
+	Geometry::Ptr
+	createSquare()
+	{
+		auto context = MinkoTests::canvas()->context();
+		auto geometry = Geometry::create();
+		std::vector<float> vertices = {
+			-1.f, -1.f, 0.f,
+			1.f, -1.f, 0.f,
+			1.f, 1.f, 0.f,
+			-1.f, 1.f, 0.f
+		};
+		auto vb = render::VertexBuffer::create(context, vertices);
+
+		vb->addAttribute("position", 3);
+		geometry->addVertexBuffer(vb);
+		geometry->indices(render::IndexBuffer::create(context, std::vector<unsigned short>{ 0, 1, 2, 0, 2, 3 }));
+
+		return geometry;
+	}
+
+	// tests every triangle, as Geometry::cast used to
+	bool
+	castEveryTriangle(Geometry::Ptr geometry, Ray::Ptr ray, float& distance)
+	{
+		auto xyzBuffer = geometry->vertexBuffer("position");
+		auto& xyz = xyzBuffer->data();
+		auto& indices = geometry->indices()->data();
+		auto hit = false;
+
+		for (uint i = 0; i < indices.size(); i += 3)
+		{
+			auto v0 = Vector3::create(&xyz[indices[i] * xyzBuffer->vertexSize()]);
+			auto edge1 = Vector3::create(&xyz[indices[i + 1] * xyzBuffer->vertexSize()])->subtract(v0);
+			auto edge2 = Vector3::create(&xyz[indices[i + 2] * xyzBuffer->vertexSize()])->subtract(v0);
+			auto pvec = Vector3::create(ray->direction())->cross(edge2);
+			auto dot = edge1->dot(pvec);
+
+			if (dot > -0.00001f && dot < 0.00001f)
+				continue;
+
+			auto tvec = Vector3::create(ray->origin())->subtract(v0);
+			auto u = tvec->dot(pvec) / dot;
+			auto qvec = Vector3::create(tvec)->cross(edge1);
+			auto v = ray->direction()->dot(qvec) / dot;
+			auto t = edge2->dot(qvec) / dot;
+
+			if (u < 0.f || u > 1.f || v < 0.f || u + v > 1.f || t < 0.f || (hit && t >= distance))
+				continue;
+
+			distance = t;
+			hit = true;
+		}
+
+		return hit;
+	}
+}
 
 TEST_F(GeometryTest, Create)
 {
@@ -130,3 +191,97 @@ TEST_F(GeometryTest, VertexBufferRemovedFromData)
 
 	ASSERT_FALSE(g->data()->hasProperty("position"));
 }
+
+TEST_F(GeometryTest, Cast)
+{
+	auto geometry = createSquare();
+	auto ray = Ray::create(Vector3::create(.5f, .25f, 2.f), Vector3::create(0.f, 0.f, -1.f));
+	auto hitXyz = Vector3::create();
+	auto distance = 0.f;
+	uint triangle = 0;
+
+	ASSERT_TRUE(geometry->cast(ray, distance, triangle, hitXyz));
+	ASSERT_FLOAT_EQ(2.f, distance);
+	ASSERT_EQ(0, triangle);
+	ASSERT_FLOAT_EQ(.5f, hitXyz->x());
+	ASSERT_FLOAT_EQ(.25f, hitXyz->y());
+	ASSERT_FLOAT_EQ(0.f, hitXyz->z());
+}
+
+TEST_F(GeometryTest, CastBehindOrigin)
+{
+	auto geometry = createSquare();
+	auto ray = Ray::create(Vector3::create(.5f, .25f, 2.f), Vector3::create(0.f, 0.f, 1.f));
+	auto distance = 0.f;
+	uint triangle = 0;
+
+	ASSERT_FALSE(geometry->cast(ray, distance, triangle));
+}
+
+TEST_F(GeometryTest, CastAfterPositionsChanged)
+{
+	auto geometry = createSquare();
+	auto ray = Ray::create(Vector3::create(.5f, .25f, 2.f), Vector3::create(0.f, 0.f, -1.f));
+	auto distance = 0.f;
+	uint triangle = 0;
+
+	ASSERT_TRUE(geometry->cast(ray, distance, triangle));
+
+	auto bvh = geometry->boundingVolumeHierarchy();
+	auto xyzBuffer = geometry->vertexBuffer("position");
+
+	for (uint i = 2; i < xyzBuffer->data().size(); i += 3)
+		xyzBuffer->data()[i] = 1.f;
+	xyzBuffer->upload();
+
+	// the hierarchy is refit, not built again
+	ASSERT_TRUE(geometry->cast(ray, distance, triangle));
+	ASSERT_FLOAT_EQ(1.f, distance);
+	ASSERT_EQ(bvh, geometry->boundingVolumeHierarchy());
+
+	// new indices build a new hierarchy
+	geometry->indices(render::IndexBuffer::create(MinkoTests::canvas()->context(), std::vector<unsigned short>{ 0, 1, 2 }));
+
+	ASSERT_NE(bvh, geometry->boundingVolumeHierarchy());
+}
+
+TEST_F(GeometryTest, CastSphereRays)
+{
+	auto geometry = SphereGeometry::create(MinkoTests::canvas()->context(), 40);
+	std::vector<Ray::Ptr> rays;
+
+	for (uint i = 0; i < 200; ++i)
+	{
+		auto origin = Vector3::create((rand() % 200) * .01f - 1.f, (rand() % 200) * .01f - 1.f, 2.f);
+		auto target = Vector3::create((rand() % 100) * .01f - .5f, (rand() % 100) * .01f - .5f, (rand() % 100) * .01f - .5f);
+
+		rays.push_back(Ray::create(origin, Vector3::create(target)->subtract(origin)->normalize()));
+	}
+
+	std::vector<float> distances;
+	std::vector<uint> triangles;
+	auto numHits = geometry->cast(rays, distances, triangles);
+	auto numExpectedHits = 0u;
+
+	for (uint i = 0; i < rays.size(); ++i)
+	{
+		auto expectedDistance = 0.f;
+		auto distance = 0.f;
+		uint triangle = 0;
+		auto expectedHit = castEveryTriangle(geometry, rays[i], expectedDistance);
+
+		ASSERT_EQ(expectedHit, geometry->cast(rays[i], distance, triangle));
+		ASSERT_EQ(expectedHit, distances[i] != std::numeric_limits<float>::infinity());
+
+		if (expectedHit)
+		{
+			++numExpectedHits;
+			ASSERT_NEAR(expectedDistance, distance, 1e-4f);
+			ASSERT_FLOAT_EQ(distance, distances[i]);
+			ASSERT_EQ(triangle, triangles[i]);
+		}
+	}
+
+	ASSERT_EQ(numExpectedHits, numHits);
+	ASSERT_LT(0u, numHits);
+}
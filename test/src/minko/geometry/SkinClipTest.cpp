@@ -0,0 +1,145 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+
+#include "SkinClipTest.hpp"
+
+#include "minko/geometry/Bone.hpp"
+#include "minko/geometry/Skin.hpp"
+#include "minko/geometry/SkinClip.hpp"
+
+using namespace minko;
+using namespace minko::geometry;
+using namespace minko::math;
+
+namespace
+{
+	Skin::Ptr
+	createSkin(uint numBones, uint numFrames, std::function<Matrix4x4::Ptr(uint, uint)> matrix)
+	{
+		auto skin = Skin::create(numBones, 1000, numFrames);
+
+		for (uint boneId = 0; boneId < numBones; ++boneId)
+		{
+			skin->bone(boneId, Bone::create(Matrix4x4::create(), { 0 }, { 1.f }));
+
+			for (uint frameId = 0; frameId < numFrames; ++frameId)
+				skin->matrix(frameId, boneId, matrix(boneId, frameId));
+		}
+
+		return skin->reorganizeByVertices()->transposeMatrices();
+	}
+
+	float
+	maxDifference(const std::vector<float>& a, const std::vector<float>& b)
+	{
+		float difference = 0.f;
+
+		for (uint i = 0; i < a.size(); ++i)
+			difference = std::max(difference, std::abs(a[i] - b[i]));
+
+		return difference;
+	}
+}
+
+TEST_F(SkinClipTest, CompressedMatricesWithinTolerance)
+{
+	const uint numBones = 20;
+	const uint numFrames = 90;
+	const float tolerance = 1e-3f;
+
+	auto skin = createSkin(numBones, numFrames, [](uint boneId, uint frameId)
+	{
+		return Matrix4x4::create()
+			->appendScale(1.f + .002f * frameId, 1.f, 1.f)
+			->appendRotationY(.01f * frameId * (boneId % 4))
+			->appendRotationX(.2f * std::sin(.05f * frameId))
+			->appendTranslation(float(boneId), .1f * frameId, .1f * std::cos(.05f * frameId));
+	});
+	auto baked = skin->getBoneMatricesPerFrame();
+
+	skin->compressMatrices(tolerance);
+
+	auto clip = skin->clip();
+
+	ASSERT_NE(nullptr, clip);
+	ASSERT_EQ(numFrames, skin->numFrames());
+	ASSERT_EQ(0u, clip->numBakedBones());
+	ASSERT_LT(clip->numKeys(), numBones * numFrames / 2);
+	ASSERT_LT(clip->size(), numBones * numFrames * 16 * sizeof(float));
+
+	for (uint frameId = 0; frameId < numFrames; ++frameId)
+		ASSERT_LE(maxDifference(baked[frameId], skin->matrices(frameId)), tolerance * 1.01f);
+}
+
+TEST_F(SkinClipTest, StaticBonesKeepOneKey)
+{
+	const uint numBones = 10;
+
+	auto skin = createSkin(numBones, 60, [](uint boneId, uint frameId)
+	{
+		return Matrix4x4::create()->appendRotationZ(float(boneId))->appendTranslation(float(boneId));
+	});
+
+	skin->compressMatrices(SkinClip::DEFAULT_TOLERANCE);
+
+	ASSERT_EQ(numBones, skin->clip()->numKeys());
+}
+
+TEST_F(SkinClipTest, ShearedBonesKeepBakedMatrices)
+{
+	auto skin = createSkin(2, 30, [](uint boneId, uint frameId)
+	{
+		auto matrix = Matrix4x4::create()->appendTranslation(float(frameId));
+
+		if (boneId == 1)
+			matrix->append(Matrix4x4::create()->initialize(
+				1.f, .5f, 0.f, 0.f,
+				0.f, 1.f, 0.f, 0.f,
+				0.f, 0.f, 1.f, 0.f,
+				0.f, 0.f, 0.f, 1.f
+			));
+
+		return matrix;
+	});
+	auto baked = skin->getBoneMatricesPerFrame();
+
+	skin->compressMatrices(SkinClip::DEFAULT_TOLERANCE);
+
+	ASSERT_EQ(1u, skin->clip()->numBakedBones());
+	for (uint frameId = 0; frameId < 30; ++frameId)
+		ASSERT_LE(maxDifference(baked[frameId], skin->matrices(frameId)), SkinClip::DEFAULT_TOLERANCE);
+}
+
+TEST_F(SkinClipTest, ClonesShareClip)
+{
+	auto skin = createSkin(4, 30, [](uint boneId, uint frameId)
+	{
+		return Matrix4x4::create()->appendRotationY(.1f * frameId)->appendTranslation(float(boneId));
+	});
+
+	skin->compressMatrices(SkinClip::DEFAULT_TOLERANCE);
+
+	auto clone = skin->clone();
+
+	ASSERT_EQ(skin->clip(), clone->clip());
+	ASSERT_TRUE(clone->getBoneMatricesPerFrame() == skin->getBoneMatricesPerFrame());
+	ASSERT_TRUE(clone->matrices(12) == skin->matrices(12));
+	ASSERT_THROW(clone->matrix(0, 0, Matrix4x4::create()), std::logic_error);
+}
@@ -0,0 +1,195 @@
+/*
+Copyright (c) 2013 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "OctTreeTest.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::math;
+
+scene::Node::Ptr
+OctTreeTest::createNode(scene::Node::Ptr root, float x, float y, float z, float size)
+{
+	auto node = scene::Node::create()
+		->addComponent(Transform::create(Matrix4x4::create()->appendTranslation(x, y, z)))
+		->addComponent(BoundingBox::create(size, Vector3::create()));
+
+	root->addChild(node);
+
+	return node;
+}
+
+Frustum::Ptr
+OctTreeTest::createFrustum()
+{
+	auto frustum = Frustum::create();
+
+	// looking down -z from the origin
+	frustum->updateFromMatrix(Matrix4x4::create()->perspective(.785f, 1.f, .1f, 1000.f));
+
+	return frustum;
+}
+
+TEST_F(OctTreeTest, InsertAndRemove)
+{
+	auto root = scene::Node::create()->addComponent(SceneManager::create(MinkoTests::canvas()));
+	auto octTree = OctTree::create(10.f, 7, Vector3::create());
+	auto a = createNode(root, 1.f, 2.f, 3.f);
+	auto b = createNode(root, -1.f, -2.f, -3.f);
+
+	octTree->insert(a)->insert(b)->insert(a);
+
+	ASSERT_EQ(octTree->numNodes(), 2);
+	ASSERT_TRUE(octTree->hasNode(a));
+	ASSERT_TRUE(octTree->hasNode(b));
+
+	octTree->remove(a);
+
+	ASSERT_EQ(octTree->numNodes(), 1);
+	ASSERT_FALSE(octTree->hasNode(a));
+	ASSERT_TRUE(octTree->hasNode(b));
+}
+
+TEST_F(OctTreeTest, TreeGrowsToFitNodes)
+{
+	auto root = scene::Node::create()->addComponent(SceneManager::create(MinkoTests::canvas()));
+	auto near = createNode(root, 0.f, 0.f, -10.f);
+	auto far = createNode(root, 0.f, 0.f, -500.f, 10.f);
+	auto behind = createNode(root, 0.f, 0.f, 3000.f);
+	auto octTree = OctTree::create(10.f, 7, Vector3::create());
+	std::set<scene::Node::Ptr> inside;
+
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+	octTree->insert(near)->insert(far)->insert(behind);
+
+	ASSERT_GE(octTree->worldSize(), 3000.f);
+
+	octTree->testFrustum(
+		createFrustum(),
+		[&](scene::Node::Ptr node) { inside.insert(node); },
+		[&](scene::Node::Ptr node) { }
+	);
+
+	ASSERT_EQ(inside.size(), 2);
+	ASSERT_EQ(inside.count(near), 1);
+	ASSERT_EQ(inside.count(far), 1);
+}
+
+TEST_F(OctTreeTest, OnlyVisibilityChangesAreReported)
+{
+	auto root = scene::Node::create()->addComponent(SceneManager::create(MinkoTests::canvas()));
+	auto octTree = OctTree::create(64.f, 7, Vector3::create());
+	auto numInside = 0;
+	auto numOutside = 0;
+	auto insideCallback = [&](scene::Node::Ptr node) { ++numInside; };
+	auto outsideCallback = [&](scene::Node::Ptr node) { ++numOutside; };
+
+	for (auto i = 0; i < 100; ++i)
+		createNode(root, float(i % 10) * 3.f - 15.f, 0.f, float(i / 10) * 3.f - 15.f);
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+	for (auto node : root->children())
+		octTree->insert(node);
+
+	octTree->testFrustum(createFrustum(), insideCallback, outsideCallback);
+
+	ASSERT_EQ(numInside + numOutside, 100);
+	ASSERT_GT(numInside, 0);
+	ASSERT_GT(numOutside, 0);
+
+	numInside = 0;
+	numOutside = 0;
+	octTree->testFrustum(createFrustum(), insideCallback, outsideCallback);
+
+	ASSERT_EQ(numInside, 0);
+	ASSERT_EQ(numOutside, 0);
+
+	// looking the other way
+	auto frustum = Frustum::create();
+
+	frustum->updateFromMatrix(Matrix4x4::create()
+		->appendRotationY(3.1415f)
+		->append(Matrix4x4::create()->perspective(.785f, 1.f, .1f, 1000.f))
+	);
+	octTree->testFrustum(frustum, insideCallback, outsideCallback);
+
+	ASSERT_GT(numInside, 0);
+	ASSERT_GT(numOutside, 0);
+}
+
+TEST_F(OctTreeTest, MovingNodeIsReinserted)
+{
+	auto root = scene::Node::create()->addComponent(SceneManager::create(MinkoTests::canvas()));
+	auto octTree = OctTree::create(64.f, 7, Vector3::create());
+	auto node = createNode(root, 0.f, 0.f, 20.f);
+	auto frustum = createFrustum();
+	std::vector<bool> results;
+	auto insideCallback = [&](scene::Node::Ptr node) { results.push_back(true); };
+	auto outsideCallback = [&](scene::Node::Ptr node) { results.push_back(false); };
+
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+	octTree->insert(node);
+	octTree->testFrustum(frustum, insideCallback, outsideCallback);
+
+	ASSERT_EQ(results, std::vector<bool>({ false }));
+	ASSERT_FALSE(octTree->hasChangedNodes());
+
+	node->component<Transform>()->matrix()->appendTranslation(0.f, 0.f, -40.f);
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+
+	ASSERT_TRUE(octTree->hasChangedNodes());
+
+	octTree->testChangedNodes(frustum, insideCallback, outsideCallback);
+
+	ASSERT_EQ(results, std::vector<bool>({ false, true }));
+	ASSERT_FALSE(octTree->hasChangedNodes());
+
+	// far away: the tree has to grow and the node is still found by a full test
+	node->component<Transform>()->matrix()->appendTranslation(0.f, 0.f, 4000.f);
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+	octTree->testFrustum(frustum, insideCallback, outsideCallback);
+
+	ASSERT_EQ(results, std::vector<bool>({ false, true, false }));
+	ASSERT_GE(octTree->worldSize(), 3980.f);
+}
+
+TEST_F(OctTreeTest, RemovedNodeIsNotReported)
+{
+	auto root = scene::Node::create()->addComponent(SceneManager::create(MinkoTests::canvas()));
+	auto octTree = OctTree::create(64.f, 7, Vector3::create());
+	auto a = createNode(root, 0.f, 0.f, -10.f);
+	auto b = createNode(root, 0.f, 0.f, -20.f);
+	auto c = createNode(root, 0.f, 0.f, -30.f);
+	std::set<scene::Node::Ptr> inside;
+
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+	octTree->insert(a)->insert(b)->insert(c)->remove(a);
+	octTree->testFrustum(
+		createFrustum(),
+		[&](scene::Node::Ptr node) { inside.insert(node); },
+		[&](scene::Node::Ptr node) { }
+	);
+
+	ASSERT_EQ(inside, std::set<scene::Node::Ptr>({ b, c }));
+
+	// moving a removed node does not do anything
+	a->component<Transform>()->matrix()->appendTranslation(1.f, 0.f, 0.f);
+	root->component<SceneManager>()->nextFrame(0.f, 0.f);
+
+	ASSERT_FALSE(octTree->hasChangedNodes());
+}
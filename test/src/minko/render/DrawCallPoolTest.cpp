@@ -0,0 +1,340 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "DrawCallPoolTest.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::math;
+using namespace minko::render;
+
+scene::Node::Ptr
+DrawCallPoolTest::createScene(RecordingContext::Ptr context)
+{
+    auto sceneManager = SceneManager::create(context);
+
+    sceneManager->assets()->loader()->queue("effect/Basic.effect");
+    sceneManager->assets()->loader()->load();
+
+    auto root = scene::Node::create("root")->addComponent(sceneManager);
+
+    root->addChild(scene::Node::create("camera")
+        ->addComponent(Renderer::create())
+        ->addComponent(Transform::create())
+        ->addComponent(PerspectiveCamera::create(1.f))
+    );
+
+    return root;
+}
+
+scene::Node::Ptr
+DrawCallPoolTest::createMesh(scene::Node::Ptr root, float id, float priority, float z, bool zSorted)
+{
+    auto assets = root->component<SceneManager>()->assets();
+    auto material = material::BasicMaterial::create();
+
+    // the diffuse color is used to identify the mesh in the recorded commands
+    material->diffuseColor(Vector4::create(id, .25f, .5f, .75f));
+    material->priority(priority);
+    material->zSorted(zSorted);
+
+    auto mesh = scene::Node::create()
+        ->addComponent(Transform::create(Matrix4x4::create()->appendTranslation(0.f, 0.f, z)))
+        ->addComponent(Surface::create(
+            geometry::CubeGeometry::create(assets->context()),
+            material,
+            assets->effect("effect/Basic.effect")
+        ));
+
+    root->addChild(mesh);
+
+    return mesh;
+}
+
+std::vector<scene::Node::Ptr>
+DrawCallPoolTest::createInstances(scene::Node::Ptr      root,
+                                  material::Material::Ptr  material,
+                                  uint                  numInstances)
+{
+    auto assets = root->component<SceneManager>()->assets();
+    auto geometry = geometry::CubeGeometry::create(assets->context());
+    std::vector<scene::Node::Ptr> meshes;
+
+    for (uint i = 0; i < numInstances; ++i)
+    {
+        auto mesh = scene::Node::create()
+            ->addComponent(Transform::create(Matrix4x4::create()->appendTranslation(float(i), 0.f, -10.f)))
+            ->addComponent(Surface::create(geometry, material, assets->effect("effect/Basic.effect")));
+
+        root->addChild(mesh);
+        meshes.push_back(mesh);
+    }
+
+    return meshes;
+}
+
+std::vector<float>
+DrawCallPoolTest::renderedMeshes(scene::Node::Ptr root, RecordingContext::Ptr context)
+{
+    std::vector<float> meshes;
+
+    context->clearCommands();
+    root->component<SceneManager>()->nextFrame(0.f, 0.f);
+
+    for (auto& command : context->commands())
+        if (command.type == RecordingContext::CommandType::SET_UNIFORM
+            && command.args[0] == 4
+            && command.values[1] == .25f && command.values[2] == .5f && command.values[3] == .75f)
+            meshes.push_back(command.values[0]);
+
+    return meshes;
+}
+
+TEST_F(DrawCallPoolTest, SortByPriority)
+{
+    auto context = RecordingContext::create();
+    auto root = createScene(context);
+
+    createMesh(root, 1.f, Priority::OPAQUE, 0.f, false);
+    createMesh(root, 2.f, Priority::FIRST, 0.f, false);
+    createMesh(root, 3.f, Priority::BACKGROUND, 0.f, false);
+    createMesh(root, 4.f, Priority::LAST, 0.f, false);
+
+    ASSERT_EQ(renderedMeshes(root, context), std::vector<float>({ 2.f, 3.f, 1.f, 4.f }));
+}
+
+TEST_F(DrawCallPoolTest, SortTransparentBackToFront)
+{
+    auto context = RecordingContext::create();
+    auto root = createScene(context);
+
+    createMesh(root, 1.f, Priority::TRANSPARENT, -2.f, true);
+    createMesh(root, 2.f, Priority::TRANSPARENT, -10.f, true);
+    createMesh(root, 3.f, Priority::TRANSPARENT, -5.f, true);
+    createMesh(root, 4.f, Priority::OPAQUE, 0.f, false);
+
+    ASSERT_EQ(renderedMeshes(root, context), std::vector<float>({ 4.f, 2.f, 3.f, 1.f }));
+}
+
+TEST_F(DrawCallPoolTest, SortAfterTransparentMeshMoved)
+{
+    auto context = RecordingContext::create();
+    auto root = createScene(context);
+
+    auto mesh = createMesh(root, 1.f, Priority::TRANSPARENT, -2.f, true);
+    createMesh(root, 2.f, Priority::TRANSPARENT, -5.f, true);
+
+    ASSERT_EQ(renderedMeshes(root, context), std::vector<float>({ 2.f, 1.f }));
+
+    mesh->component<Transform>()->matrix()->appendTranslation(0.f, 0.f, -8.f);
+
+    ASSERT_EQ(renderedMeshes(root, context), std::vector<float>({ 1.f, 2.f }));
+}
+
+TEST_F(DrawCallPoolTest, RemoveSurface)
+{
+    auto context = RecordingContext::create();
+    auto root = createScene(context);
+
+    createMesh(root, 1.f, Priority::OPAQUE, 0.f, false);
+    auto mesh = createMesh(root, 2.f, Priority::FIRST, 0.f, false);
+    createMesh(root, 3.f, Priority::LAST, 0.f, false);
+
+    ASSERT_EQ(renderedMeshes(root, context), std::vector<float>({ 2.f, 1.f, 3.f }));
+
+    root->removeChild(mesh);
+
+    ASSERT_EQ(renderedMeshes(root, context), std::vector<float>({ 1.f, 3.f }));
+}
+
+TEST_F(DrawCallPoolTest, InstanceSurfacesSharingGeometryAndMaterial)
+{
+    auto context = RecordingContext::create();
+    auto root = createScene(context);
+    auto material = material::BasicMaterial::create();
+
+    material->diffuseColor(Vector4::create(1.f, .25f, .5f, .75f));
+    createInstances(root, material, 10);
+    createMesh(root, 2.f, Priority::OPAQUE, 0.f, false);
+
+    auto meshes = renderedMeshes(root, context);
+
+    std::sort(meshes.begin(), meshes.end());
+
+    ASSERT_EQ(meshes, std::vector<float>({ 1.f, 2.f }));
+    ASSERT_EQ(context->numDrawCalls(), 2);
+    ASSERT_EQ(context->numInstances(), 11);
+    ASSERT_EQ(root->children()[0]->component<Renderer>()->numDrawCalls(), 2);
+}
+
+TEST_F(DrawCallPoolTest, InstancingFallback)
+{
+    auto context = RecordingContext::create();
+    auto root = createScene(context);
+    auto material = material::BasicMaterial::create();
+
+    context->supportsInstancing(false);
+    createInstances(root, material, 10);
+    renderedMeshes(root, context);
+
+    ASSERT_EQ(context->numDrawCalls(), 10);
+    ASSERT_EQ(context->numInstances(), 10);
+}
+
+TEST_F(DrawCallPoolTest, DisableInstancing)
+{
+    auto context = RecordingContext::create();
+    auto root = createScene(context);
+    auto renderer = root->children()[0]->component<Renderer>();
+
+    createInstances(root, material::BasicMaterial::create(), 10);
+    renderedMeshes(root, context);
+
+    ASSERT_EQ(context->numDrawCalls(), 1);
+
+    renderer->instancing(false);
+    renderedMeshes(root, context);
+
+    ASSERT_EQ(context->numDrawCalls(), 10);
+
+    renderer->instancing(true);
+    renderedMeshes(root, context);
+
+    ASSERT_EQ(context->numDrawCalls(), 1);
+}
+
+TEST_F(DrawCallPoolTest, NoInstancingForZSortedSurfaces)
+{
+    auto context = RecordingContext::create();
+    auto root = createScene(context);
+    auto material = material::BasicMaterial::create();
+
+    material->priority(Priority::TRANSPARENT);
+    material->zSorted(true);
+    createInstances(root, material, 10);
+    renderedMeshes(root, context);
+
+    ASSERT_EQ(context->numDrawCalls(), 10);
+}
+
+TEST_F(DrawCallPoolTest, InstancingAfterSurfaceRemoved)
+{
+    auto context = RecordingContext::create();
+    auto root = createScene(context);
+    auto meshes = createInstances(root, material::BasicMaterial::create(), 3);
+
+    renderedMeshes(root, context);
+
+    ASSERT_EQ(context->numDrawCalls(), 1);
+    ASSERT_EQ(context->numInstances(), 3);
+
+    root->removeChild(meshes[0]);
+    renderedMeshes(root, context);
+
+    ASSERT_EQ(context->numDrawCalls(), 1);
+    ASSERT_EQ(context->numInstances(), 2);
+
+    root->removeChild(meshes[1]);
+    renderedMeshes(root, context);
+
+    ASSERT_EQ(context->numDrawCalls(), 1);
+    ASSERT_EQ(context->numInstances(), 1);
+}
+
+TEST_F(DrawCallPoolTest, InstanceBufferFollowsTransforms)
+{
+    auto context = RecordingContext::create();
+    auto root = createScene(context);
+    auto meshes = createInstances(root, material::BasicMaterial::create(), 4);
+
+    renderedMeshes(root, context);
+    renderedMeshes(root, context);
+
+    // nothing moved: no upload
+    ASSERT_EQ(context->numCommands(RecordingContext::CommandType::UPLOAD_VERTEX_BUFFER), 0);
+
+    meshes[2]->component<Transform>()->matrix()->appendTranslation(0.f, 1.f, 0.f);
+    renderedMeshes(root, context);
+
+    // only the moved instance is uploaded
+    auto uploads = std::count_if(context->commands().begin(), context->commands().end(), [](const RecordingContext::Command& c)
+    {
+        return c.type == RecordingContext::CommandType::UPLOAD_VERTEX_BUFFER && c.args[0] == 2 * 16 && c.args[1] == 16;
+    });
+
+    ASSERT_EQ(context->numCommands(RecordingContext::CommandType::UPLOAD_VERTEX_BUFFER), 1);
+    ASSERT_EQ(uploads, 1);
+}
+
+TEST_F(DrawCallPoolTest, OnlyChangedInstancingGroupsAreRebuilt)
+{
+    auto context = RecordingContext::create();
+    auto root = createScene(context);
+    auto meshes = createInstances(root, material::BasicMaterial::create(), 3);
+
+    createInstances(root, material::BasicMaterial::create(), 3);
+    renderedMeshes(root, context);
+
+    ASSERT_EQ(context->numDrawCalls(), 2);
+    ASSERT_EQ(context->numInstances(), 6);
+
+    meshes[0]->component<Surface>()->visible(false);
+    renderedMeshes(root, context);
+
+    // the group of the hidden surface keeps its instance buffer, the other one is untouched
+    ASSERT_EQ(context->numDrawCalls(), 2);
+    ASSERT_EQ(context->numInstances(), 5);
+    ASSERT_EQ(context->numCommands(RecordingContext::CommandType::CREATE_VERTEX_BUFFER), 0);
+}
+
+TEST_F(DrawCallPoolTest, InstanceBufferGrowsOnlyPastItsCapacity)
+{
+    auto context = RecordingContext::create();
+    auto root = createScene(context);
+    auto material = material::BasicMaterial::create();
+    auto meshes = createInstances(root, material, 3);
+
+    renderedMeshes(root, context);
+
+    meshes[1]->component<Surface>()->visible(false);
+    renderedMeshes(root, context);
+
+    ASSERT_EQ(context->numDrawCalls(), 1);
+    ASSERT_EQ(context->numInstances(), 2);
+    ASSERT_EQ(context->numCommands(RecordingContext::CommandType::CREATE_VERTEX_BUFFER), 0);
+
+    meshes[1]->component<Surface>()->visible(true);
+    renderedMeshes(root, context);
+
+    ASSERT_EQ(context->numDrawCalls(), 1);
+    ASSERT_EQ(context->numInstances(), 3);
+    ASSERT_EQ(context->numCommands(RecordingContext::CommandType::CREATE_VERTEX_BUFFER), 0);
+
+    auto surface = meshes[0]->component<Surface>();
+
+    root->addChild(scene::Node::create()
+        ->addComponent(Transform::create(Matrix4x4::create()->appendTranslation(3.f, 0.f, -10.f)))
+        ->addComponent(Surface::create(surface->geometry(), material, surface->effect()))
+    );
+    renderedMeshes(root, context);
+
+    ASSERT_EQ(context->numDrawCalls(), 1);
+    ASSERT_EQ(context->numInstances(), 4);
+    ASSERT_EQ(context->numCommands(RecordingContext::CommandType::CREATE_VERTEX_BUFFER), 1);
+}
@@ -0,0 +1,99 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "DrawCallTest.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::math;
+using namespace minko::render;
+
+namespace
+{
+    Renderer::Ptr
+    createScene(RecordingContext::Ptr context, uint numMeshes)
+    {
+        auto sceneManager = SceneManager::create(context);
+        auto assets = sceneManager->assets();
+
+        assets->loader()->queue("effect/Basic.effect");
+        assets->loader()->load();
+
+        auto root = scene::Node::create("root")->addComponent(sceneManager);
+        auto renderer = Renderer::create();
+        auto geometry = geometry::CubeGeometry::create(context);
+
+        root->addChild(scene::Node::create("camera")
+            ->addComponent(renderer)
+            ->addComponent(Transform::create())
+            ->addComponent(PerspectiveCamera::create(1.f))
+        );
+
+        for (auto i = 0u; i < numMeshes; ++i)
+            root->addChild(scene::Node::create()
+                ->addComponent(Transform::create(Matrix4x4::create()->appendTranslation(0.f, 0.f, -10.f - i)))
+                ->addComponent(Surface::create(
+                    geometry,
+                    material::BasicMaterial::create()->diffuseColor(Vector4::create(i / float(numMeshes), 0.f, 0.f, 1.f)),
+                    assets->effect("effect/Basic.effect")
+                ))
+            );
+
+        sceneManager->nextFrame(0.f, 0.f);
+        context->recordCommands(false);
+        context->clearCommands();
+
+        return renderer;
+    }
+}
+
+TEST_F(DrawCallTest, RenderManyFrames)
+{
+    const auto numMeshes = 200u;
+    const auto numFrames = 10u;
+
+    auto context = RecordingContext::create();
+    auto renderer = createScene(context, numMeshes);
+
+    for (auto i = 0u; i < numFrames; ++i)
+        renderer->render(context);
+
+    ASSERT_EQ(context->numDrawCalls(), numFrames * numMeshes);
+    ASSERT_EQ(context->numTriangles(), numFrames * numMeshes * 12);
+}
+
+// opt-in: run with --gtest_also_run_disabled_tests --gtest_filter=*Benchmark*
+TEST_F(DrawCallTest, DISABLED_RenderBenchmark)
+{
+    const auto numMeshes = 2000u;
+    const auto numFrames = 50u;
+
+    auto context = RecordingContext::create();
+    auto renderer = createScene(context, numMeshes);
+    auto start = std::chrono::high_resolution_clock::now();
+
+    for (auto i = 0u; i < numFrames; ++i)
+        renderer->render(context);
+
+    auto duration = std::chrono::duration<double, std::micro>(std::chrono::high_resolution_clock::now() - start);
+
+    RecordProperty("usPerDrawCall", std::to_string(duration.count() / (numFrames * numMeshes)));
+
+    ASSERT_EQ(context->numDrawCalls(), numFrames * numMeshes);
+}
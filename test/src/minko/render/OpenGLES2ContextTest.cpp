@@ -0,0 +1,262 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "OpenGLES2ContextTest.hpp"
+
+#include "minko/render/WrapMode.hpp"
+#include "minko/render/TextureFilter.hpp"
+#include "minko/render/MipFilter.hpp"
+
+using namespace minko;
+using namespace minko::render;
+
+uint
+OpenGLES2ContextTest::createProgram(const std::string& vertexShaderSource, const std::string& fragmentShaderSource)
+{
+    auto context = this->context();
+    auto vertexShader = context->createVertexShader();
+    auto fragmentShader = context->createFragmentShader();
+    auto program = context->createProgram();
+
+    context->setShaderSource(vertexShader, vertexShaderSource);
+    context->compileShader(vertexShader);
+    context->setShaderSource(fragmentShader, fragmentShaderSource);
+    context->compileShader(fragmentShader);
+    context->attachShader(program, vertexShader);
+    context->attachShader(program, fragmentShader);
+    context->linkProgram(program);
+
+    return program;
+}
+
+TEST_F(OpenGLES2ContextTest, RedundantBlendModeIsSkipped)
+{
+    auto context = this->context();
+
+    ASSERT_TRUE(context != nullptr);
+
+    context->setBlendMode(Blending::Mode::ADDITIVE);
+    context->resetStateChangesCounters();
+    context->setBlendMode(Blending::Mode::ADDITIVE);
+
+    ASSERT_EQ(context->numIssuedStateChanges(), 0);
+    ASSERT_EQ(context->numSkippedStateChanges(), 1);
+
+    context->setBlendMode(Blending::Mode::ALPHA);
+
+    ASSERT_EQ(context->numIssuedStateChanges(), 1);
+    ASSERT_EQ(context->numSkippedStateChanges(), 1);
+}
+
+TEST_F(OpenGLES2ContextTest, RedundantDepthTestIsSkipped)
+{
+    auto context = this->context();
+
+    ASSERT_TRUE(context != nullptr);
+
+    context->setDepthTest(true, CompareMode::LESS);
+    context->resetStateChangesCounters();
+    context->setDepthTest(true, CompareMode::LESS);
+
+    ASSERT_EQ(context->numIssuedStateChanges(), 0);
+
+    context->setDepthTest(true, CompareMode::GREATER);
+
+    ASSERT_EQ(context->numIssuedStateChanges(), 1);
+}
+
+TEST_F(OpenGLES2ContextTest, RedundantTextureIsSkipped)
+{
+    auto context = this->context();
+
+    ASSERT_TRUE(context != nullptr);
+
+    auto texture = context->createTexture(TextureType::Texture2D, 32, 32, false);
+
+    context->setTextureAt(0, texture);
+    context->resetStateChangesCounters();
+    context->setTextureAt(0, texture);
+    context->setSamplerStateAt(0, WrapMode::CLAMP, TextureFilter::NEAREST, MipFilter::NONE);
+
+    ASSERT_EQ(context->numIssuedStateChanges(), 0);
+
+    context->setSamplerStateAt(0, WrapMode::REPEAT, TextureFilter::NEAREST, MipFilter::NONE);
+
+    ASSERT_NE(context->numIssuedStateChanges(), 0);
+
+    context->deleteTexture(texture);
+}
+
+TEST_F(OpenGLES2ContextTest, RedundantVertexBufferIsSkipped)
+{
+    auto context = this->context();
+
+    ASSERT_TRUE(context != nullptr);
+
+    auto vertexBuffer = context->createVertexBuffer(36);
+
+    context->setVertexBufferAt(0, vertexBuffer, 3, 6, 0);
+    context->resetStateChangesCounters();
+    context->setVertexBufferAt(0, vertexBuffer, 3, 6, 0);
+
+    ASSERT_EQ(context->numIssuedStateChanges(), 0);
+
+    context->setVertexBufferAt(0, vertexBuffer, 3, 6, 3);
+
+    ASSERT_NE(context->numIssuedStateChanges(), 0);
+
+    context->setVertexBufferAt(0, 0, 0, 0, 0);
+    context->deleteVertexBuffer(vertexBuffer);
+}
+
+TEST_F(OpenGLES2ContextTest, RedundantUniformIsSkipped)
+{
+    auto context = this->context();
+
+    ASSERT_TRUE(context != nullptr);
+
+    auto program = createProgram(
+        "attribute vec3 position;\n"
+        "uniform vec4 color;\n"
+        "void main() { gl_Position = vec4(position, 1.0) * color; }\n",
+        "void main() { gl_FragColor = vec4(1.0); }\n"
+    );
+    auto location = context->getProgramInputs(program)->location("color");
+
+    ASSERT_GE(location, 0);
+
+    context->setProgram(program);
+    context->setUniform(location, 1.f, 2.f, 3.f, 4.f);
+    context->resetStateChangesCounters();
+    context->setUniform(location, 1.f, 2.f, 3.f, 4.f);
+
+    ASSERT_EQ(context->numIssuedStateChanges(), 0);
+    ASSERT_EQ(context->numSkippedStateChanges(), 1);
+
+    context->setUniform(location, 1.f, 2.f, 3.f, 5.f);
+
+    ASSERT_EQ(context->numIssuedStateChanges(), 1);
+
+    // linking resets the uniforms of the program
+    context->linkProgram(program);
+    context->setUniform(location, 1.f, 2.f, 3.f, 5.f);
+
+    ASSERT_EQ(context->numIssuedStateChanges(), 2);
+
+    context->deleteProgram(program);
+}
+
+TEST_F(OpenGLES2ContextTest, UniformsAreCachedPerProgram)
+{
+    auto context = this->context();
+
+    ASSERT_TRUE(context != nullptr);
+
+    auto vertexShaderSource = std::string(
+        "attribute vec3 position;\n"
+        "uniform float scale;\n"
+        "void main() { gl_Position = vec4(position * scale, 1.0); }\n"
+    );
+    auto fragmentShaderSource = std::string("void main() { gl_FragColor = vec4(1.0); }\n");
+    auto program1 = createProgram(vertexShaderSource, fragmentShaderSource);
+    auto program2 = createProgram(vertexShaderSource, fragmentShaderSource);
+    auto location1 = context->getProgramInputs(program1)->location("scale");
+    auto location2 = context->getProgramInputs(program2)->location("scale");
+
+    context->setProgram(program1);
+    context->setUniform(location1, 2.f);
+    context->setProgram(program2);
+    context->resetStateChangesCounters();
+    context->setUniform(location2, 2.f);
+
+    ASSERT_EQ(context->numIssuedStateChanges(), 1);
+
+    context->setProgram(program1);
+    context->resetStateChangesCounters();
+    context->setUniform(location1, 2.f);
+
+    ASSERT_EQ(context->numIssuedStateChanges(), 0);
+
+    context->deleteProgram(program1);
+    context->deleteProgram(program2);
+}
+
+TEST_F(OpenGLES2ContextTest, DrawInstancedTriangles)
+{
+    auto context = this->context();
+
+    ASSERT_TRUE(context != nullptr);
+
+    if (!context->supportsInstancing())
+        return;
+
+    // a quad covering the left half of the viewport, drawn twice: once in place, once moved to the right half
+    auto program = createProgram(
+        "attribute vec2 position;\n"
+        "attribute float offset;\n"
+        "attribute vec4 color;\n"
+        "varying vec4 vertexColor;\n"
+        "void main() { vertexColor = color; gl_Position = vec4(position.x + offset, position.y, 0.0, 1.0); }\n",
+        "varying vec4 vertexColor;\n"
+        "void main() { gl_FragColor = vertexColor; }\n"
+    );
+    auto inputs = context->getProgramInputs(program);
+    float positions[] = { -1.f, -1.f, 0.f, -1.f, 0.f, 1.f, -1.f, 1.f };
+    float instances[] = { 0.f, 1.f, 0.f, 0.f, 1.f, 1.f, 0.f, 1.f, 0.f, 1.f };
+    unsigned short indices[] = { 0, 1, 2, 0, 2, 3 };
+    auto vertexBuffer = context->createVertexBuffer(8);
+    auto instanceBuffer = context->createVertexBuffer(10);
+    auto indexBuffer = context->createIndexBuffer(6);
+    auto texture = context->createTexture(TextureType::Texture2D, 4, 4, false, true);
+
+    context->uploadVertexBufferData(vertexBuffer, 0, 8, positions);
+    context->uploadVertexBufferData(instanceBuffer, 0, 10, instances);
+    context->uploaderIndexBufferData(indexBuffer, 0, 6, indices);
+
+    context->setRenderToTexture(texture, true);
+    context->clear();
+    context->setProgram(program);
+    context->setBlendMode(Blending::Mode::DEFAULT);
+    context->setDepthTest(true, CompareMode::ALWAYS);
+    context->setTriangleCulling(TriangleCulling::NONE);
+    context->setVertexBufferAt(inputs->location("position"), vertexBuffer, 2, 2, 0);
+    context->setVertexBufferAt(inputs->location("offset"), instanceBuffer, 1, 5, 0, 1);
+    context->setVertexBufferAt(inputs->location("color"), instanceBuffer, 4, 5, 1, 1);
+    context->drawInstancedTriangles(indexBuffer, 2, 2);
+
+    std::vector<unsigned char> pixels(4 * 4 * 4);
+
+    context->readPixels(0, 0, 4, 4, &pixels[0]);
+
+    // red on the left, green on the right
+    ASSERT_EQ(pixels[0], 255);
+    ASSERT_EQ(pixels[1], 0);
+    ASSERT_EQ(pixels[3 * 4], 0);
+    ASSERT_EQ(pixels[3 * 4 + 1], 255);
+
+    context->setVertexBufferAt(inputs->location("offset"), 0, 0, 0, 0);
+    context->setVertexBufferAt(inputs->location("color"), 0, 0, 0, 0);
+    context->setVertexBufferAt(inputs->location("position"), 0, 0, 0, 0);
+    context->setRenderToBackBuffer();
+    context->deleteTexture(texture);
+    context->deleteIndexBuffer(indexBuffer);
+    context->deleteVertexBuffer(instanceBuffer);
+    context->deleteVertexBuffer(vertexBuffer);
+    context->deleteProgram(program);
+}
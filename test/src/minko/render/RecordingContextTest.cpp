@@ -0,0 +1,196 @@
+/*
+Copyright (c) 2014 Aerys
+
+Permission is hereby granted, free of charge, to any person obtaining a copy of this software and
+associated documentation files (the "Software"), to deal in the Software without restriction,
+including without limitation the rights to use, copy, modify, merge, publish, distribute,
+sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all copies or
+substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING
+BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS FOR A PARTICULAR PURPOSE AND
+NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+*/
+
+#include "RecordingContextTest.hpp"
+
+using namespace minko;
+using namespace minko::component;
+using namespace minko::render;
+
+TEST_F(RecordingContextTest, Create)
+{
+    try
+    {
+        auto context = RecordingContext::create();
+    }
+    catch (...)
+    {
+        ASSERT_TRUE(false);
+    }
+}
+
+TEST_F(RecordingContextTest, CreateResources)
+{
+    auto context = RecordingContext::create();
+
+    auto vertexBuffer = context->createVertexBuffer(12);
+    auto indexBuffer = context->createIndexBuffer(3);
+    auto texture = context->createTexture(TextureType::Texture2D, 32, 32, false);
+
+    ASSERT_NE(vertexBuffer, 0);
+    ASSERT_NE(indexBuffer, 0);
+    ASSERT_NE(texture, 0);
+    ASSERT_NE(vertexBuffer, indexBuffer);
+    ASSERT_NE(indexBuffer, texture);
+    ASSERT_EQ(context->numCommands(RecordingContext::CommandType::CREATE_VERTEX_BUFFER), 1);
+    ASSERT_EQ(context->numCommands(RecordingContext::CommandType::CREATE_INDEX_BUFFER), 1);
+    ASSERT_EQ(context->numCommands(RecordingContext::CommandType::CREATE_TEXTURE), 1);
+    ASSERT_EQ(context->commands().size(), 3);
+}
+
+TEST_F(RecordingContextTest, RenderToInvalidTexture)
+{
+    auto context = RecordingContext::create();
+    auto texture = context->createTexture(TextureType::Texture2D, 32, 32, false);
+
+    ASSERT_THROW(context->setRenderToTexture(texture), std::logic_error);
+}
+
+TEST_F(RecordingContextTest, RedundantStateChanges)
+{
+    auto context = RecordingContext::create();
+
+    context->setBlendMode(Blending::Mode::ADDITIVE);
+    context->setBlendMode(Blending::Mode::ADDITIVE);
+    context->setBlendMode(Blending::Mode::ALPHA);
+
+    ASSERT_EQ(context->numCommands(RecordingContext::CommandType::SET_BLEND_MODE), 3);
+    ASSERT_EQ(context->numRedundantCommands(RecordingContext::CommandType::SET_BLEND_MODE), 1);
+
+    context->setUniform(0, 1.f, 2.f, 3.f);
+    context->setUniform(0, 1.f, 2.f, 3.f);
+    context->setUniform(0, 1.f, 2.f, 4.f);
+
+    ASSERT_EQ(context->numCommands(RecordingContext::CommandType::SET_UNIFORM), 3);
+    ASSERT_EQ(context->numRedundantCommands(RecordingContext::CommandType::SET_UNIFORM), 1);
+    ASSERT_EQ(context->numRedundantCommands(), 2);
+
+    context->clearCommands();
+
+    ASSERT_EQ(context->numCommands(), 0);
+    ASSERT_TRUE(context->commands().empty());
+
+    context->setBlendMode(Blending::Mode::ALPHA);
+
+    ASSERT_EQ(context->numRedundantCommands(RecordingContext::CommandType::SET_BLEND_MODE), 1);
+}
+
+TEST_F(RecordingContextTest, DisableCommandLog)
+{
+    auto context = RecordingContext::create();
+
+    context->recordCommands(false);
+    context->clear();
+    context->present();
+
+    ASSERT_TRUE(context->commands().empty());
+    ASSERT_EQ(context->numCommands(), 2);
+}
+
+TEST_F(RecordingContextTest, ProgramInputs)
+{
+    auto context = RecordingContext::create();
+    auto vertexShader = context->createVertexShader();
+    auto fragmentShader = context->createFragmentShader();
+    auto program = context->createProgram();
+
+    context->setShaderSource(
+        vertexShader,
+        "#define VERTEX_SHADER\n"
+        "#define NUM_BONES 2\n"
+        "attribute vec3 position;\n"
+        "#ifdef SKINNING\n"
+        "attribute vec4 boneWeights;\n"
+        "#endif\n"
+        "uniform mat4 modelToWorldMatrix;\n"
+        "uniform mat4 boneMatrices[NUM_BONES]; // comment\n"
+        "void main() { gl_Position = modelToWorldMatrix * vec4(position, 1.0); }\n"
+    );
+    context->setShaderSource(
+        fragmentShader,
+        "#ifdef GL_ES\n"
+        "precision mediump float;\n"
+        "#endif\n"
+        "struct Light { vec3 color; float attenuation; };\n"
+        "/* uniform float ignored; */\n"
+        "uniform Light lights[2];\n"
+        "#if defined(VERTEX_SHADER) || NUM_BONES > 1\n"
+        "uniform float ignored;\n"
+        "#else\n"
+        "uniform sampler2D diffuseMap;\n"
+        "#endif\n"
+        "uniform mat4 modelToWorldMatrix;\n"
+        "void main() { gl_FragColor = texture2D(diffuseMap, vec2(0.0)); }\n"
+    );
+    context->compileShader(vertexShader);
+    context->compileShader(fragmentShader);
+    context->attachShader(program, vertexShader);
+    context->attachShader(program, fragmentShader);
+    context->linkProgram(program);
+
+    auto inputs = context->getProgramInputs(program);
+
+    ASSERT_EQ(inputs->type("position"), ProgramInputs::Type::attribute);
+    ASSERT_FALSE(inputs->hasName("boneWeights"));
+    ASSERT_EQ(inputs->type("modelToWorldMatrix"), ProgramInputs::Type::float16);
+    ASSERT_EQ(inputs->type("boneMatrices[0]"), ProgramInputs::Type::float16);
+    ASSERT_EQ(inputs->type("lights[1].color"), ProgramInputs::Type::float3);
+    ASSERT_EQ(inputs->type("lights[1].attenuation"), ProgramInputs::Type::float1);
+    ASSERT_EQ(inputs->type("diffuseMap"), ProgramInputs::Type::sampler2d);
+    ASSERT_FALSE(inputs->hasName("ignored"));
+    ASSERT_NE(inputs->location("lights[0].color"), inputs->location("lights[1].color"));
+}
+
+TEST_F(RecordingContextTest, RenderFrame)
+{
+    auto context = RecordingContext::create();
+    auto sceneManager = SceneManager::create(context);
+    auto assets = sceneManager->assets();
+
+    assets->loader()->queue("effect/Basic.effect");
+    assets->loader()->load();
+
+    auto root = scene::Node::create("root")->addComponent(sceneManager);
+    auto camera = scene::Node::create("camera")
+        ->addComponent(Renderer::create())
+        ->addComponent(PerspectiveCamera::create(1.f));
+    auto geometry = geometry::CubeGeometry::create(context);
+    auto numMeshes = 10u;
+
+    root->addChild(camera);
+
+    for (auto i = 0u; i < numMeshes; ++i)
+        root->addChild(scene::Node::create()
+            ->addComponent(Transform::create())
+            ->addComponent(Surface::create(
+                geometry,
+                material::BasicMaterial::create()->diffuseColor(0xff0000ff),
+                assets->effect("effect/Basic.effect")
+            ))
+        );
+
+    sceneManager->nextFrame(0.f, 0.f);
+    context->clearCommands();
+    sceneManager->nextFrame(0.f, 0.f);
+
+    ASSERT_EQ(context->numDrawCalls(), numMeshes);
+    ASSERT_EQ(context->numTriangles(), numMeshes * 12);
+    ASSERT_EQ(context->numCommands(RecordingContext::CommandType::CLEAR), 1);
+    ASSERT_EQ(context->numCommands(RecordingContext::CommandType::PRESENT), 1);
+}